@@ -67,7 +67,9 @@ void SiLabs_Startup (void)
 #include "cos_mgr.h"
 #include "cos_nmt.h"
 #include "cos_pdo.h"
+#include "cos_psch.h"
 #include "cos_time.h"
+#include "cos_nvm.h"
 
 
 #include "mc_i2c.h"
@@ -77,6 +79,18 @@ void SiLabs_Startup (void)
 #include "c51f550_hal.h"
 #define TRANSMIT_MO        0x05
 
+//-------------------------------------------------------------------
+// listen time for each bitrate of the automatic detection in
+// microseconds
+//
+#define AUTOBAUD_WAIT      200000L
+
+//-------------------------------------------------------------------
+// total time of the automatic detection in microseconds, on a quiet
+// bus the node starts with the cached bitrate or with 250 kBit/s
+//
+#define AUTOBAUD_TIMEOUT   10000000L
+
 extern void Sk60AppInit(void);
 extern void McCpuInit(void);
 extern void McWdtInit(void);
@@ -97,7 +111,13 @@ void main(void)
 {
    uint8_t  ubBaudSelT = CP_BAUD_250K;    // selected CANopen baudrate
    uint8_t  ubNodeIdT = 20;     // selected CANopen Node-ID
+   #if CP_AUTOBAUD > 0
    uint16_t uwBaudWaitT;   // wait time for automatic bit-rate detection
+   uint32_t ulBaudStartT;  // timer tick at start of the detection
+   uint8_t  ubBaudStatusT; // result of the automatic bit-rate detection
+   uint8_t  ubBaudNvmT;    // bit-rate cached in NVM
+   uint16_t uwChecksumT;   // NVM checksum after caching the bit-rate
+   #endif
    #if COS_TMR_INT == 0
    uint32_t ulTimerTickT = 0;    // timer tick value
    #endif
@@ -123,9 +143,12 @@ void main(void)
    //
    McTmrInit();
    //----------------------------------------------------------------
-   // Initialise EEPROM
+   // Initialise EEPROM, it holds the bitrate found by the automatic
+   // bitrate detection
    //
-//   McNvmInit();
+   #if CP_AUTOBAUD > 0
+   McNvmInit();
+   #endif
 
    //----------------------------------------------------------------
    // Initialise the hardware / demo board
@@ -135,9 +158,18 @@ void main(void)
    //McI2C_Init(eI2C_NET_1);
 
    //----------------------------------------------------------------
-   // read the actual baurate setting and test if it is valid
+   // read the actual baurate setting and test if it is valid, with
+   // automatic bitrate detection the bitrate cached in the LSS entry
+   // is the first candidate of the detection (a value out of range
+   // means not configured yet)
    //
+   #if CP_AUTOBAUD > 0
+   McNvmRead(eNVM_305_BAUDRATE_U08, &ubBaudSelT, 1);
+   if(ubBaudSelT > CP_BAUD_MAX) ubBaudSelT = CP_BAUD_AUTO;
+   ubBaudNvmT = ubBaudSelT;
+   #else
    ubBaudSelT = CP_BAUD_250K;
+   #endif
    if(ubBaudSelT > CP_BAUD_MAX)
    {
       //---------------------------------------------------
@@ -156,13 +188,46 @@ void main(void)
 
    //----------------------------------------------------------------
    // test for auto-baudrate detection (this feature depends on the
-   // used CAN controller)
+   // used CAN controller), a cached bitrate is verified as well: the
+   // node may have been moved to a network with another bitrate
    //
-   if(ubBaudSelT == CP_BAUD_AUTO)
+   #if CP_AUTOBAUD > 0
+   uwBaudWaitT  = (uint16_t) (AUTOBAUD_WAIT / COS_TIMER_PERIOD);
+   ulBaudStartT = McTmrTick();
+   do
    {
-      uwBaudWaitT = 1;
-      while( CpCoreAutobaud(CP_CHANNEL_1, &ubBaudSelT, &uwBaudWaitT));
+      ubBaudStatusT = CpCoreAutobaud(CP_CHANNEL_1, &ubBaudSelT, &uwBaudWaitT);
+
+      //---------------------------------------------------
+      // no bitrate found in time: end the detection and
+      // start with the cached bitrate or with the default
+      //
+      if( (ubBaudStatusT != CpErr_OK) &&
+          ((McTmrTick() - ulBaudStartT) >=
+           (uint32_t) (AUTOBAUD_TIMEOUT / COS_TIMER_PERIOD)) )
+      {
+         uwBaudWaitT = 0;
+         CpCoreAutobaud(CP_CHANNEL_1, &ubBaudSelT, &uwBaudWaitT);
+         if(ubBaudNvmT < CP_BAUD_AUTO) ubBaudSelT = ubBaudNvmT;
+         else                          ubBaudSelT = CP_BAUD_250K;
+         break;
+      }
    }
+   while(ubBaudStatusT != CpErr_OK);
+
+   //---------------------------------------------------
+   // cache the detected bitrate, the following boots
+   // try it first (the NVM is written only on a change)
+   //
+   if((ubBaudStatusT == CpErr_OK) && (ubBaudSelT != ubBaudNvmT))
+   {
+      McNvmWriteEnable();
+      McNvmWrite(eNVM_305_BAUDRATE_U08, &ubBaudSelT, 1);
+      uwChecksumT = McNvmBuildChecksum(eNVM_CHECKSUM_START, eNVM_CHECKSUM_END);
+      McNvmWrite(eNVM_CHECKSUM_U16, &uwChecksumT, 2);
+      McNvmWriteDisable();
+   }
+   #endif
 
 
    //----------------------------------------------------------------
@@ -271,6 +336,9 @@ void main(void)
       if (ubTimerTriggerG)
       {
           CosTmrEvent();
+          #if COS_PDO_SCHED > 0
+          CosPschTmrEvent();
+          #endif
           AppEvent();
     	  ubTimerTriggerG = 0;
     	  // CpCoreBufferSend(0,1);
@@ -289,14 +289,14 @@ uint8_t CosMgrGetBaudrate(void)
    uint8_t  ubBaudT;             // value for baudrate switch
    uint8_t	ubBitrateT;
 
-	 uint8_t	aubI2C_DataT[4];
+//	 uint8_t	aubI2C_DataT[4];
 	
    //----------------------------------------------------------------
    // Example:
    // Read value of DIP-/HEX-switch here
    //
-	 aubI2C_DataT[0] = 0xFF;
-	 aubI2C_DataT[1] = 0xFF;
+//	 aubI2C_DataT[0] = 0xFF;
+//	 aubI2C_DataT[1] = 0xFF;
 
 //   McI2C_DataRead(eI2C_NET_1, 0x40, 0x00,
 //                         &aubI2C_DataT[0],
@@ -352,7 +352,7 @@ uint8_t CosMgrGetBaudrate(void)
 uint8_t CosMgrGetNodeAddress(void)
 {
    uint8_t  ubAddrT = 11;
-   uint8_t	aubI2C_DataT[4];
+//   uint8_t	aubI2C_DataT[4];
 	
    //----------------------------------------------------------------
    // Example:
@@ -372,7 +372,8 @@ uint8_t CosMgrGetNodeAddress(void)
 	 ubAddrT = 21;
    else
 	 ubAddrT = 20;
-	 return(ubAddrT);
+
+   return(ubAddrT);
 }
 
 
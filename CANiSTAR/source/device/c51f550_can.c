@@ -23,6 +23,10 @@
 #include "cp_msg.h"
 #include "c51f550_can.h"
 
+#if CP_AUTOBAUD > 0
+#include "mc_tmr.h"
+#endif
+
 
 
 /*----------------------------------------------------------------------------*\
@@ -49,6 +53,44 @@
 #define  MSG_DIR_RCV    0x00
 #define  MSG_DIR_TRM    0x01
 
+//-------------------------------------------------------------------
+// Each side owns one message interface register set: the API
+// functions use IF1, the CAN interrupt handler uses IF2. A write
+// transfer is only started, the next user of the same IF waits for
+// its end. The interrupt handler never waits for a transfer of the
+// application and vice versa.
+//
+#define  CAN_IF_API     0x00
+#define  CAN_IF_IRQ     CAN_IF2_INDICATOR
+
+//-------------------------------------------------------------------
+// with a receive FIFO the CAN interrupt handler reads the data of the
+// message object as well, the identifier is read in any case
+//
+#if CP_FIFO_RCV_SIZE > 0
+#define  CAN_CMDMSK_IRQ_DATA  (CAN_CMDMSK_DATAA | CAN_CMDMSK_DATAB)
+#define  CAN_FIFO_MASK        (CP_FIFO_RCV_SIZE - 1)
+#else
+#define  CAN_CMDMSK_IRQ_DATA  0
+#endif
+
+#if CP_AUTOBAUD > 0
+//-------------------------------------------------------------------
+// CpCoreAutobaud() accepts a bitrate after this number of frames
+// received without error
+//
+#define  CAN_AUTOBAUD_FRAMES  2
+#endif
+
+#if CP_FIFO_RCV_SIZE > 0
+#if (CP_FIFO_RCV_SIZE > 128) || ((CP_FIFO_RCV_SIZE & CAN_FIFO_MASK) != 0)
+#error Value for symbol CP_FIFO_RCV_SIZE must be a power of 2 (max. 128)
+#endif
+#if CP_CAN_MSG_USER == 0
+#error The receive FIFO requires CP_CAN_MSG_USER = 1
+#endif
+#endif
+
 /*----------------------------------------------------------------------------*\
 ** Variables of module                                                        **
 **                                                                            **
@@ -59,6 +101,10 @@ static CpCanMsg_ts      tsCanMsgS;        // global buffer for CAN message (IRQ)
 
 #if CP_AUTOBAUD > 0
 static uint8_t          ubAutobaudSelectS;
+static uint8_t          ubAutobaudListenS;   // 1 = bitrate is tested
+static uint8_t          ubAutobaudFramesS;   // frames received without error
+static uint16_t         uwAutobaudRecS;      // receive error counter at start
+static uint32_t         ulAutobaudStartS;    // timer tick at start of listening
 #endif
 
 #if CP_STATISTIC > 0
@@ -69,8 +115,6 @@ static uint32_t         ulErrCountS;
 
 static uint16_t         uwCanStatusOldS;
 
-static uint16_t         uwCanDebugS;
-
 //-------------------------------------------------------------------
 // this CAN implementation is a little weird concerning RTR, so we
 // keep the information about message direction at this place.
@@ -78,20 +122,53 @@ static uint16_t         uwCanDebugS;
 static uint8_t          aubMsgDirectionS[CP_BUFFER_MAX];
 
 
+#if CP_FIFO_RCV_SIZE > 0
+//-------------------------------------------------------------------
+// receive FIFO: the CAN interrupt handler is the only writer of the
+// head index, CpCoreMsgRead() is the only writer of the tail index.
+// Both indices are 8 bit values (atomic access), so no lock is
+// required. The buffer number of a message is kept in ulMsgUser.
+//
+static CpCanMsg_ts      atsCanFifoRcvS[CP_FIFO_RCV_SIZE];
+static volatile uint8_t ubCanFifoHeadS;
+static volatile uint8_t ubCanFifoTailS;
+static uint8_t          ubCanFifoOverrunS;   // mark next message
+
+//-------------------------------------------------------------------
+// copy of the message read last by CpCoreMsgRead(), it is returned
+// by CpCoreBufferGetData() / CpCoreBufferGetDlc() for this buffer
+// until the next call of CpCoreMsgRead() or until the buffer is
+// initialised or released
+//
+static CpCanMsg_ts      tsCanFifoMsgS;
+static uint8_t          ubCanFifoBufferS;    // 0 = no message
+
+#if CP_STATISTIC > 0
+static uint32_t         ulFifoOverrunCountS;
+static uint8_t          ubFifoLevelMaxS;
+#endif
+#endif
+
+
 //-------------------------------------------------------------------
 // these pointers store the callback handlers
 //
 uint8_t           (* pfnRcvIntHandler) (CpCanMsg_ts *, uint8_t);
 uint8_t           (* pfnTrmIntHandler) (CpCanMsg_ts *, uint8_t);
-uint8_t           (* pfnErrIntHandler) (uint8_t);
+uint8_t           (* pfnErrIntHandler) (CpState_ts *);
 
 
 //-------------------------------------------------------------------
 // declaration of internal functions
 //
-static uint8_t CAN_GetFreeIF(void);
 static void    CAN_WaitIF(uint8_t);
 
+static void    CAN_ReadMsgIF(uint16_t uwCanMsgArbV);
+
+#if CP_FIFO_RCV_SIZE > 0
+static void    CAN_FifoPush(uint8_t ubBufferIdxV);
+#endif
+
 uint16_t  uwCANDebugRegVG;
 
 /*------------------------------------------------------------------------
@@ -113,6 +190,26 @@ static uint16_t atsBitTimingTableS[] = {
    0x1801    //   1 MBit/s  : BRP =  1, SJW = 1, 12 Tq // angepasst auf 83.3%
 };
 
+#if CP_AUTOBAUD > 0
+/*------------------------------------------------------------------------
+** Order of the automatic bitrate detection
+**
+** The bitrates of the plant segments come first, the slow bitrates
+** come last since they need the longest time to receive a frame.
+*/
+static uint8_t aubAutobaudOrderS[] = {
+   CP_BAUD_125K,
+   CP_BAUD_250K,
+   CP_BAUD_500K,
+   CP_BAUD_1M,
+   CP_BAUD_800K,
+   CP_BAUD_100K,
+   CP_BAUD_50K,
+   CP_BAUD_20K,
+   CP_BAUD_10K
+};
+#endif
+
 /*----------------------------------------------------------------------------*\
 ** Function implementation                                                    **
 **                                                                            **
@@ -128,17 +225,128 @@ static uint16_t atsBitTimingTableS[] = {
 CpStatus_tv CpCoreAutobaud(CpPort_ts * ptsPortV, uint8_t * pubBaudSelV, 
                            uint16_t * puwWaitV)
 {
+   #if CP_AUTOBAUD > 0
+   uint16_t uwStatusT;           // CAN status register
+   uint8_t  ubResultT;
+   #endif
+
    //----------------------------------------------------------------
    // check if automatic baudrate detection is enabled
    //
-	#if CP_AUTOBAUD == 0
+   #if CP_AUTOBAUD == 0
    return(CpErr_NOT_SUPPORTED);
    #else
 
    //----------------------------------------------------------------
-   // ToDo: Implement here AutoBaudrate detection 
+   // a listen time of 0 ends a running detection, e.g. when the
+   // application gives up on a quiet bus
    //
+   if(*puwWaitV == 0)
+   {
+      if(ubAutobaudListenS)
+      {
+         ubAutobaudListenS = 0;
+         SFRPAGE = CAN0_PAGE;
+         CAN0CN  = (CAN_CR_INIT | CAN_CR_CCE);
+      }
+      *pubBaudSelV = CP_BAUD_AUTO;
+      return(CpErr_BAUDRATE);
+   }
+
+   if(ubAutobaudListenS == 0)
+   {
+      //--------------------------------------------------------
+      // A valid bitrate in *pubBaudSelV is tried first, e.g. a
+      // value cached in non-volatile memory. With CP_BAUD_AUTO
+      // the next bitrate of the detection order is tried.
+      //
+      if(*pubBaudSelV >= CP_BAUD_AUTO)
+      {
+         *pubBaudSelV = aubAutobaudOrderS[ubAutobaudSelectS];
+         ubAutobaudSelectS++;
+         if(ubAutobaudSelectS >= sizeof(aubAutobaudOrderS))
+         {
+            ubAutobaudSelectS = 0;
+         }
+      }
 
+      //--------------------------------------------------------
+      // listen-only (silent mode) with the CAN interrupt
+      // disabled, the interrupt handler would clear the RxOk
+      // flag
+      //
+      SFRPAGE = CAN0_PAGE;
+      CAN0CN  = (CAN_CR_INIT | CAN_CR_CCE | CAN_CR_TEST);
+      CAN0TST = CAN_TST_SILENT;
+      CAN0BT  = atsBitTimingTableS[*pubBaudSelV];
+      CAN0STAT = CAN_STAT_LEC;      // LEC = 7: no bus event yet
+      uwAutobaudRecS = CAN0ERR & CAN_ERR_REC;
+      CAN0CN &= ~(CAN_CR_INIT | CAN_CR_CCE);
+
+      ubAutobaudFramesS = 0;
+      ulAutobaudStartS  = McTmrTick();
+      ubAutobaudListenS = 1;
+   }
+
+   //----------------------------------------------------------------
+   // One check of the bus per call, the bitrate is tested for
+   // *puwWaitV timer ticks. Any protocol error rejects the bitrate
+   // at once, so a wrong bitrate on a busy bus costs only a few bit
+   // times. The bitrate is accepted after a number of frames
+   // without error.
+   //
+   SFRPAGE   = CAN0_PAGE;
+   uwStatusT = CAN0STAT;
+   ubResultT = CpErr_BAUDRATE_WAIT;
+   if( ((uwStatusT & CAN_STAT_LEC) != 0)            &&
+       ((uwStatusT & CAN_STAT_LEC) != CAN_STAT_LEC)    )
+   {
+      ubResultT = CpErr_BAUDRATE;
+   }
+   else if((CAN0ERR & CAN_ERR_REC) > uwAutobaudRecS)
+   {
+      ubResultT = CpErr_BAUDRATE;
+   }
+   else
+   {
+      if(uwStatusT & CAN_STAT_RXOK)
+      {
+         CAN0STAT = CAN_STAT_LEC;   // clear RxOk, LEC = 7
+         ubAutobaudFramesS++;
+         if(ubAutobaudFramesS >= CAN_AUTOBAUD_FRAMES)
+         {
+            ubResultT = CpErr_OK;
+         }
+      }
+
+      if( (ubResultT != CpErr_OK) &&
+          ((McTmrTick() - ulAutobaudStartS) >= (uint32_t) *puwWaitV) )
+      {
+         ubResultT = CpErr_BAUDRATE;
+      }
+   }
+
+   if(ubResultT == CpErr_BAUDRATE_WAIT)
+   {
+      return(CpErr_BAUDRATE_WAIT);
+   }
+
+   //----------------------------------------------------------------
+   // back to initialisation mode, leaving the test mode clears the
+   // silent mode
+   //
+   ubAutobaudListenS = 0;
+   CAN0CN = (CAN_CR_INIT | CAN_CR_CCE);
+
+   if(ubResultT == CpErr_OK)
+   {
+      return(CpErr_OK);
+   }
+
+   //----------------------------------------------------------------
+   // next bitrate for the following call
+   //
+   *pubBaudSelV = CP_BAUD_AUTO;
    return(CpErr_BAUDRATE);
    #endif
 
@@ -182,6 +390,69 @@ CpStatus_tv CpCoreBaudrate(CpPort_ts * ptsPortV, uint8_t ubBaudSelV)
 }
 
 
+//----------------------------------------------------------------------------//
+// CpCoreBufferAccMask()                                                      //
+// set acceptance mask of a message buffer                                    //
+//----------------------------------------------------------------------------//
+CpStatus_tv CpCoreBufferAccMask( CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
+                                 uint32_t ulAccMaskV)
+{
+   //----------------------------------------------------------------
+   // check for valid buffer number
+   //
+   if(ubBufferIdxV < CP_BUFFER_1  ) return(CpErr_BUFFER);
+   if(ubBufferIdxV > CP_BUFFER_MAX) return(CpErr_BUFFER);
+
+   CAN_IRQ_DISABLE();
+   SFRPAGE = CAN0_PAGE;
+   CAN_WaitIF(CAN_IF_API);
+
+   //----------------------------------------------------------------
+   // read the arbitration register to get the frame format, the
+   // use of the mask (UMASK) is already enabled by
+   // CpCoreBufferInit()
+   //
+   CAN0IF1CM = CAN_CMDMSK_ARB;
+   CAN0IF1CR = ubBufferIdxV;
+   CAN_WaitIF(CAN_IF_API);
+
+   //----------------------------------------------------------------
+   // a mask bit set to 1 is used for acceptance filtering
+   //
+   if(CAN0IF1A2 & CAN_ARB2_XTD)
+   {
+      CAN0IF1M1 = (uint16_t) (ulAccMaskV);
+      CAN0IF1M2 = ((uint16_t) (ulAccMaskV >> 16) & 0x1FFF) | CAN_MSK2_MXTD;
+   }
+   else
+   {
+      CAN0IF1M1 = 0x0000;
+      CAN0IF1M2 = ((uint16_t) ulAccMaskV & 0x07FF) << 2;
+   }
+
+   //----------------------------------------------------------------
+   // only the mask registers are written to the message buffer
+   //
+   CAN0IF1CM = (CAN_CMDMSK_WRRD | CAN_CMDMSK_MASK);
+   CAN0IF1CR = ubBufferIdxV;
+
+   CAN_IRQ_ENABLE();
+
+   return (CpErr_OK);
+}
+
+
+//----------------------------------------------------------------------------//
+// CpCoreBufferCommit()                                                       //
+// the data registers are SFRs, there is no reserved data to transfer         //
+//----------------------------------------------------------------------------//
+CpStatus_tv CpCoreBufferCommit(  CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
+                                 uint8_t ubSendV)
+{
+   return (CpErr_NOT_SUPPORTED);
+}
+
+
 //----------------------------------------------------------------------------//
 // CpCoreBufferGetData()                                                      //
 //                                                                            //
@@ -189,8 +460,9 @@ CpStatus_tv CpCoreBaudrate(CpPort_ts * ptsPortV, uint8_t ubBaudSelV)
 CpStatus_tv CpCoreBufferGetData( CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
                                  uint8_t * pubDataV)
 {
-   uint8_t  ubMsgIfRegT;   // message interface register set
-
+   #if CP_FIFO_RCV_SIZE > 0
+   uint8_t  ubCntT;
+   #endif
 
    //----------------------------------------------------------------
    // check for valid buffer number
@@ -199,6 +471,22 @@ CpStatus_tv CpCoreBufferGetData( CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
    if(ubBufferIdxV > CP_BUFFER_MAX) return(CpErr_BUFFER);
 
 
+   //----------------------------------------------------------------
+   // the message of this buffer was taken from the receive FIFO
+   //
+   #if CP_FIFO_RCV_SIZE > 0
+   if(ubBufferIdxV == ubCanFifoBufferS)
+   {
+      for(ubCntT = 0; ubCntT < 8; ubCntT++)
+      {
+         *pubDataV = CpMsgGetData(&tsCanFifoMsgS, ubCntT);
+         pubDataV++;
+      }
+      return (CpErr_OK);
+   }
+   #endif
+
+
    //----------------------------------------------------------------
    // disable global CAN interrupt to avoid conflict between
    // application and CAN IRQ handler
@@ -211,94 +499,51 @@ CpStatus_tv CpCoreBufferGetData( CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
    SFRPAGE = CAN0_PAGE;
    
    //----------------------------------------------------------------
-   // get a free message interface register
+   // IF1 is reserved for the API functions, wait until its
+   // previous transfer is finished
    //
-   while( (ubMsgIfRegT = CAN_GetFreeIF() ) > CAN_IF2_INDICATOR) { };
-
-   if (ubMsgIfRegT)  // registerSet2
-   {
-	   //----------------------------------------------------------------
-	   // read access to data register A and B
-	   //
-
-	   // Point to IFn Command Mask Register
-	   CAN0IF2CM = (CAN_CMDMSK_DATAA | CAN_CMDMSK_DATAB);
+   CAN_WaitIF(CAN_IF_API);
 
-	   // Point to IFn Command Request Register
-	   CAN0IF2CR = ubBufferIdxV;
-
-	   // wait until the Busy Flag  of IFn is cleared
-	   while((CAN0IF2CR & CAN_CMDRQST_BUSY) > 0) { };
-
-	   //----------------------------------------------------------------
-	   // read data from selected buffer
-	   //
-	   *pubDataV = CAN0IF2DA1L;
-	   pubDataV++;
-
-	   *pubDataV = CAN0IF2DA1H;
-	   pubDataV++;
-
-	   *pubDataV = CAN0IF2DA2L;
-	   pubDataV++;
-
-	   *pubDataV = CAN0IF2DA2H;
-	   pubDataV++;
-
-	   *pubDataV = CAN0IF2DB1L;
-	   pubDataV++;
-
-	   *pubDataV = CAN0IF2DB1H;
-	   pubDataV++;
+   //----------------------------------------------------------------
+   // read access to data register A and B
+   //
 
-	   *pubDataV = CAN0IF2DB2L;
-	   pubDataV++;
+   // Point to IFn Command Mask Register
+   CAN0IF1CM = (CAN_CMDMSK_DATAA | CAN_CMDMSK_DATAB);
 
-	   *pubDataV = CAN0IF2DB2H;
-	   pubDataV++;
-   }
-   else // registerSet1
-   {
-	   //----------------------------------------------------------------
-	   // read access to data register A and B
-	   //
+   // Point to IFn Command Request Register
+   CAN0IF1CR = ubBufferIdxV;
 
-	   // Point to IFn Command Mask Register
-	   CAN0IF1CM = (CAN_CMDMSK_DATAA | CAN_CMDMSK_DATAB);
+   // wait until the Busy Flag  of IFn is cleared
+   while((CAN0IF1CR & CAN_CMDRQST_BUSY) > 0) { };
 
-	   // Point to IFn Command Request Register
-	   CAN0IF1CR = ubBufferIdxV;
-
-	   // wait until the Busy Flag  of IFn is cleared
-	   while((CAN0IF1CR & CAN_CMDRQST_BUSY) > 0) { };
+   //----------------------------------------------------------------
+   // read data from selected buffer
+   //
+   *pubDataV = CAN0IF1DA1L;
+   pubDataV++;
 
-	   //----------------------------------------------------------------
-	   // read data from selected buffer
-	   //
-	   *pubDataV = CAN0IF1DA1L;
-	   pubDataV++;
+   *pubDataV = CAN0IF1DA1H;
+   pubDataV++;
 
-	   *pubDataV = CAN0IF1DA1H;
-	   pubDataV++;
+   *pubDataV = CAN0IF1DA2L;
+   pubDataV++;
 
-	   *pubDataV = CAN0IF1DA2L;
-	   pubDataV++;
+   *pubDataV = CAN0IF1DA2H;
+   pubDataV++;
 
-	   *pubDataV = CAN0IF1DA2H;
-	   pubDataV++;
+   *pubDataV = CAN0IF1DB1L;
+   pubDataV++;
 
-	   *pubDataV = CAN0IF1DB1L;
-	   pubDataV++;
+   *pubDataV = CAN0IF1DB1H;
+   pubDataV++;
 
-	   *pubDataV = CAN0IF1DB1H;
-	   pubDataV++;
+   *pubDataV = CAN0IF1DB2L;
+   pubDataV++;
 
-	   *pubDataV = CAN0IF1DB2L;
-	   pubDataV++;
+   *pubDataV = CAN0IF1DB2H;
+   pubDataV++;
 
-	   *pubDataV = CAN0IF1DB2H;
-	   pubDataV++;
-   }
 
    //----------------------------------------------------------------
    // enable global CAN interrupt
@@ -317,7 +562,6 @@ CpStatus_tv CpCoreBufferGetData( CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
 CpStatus_tv CpCoreBufferGetDlc(  CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
                                  uint8_t * pubDlcV)
 {
-   uint8_t  ubMsgIfRegT;   // message interface register set
    uint16_t  uwDlcT;        // DLC value
 
 
@@ -328,6 +572,18 @@ CpStatus_tv CpCoreBufferGetDlc(  CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
    if(ubBufferIdxV > CP_BUFFER_MAX) return(CpErr_BUFFER);
 
 
+   //----------------------------------------------------------------
+   // the message of this buffer was taken from the receive FIFO
+   //
+   #if CP_FIFO_RCV_SIZE > 0
+   if(ubBufferIdxV == ubCanFifoBufferS)
+   {
+      *pubDlcV = CpMsgGetDlc(&tsCanFifoMsgS);
+      return (CpErr_OK);
+   }
+   #endif
+
+
    //----------------------------------------------------------------
    // disable global CAN interrupt to avoid conflict between
    // application and CAN IRQ handler
@@ -340,45 +596,26 @@ CpStatus_tv CpCoreBufferGetDlc(  CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
    SFRPAGE = CAN0_PAGE;
    
    //----------------------------------------------------------------
-   // get a free message interface register
+   // IF1 is reserved for the API functions, wait until its
+   // previous transfer is finished
    //
-   while( (ubMsgIfRegT = CAN_GetFreeIF() ) > CAN_IF2_INDICATOR) { };
-   
-   if (ubMsgIfRegT) // IF2
-   {
-	   //----------------------------------------------------------------
-	   // read access to message control register
-	   //
-	   // Point to IFn Command Mask Register
-	   CAN0IF2CM= CAN_CMDMSK_CONTROL;
+   CAN_WaitIF(CAN_IF_API);
 
-	   // Point to IFn Command Request Register
-	   CAN0IF2CR = ubBufferIdxV;
-
-	   // wait until the Busy Flag is cleared
-	   while((CAN0IF2CR & CAN_CMDRQST_BUSY) > 0) { };
-
-	   // get DLC
-	   uwDlcT = CAN0IF2MC;
+   //----------------------------------------------------------------
+   // read access to message control register
+   //
+   // Point to IFn Command Mask Register
+   CAN0IF1CM= CAN_CMDMSK_CONTROL;
 
-   }
-   else	// IF2
-   {
-	   //----------------------------------------------------------------
-	   // read access to message control register
-	   //
-	   // Point to IFn Command Mask Register
-	   CAN0IF1CM= CAN_CMDMSK_CONTROL;
+   // Point to IFn Command Request Register
+   CAN0IF1CR = ubBufferIdxV;
 
-	   // Point to IFn Command Request Register
-	   CAN0IF1CR = ubBufferIdxV;
+   // wait until the Busy Flag is cleared
+   while((CAN0IF1CR & CAN_CMDRQST_BUSY) > 0) { };
 
-	   // wait until the Busy Flag is cleared
-	   while((CAN0IF1CR & CAN_CMDRQST_BUSY) > 0) { };
+   // get DLC
+   uwDlcT = CAN0IF1MC;
 
-	   // get DLC
-	   uwDlcT = CAN0IF1MC;
-   }
    
    //----------------------------------------------------------------
    // enable global CAN interrupt
@@ -402,263 +639,155 @@ CpStatus_tv CpCoreBufferGetDlc(  CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
 CpStatus_tv CpCoreBufferInit( CpPort_ts * ptsPortV, CpCanMsg_ts * ptsCanMsgV,
                               uint8_t ubBufferIdxV, uint8_t ubDirectionV)
 {
-   uint8_t ubMsgIfRegT;    // message interface register set
-
-
    //----------------------------------------------------------------
    // check for valid buffer number
    //
    if(ubBufferIdxV < CP_BUFFER_1  ) return(CpErr_BUFFER);
    if(ubBufferIdxV > CP_BUFFER_MAX) return(CpErr_BUFFER);
 
+   //----------------------------------------------------------------
+   // a message of this buffer read from the receive FIFO is no
+   // longer valid
+   //
+   #if CP_FIFO_RCV_SIZE > 0
+   if(ubBufferIdxV == ubCanFifoBufferS) ubCanFifoBufferS = 0;
+   #endif
+
+   //----------------------------------------------------------------
+   // disable global CAN interrupt, a callback of the CAN IRQ
+   // handler may use IF1 as well
+   //
+   CAN_IRQ_DISABLE();
+
    //----------------------------------------------------------------
    // config SFRPAGE to access CAN0 registers
    //
    SFRPAGE = CAN0_PAGE;
    
    //----------------------------------------------------------------
-   // get a free message interface register
-   //
-   while( (ubMsgIfRegT = CAN_GetFreeIF() ) > CAN_IF2_INDICATOR) { };
-
-   if (ubMsgIfRegT)
-   {     // Interface 2
-	   //----------------------------------------------------------------
-	   // write to the command mask register, access to all register
-	   //
-	   // Point to IFn Command Mask Register
-	   CAN0IF2CM = (CAN_CMDMSK_WRRD    |
-	                CAN_CMDMSK_MASK    |
-	                CAN_CMDMSK_ARB     |
-	                CAN_CMDMSK_CONTROL |
-	                CAN_CMDMSK_DATAA   |
-	                CAN_CMDMSK_DATAB);
-
-
-	   //----------------------------------------------------------------
-	   // setup the buffer for Transmit / Receive operation
-	   //
-	   if(ubDirectionV == CP_BUFFER_DIR_TX)
-	   {
-	      //-------------------------------------------------------//
-	      // direction is transmit                                 //
-	      //                                                       //
-	      //-------------------------------------------------------//
-
-	      //--------------------------------------------------------
-	      // set message direction to 'transmit'
-	      //
-	      aubMsgDirectionS[ubBufferIdxV - 1] = MSG_DIR_TRM;
-
-
-	      if( CpMsgIsExtended(ptsCanMsgV) )
-	      {
-	         // config Arbitration registers
-	         CAN0IF2CM  = (uint16_t) (CpMsgGetExtId(ptsCanMsgV));
-	         CAN0IF2A2  = ((uint16_t) (CpMsgGetExtId(ptsCanMsgV) >> 16) |
-	                     CAN_ARB2_XTD                             |
-	                     CAN_ARB2_DIR                             |
-	                     CAN_ARB2_MSGVAL);
-	      }
-	      else
-	      {
-	         // config Mask registers
-	         CAN0IF2M1  = 0x0000;
-	         CAN0IF2M2  = (0x07FF << 2);
-
-	         // config Arbitration registers
-	         CAN0IF2A1  = 0x0000;
-	         CAN0IF2A2  = ((CpMsgGetStdId(ptsCanMsgV) << 2) |
-	                     CAN_ARB2_DIR                     |
-	                     CAN_ARB2_MSGVAL);
-	      }
-
-	      // config Message Control register
-	      CAN0IF2MC  = (CpMsgGetDlc(ptsCanMsgV) |
-	                  CAN_MSGC_EOB            |
-	                  CAN_MSGC_TXIE           |
-	                  CAN_MSGC_UMASK          |
-	                  CAN_MSGC_RXIE);
-	   }
-	   else
-	   {
-	      //-------------------------------------------------------//
-	      // direction is receive                                  //
-	      //                                                       //
-	      //-------------------------------------------------------//
-
-	      //--------------------------------------------------------
-	      // set message direction to 'receive'
-	      //
-	      aubMsgDirectionS[ubBufferIdxV - 1] = MSG_DIR_RCV;
-
-	      if( CpMsgIsExtended(ptsCanMsgV) ) // Extended Identifier
-	      {
-	         // config Mask registers
-	         CAN0IF2M1  = 0xFFFF;
-	         CAN0IF2M2  = (0x01FF | CAN_MSK2_MXTD);
-
-	         // config Arbitration registers
-	         CAN0IF2A1  = (uint16_t) (CpMsgGetExtId(ptsCanMsgV));
-	         CAN0IF2A2  = ((uint16_t) (CpMsgGetExtId(ptsCanMsgV) >> 16) |
-	                     CAN_ARB2_XTD                             |
-	                     CAN_ARB2_MSGVAL);
-	      }
-	      else // Standard Identifier
-	      {
-	         // config Mask registers
-	         CAN0IF2A2  = 0x0000;
-	         CAN0IF2M2  = (0x07FF << 2);
-
-	         // config Arbitration registers
-	         CAN0IF2A1  = 0x0000;
-	         CAN0IF2A2  = ((CpMsgGetStdId(ptsCanMsgV) << 2) |
-	                     CAN_ARB2_MSGVAL);
-	      }
-
-	      // config Message Control register
-	      CAN0IF2MC  = (CAN_MSGC_EOB  |
-	                  CAN_MSGC_RXIE |
-	                  CAN_MSGC_UMASK);
-	   }
-
-
-	   //----------------------------------------------------------------
-	   // clear the data registers
-	   //
-	   CAN0IF2DA1  = 0x0000;
-	   CAN0IF2DA2  = 0x0000;
-	   CAN0IF2DB1  = 0x0000;
-	   CAN0IF2DB2  = 0x0000;
-
-	   //----------------------------------------------------------------
-	   // write data to selected buffer
-	   //
-	   CAN0IF2CR = ubBufferIdxV;            // Start command request
-
-	   while (CAN0IF2CRH & 0x80) {}        // Poll on Busy bit
+   // IF1 is reserved for the API functions, wait until its
+   // previous transfer is finished
+   //
+   CAN_WaitIF(CAN_IF_API);
+
+   //----------------------------------------------------------------
+   // write to the command mask register, access to all register
+   //
+   // Point to IFn Command Mask Register
+   CAN0IF1CM = (CAN_CMDMSK_WRRD    |
+                CAN_CMDMSK_MASK    |
+                CAN_CMDMSK_ARB     |
+                CAN_CMDMSK_CONTROL |
+                CAN_CMDMSK_DATAA   |
+                CAN_CMDMSK_DATAB);
+
+
+   //----------------------------------------------------------------
+   // setup the buffer for Transmit / Receive operation
+   //
+   if(ubDirectionV == CP_BUFFER_DIR_TX)
+   {
+      //-------------------------------------------------------//
+      // direction is transmit                                 //
+      //                                                       //
+      //-------------------------------------------------------//
 
+      //--------------------------------------------------------
+      // set message direction to 'transmit'
+      //
+      aubMsgDirectionS[ubBufferIdxV - 1] = MSG_DIR_TRM;
+
+
+      if( CpMsgIsExtended(ptsCanMsgV) )
+      {
+         // config Arbitration registers
+         CAN0IF1A1  = (uint16_t) (CpMsgGetExtId(ptsCanMsgV));
+         CAN0IF1A2  = ((uint16_t) (CpMsgGetExtId(ptsCanMsgV) >> 16) |
+                     CAN_ARB2_XTD                             |
+                     CAN_ARB2_DIR                             |
+                     CAN_ARB2_MSGVAL);
+      }
+      else
+      {
+         // config Mask registers
+         CAN0IF1M1  = 0x0000;
+         CAN0IF1M2  = (0x07FF << 2);
+
+         // config Arbitration registers
+         CAN0IF1A1  = 0x0000;
+         CAN0IF1A2  = ((CpMsgGetStdId(ptsCanMsgV) << 2) |
+                     CAN_ARB2_DIR                     |
+                     CAN_ARB2_MSGVAL);
+      }
 
+      // config Message Control register
+      CAN0IF1MC  = (CpMsgGetDlc(ptsCanMsgV) |
+                  CAN_MSGC_EOB            |
+                  CAN_MSGC_TXIE           |
+                  CAN_MSGC_UMASK          |
+                  CAN_MSGC_RXIE);
    }
-   else  // Interface 1
+   else
    {
-	   //----------------------------------------------------------------
-	   // write to the command mask register, access to all register
-	   //
-	   // Point to IFn Command Mask Register
-	   CAN0IF1CM = (CAN_CMDMSK_WRRD    |
-	                CAN_CMDMSK_MASK    |
-	                CAN_CMDMSK_ARB     |
-	                CAN_CMDMSK_CONTROL |
-	                CAN_CMDMSK_DATAA   |
-	                CAN_CMDMSK_DATAB);
-
-
-	   //----------------------------------------------------------------
-	   // setup the buffer for Transmit / Receive operation
-	   //
-	   if(ubDirectionV == CP_BUFFER_DIR_TX)
-	   {
-	      //-------------------------------------------------------//
-	      // direction is transmit                                 //
-	      //                                                       //
-	      //-------------------------------------------------------//
-
-	      //--------------------------------------------------------
-	      // set message direction to 'transmit'
-	      //
-	      aubMsgDirectionS[ubBufferIdxV - 1] = MSG_DIR_TRM;
-
-
-	      if( CpMsgIsExtended(ptsCanMsgV) )
-	      {
-	         // config Arbitration registers
-	         CAN0IF1CM  = (uint16_t) (CpMsgGetExtId(ptsCanMsgV));
-	         CAN0IF1A2  = ((uint16_t) (CpMsgGetExtId(ptsCanMsgV) >> 16) |
-	                     CAN_ARB2_XTD                             |
-	                     CAN_ARB2_DIR                             |
-	                     CAN_ARB2_MSGVAL);
-	      }
-	      else
-	      {
-	         // config Mask registers
-	         CAN0IF1M1  = 0x0000;
-	         CAN0IF1M2  = (0x07FF << 2);
-
-	         // config Arbitration registers
-	         CAN0IF1A1  = 0x0000;
-	         CAN0IF1A2  = ((CpMsgGetStdId(ptsCanMsgV) << 2) |
-	                     CAN_ARB2_DIR                     |
-	                     CAN_ARB2_MSGVAL);
-	      }
-
-	      // config Message Control register
-	      CAN0IF1MC  = (CpMsgGetDlc(ptsCanMsgV) |
-	                  CAN_MSGC_EOB            |
-	                  CAN_MSGC_TXIE           |
-	                  CAN_MSGC_UMASK          |
-	                  CAN_MSGC_RXIE);
-	   }
-	   else
-	   {
-	      //-------------------------------------------------------//
-	      // direction is receive                                  //
-	      //                                                       //
-	      //-------------------------------------------------------//
-
-	      //--------------------------------------------------------
-	      // set message direction to 'receive'
-	      //
-	      aubMsgDirectionS[ubBufferIdxV - 1] = MSG_DIR_RCV;
-
-	      if( CpMsgIsExtended(ptsCanMsgV) ) // Extended Identifier
-	      {
-	         // config Mask registers
-	         CAN0IF1M1  = 0xFFFF;
-	         CAN0IF1M2  = (0x01FF | CAN_MSK2_MXTD);
-
-	         // config Arbitration registers
-	         CAN0IF1A1  = (uint16_t) (CpMsgGetExtId(ptsCanMsgV));
-	         CAN0IF1A2  = ((uint16_t) (CpMsgGetExtId(ptsCanMsgV) >> 16) |
-	                     CAN_ARB2_XTD                             |
-	                     CAN_ARB2_MSGVAL);
-	      }
-	      else // Standard Identifier
-	      {
-	         // config Mask registers
-	         CAN0IF1A2  = 0x0000;
-	         CAN0IF1M2  = (0x07FF << 2);
-
-	         // config Arbitration registers
-	         CAN0IF1A1  = 0x0000;
-	         CAN0IF1A2  = ((CpMsgGetStdId(ptsCanMsgV) << 2) |
-	                     CAN_ARB2_MSGVAL);
-	      }
-
-	      // config Message Control register
-	      CAN0IF1MC  = (CAN_MSGC_EOB  |
-	                  CAN_MSGC_RXIE |
-	                  CAN_MSGC_UMASK);
-	   }
-
-
-	   //----------------------------------------------------------------
-	   // clear the data registers
-	   //
-	   CAN0IF1DA1  = 0x0000;
-	   CAN0IF1DA2  = 0x0000;
-	   CAN0IF1DB1  = 0x0000;
-	   CAN0IF1DB2  = 0x0000;
-
-	   //----------------------------------------------------------------
-	   // write data to selected buffer
-	   //
-	   CAN0IF1CR = ubBufferIdxV;            // Start command request
-
-	   while (CAN0IF1CRH & 0x80) {}        // Poll on Busy bit
+      //-------------------------------------------------------//
+      // direction is receive                                  //
+      //                                                       //
+      //-------------------------------------------------------//
+
+      //--------------------------------------------------------
+      // set message direction to 'receive'
+      //
+      aubMsgDirectionS[ubBufferIdxV - 1] = MSG_DIR_RCV;
 
+      if( CpMsgIsExtended(ptsCanMsgV) ) // Extended Identifier
+      {
+         // config Mask registers
+         CAN0IF1M1  = 0xFFFF;
+         CAN0IF1M2  = (0x01FF | CAN_MSK2_MXTD);
+
+         // config Arbitration registers
+         CAN0IF1A1  = (uint16_t) (CpMsgGetExtId(ptsCanMsgV));
+         CAN0IF1A2  = ((uint16_t) (CpMsgGetExtId(ptsCanMsgV) >> 16) |
+                     CAN_ARB2_XTD                             |
+                     CAN_ARB2_MSGVAL);
+      }
+      else // Standard Identifier
+      {
+         // config Mask registers
+         CAN0IF1M1  = 0x0000;
+         CAN0IF1M2  = (0x07FF << 2);
+
+         // config Arbitration registers
+         CAN0IF1A1  = 0x0000;
+         CAN0IF1A2  = ((CpMsgGetStdId(ptsCanMsgV) << 2) |
+                     CAN_ARB2_MSGVAL);
+      }
+
+      // config Message Control register
+      CAN0IF1MC  = (CAN_MSGC_EOB  |
+                  CAN_MSGC_RXIE |
+                  CAN_MSGC_UMASK);
    }
 
+
+   //----------------------------------------------------------------
+   // clear the data registers
+   //
+   CAN0IF1DA1  = 0x0000;
+   CAN0IF1DA2  = 0x0000;
+   CAN0IF1DB1  = 0x0000;
+   CAN0IF1DB2  = 0x0000;
+
+   //----------------------------------------------------------------
+   // write data to selected buffer
+   //
+   CAN0IF1CR = ubBufferIdxV;            // Start command request
+
+   //----------------------------------------------------------------
+   // enable global CAN interrupt
+   //
+   CAN_IRQ_ENABLE();
+
    return (CpErr_OK);
 }
 
@@ -669,15 +798,26 @@ CpStatus_tv CpCoreBufferInit( CpPort_ts * ptsPortV, CpCanMsg_ts * ptsCanMsgV,
 //----------------------------------------------------------------------------//
 CpStatus_tv CpCoreBufferRelease( CpPort_ts * ptsPortV, uint8_t ubBufferIdxV)
 {
-   uint8_t ubMsgIfRegT;    // message interface register set
-
-
    //----------------------------------------------------------------
    // check for valid buffer number
    //
    if(ubBufferIdxV < CP_BUFFER_1  ) return(CpErr_BUFFER);
    if(ubBufferIdxV > CP_BUFFER_MAX) return(CpErr_BUFFER);
 
+   //----------------------------------------------------------------
+   // a message of this buffer read from the receive FIFO is no
+   // longer valid
+   //
+   #if CP_FIFO_RCV_SIZE > 0
+   if(ubBufferIdxV == ubCanFifoBufferS) ubCanFifoBufferS = 0;
+   #endif
+
+   //----------------------------------------------------------------
+   // disable global CAN interrupt, a callback of the CAN IRQ
+   // handler may use IF1 as well
+   //
+   CAN_IRQ_DISABLE();
+
    //----------------------------------------------------------------
    // config SFRPAGE to access CAN0 registers
    //
@@ -685,59 +825,52 @@ CpStatus_tv CpCoreBufferRelease( CpPort_ts * ptsPortV, uint8_t ubBufferIdxV)
    
    
    //----------------------------------------------------------------
-   // get a free message interface register
+   // IF1 is reserved for the API functions, wait until its
+   // previous transfer is finished
    //
-   while( (ubMsgIfRegT = CAN_GetFreeIF() ) > CAN_IF2_INDICATOR) { };
-   
-   if (ubMsgIfRegT)
-   {	// IF2
-
-	   //----------------------------------------------------------------
-	   // write to the command mask register, access to control register
-	   //
-	   CAN0IF2CM =  CAN_CMDMSK_WRRD | CAN_CMDMSK_CONTROL;
+   CAN_WaitIF(CAN_IF_API);
 
-
-	   //----------------------------------------------------------------
-	   // disable message object
-	   //
-	   // clear message controle register
-	   CAN0IF2MC = 0x0000;
-
-	   CAN0IF2CR = ubBufferIdxV;
-	   while((CAN0IF2CR & CAN_CMDRQST_BUSY) > 0) { };
-
-   }
-   else
-   {	// IF1
-
-	   //----------------------------------------------------------------
-	   // write to the command mask register, access to control register
-	   //
-	   CAN0IF1CM =  CAN_CMDMSK_WRRD | CAN_CMDMSK_CONTROL;
+   //----------------------------------------------------------------
+   // write to the command mask register, access to control register
+   //
+   CAN0IF1CM =  CAN_CMDMSK_WRRD | CAN_CMDMSK_CONTROL;
 
 
-	   //----------------------------------------------------------------
-	   // disable message object
-	   //
-	   // clear message controle register
-	   CAN0IF1MC = 0x0000;
+   //----------------------------------------------------------------
+   // disable message object
+   //
+   // clear message controle register
+   CAN0IF1MC = 0x0000;
 
-	   CAN0IF1CR = ubBufferIdxV;
-	   while((CAN0IF1CR & CAN_CMDRQST_BUSY) > 0) { };
+   CAN0IF1CR = ubBufferIdxV;
 
-   }
    
    //----------------------------------------------------------------
    // set message direction to read (default)
    //
    aubMsgDirectionS[ubBufferIdxV - 1] = MSG_DIR_RCV;
 
+   //----------------------------------------------------------------
+   // enable global CAN interrupt
+   //
+   CAN_IRQ_ENABLE();
+
 
    return (CpErr_OK);
 }
 
 
+//----------------------------------------------------------------------------//
+// CpCoreBufferReserve()                                                      //
+// the data registers are SFRs and can't be accessed via a pointer            //
+//----------------------------------------------------------------------------//
+CpStatus_tv CpCoreBufferReserve( CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
+                                 uint8_t ** ppubDataV)
+{
+   return (CpErr_NOT_SUPPORTED);
+}
+
+
 //----------------------------------------------------------------------------//
 // CpCoreBufferSetData()                                                      //
 //                                                                            //
@@ -745,9 +878,6 @@ CpStatus_tv CpCoreBufferRelease( CpPort_ts * ptsPortV, uint8_t ubBufferIdxV)
 CpStatus_tv CpCoreBufferSetData( CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
                                  uint8_t * pubDataV)
 {
-   uint8_t    ubMsgIfRegT;   // message interface register set
-
-
    //----------------------------------------------------------------
    // check for valid buffer number
    //
@@ -768,98 +898,51 @@ CpStatus_tv CpCoreBufferSetData( CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
    
    
    //----------------------------------------------------------------
-   // get a free message interface register
+   // IF1 is reserved for the API functions, wait until its
+   // previous transfer is finished
    //
-   while( (ubMsgIfRegT = CAN_GetFreeIF() ) > CAN_IF2_INDICATOR) { };
-
-   if (ubMsgIfRegT)
-   {	// IF2
-
-	   //----------------------------------------------------------------
-	   // write access to data register A and B
-	   //
-	   CAN0IF2CM= (CAN_CMDMSK_WRRD  |
-	              CAN_CMDMSK_DATAA |
-	              CAN_CMDMSK_DATAB);
-
-
-	   //----------------------------------------------------------------
-	   // write data to selected buffer
-	   //
-	   CAN0IF2DA1L = (*pubDataV);
-	   pubDataV++;
-
-	   CAN0IF2DA1H = (*pubDataV);
-	   pubDataV++;
-
-	   CAN0IF2DA2L = (*pubDataV);
-	   pubDataV++;
-
-	   CAN0IF2DA2H = (*pubDataV);
-	   pubDataV++;
-
-	   CAN0IF2DB1L = (*pubDataV);
-	   pubDataV++;
-
-	   CAN0IF2DB1H = (*pubDataV);
-	   pubDataV++;
-
-	   CAN0IF2DB2L= (*pubDataV);
-	   pubDataV++;
-
-	   CAN0IF2DB2H= (*pubDataV);
-
-
-	   //----------------------------------------------------------------
-	   // transfer data
-	   //
-	   CAN0IF2CRL = ubBufferIdxV;
-
-   }
-   else
-   {	// IF1
-	   //----------------------------------------------------------------
-	   // write access to data register A and B
-	   //
-	   CAN0IF1CM= (CAN_CMDMSK_WRRD  |
-	              CAN_CMDMSK_DATAA |
-	              CAN_CMDMSK_DATAB);
+   CAN_WaitIF(CAN_IF_API);
 
+   //----------------------------------------------------------------
+   // write access to data register A and B
+   //
+   CAN0IF1CM= (CAN_CMDMSK_WRRD  |
+              CAN_CMDMSK_DATAA |
+              CAN_CMDMSK_DATAB);
 
-	   //----------------------------------------------------------------
-	   // write data to selected buffer
-	   //
-	   CAN0IF1DA1L = (*pubDataV);
-	   pubDataV++;
 
-	   CAN0IF1DA1H = (*pubDataV);
-	   pubDataV++;
+   //----------------------------------------------------------------
+   // write data to selected buffer
+   //
+   CAN0IF1DA1L = (*pubDataV);
+   pubDataV++;
 
-	   CAN0IF1DA2L = (*pubDataV);
-	   pubDataV++;
+   CAN0IF1DA1H = (*pubDataV);
+   pubDataV++;
 
-	   CAN0IF1DA2H = (*pubDataV);
-	   pubDataV++;
+   CAN0IF1DA2L = (*pubDataV);
+   pubDataV++;
 
-	   CAN0IF1DB1L = (*pubDataV);
-	   pubDataV++;
+   CAN0IF1DA2H = (*pubDataV);
+   pubDataV++;
 
-	   CAN0IF1DB1H = (*pubDataV);
-	   pubDataV++;
+   CAN0IF1DB1L = (*pubDataV);
+   pubDataV++;
 
-	   CAN0IF1DB2L= (*pubDataV);
-	   pubDataV++;
+   CAN0IF1DB1H = (*pubDataV);
+   pubDataV++;
 
-	   CAN0IF1DB2H= (*pubDataV);
+   CAN0IF1DB2L= (*pubDataV);
+   pubDataV++;
 
+   CAN0IF1DB2H= (*pubDataV);
 
-	   //----------------------------------------------------------------
-	   // transfer data
-	   //
-	   CAN0IF1CRL = ubBufferIdxV;
 
+   //----------------------------------------------------------------
+   // transfer data
+   //
+   CAN0IF1CRL = ubBufferIdxV;
 
-   }
 
    //----------------------------------------------------------------
    // enable global CAN interrupt
@@ -876,9 +959,6 @@ CpStatus_tv CpCoreBufferSetData( CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
 //----------------------------------------------------------------------------//
 CpStatus_tv CpCoreBufferSend(CpPort_ts * ptsPortV, uint8_t ubBufferIdxV)
 {
-   uint8_t ubMsgIfRegT;       // message interface register set
-
-
    //----------------------------------------------------------------
    // check for valid buffer number
    //
@@ -898,40 +978,22 @@ CpStatus_tv CpCoreBufferSend(CpPort_ts * ptsPortV, uint8_t ubBufferIdxV)
    SFRPAGE = CAN0_PAGE;   
 
    //----------------------------------------------------------------
-   // get a free message interface register
+   // IF1 is reserved for the API functions, wait until its
+   // previous transfer is finished
    //
-   while( (ubMsgIfRegT = CAN_GetFreeIF() ) > CAN_IF2_INDICATOR) { };
+   CAN_WaitIF(CAN_IF_API);
 
-   if (ubMsgIfRegT)
-   {	// IF2
-	   //----------------------------------------------------------------
-	   // write to the command mask register, set TxRqst bit
-	   //
-	   CAN0IF2CML =  CAN_CMDMSK_WRRD | CAN_CMDMSK_TXRQST;
-
-
-	   //----------------------------------------------------------------
-	   // write data to selected buffer
-	   //
-	   CAN0IF2CR = ubBufferIdxV;
-	   while((CAN0IF2CR & CAN_CMDRQST_BUSY) > 0) { };
-
-   }
-   else
-   {    // IF1
+   //----------------------------------------------------------------
+   // write to the command mask register, set TxRqst bit
+   //
+   CAN0IF1CML =  CAN_CMDMSK_WRRD | CAN_CMDMSK_TXRQST;
 
-	   //----------------------------------------------------------------
-	   // write to the command mask register, set TxRqst bit
-	   //
-	   CAN0IF1CML =  CAN_CMDMSK_WRRD | CAN_CMDMSK_TXRQST;
 
+   //----------------------------------------------------------------
+   // write data to selected buffer
+   //
+   CAN0IF1CR = ubBufferIdxV;
 
-	   //----------------------------------------------------------------
-	   // write data to selected buffer
-	   //
-	   CAN0IF1CR = ubBufferIdxV;
-	   while((CAN0IF1CR & CAN_CMDRQST_BUSY) > 0) { };
-   }
 
 
    //----------------------------------------------------------------
@@ -951,7 +1013,6 @@ CpStatus_tv CpCoreBufferSend(CpPort_ts * ptsPortV, uint8_t ubBufferIdxV)
 CpStatus_tv CpCoreBufferSetDlc(  CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
                                  uint8_t ubDlcV)
 {
-   uint8_t ubMsgIfRegT;       // message interface register set
    uint16_t uwCanMsgCtrlT;     // message control register (MCR)
 
 
@@ -982,90 +1043,47 @@ CpStatus_tv CpCoreBufferSetDlc(  CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
 
 
    //----------------------------------------------------------------
-   // get a free message interface register
+   // IF1 is reserved for the API functions, wait until its
+   // previous transfer is finished
    //
-   while( (ubMsgIfRegT = CAN_GetFreeIF() ) > CAN_IF2_INDICATOR) { };
+   CAN_WaitIF(CAN_IF_API);
+
+   //----------------------------------------------------------------
+   // Modification of the DLC is performed via a Read-Modify-Write
+   // cycle, because the DLC is located inside the message control
+   // register (MCR).
+   //
+   // First, do a read access to message control register:
+   //
+   CAN0IF1CM = CAN_CMDMSK_CONTROL;
+   CAN0IF1CR = ubBufferIdxV;
+   // wait until busy flag is cleared
+   while((CAN0IF1CR & CAN_CMDRQST_BUSY) > 0) { };
+
+
+   //----------------------------------------------------------------
+   // Now read value from CAN_IFn_MCR register and modify it.
+   //
+   uwCanMsgCtrlT  = CAN0IF1MC;
+   uwCanMsgCtrlT &= 0xFF80;               // clear old DLC
+   uwCanMsgCtrlT |= (uint16_t)(ubDlcV);   // set new DLC
+
+   //----------------------------------------------------------------
+   // setup the command mask register
+   //
+   CAN0IF1CM = (CAN_CMDMSK_WRRD |
+               CAN_CMDMSK_CONTROL);
+
+   //----------------------------------------------------------------
+   // Finally write the new value into the CAN message memory.
+   //
+   CAN0IF1MC = uwCanMsgCtrlT;
+
+   //----------------------------------------------------------------
+   // write data to selected buffer
+   //
+   CAN0IF1CR = ubBufferIdxV;
 
-   if (ubMsgIfRegT)
-   {
-	   //----------------------------------------------------------------
-	   // Modification of the DLC is performed via a Read-Modify-Write
-	   // cycle, because the DLC is located inside the message control
-	   // register (MCR).
-	   //
-	   // First, do a read access to message control register:
-	   //
-	   CAN0IF2CM = CAN_CMDMSK_CONTROL;
-	   // wait until busy flag is cleared
-	   while((CAN0IF2CR & CAN_CMDRQST_BUSY) > 0) { };
-
-
-	   //----------------------------------------------------------------
-	   // Now read value from CAN_IFn_MCR register and modify it.
-	   //
-	   uwCanMsgCtrlT  = CAN0IF2MC;
-	   uwCanMsgCtrlT &= 0xFF80;               // clear old DLC
-	   uwCanMsgCtrlT |= (uint16_t)(ubDlcV);   // set new DLC
-
-	   //----------------------------------------------------------------
-	   // setup the command mask register
-	   //
-	   CAN0IF2CM = (CAN_CMDMSK_WRRD |
-	               CAN_CMDMSK_CONTROL);
-
-	   //----------------------------------------------------------------
-	   // Finally write the new value into the CAN message memory.
-	   //
-	   CAN0IF2MC = (uint8_t) uwCanMsgCtrlT;
-
-	   //----------------------------------------------------------------
-	   // write data to selected buffer
-	   //
-	   CAN0IF2CR = ubBufferIdxV;
-
-	   // wait until busy flag is cleared
-	   while((CAN0IF2CR & CAN_CMDRQST_BUSY) > 0) { };
-   }
-   else
-   {
-	   //----------------------------------------------------------------
-	   // Modification of the DLC is performed via a Read-Modify-Write
-	   // cycle, because the DLC is located inside the message control
-	   // register (MCR).
-	   //
-	   // First, do a read access to message control register:
-	   //
-	   CAN0IF1CM = CAN_CMDMSK_CONTROL;
-	   // wait until busy flag is cleared
-	   while((CAN0IF1CR & CAN_CMDRQST_BUSY) > 0) { };
-
-
-	   //----------------------------------------------------------------
-	   // Now read value from CAN_IFn_MCR register and modify it.
-	   //
-	   uwCanMsgCtrlT  = CAN0IF1MC;
-	   uwCanMsgCtrlT &= 0xFF80;               // clear old DLC
-	   uwCanMsgCtrlT |= (uint16_t)(ubDlcV);   // set new DLC
-
-	   //----------------------------------------------------------------
-	   // setup the command mask register
-	   //
-	   CAN0IF1CM = (CAN_CMDMSK_WRRD |
-	               CAN_CMDMSK_CONTROL);
-
-	   //----------------------------------------------------------------
-	   // Finally write the new value into the CAN message memory.
-	   //
-	   CAN0IF1MC = (uint8_t) uwCanMsgCtrlT;
-
-	   //----------------------------------------------------------------
-	   // write data to selected buffer
-	   //
-	   CAN0IF1CR = ubBufferIdxV;
-
-	   // wait until busy flag is cleared
-	   while((CAN0IF1CR & CAN_CMDRQST_BUSY) > 0) { };
-   }
    
    //----------------------------------------------------------------
    // enable global CAN interrupt
@@ -1115,19 +1133,27 @@ CpStatus_tv CpCoreCanMode(CpPort_ts * ptsPortV, uint8_t ubModeV)
          SFRPAGE = CAN0_PAGE;
          
          CAN0CN |=  (CAN_CR_IE | CAN_CR_SIE | CAN_CR_EIE);
-         CAN0CN &= ~(CAN_CR_INIT | CAN_CR_CCE);
+         CAN0CN &= ~(CAN_CR_INIT | CAN_CR_CCE | CAN_CR_TEST);
          
          ubStatusT = CpErr_OK;
          break;
 
       //--------------------------------------------------------
       // Start the CAN controller (Listen-Only)
-      // CAN General Control register:
-      //    ENA = 1     : enable CAN
-      //    AUTOBAUD = 1: Listen-Only mode
+      // The silent mode of the test register only sends
+      // recessive bits, i.e. no acknowledge and no error frames.
       // Enable CAN interrupt
       //
       case CP_MODE_LISTEN_ONLY:
+         //------------------------------------------------
+         // config SFRPAGE to access CAN0 registers
+         //
+         SFRPAGE = CAN0_PAGE;
+
+         CAN0CN |=  CAN_CR_TEST;
+         CAN0TST =  CAN_TST_SILENT;
+         CAN0CN |=  (CAN_CR_IE | CAN_CR_SIE | CAN_CR_EIE);
+         CAN0CN &= ~(CAN_CR_INIT | CAN_CR_CCE);
 
          ubStatusT = CpErr_OK;
          break;
@@ -1292,6 +1318,30 @@ CpStatus_tv CpCoreDriverInit(uint8_t ubLogIfV, CpPort_ts * ptsPortV)
    #endif
 
 
+   //----------------------------------------------------------------
+   // automatic bitrate detection starts with the first entry
+   //
+   #if CP_AUTOBAUD > 0
+   ubAutobaudSelectS = 0;
+   ubAutobaudListenS = 0;
+   #endif
+
+
+   //----------------------------------------------------------------
+   // clear receive FIFO
+   //
+   #if CP_FIFO_RCV_SIZE > 0
+   ubCanFifoHeadS    = 0;
+   ubCanFifoTailS    = 0;
+   ubCanFifoOverrunS = 0;
+   ubCanFifoBufferS  = 0;
+   #if CP_STATISTIC > 0
+   ulFifoOverrunCountS = 0;
+   ubFifoLevelMaxS     = 0;
+   #endif
+   #endif
+
+
    //----------------------------------------------------------------
    // The variable 'uwCanStatusOldS' holds the (previous) value
    // of the CAN status register (CAN_SR). It is updated inside the
@@ -1342,6 +1392,83 @@ CpStatus_tv CpCoreIntFunctions(uint8_t ubChannelV,
 }
 
 
+//----------------------------------------------------------------------------//
+// CpCoreIntLock()                                                            //
+// disable the CAN interrupt                                                  //
+//----------------------------------------------------------------------------//
+void CpCoreIntLock(CpPort_ts * ptsPortV)
+{
+   //----------------------------------------------------------------
+   // inside the CAN interrupt handler the interrupt is enabled
+   // again by CpCoreIntUnlock(), this has no effect before RETI
+   //
+   CAN_IRQ_DISABLE();
+}
+
+
+//----------------------------------------------------------------------------//
+// CpCoreIntUnlock()                                                          //
+// enable the CAN interrupt                                                   //
+//----------------------------------------------------------------------------//
+void CpCoreIntUnlock(CpPort_ts * ptsPortV)
+{
+   CAN_IRQ_ENABLE();
+}
+
+
+//----------------------------------------------------------------------------//
+// CpCoreMsgRead()                                                            //
+// read messages from the receive FIFO                                        //
+//----------------------------------------------------------------------------//
+CpStatus_tv CpCoreMsgRead( CpPort_ts * ptsPortV, CpCanMsg_ts * ptsBufferV,
+                           uint32_t * pulBufferSizeV)
+{
+   #if CP_FIFO_RCV_SIZE > 0
+   uint32_t ulCountT = 0;
+   uint8_t  ubTailT;
+
+
+   //----------------------------------------------------------------
+   // the copy of the previous message is no longer valid, a call
+   // with *pulBufferSizeV = 0 only releases it
+   //
+   ubCanFifoBufferS = 0;
+
+   //----------------------------------------------------------------
+   // copy up to *pulBufferSizeV messages, every slot is released
+   // to the CAN interrupt handler as soon as it has been copied
+   //
+   ubTailT = ubCanFifoTailS;
+   while( (ulCountT < *pulBufferSizeV) && (ubTailT != ubCanFifoHeadS) )
+   {
+      *ptsBufferV = atsCanFifoRcvS[ubTailT & CAN_FIFO_MASK];
+      ubTailT++;
+      ubCanFifoTailS = ubTailT;
+      ptsBufferV++;
+      ulCountT++;
+   }
+   *pulBufferSizeV = ulCountT;
+
+   if(ulCountT == 0)
+   {
+      return (CpErr_FIFO_EMPTY);
+   }
+
+   //----------------------------------------------------------------
+   // keep the last message for CpCoreBufferGetData()
+   //
+   ptsBufferV--;
+   tsCanFifoMsgS    = *ptsBufferV;
+   ubCanFifoBufferS = (uint8_t) ptsBufferV->ulMsgUser;
+
+   return (CpErr_OK);
+   #else
+   *pulBufferSizeV = 0;
+   return (CpErr_NOT_SUPPORTED);
+   #endif
+}
+
+
 //----------------------------------------------------------------------------//
 // CpCoreStatistic()                                                          //
 // return statistical information                                             //
@@ -1352,6 +1479,10 @@ CpStatus_tv CpCoreStatistic(CpPort_ts * ptsPortV, CpStatistic_ts * ptsStatsV)
    ptsStatsV->ulRcvMsgCount = ulRcvCountS;
    ptsStatsV->ulTrmMsgCount = ulTrmCountS;
    ptsStatsV->ulErrMsgCount = ulErrCountS;
+   #if CP_FIFO_RCV_SIZE > 0
+   ptsStatsV->ulFifoOverrunCount = ulFifoOverrunCountS;
+   ptsStatsV->ulFifoLevelMax     = ubFifoLevelMaxS;
+   #endif
    return(CpErr_OK);
    #else
    return(CpErr_NOT_SUPPORTED);
@@ -1360,58 +1491,113 @@ CpStatus_tv CpCoreStatistic(CpPort_ts * ptsPortV, CpStatistic_ts * ptsStatsV)
 
 
 //----------------------------------------------------------------------------//
-// CAN_GetFreeIF()                                                            //
-// check which CAN IFx Message Interface Register Set is free                 //
+// CAN_WaitIF()                                                               //
+// wait until access to CAN IFx Message Interface Register Set is free        //
 //----------------------------------------------------------------------------//
-static uint8_t CAN_GetFreeIF(void)
+static void CAN_WaitIF(uint8_t ubMsgIfRegV)
 {
+   //----------------------------------------------------------------
+   // test valid IF number
+   //
+   if((ubMsgIfRegV != 0) && (ubMsgIfRegV != CAN_IF2_INDICATOR)) return;
+
 
    //----------------------------------------------------------------
-   // test if IF1 Message Interface Register Set if free
+   // wait until IFx Message Interface Register Set if free
    //
-   if((CAN0IF1CR & CAN_CMDRQST_BUSY) == 0)
+   if (ubMsgIfRegV)
+   {
+      while((CAN0IF2CR & CAN_CMDRQST_BUSY) > 0) { };
+   }
+   else
    {
-      return(0x00);
+      while((CAN0IF1CR & CAN_CMDRQST_BUSY) > 0) { };
    }
+}
+
+
+#if CP_FIFO_RCV_SIZE > 0
+//----------------------------------------------------------------------------//
+// CAN_FifoPush()                                                             //
+// put the message in tsCanMsgS into the receive FIFO (IRQ only)              //
+//----------------------------------------------------------------------------//
+static void CAN_FifoPush(uint8_t ubBufferIdxV)
+{
+   uint8_t  ubHeadT;
+   uint8_t  ubLevelT;
+
+   ubHeadT  = ubCanFifoHeadS;
+   ubLevelT = (uint8_t) (ubHeadT - ubCanFifoTailS);
 
    //----------------------------------------------------------------
-   // test if IF2 Message Interface Register Set if free
+   // FIFO is full: drop the message and mark the next one
    //
-   if((CAN0IF2CR & CAN_CMDRQST_BUSY) == 0)
+   if(ubLevelT >= CP_FIFO_RCV_SIZE)
    {
-      // return offset to access the second IF Register set
-      return(CAN_IF2_INDICATOR);
+      ubCanFifoOverrunS = 1;
+      #if CP_STATISTIC > 0
+      ulFifoOverrunCountS++;
+      #endif
+      return;
    }
 
+   if(ubCanFifoOverrunS)
+   {
+      CpMsgSetOverrun(&tsCanMsgS);
+      ubCanFifoOverrunS = 0;
+   }
+   tsCanMsgS.ulMsgUser = ubBufferIdxV;
+   atsCanFifoRcvS[ubHeadT & CAN_FIFO_MASK] = tsCanMsgS;
+
    //----------------------------------------------------------------
-   // nothing is free
+   // publish the message after it has been copied
    //
-   return(0xFF);
+   ubCanFifoHeadS = ubHeadT + 1;
+
+   #if CP_STATISTIC > 0
+   if(ubLevelT >= ubFifoLevelMaxS)
+   {
+      ubFifoLevelMaxS = ubLevelT + 1;
+   }
+   #endif
 }
+#endif
 
 
 //----------------------------------------------------------------------------//
-// CAN_WaitIF()                                                               //
-// wait until access to CAN IFx Message Interface Register Set is free        //
+// CAN_ReadMsgIF()                                                            //
+// copy identifier and data from IF2 registers to tsCanMsgS (IRQ only)        //
 //----------------------------------------------------------------------------//
-static void CAN_WaitIF(uint8_t ubMsgIfRegV)
+static void CAN_ReadMsgIF(uint16_t uwCanMsgArbV)
 {
-   //----------------------------------------------------------------
-   // test valid IF number
-   //
-   if((ubMsgIfRegV != 0) | (ubMsgIfRegV != CAN_IF2_INDICATOR)) return;
-
+   uint16_t  uwArb1T;
 
    //----------------------------------------------------------------
-   // wait until IFx Message Interface Register Set if free
+   // the identifier is always copied: a buffer with an acceptance
+   // mask receives more than one identifier, the callback needs the
+   // identifier of the frame and not the one of the buffer
    //
-   if (ubMsgIfRegV)
+   uwArb1T = CAN0IF2A1;
+
+   #if CP_FIFO_RCV_SIZE > 0
+   CpMsgSetData(&tsCanMsgS, 0, CAN0IF2DA1L);
+   CpMsgSetData(&tsCanMsgS, 1, CAN0IF2DA1H);
+   CpMsgSetData(&tsCanMsgS, 2, CAN0IF2DA2L);
+   CpMsgSetData(&tsCanMsgS, 3, CAN0IF2DA2H);
+   CpMsgSetData(&tsCanMsgS, 4, CAN0IF2DB1L);
+   CpMsgSetData(&tsCanMsgS, 5, CAN0IF2DB1H);
+   CpMsgSetData(&tsCanMsgS, 6, CAN0IF2DB2L);
+   CpMsgSetData(&tsCanMsgS, 7, CAN0IF2DB2H);
+   #endif
+
+   if(uwCanMsgArbV & CAN_ARB2_XTD)
    {
-	   while((CAN0IF2CR & CAN_CMDRQST_BUSY) > 0) { };
+      CpMsgSetExtId(&tsCanMsgS,
+                    ((((uint32_t) (uwCanMsgArbV & 0x1FFF)) << 16) | uwArb1T));
    }
    else
    {
-	   while((CAN0IF1CR & CAN_CMDRQST_BUSY) > 0) { };
+      CpMsgSetStdId(&tsCanMsgS, ((uwCanMsgArbV >> 2) & 0x07FF));
    }
 }
 
@@ -1425,7 +1611,6 @@ INTERRUPT(CAN0_IRQ, CAN0_IRQn)
 {
    uint16_t  uwIntIdRegT;
    uint16_t  uwCanStatusT;        // value of CAN status register
-   uint8_t  ubMsgIfRegT;         // message interface register set
    uint16_t  uwCanMsgCtrlT;       // message control register
    uint16_t  uwCanMsgArbT;        // message arbitration register
 
@@ -1478,254 +1663,139 @@ INTERRUPT(CAN0_IRQ, CAN0_IRQn)
       if(uwIntIdRegT < 0x0021)
       {
          //-----------------------------------------------------
-         // get a free message interface register
+         // IF2 is reserved for the interrupt handler
+         //
+         CAN_WaitIF(CAN_IF_IRQ);
+
+         //-----------------------------------------------------
+         // Transfer data from the Message Object addressed
+         // by the Command Request Register into the selected
+         // Message Buffer Registers
+         //
+
+         // select registers
+         CAN0IF2CM = (CAN_CMDMSK_CONTROL | // ok
+                     CAN_CMDMSK_ARB     | // ok
+                     CAN_CMDMSK_TXRQST  | // ok NewDat
+                     CAN_CMDMSK_CLRINTPND | // clear interrupt pending bit
+                     CAN_CMDMSK_IRQ_DATA);
+         // transfer data
+         CAN0IF2CR = (uint8_t) uwIntIdRegT;
+         CAN_WaitIF(CAN_IF_IRQ);
+
+         //-----------------------------------------------------
+         // copy the following information to the
+         // tsCanRcvMsgS structure:
+         // - DLC
+         // - Remote Frame
+         // - Buffer Overrun
+         //
+         CpMsgClear(&tsCanMsgS);
+
+         //-----------------------------------------------------
+         // read CAN message control register ..
+         //
+         uwCanMsgCtrlT = CAN0IF2MC;
+
+         //-----------------------------------------------------
+         // .. and copy DLC value to message structure
+         //
+         CpMsgSetDlc(&tsCanMsgS, (uint8_t) (uwCanMsgCtrlT & 0x000F));
+
+
+         //-----------------------------------------------------
+         // read CAN message arbitration register
          //
-         while( (ubMsgIfRegT = CAN_GetFreeIF() ) > CAN_IF2_INDICATOR) { };
-
-         if (ubMsgIfRegT)
-         {	// IF2
-             //-----------------------------------------------------
-             // Transfer data from the Message Object addressed
-             // by the Command Request Register into the selected
-             // Message Buffer Registers
-             //
-
-             // select registers
-             CAN0IF2CM = (CAN_CMDMSK_CONTROL | // ok
-                         CAN_CMDMSK_ARB     | // ok
-                         CAN_CMDMSK_TXRQST  | // ok NewDat
-                         CAN_CMDMSK_CLRINTPND); // clear interrupt pending bit
-             // transfer data
-             CAN0IF2CR = (uint8_t) uwIntIdRegT;
-
-
-             //-----------------------------------------------------
-             // copy the following information to the
-             // tsCanRcvMsgS structure:
-             // - DLC
-             // - Remote Frame
-             // - Buffer Overrun
-             //
-             CpMsgClear(&tsCanMsgS);
-
-             //-----------------------------------------------------
-             // read CAN message control register ..
-             //
-             uwCanMsgCtrlT = CAN0IF2MC;
-
-             //-----------------------------------------------------
-             // .. and copy DLC value to message structure
-             //
-             CpMsgSetDlc(&tsCanMsgS, (uint8_t) (uwCanMsgCtrlT & 0x000F));
-
-
-             //-----------------------------------------------------
-             // read CAN message arbitration register
-             //
-             uwCanMsgArbT = CAN0IF2A2;
-
-
-             //-----------------------------------------------------
-             // was this a Tx message buffer?
-             //
-             //-----------------------------------------------------
-             if(aubMsgDirectionS[uwIntIdRegT - 1] == MSG_DIR_TRM)
-             {
-                //---------------------------------------------
-                // Check if direction bit in arbitration
-                // register is set to 0 (message reception
-                // in transmit buffer).
-                // If so, set it to 1 again!
-                //
-                if( (uwCanMsgArbT & CAN_ARB2_DIR) == 0)
-                {
-                   uwCanMsgArbT = uwCanMsgArbT | CAN_ARB2_DIR;
-
-                   //--------------------------------
-                   // write to the command mask
-                   // register, access to message
-                   // arbitration
-                   //
-                   CAN0IF2CM = (CAN_CMDMSK_WRRD | CAN_CMDMSK_ARB);
-
-                   CAN0IF2A2  = uwCanMsgArbT;
-
-                   CAN0IF2CR = (uint8_t) uwIntIdRegT;
-
-                   if(pfnRcvIntHandler)
-                   {
-                      (* pfnRcvIntHandler)(&tsCanMsgS, (uint8_t) (uwIntIdRegT));
-                   }
-                }
-
-                //---------------------------------------------
-                // test for transmit callback handler
-                //
-                else
-                {
-                   if(pfnTrmIntHandler)
-                   {
-                      (* pfnTrmIntHandler)(&tsCanMsgS, (uint8_t) (uwIntIdRegT));
-                   }
-                }
-
-                #if CP_STATISTIC > 0
-                ulTrmCountS++;
-                #endif
-
-             }
-             else
-             //------------------------------------------------
-             // it was a Rx message buffer
-             //
-             //------------------------------------------------
-             {
-                //----------------------------------------
-                // newdat = 1 && DIR == 1 -> RTR
-                //
-                if( (uwCanMsgCtrlT & CAN_MSGC_NEWDAT) &&
-                    (uwCanMsgArbT & CAN_ARB2_DIR) )
-                {
-                   CpMsgSetRemote(&tsCanMsgS);
-                }
-
-
-                //----------------------------------------
-                // test for receive callback handler
-                //
-
-                if(pfnRcvIntHandler)
-                {
-                   (* pfnRcvIntHandler)(&tsCanMsgS, (uint8_t) (uwIntIdRegT));
-                }
-
-                #if CP_STATISTIC > 0
-                ulRcvCountS++;
-                #endif
-             }
-          }
+         uwCanMsgArbT = CAN0IF2A2;
+         CAN_ReadMsgIF(uwCanMsgArbT);
+
+
+         //-----------------------------------------------------
+         // was this a Tx message buffer?
+         //
+         //-----------------------------------------------------
+         if(aubMsgDirectionS[uwIntIdRegT - 1] == MSG_DIR_TRM)
+         {
+            //---------------------------------------------
+            // Check if direction bit in arbitration
+            // register is set to 0 (message reception
+            // in transmit buffer).
+            // If so, set it to 1 again!
+            //
+            if( (uwCanMsgArbT & CAN_ARB2_DIR) == 0)
+            {
+               uwCanMsgArbT = uwCanMsgArbT | CAN_ARB2_DIR;
+
+               //--------------------------------
+               // write to the command mask
+               // register, access to message
+               // arbitration
+               //
+               CAN0IF2CM = (CAN_CMDMSK_WRRD | CAN_CMDMSK_ARB);
+
+               CAN0IF2A2  = uwCanMsgArbT;
+
+               CAN0IF2CR = (uint8_t) uwIntIdRegT;
+
+               if(pfnRcvIntHandler)
+               {
+                  (* pfnRcvIntHandler)(&tsCanMsgS, (uint8_t) (uwIntIdRegT));
+               }
+            }
+
+            //---------------------------------------------
+            // test for transmit callback handler
+            //
+            else
+            {
+               if(pfnTrmIntHandler)
+               {
+                  (* pfnTrmIntHandler)(&tsCanMsgS, (uint8_t) (uwIntIdRegT));
+               }
+            }
+
+            #if CP_STATISTIC > 0
+            ulTrmCountS++;
+            #endif
+
+         }
          else
-         {  // IF1
-             //-----------------------------------------------------
-             // Transfer data from the Message Object addressed
-             // by the Command Request Register into the selected
-             // Message Buffer Registers
-             //
-
-             // select registers
-             CAN0IF1CM = (CAN_CMDMSK_CONTROL | // ok
-                         CAN_CMDMSK_ARB     | // ok
-                         CAN_CMDMSK_TXRQST  | // ok NewDat
-                         CAN_CMDMSK_CLRINTPND); // clear interrupt pending bit
-             // transfer data
-             CAN0IF1CR = (uint8_t) uwIntIdRegT;
-
-
-             //-----------------------------------------------------
-             // copy the following information to the
-             // tsCanRcvMsgS structure:
-             // - DLC
-             // - Remote Frame
-             // - Buffer Overrun
-             //
-             CpMsgClear(&tsCanMsgS);
-
-             //-----------------------------------------------------
-             // read CAN message control register ..
-             //
-             uwCanMsgCtrlT = CAN0IF1MC;
-
-             //-----------------------------------------------------
-             // .. and copy DLC value to message structure
-             //
-             CpMsgSetDlc(&tsCanMsgS, (uint8_t) (uwCanMsgCtrlT & 0x000F));
-
-
-             //-----------------------------------------------------
-             // read CAN message arbitration register
-             //
-             uwCanMsgArbT = CAN0IF1A2;
-
-
-             //-----------------------------------------------------
-             // was this a Tx message buffer?
-             //
-             //-----------------------------------------------------
-             if(aubMsgDirectionS[uwIntIdRegT - 1] == MSG_DIR_TRM)
-             {
-                //---------------------------------------------
-                // Check if direction bit in arbitration
-                // register is set to 0 (message reception
-                // in transmit buffer).
-                // If so, set it to 1 again!
-                //
-                if( (uwCanMsgArbT & CAN_ARB2_DIR) == 0)
-                {
-                   uwCanMsgArbT = uwCanMsgArbT | CAN_ARB2_DIR;
-
-                   //--------------------------------
-                   // write to the command mask
-                   // register, access to message
-                   // arbitration
-                   //
-                   CAN0IF1CM = (CAN_CMDMSK_WRRD | CAN_CMDMSK_ARB);
-
-                   CAN0IF1A2  = uwCanMsgArbT;
-
-                   CAN0IF1CR = (uint8_t) uwIntIdRegT;
-
-                   if(pfnRcvIntHandler)
-                   {
-                      (* pfnRcvIntHandler)(&tsCanMsgS, (uint8_t) (uwIntIdRegT));
-                   }
-                }
-
-                //---------------------------------------------
-                // test for transmit callback handler
-                //
-                else
-                {
-                   if(pfnTrmIntHandler)
-                   {
-                      (* pfnTrmIntHandler)(&tsCanMsgS, (uint8_t) (uwIntIdRegT));
-                   }
-                }
-
-                #if CP_STATISTIC > 0
-                ulTrmCountS++;
-                #endif
-
-             }
-             else
-             //------------------------------------------------
-             // it was a Rx message buffer
-             //
-             //------------------------------------------------
-             {
-                //----------------------------------------
-                // newdat = 1 && DIR == 1 -> RTR
-                //
-                if( (uwCanMsgCtrlT & CAN_MSGC_NEWDAT) &&
-                    (uwCanMsgArbT & CAN_ARB2_DIR) )
-                {
-                   CpMsgSetRemote(&tsCanMsgS);
-                }
-
-
-                //----------------------------------------
-                // test for receive callback handler
-                //
-
-                if(pfnRcvIntHandler)
-                {
-                   (* pfnRcvIntHandler)(&tsCanMsgS, (uint8_t) (uwIntIdRegT));
-                }
-
-                #if CP_STATISTIC > 0
-                ulRcvCountS++;
-                #endif
-             }
-          }
+         //------------------------------------------------
+         // it was a Rx message buffer
+         //
+         //------------------------------------------------
+         {
+            //----------------------------------------
+            // newdat = 1 && DIR == 1 -> RTR
+            //
+            if( (uwCanMsgCtrlT & CAN_MSGC_NEWDAT) &&
+                (uwCanMsgArbT & CAN_ARB2_DIR) )
+            {
+               CpMsgSetRemote(&tsCanMsgS);
+            }
+
+
+            //----------------------------------------
+            // test for receive callback handler
+            //
+
+            if(pfnRcvIntHandler)
+            {
+               #if CP_FIFO_RCV_SIZE > 0
+               if( (* pfnRcvIntHandler)(&tsCanMsgS, (uint8_t) (uwIntIdRegT))
+                   == CP_CALLBACK_PUSH_FIFO)
+               {
+                  CAN_FifoPush((uint8_t) (uwIntIdRegT));
+               }
+               #else
+               (* pfnRcvIntHandler)(&tsCanMsgS, (uint8_t) (uwIntIdRegT));
+               #endif
+            }
+
+            #if CP_STATISTIC > 0
+            ulRcvCountS++;
+            #endif
+         }
       }
       
       //----------------------------------------------------------------
@@ -174,6 +174,28 @@
 //@}
 
 
+/*!
+** \defgroup   CAN_TST
+** \brief      Defines Flags of CAN Test register, the register is
+**             only writeable with CAN_CR_TEST set
+*/
+//@{
+#define CAN_TST_LBACK   0x0010
+#define CAN_TST_SILENT  0x0008
+//@}
+
+
+/*!
+** \defgroup   CAN_ERR
+** \brief      Defines Fields of CAN Error Counter register
+*/
+//@{
+#define CAN_ERR_RP      0x8000
+#define CAN_ERR_REC     0x7F00
+#define CAN_ERR_TEC     0x00FF
+//@}
+
+
 /*! 
 ** \brief 16Bit access to CAN0DAT Register
 ** 
@@ -9,6 +9,7 @@
 // Date        History                                                        //
 // ----------  -------------------------------------------------------------- //
 // 26.09.2017  Initial version derived from microcontrol can-pie              //
+// 17.10.2026  High-resolution timer from the Timer2 counter                  //
 //                                                                            //
 //****************************************************************************//
 
@@ -21,6 +22,23 @@
 #include "c51f550_hal.h"
 
 
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------
+// Timer2 counts with SYSCLK / 12 = 2 MHz, i.e. 500 ns per count;
+// number of counts of one timer tick, this is the reload value
+// of McTmrInit()
+//
+#if COS_TIMER_PERIOD == 5000
+#define  TMR_COUNT_TICK       10000
+#else
+#define  TMR_COUNT_TICK       2000
+#endif
+
+
 /*----------------------------------------------------------------------------*\
 ** Variables of module                                                        **
 **                                                                            **
@@ -32,6 +50,29 @@
 //
 //void  (* pfnTmrHandler) (void);
 
+//-------------------------------------------------------------------
+// number of timer interrupts since McTmrInit()
+//
+static volatile uint32_t ulTmrTickS;
+
+//-------------------------------------------------------------------
+// high-resolution timer: Timer2 counts per high-resolution tick
+// (0 = not initialised), high-resolution ticks per timer tick and
+// the value at McTmrHResStart()
+//
+static uint8_t    ubTmrHResDivS;
+static uint16_t   uwTmrHResTickS;
+static uint32_t   ulTmrHResBaseS;
+
+//-------------------------------------------------------------------
+// Timer2 counts per high-resolution tick, the index is the tick
+// period taken from TMR_HRES_TICK_e, starting at 500 ns; every
+// value divides TMR_COUNT_TICK
+//
+static CPP_CONST uint8_t aubTmrHResDivC[] = {
+   1, 2, 4, 10, 20, 40, 100
+};
+
 /*----------------------------------------------------------------------------*\
 ** Functions                                                                  **
 **                                                                            **
@@ -69,6 +110,7 @@ void McTmrInit(void)
 
 //	_U08 XRAM BackupPage;
   ubTimerTriggerG = 0;
+  ulTmrTickS = 0;
 /*
    // ----------------------------------------------------------------
    // SYSCLOCK ist configured to internal clock of 24MHz
@@ -153,6 +195,7 @@ INTERRUPT(TIMER2_ISR, TIMER2_IRQn)
    blink = !blink;
    nOUT_RED = blink;
    ubTimerTriggerG = 1;
+   ulTmrTickS++;
 
    /*
    //----------------------------------------------------------------
@@ -165,3 +208,112 @@ INTERRUPT(TIMER2_ISR, TIMER2_IRQn)
    */
 }
 
+
+//----------------------------------------------------------------------------//
+// McTmrTick()                                                                //
+// return number of timer ticks                                               //
+//----------------------------------------------------------------------------//
+uint32_t McTmrTick(void)
+{
+   uint32_t ulTickT;
+   bit      ET2_SAVE = IE_ET2;         // Preserve ET2
+
+   //----------------------------------------------------------------
+   // the 32 bit value can not be read in one instruction, block the
+   // timer interrupt during the copy; the function is also called
+   // before McTmrInit() and inside interrupt handlers, so the
+   // previous state of the interrupt enable is restored
+   //
+   IE_ET2  = 0;
+   ulTickT = ulTmrTickS;
+   IE_ET2  = ET2_SAVE;
+
+   return(ulTickT);
+}
+
+
+//----------------------------------------------------------------------------//
+// McTmrHResInit()                                                            //
+// select the period of the high-resolution tick                              //
+//----------------------------------------------------------------------------//
+Status_tv McTmrHResInit(uint8_t ubTickPeriodV)
+{
+   //----------------------------------------------------------------
+   // the resolution is limited by the Timer2 clock of 500 ns
+   //
+   if((ubTickPeriodV < eTMR_HRES_TICK_500ns) ||
+      (ubTickPeriodV > eTMR_HRES_TICK_50us))
+   {
+      return(-eTMR_ERR_RES_INVALID);
+   }
+
+   ubTmrHResDivS  = aubTmrHResDivC[ubTickPeriodV - eTMR_HRES_TICK_500ns];
+   uwTmrHResTickS = TMR_COUNT_TICK / ubTmrHResDivS;
+   ulTmrHResBaseS = 0;
+
+   return(eTMR_ERR_OK);
+}
+
+
+//----------------------------------------------------------------------------//
+// McTmrHResStart()                                                           //
+// start the high-resolution time measurement at 0                            //
+//----------------------------------------------------------------------------//
+void McTmrHResStart(void)
+{
+   ulTmrHResBaseS = 0;
+   ulTmrHResBaseS = McTmrHResTick();
+}
+
+
+//----------------------------------------------------------------------------//
+// McTmrHResTick()                                                            //
+// return the high-resolution tick, built from ulTmrTickS and Timer2          //
+//----------------------------------------------------------------------------//
+uint32_t McTmrHResTick(void)
+{
+   uint32_t ulTickT;
+   uint16_t uwCountT;
+   uint8_t  ubHighT;
+   uint8_t  SFRPAGE_save = SFRPAGE;
+   bit      ET2_SAVE = IE_ET2;         // Preserve ET2
+
+   if(ubTmrHResDivS == 0) return(0);
+
+   //----------------------------------------------------------------
+   // the tick counter and Timer2 are read with the timer interrupt
+   // blocked, the high byte is read again in case the low byte
+   // has overflowed; an overflow which is not yet counted by the
+   // interrupt handler (TF2H set) has reloaded the counter, it is
+   // read again and one tick is added
+   //
+   SFRPAGE = LEGACY_PAGE;
+   IE_ET2  = 0;
+   ulTickT = ulTmrTickS;
+   do
+   {
+      ubHighT  = TMR2H;
+      uwCountT = ((uint16_t) ubHighT << 8) | TMR2L;
+   } while(ubHighT != TMR2H);
+
+   if(TMR2CN_TF2H)
+   {
+      do
+      {
+         ubHighT  = TMR2H;
+         uwCountT = ((uint16_t) ubHighT << 8) | TMR2L;
+      } while(ubHighT != TMR2H);
+      ulTickT++;
+   }
+   IE_ET2  = ET2_SAVE;
+   SFRPAGE = SFRPAGE_save;
+
+   //----------------------------------------------------------------
+   // counts since the last reload (TMR2RL = -TMR_COUNT_TICK), the
+   // result wraps around like the tick counter
+   //
+   uwCountT = uwCountT + TMR_COUNT_TICK;
+   ulTickT  = (ulTickT * uwTmrHResTickS) + (uwCountT / ubTmrHResDivS);
+
+   return(ulTickT - ulTmrHResBaseS);
+}
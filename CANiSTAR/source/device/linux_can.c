@@ -0,0 +1,1247 @@
+//****************************************************************************//
+// File:          linux_can.c                                                 //
+// Description:   CANpie Core functions for a virtual CAN bus on Linux        //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "cp_core.h"
+#include "cp_msg.h"
+#include "linux_can.h"
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#if CP_TARGET != MC_OS_LINUX
+#error  linux_can.c requires CP_TARGET == MC_OS_LINUX
+#endif
+
+#if CP_FIFO_RCV_SIZE > 0
+#error  linux_can.c has no receive FIFO, CpVBusProcess() runs in the main loop
+#endif
+
+//-------------------------------------------------------------------
+// magic value which marks an initialised bus segment
+//
+#define  VBUS_MAGIC           0x43505642
+
+//-------------------------------------------------------------------
+// maximum number of frames that are copied out of the bus log
+// with one lock operation
+//
+#define  VBUS_RCV_CHUNK       64
+
+//-------------------------------------------------------------------
+// error counter limits as defined by ISO 11898-1
+//
+#define  VBUS_ERR_WARN        96
+#define  VBUS_ERR_PASSIVE     128
+
+#define  MSG_DIR_RCV          0x00
+#define  MSG_DIR_TRM          0x01
+
+//-------------------------------------------------------------------
+// flags of a local message object
+//
+#define  VBUS_OBJ_VALID       0x01
+#define  VBUS_OBJ_NEWDAT      0x02
+
+
+//-------------------------------------------------------------------
+// one CAN frame on the bus
+//
+typedef struct VBusFrame_s {
+   uint32_t    ulArbField;       // arbitration field, lower value wins
+   uint32_t    ulIdentifier;     // identifier value
+   uint16_t    uwNode;           // node slot of the transmitter
+   uint8_t     ubBuffer;         // message buffer of the transmitter
+   uint8_t     ubMsgCtrl;        // CP_MASK_EXT_BIT / CP_MASK_RTR_BIT
+   uint8_t     ubMsgDLC;         // data length code
+   uint8_t     ubBaudSel;        // bit-rate of the transmitter
+   uint8_t     aubData[8];       // payload
+} VBusFrame_ts;
+
+//-------------------------------------------------------------------
+// node slot inside the shared memory segment
+//
+typedef struct VBusNode_s {
+   uint8_t        ubUsed;        // slot is assigned to a controller
+   uint8_t        ubMode;        // CP_MODE_xxx
+   uint8_t        ubBaudSel;     // CP_BAUD_xxx
+   uint8_t        ubReserved;
+   uint32_t       ulTxPending;   // bit n: buffer (n + 1) requests transmission
+   VBusFrame_ts   atsTxFrame[CP_BUFFER_MAX];
+} VBusNode_ts;
+
+//-------------------------------------------------------------------
+// layout of the shared memory segment
+//
+typedef struct VBus_s {
+   uint32_t          ulMagic;
+   pthread_mutex_t   tsLock;
+   uint32_t          ulSeqNext;  // sequence number of next frame in log
+   uint16_t          auwActive[CP_BAUD_MAX];   // started nodes per bit-rate
+   VBusNode_ts       atsNode[CP_VBUS_NODE_MAX];
+   VBusFrame_ts      atsLog[CP_VBUS_LOG_SIZE];
+} VBus_ts;
+
+//-------------------------------------------------------------------
+// local message object of a CAN channel
+//
+typedef struct VBusObj_s {
+   uint32_t    ulIdentifier;
+   uint32_t    ulAccMask;
+   uint8_t     ubFlags;
+   uint8_t     ubDirection;
+   uint8_t     ubMsgCtrl;
+   uint8_t     ubMsgDLC;
+   uint8_t     aubData[8];
+} VBusObj_ts;
+
+//-------------------------------------------------------------------
+// local state of a CAN channel
+//
+typedef struct VBusPort_s {
+   VBus_ts *      ptsBus;
+   VBusNode_ts *  ptsNode;
+   uint32_t       ulRcvSeq;         // next frame to read from log
+   uint8_t        ubOverrun;        // frames have been lost
+   uint8_t        ubRcvErrCnt;
+   uint8_t        ubTrmErrCnt;
+   uint8_t        ubErrType;
+   uint8_t        ubErrStateOld;
+   VBusObj_ts     atsObj[CP_BUFFER_MAX];
+
+   uint8_t  (* pfnRcvIntHandler) (CpCanMsg_ts *, uint8_t);
+   uint8_t  (* pfnTrmIntHandler) (CpCanMsg_ts *, uint8_t);
+   uint8_t  (* pfnErrIntHandler) (CpState_ts *);
+
+   //--------------------------------------------------------
+   // held while the callbacks run, CpCoreIntLock() takes the
+   // role of disabling the CAN interrupt
+   //
+   pthread_mutex_t   tsIntLock;
+
+   #if CP_STATISTIC > 0
+   uint32_t       ulTrmCount;
+   uint32_t       ulRcvCount;
+   uint32_t       ulErrCount;
+   #endif
+} VBusPort_ts;
+
+
+/*----------------------------------------------------------------------------*\
+** Variables of module                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+static VBusPort_ts   atsVBusPortS[CP_CHANNEL_MAX];
+
+//-------------------------------------------------------------------
+// Message flags for polling mode (COS_MGR_INT == 0), these are
+// served for the first CAN channel when no callback is installed.
+//
+uint32_t             ulCpRcvBufferFlagG;
+uint32_t             ulCpTrmBufferFlagG;
+CpCanMsg_ts          atsCanMsgG[CP_BUFFER_MAX];
+
+
+//-------------------------------------------------------------------
+// declaration of internal functions
+//
+static void          VBusArbitrate(VBus_ts * ptsBusV);
+static VBusPort_ts * VBusGetPort(CpPort_ts * ptsPortV);
+static void          VBusReceive(CpPort_ts * ptsPortV, VBusPort_ts * ptsVPortV,
+                                 VBusFrame_ts * ptsFrameV);
+static void          VBusSetMode(VBusPort_ts * ptsVPortV, uint8_t ubModeV,
+                                 uint8_t ubBaudSelV);
+
+
+/*----------------------------------------------------------------------------*\
+** Function implementation                                                    **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------//
+// CpCoreAutobaud()                                                           //
+// run automatic baudrate detection                                           //
+//----------------------------------------------------------------------------//
+CpStatus_tv CpCoreAutobaud(CpPort_ts * CPP_PARM_UNUSED(ptsPortV),
+                           uint8_t * CPP_PARM_UNUSED(pubBaudSelV),
+                           uint16_t * CPP_PARM_UNUSED(puwWaitV))
+{
+   return(CpErr_NOT_SUPPORTED);
+}
+
+
+//----------------------------------------------------------------------------//
+// CpCoreBaudrate()                                                           //
+// Setup baudrate of CAN controller                                           //
+//----------------------------------------------------------------------------//
+CpStatus_tv CpCoreBaudrate(CpPort_ts * ptsPortV, uint8_t ubBaudSelV)
+{
+   VBusPort_ts *  ptsVPortT;
+
+   ptsVPortT = VBusGetPort(ptsPortV);
+   if(ptsVPortT == 0L) return(CpErr_CHANNEL);
+
+   //----------------------------------------------------------------
+   // like on the C_CAN the bit timing can only be changed while
+   // the controller is stopped
+   //
+   if(ptsVPortT->ptsNode->ubMode != CP_MODE_STOP)
+   {
+      return(CpErr_INIT_FAIL);
+   }
+
+   if(ubBaudSelV > CP_BAUD_1M)
+   {
+      return(CpErr_BAUDRATE);
+   }
+
+   ptsVPortT->ptsNode->ubBaudSel = ubBaudSelV;
+
+   return(CpErr_OK);
+}
+
+
+//----------------------------------------------------------------------------//
+// CpCoreBufferAccMask()                                                      //
+// set acceptance mask of a message buffer                                    //
+//----------------------------------------------------------------------------//
+CpStatus_tv CpCoreBufferAccMask( CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
+                                 uint32_t ulAccMaskV)
+{
+   VBusPort_ts *  ptsVPortT;
+
+   ptsVPortT = VBusGetPort(ptsPortV);
+   if(ptsVPortT == 0L) return(CpErr_CHANNEL);
+
+   if(ubBufferIdxV < CP_BUFFER_1  ) return(CpErr_BUFFER);
+   if(ubBufferIdxV > CP_BUFFER_MAX) return(CpErr_BUFFER);
+
+   ptsVPortT->atsObj[ubBufferIdxV - 1].ulAccMask = ulAccMaskV;
+
+   return(CpErr_OK);
+}
+
+
+//----------------------------------------------------------------------------//
+// CpCoreBufferCommit()                                                       //
+// the reserved data is the message object, only the send is left             //
+//----------------------------------------------------------------------------//
+CpStatus_tv CpCoreBufferCommit(  CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
+                                 uint8_t ubSendV)
+{
+   if(VBusGetPort(ptsPortV) == 0L) return(CpErr_CHANNEL);
+
+   if(ubBufferIdxV < CP_BUFFER_1  ) return(CpErr_BUFFER);
+   if(ubBufferIdxV > CP_BUFFER_MAX) return(CpErr_BUFFER);
+
+   if(ubSendV) return(CpCoreBufferSend(ptsPortV, ubBufferIdxV));
+
+   return(CpErr_OK);
+}
+
+
+//----------------------------------------------------------------------------//
+// CpCoreBufferGetData()                                                      //
+//                                                                            //
+//----------------------------------------------------------------------------//
+CpStatus_tv CpCoreBufferGetData( CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
+                                 uint8_t * pubDataV)
+{
+   VBusPort_ts *  ptsVPortT;
+
+   ptsVPortT = VBusGetPort(ptsPortV);
+   if(ptsVPortT == 0L) return(CpErr_CHANNEL);
+
+   if(ubBufferIdxV < CP_BUFFER_1  ) return(CpErr_BUFFER);
+   if(ubBufferIdxV > CP_BUFFER_MAX) return(CpErr_BUFFER);
+
+   memcpy(pubDataV, &(ptsVPortT->atsObj[ubBufferIdxV - 1].aubData[0]), 8);
+
+   return(CpErr_OK);
+}
+
+
+//----------------------------------------------------------------------------//
+// CpCoreBufferGetDlc()                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+CpStatus_tv CpCoreBufferGetDlc(  CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
+                                 uint8_t * pubDlcV)
+{
+   VBusPort_ts *  ptsVPortT;
+
+   ptsVPortT = VBusGetPort(ptsPortV);
+   if(ptsVPortT == 0L) return(CpErr_CHANNEL);
+
+   if(ubBufferIdxV < CP_BUFFER_1  ) return(CpErr_BUFFER);
+   if(ubBufferIdxV > CP_BUFFER_MAX) return(CpErr_BUFFER);
+
+   *pubDlcV = ptsVPortT->atsObj[ubBufferIdxV - 1].ubMsgDLC;
+
+   return(CpErr_OK);
+}
+
+
+//----------------------------------------------------------------------------//
+// CpCoreBufferInit()                                                         //
+// initialize CAN message buffer                                              //
+//----------------------------------------------------------------------------//
+CpStatus_tv CpCoreBufferInit( CpPort_ts * ptsPortV, CpCanMsg_ts * ptsCanMsgV,
+                              uint8_t ubBufferIdxV, uint8_t ubDirectionV)
+{
+   VBusPort_ts *  ptsVPortT;
+   VBusObj_ts *   ptsObjT;
+
+   ptsVPortT = VBusGetPort(ptsPortV);
+   if(ptsVPortT == 0L) return(CpErr_CHANNEL);
+
+   if(ubBufferIdxV < CP_BUFFER_1  ) return(CpErr_BUFFER);
+   if(ubBufferIdxV > CP_BUFFER_MAX) return(CpErr_BUFFER);
+
+   ptsObjT = &(ptsVPortT->atsObj[ubBufferIdxV - 1]);
+
+   //----------------------------------------------------------------
+   // a pending transmission of this buffer is cancelled
+   //
+   pthread_mutex_lock(&(ptsVPortT->ptsBus->tsLock));
+   ptsVPortT->ptsNode->ulTxPending &= ~(((uint32_t) 1) << (ubBufferIdxV - 1));
+   pthread_mutex_unlock(&(ptsVPortT->ptsBus->tsLock));
+
+   //----------------------------------------------------------------
+   // setup the message object, the default acceptance mask is
+   // an exact match like in c51f550_can.c
+   //
+   if(CpMsgIsExtended(ptsCanMsgV))
+   {
+      ptsObjT->ulIdentifier = CpMsgGetExtId(ptsCanMsgV) & CP_MASK_EXT_FRAME;
+      ptsObjT->ulAccMask    = CP_MASK_EXT_FRAME;
+      ptsObjT->ubMsgCtrl    = CP_MASK_EXT_BIT;
+   }
+   else
+   {
+      ptsObjT->ulIdentifier = CpMsgGetStdId(ptsCanMsgV) & CP_MASK_STD_FRAME;
+      ptsObjT->ulAccMask    = CP_MASK_STD_FRAME;
+      ptsObjT->ubMsgCtrl    = 0;
+   }
+
+   if(ubDirectionV == CP_BUFFER_DIR_TX)
+   {
+      ptsObjT->ubDirection = MSG_DIR_TRM;
+      ptsObjT->ubMsgDLC    = CpMsgGetDlc(ptsCanMsgV);
+      if(ptsObjT->ubMsgDLC > 8) ptsObjT->ubMsgDLC = 8;
+      if(CpMsgIsRemote(ptsCanMsgV))
+      {
+         ptsObjT->ubMsgCtrl |= CP_MASK_RTR_BIT;
+      }
+   }
+   else
+   {
+      ptsObjT->ubDirection = MSG_DIR_RCV;
+      ptsObjT->ubMsgDLC    = 0;
+   }
+
+   memset(&(ptsObjT->aubData[0]), 0, 8);
+   ptsObjT->ubFlags = VBUS_OBJ_VALID;
+
+   return(CpErr_OK);
+}
+
+
+//----------------------------------------------------------------------------//
+// CpCoreBufferRelease()                                                      //
+//                                                                            //
+//----------------------------------------------------------------------------//
+CpStatus_tv CpCoreBufferRelease( CpPort_ts * ptsPortV, uint8_t ubBufferIdxV)
+{
+   VBusPort_ts *  ptsVPortT;
+
+   ptsVPortT = VBusGetPort(ptsPortV);
+   if(ptsVPortT == 0L) return(CpErr_CHANNEL);
+
+   if(ubBufferIdxV < CP_BUFFER_1  ) return(CpErr_BUFFER);
+   if(ubBufferIdxV > CP_BUFFER_MAX) return(CpErr_BUFFER);
+
+   pthread_mutex_lock(&(ptsVPortT->ptsBus->tsLock));
+   ptsVPortT->ptsNode->ulTxPending &= ~(((uint32_t) 1) << (ubBufferIdxV - 1));
+   pthread_mutex_unlock(&(ptsVPortT->ptsBus->tsLock));
+
+   ptsVPortT->atsObj[ubBufferIdxV - 1].ubFlags     = 0;
+   ptsVPortT->atsObj[ubBufferIdxV - 1].ubDirection = MSG_DIR_RCV;
+
+   return(CpErr_OK);
+}
+
+
+//----------------------------------------------------------------------------//
+// CpCoreBufferReserve()                                                      //
+// message objects are located in RAM, no extra data copy is needed           //
+//----------------------------------------------------------------------------//
+CpStatus_tv CpCoreBufferReserve( CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
+                                 uint8_t ** ppubDataV)
+{
+   VBusPort_ts *  ptsVPortT;
+
+   ptsVPortT = VBusGetPort(ptsPortV);
+   if(ptsVPortT == 0L) return(CpErr_CHANNEL);
+
+   if(ubBufferIdxV < CP_BUFFER_1  ) return(CpErr_BUFFER);
+   if(ubBufferIdxV > CP_BUFFER_MAX) return(CpErr_BUFFER);
+
+   *ppubDataV = &(ptsVPortT->atsObj[ubBufferIdxV - 1].aubData[0]);
+
+   return(CpErr_OK);
+}
+
+
+//----------------------------------------------------------------------------//
+// CpCoreBufferSend()                                                         //
+// send message out of the CAN controller                                     //
+//----------------------------------------------------------------------------//
+CpStatus_tv CpCoreBufferSend(CpPort_ts * ptsPortV, uint8_t ubBufferIdxV)
+{
+   VBusPort_ts *  ptsVPortT;
+   VBusObj_ts *   ptsObjT;
+   VBusFrame_ts * ptsFrameT;
+
+   ptsVPortT = VBusGetPort(ptsPortV);
+   if(ptsVPortT == 0L) return(CpErr_CHANNEL);
+
+   if(ubBufferIdxV < CP_BUFFER_1  ) return(CpErr_BUFFER);
+   if(ubBufferIdxV > CP_BUFFER_MAX) return(CpErr_BUFFER);
+
+   ptsObjT = &(ptsVPortT->atsObj[ubBufferIdxV - 1]);
+   if((ptsObjT->ubFlags & VBUS_OBJ_VALID) == 0) return(CpErr_BUFFER);
+
+   //----------------------------------------------------------------
+   // copy the message object into the node slot and set the
+   // transmit request, the frame leaves the node in the next
+   // arbitration round
+   //
+   pthread_mutex_lock(&(ptsVPortT->ptsBus->tsLock));
+
+   ptsFrameT = &(ptsVPortT->ptsNode->atsTxFrame[ubBufferIdxV - 1]);
+   ptsFrameT->ulIdentifier = ptsObjT->ulIdentifier;
+   ptsFrameT->ubBuffer     = ubBufferIdxV;
+   ptsFrameT->ubMsgCtrl    = ptsObjT->ubMsgCtrl;
+   ptsFrameT->ubMsgDLC     = ptsObjT->ubMsgDLC;
+   ptsFrameT->uwNode       = (uint16_t) (ptsVPortT->ptsNode -
+                                         &(ptsVPortT->ptsBus->atsNode[0]));
+   memcpy(&(ptsFrameT->aubData[0]), &(ptsObjT->aubData[0]), 8);
+
+   //----------------------------------------------------------------
+   // The arbitration field is built in bit order on the wire, so the
+   // frame with the lower value wins:
+   // ID[28..18] | RTR/SRR | IDE | ID[17..0] | RTR
+   //
+   if(ptsObjT->ubMsgCtrl & CP_MASK_EXT_BIT)
+   {
+      ptsFrameT->ulArbField = ((ptsObjT->ulIdentifier >> 18) << 21) |
+                              (((uint32_t) 1) << 20)              |
+                              (((uint32_t) 1) << 19)              |
+                              ((ptsObjT->ulIdentifier & 0x0003FFFF) << 1);
+      if(ptsObjT->ubMsgCtrl & CP_MASK_RTR_BIT)
+      {
+         ptsFrameT->ulArbField |= 1;
+      }
+   }
+   else
+   {
+      ptsFrameT->ulArbField = ptsObjT->ulIdentifier << 21;
+      if(ptsObjT->ubMsgCtrl & CP_MASK_RTR_BIT)
+      {
+         ptsFrameT->ulArbField |= (((uint32_t) 1) << 20);
+      }
+   }
+
+   ptsVPortT->ptsNode->ulTxPending |= (((uint32_t) 1) << (ubBufferIdxV - 1));
+
+   pthread_mutex_unlock(&(ptsVPortT->ptsBus->tsLock));
+
+   return(CpErr_OK);
+}
+
+
+//----------------------------------------------------------------------------//
+// CpCoreBufferSetData()                                                      //
+//                                                                            //
+//----------------------------------------------------------------------------//
+CpStatus_tv CpCoreBufferSetData( CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
+                                 uint8_t * pubDataV)
+{
+   VBusPort_ts *  ptsVPortT;
+
+   ptsVPortT = VBusGetPort(ptsPortV);
+   if(ptsVPortT == 0L) return(CpErr_CHANNEL);
+
+   if(ubBufferIdxV < CP_BUFFER_1  ) return(CpErr_BUFFER);
+   if(ubBufferIdxV > CP_BUFFER_MAX) return(CpErr_BUFFER);
+
+   memcpy(&(ptsVPortT->atsObj[ubBufferIdxV - 1].aubData[0]), pubDataV, 8);
+
+   return(CpErr_OK);
+}
+
+
+//----------------------------------------------------------------------------//
+// CpCoreBufferSetDlc()                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+CpStatus_tv CpCoreBufferSetDlc(  CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
+                                 uint8_t ubDlcV)
+{
+   VBusPort_ts *  ptsVPortT;
+
+   ptsVPortT = VBusGetPort(ptsPortV);
+   if(ptsVPortT == 0L) return(CpErr_CHANNEL);
+
+   if(ubBufferIdxV < CP_BUFFER_1  ) return(CpErr_BUFFER);
+   if(ubBufferIdxV > CP_BUFFER_MAX) return(CpErr_BUFFER);
+
+   //----------------------------------------------------------------
+   // limit DLC value to prevent some undefined behaviour
+   //
+   if(ubDlcV > 8)
+   {
+      ubDlcV = 8;
+   }
+
+   ptsVPortT->atsObj[ubBufferIdxV - 1].ubMsgDLC = ubDlcV;
+
+   return(CpErr_OK);
+}
+
+
+//----------------------------------------------------------------------------//
+// CpCoreBufferTransmit()                                                     //
+// setup message buffer and send message                                      //
+//----------------------------------------------------------------------------//
+CpStatus_tv CpCoreBufferTransmit(CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
+                                 CpCanMsg_ts * ptsCanMsgV)
+{
+   CpStatus_tv    tvStatusT;
+
+   tvStatusT = CpCoreBufferInit(ptsPortV, ptsCanMsgV, ubBufferIdxV,
+                                CP_BUFFER_DIR_TX);
+   if(tvStatusT != CpErr_OK) return(tvStatusT);
+
+   CpCoreBufferSetData(ptsPortV, ubBufferIdxV,
+                       &(ptsCanMsgV->tuMsgData.aubByte[0]));
+
+   return(CpCoreBufferSend(ptsPortV, ubBufferIdxV));
+}
+
+
+//----------------------------------------------------------------------------//
+// CpCoreCanMode()                                                            //
+//                                                                            //
+//----------------------------------------------------------------------------//
+CpStatus_tv CpCoreCanMode(CpPort_ts * ptsPortV, uint8_t ubModeV)
+{
+   VBusPort_ts *  ptsVPortT;
+   uint8_t        ubStatusT;
+
+   ptsVPortT = VBusGetPort(ptsPortV);
+   if(ptsVPortT == 0L) return(CpErr_CHANNEL);
+
+   switch(ubModeV)
+   {
+      case CP_MODE_STOP:
+      case CP_MODE_START:
+      case CP_MODE_LISTEN_ONLY:
+         pthread_mutex_lock(&(ptsVPortT->ptsBus->tsLock));
+         VBusSetMode(ptsVPortT, ubModeV, ptsVPortT->ptsNode->ubBaudSel);
+
+         //------------------------------------------------
+         // a stopped controller does not see the frames
+         // which are sent in the meantime
+         //
+         if(ubModeV == CP_MODE_STOP)
+         {
+            ptsVPortT->ptsNode->ulTxPending = 0;
+            ptsVPortT->ulRcvSeq = ptsVPortT->ptsBus->ulSeqNext;
+         }
+         pthread_mutex_unlock(&(ptsVPortT->ptsBus->tsLock));
+         ubStatusT = CpErr_OK;
+         break;
+
+      //--------------------------------------------------------
+      // Other modes are not supported
+      //
+      default:
+         ubStatusT = CpErr_NOT_SUPPORTED;
+         break;
+   }
+
+   return(ubStatusT);
+}
+
+
+//----------------------------------------------------------------------------//
+// CpCoreCanState()                                                           //
+//                                                                            //
+//----------------------------------------------------------------------------//
+CpStatus_tv CpCoreCanState(CpPort_ts * ptsPortV, CpState_ts * ptsStateV)
+{
+   VBusPort_ts *  ptsVPortT;
+   uint8_t        ubErrCntT;
+
+   ptsVPortT = VBusGetPort(ptsPortV);
+   if(ptsVPortT == 0L) return(CpErr_CHANNEL);
+
+   ptsStateV->ubCanErrType   = ptsVPortT->ubErrType;
+   ptsStateV->ubCanRcvErrCnt = ptsVPortT->ubRcvErrCnt;
+   ptsStateV->ubCanTrmErrCnt = ptsVPortT->ubTrmErrCnt;
+
+   if(ptsVPortT->ptsNode->ubMode == CP_MODE_STOP)
+   {
+      ptsStateV->ubCanErrState = CP_STATE_STOPPED;
+      return(CpErr_OK);
+   }
+
+   //----------------------------------------------------------------
+   // CAN is active by default, the state is taken from the
+   // higher one of both error counters
+   //
+   ubErrCntT = ptsVPortT->ubRcvErrCnt;
+   if(ptsVPortT->ubTrmErrCnt > ubErrCntT) ubErrCntT = ptsVPortT->ubTrmErrCnt;
+
+   ptsStateV->ubCanErrState = CP_STATE_BUS_ACTIVE;
+
+   if(ubErrCntT >= VBUS_ERR_WARN)
+   {
+      ptsStateV->ubCanErrState = CP_STATE_BUS_WARN;
+   }
+
+   if(ubErrCntT >= VBUS_ERR_PASSIVE)
+   {
+      ptsStateV->ubCanErrState = CP_STATE_BUS_PASSIVE;
+   }
+
+   return(CpErr_OK);
+}
+
+
+//----------------------------------------------------------------------------//
+// CpCoreDriverInit()                                                         //
+// init CAN controller                                                        //
+//----------------------------------------------------------------------------//
+CpStatus_tv CpCoreDriverInit(uint8_t ubPhyIfV, CpPort_ts * ptsPortV)
+{
+   VBusPort_ts *        ptsVPortT;
+   VBus_ts *            ptsBusT;
+   pthread_mutexattr_t  tsAttrT;
+   char                 aszNameT[64];
+   int                  slFileT;
+   int                  slLogIfT;
+   int                  slNodeT;
+   uint8_t              ubCreateT = 0;
+
+   //----------------------------------------------------------------
+   // search a free logical interface in this process
+   //
+   for(slLogIfT = 0; slLogIfT < CP_CHANNEL_MAX; slLogIfT++)
+   {
+      if(atsVBusPortS[slLogIfT].ptsBus == 0L) break;
+   }
+   if(slLogIfT == CP_CHANNEL_MAX) return(CpErr_CHANNEL);
+   ptsVPortT = &atsVBusPortS[slLogIfT];
+
+   //----------------------------------------------------------------
+   // open the shared memory segment of the bus, the first process
+   // creates and initialises it
+   //
+   snprintf(aszNameT, sizeof(aszNameT), "%s%d", CP_VBUS_NAME, ubPhyIfV);
+   slFileT = shm_open(aszNameT, O_RDWR | O_CREAT | O_EXCL, 0666);
+   if(slFileT >= 0)
+   {
+      ubCreateT = 1;
+      if(ftruncate(slFileT, sizeof(VBus_ts)) != 0)
+      {
+         close(slFileT);
+         shm_unlink(aszNameT);
+         return(CpErr_INIT_FAIL);
+      }
+   }
+   else
+   {
+      slFileT = shm_open(aszNameT, O_RDWR, 0666);
+      if(slFileT < 0) return(CpErr_INIT_FAIL);
+   }
+
+   ptsBusT = (VBus_ts *) mmap(0L, sizeof(VBus_ts), PROT_READ | PROT_WRITE,
+                              MAP_SHARED, slFileT, 0);
+   close(slFileT);
+   if(ptsBusT == MAP_FAILED) return(CpErr_INIT_FAIL);
+
+   if(ubCreateT)
+   {
+      pthread_mutexattr_init(&tsAttrT);
+      pthread_mutexattr_setpshared(&tsAttrT, PTHREAD_PROCESS_SHARED);
+      pthread_mutex_init(&(ptsBusT->tsLock), &tsAttrT);
+      pthread_mutexattr_destroy(&tsAttrT);
+      __atomic_store_n(&(ptsBusT->ulMagic), VBUS_MAGIC, __ATOMIC_RELEASE);
+   }
+   else
+   {
+      //--------------------------------------------------------
+      // wait until the creator has finished the initialisation
+      //
+      while(__atomic_load_n(&(ptsBusT->ulMagic), __ATOMIC_ACQUIRE) !=
+            VBUS_MAGIC)
+      {
+         usleep(100);
+      }
+   }
+
+   //----------------------------------------------------------------
+   // allocate a node slot, the controller is in init mode
+   //
+   pthread_mutex_lock(&(ptsBusT->tsLock));
+   for(slNodeT = 0; slNodeT < CP_VBUS_NODE_MAX; slNodeT++)
+   {
+      if(ptsBusT->atsNode[slNodeT].ubUsed == 0) break;
+   }
+   if(slNodeT == CP_VBUS_NODE_MAX)
+   {
+      pthread_mutex_unlock(&(ptsBusT->tsLock));
+      munmap(ptsBusT, sizeof(VBus_ts));
+      return(CpErr_INIT_FAIL);
+   }
+
+   memset(ptsVPortT, 0, sizeof(VBusPort_ts));
+   ptsVPortT->ptsBus  = ptsBusT;
+   ptsVPortT->ptsNode = &(ptsBusT->atsNode[slNodeT]);
+   ptsVPortT->ptsNode->ubUsed      = 1;
+   ptsVPortT->ptsNode->ubMode      = CP_MODE_STOP;
+   ptsVPortT->ptsNode->ubBaudSel   = CP_BAUD_125K;
+   ptsVPortT->ptsNode->ulTxPending = 0;
+   ptsVPortT->ulRcvSeq      = ptsBusT->ulSeqNext;
+   ptsVPortT->ubErrStateOld = CP_STATE_BUS_ACTIVE;
+   pthread_mutex_unlock(&(ptsBusT->tsLock));
+
+   //----------------------------------------------------------------
+   // a callback may call CpCoreIntLock(), so the lock is recursive
+   //
+   pthread_mutexattr_init(&tsAttrT);
+   pthread_mutexattr_settype(&tsAttrT, PTHREAD_MUTEX_RECURSIVE);
+   pthread_mutex_init(&(ptsVPortT->tsIntLock), &tsAttrT);
+   pthread_mutexattr_destroy(&tsAttrT);
+
+   ptsPortV->slLogIf = slLogIfT;
+   ptsPortV->slPhyIf = ubPhyIfV;
+   ptsPortV->slQueue = slNodeT;
+
+   if(slLogIfT == 0)
+   {
+      ulCpRcvBufferFlagG = 0;
+      ulCpTrmBufferFlagG = 0;
+   }
+
+   return(CpErr_OK);
+}
+
+
+//----------------------------------------------------------------------------//
+// CpCoreDriverRelease()                                                      //
+//                                                                            //
+//----------------------------------------------------------------------------//
+CpStatus_tv CpCoreDriverRelease(CpPort_ts * ptsPortV)
+{
+   VBusPort_ts *  ptsVPortT;
+   VBus_ts *      ptsBusT;
+
+   ptsVPortT = VBusGetPort(ptsPortV);
+   if(ptsVPortT == 0L) return(CpErr_CHANNEL);
+
+   ptsBusT = ptsVPortT->ptsBus;
+
+   pthread_mutex_lock(&(ptsBusT->tsLock));
+   VBusSetMode(ptsVPortT, CP_MODE_STOP, ptsVPortT->ptsNode->ubBaudSel);
+   ptsVPortT->ptsNode->ulTxPending = 0;
+   ptsVPortT->ptsNode->ubUsed      = 0;
+   pthread_mutex_unlock(&(ptsBusT->tsLock));
+
+   munmap(ptsBusT, sizeof(VBus_ts));
+   pthread_mutex_destroy(&(ptsVPortT->tsIntLock));
+   memset(ptsVPortT, 0, sizeof(VBusPort_ts));
+
+   ptsPortV->slLogIf = -1;
+   ptsPortV->slPhyIf = -1;
+   ptsPortV->slQueue = -1;
+
+   return(CpErr_OK);
+}
+
+
+//----------------------------------------------------------------------------//
+// CpCoreIntFunctions()                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+CpStatus_tv CpCoreIntFunctions(CpPort_ts * ptsPortV,
+                        uint8_t (* pfnRcvHandler)(CpCanMsg_ts *, uint8_t),
+                        uint8_t (* pfnTrmHandler)(CpCanMsg_ts *, uint8_t),
+                        uint8_t (* pfnErrHandler)(CpState_ts *) )
+{
+   VBusPort_ts *  ptsVPortT;
+
+   ptsVPortT = VBusGetPort(ptsPortV);
+   if(ptsVPortT == 0L) return(CpErr_CHANNEL);
+
+   //----------------------------------------------------------------
+   // store the new callbacks
+   //
+   ptsVPortT->pfnRcvIntHandler = pfnRcvHandler;
+   ptsVPortT->pfnTrmIntHandler = pfnTrmHandler;
+   ptsVPortT->pfnErrIntHandler = pfnErrHandler;
+
+   return(CpErr_OK);
+}
+
+
+//----------------------------------------------------------------------------//
+// CpCoreIntLock()                                                            //
+// keep the callbacks of CpVBusProcess() from running                         //
+//----------------------------------------------------------------------------//
+void CpCoreIntLock(CpPort_ts * ptsPortV)
+{
+   VBusPort_ts *  ptsVPortT;
+
+   ptsVPortT = VBusGetPort(ptsPortV);
+   if(ptsVPortT == 0L) return;
+
+   pthread_mutex_lock(&(ptsVPortT->tsIntLock));
+}
+
+
+//----------------------------------------------------------------------------//
+// CpCoreIntUnlock()                                                          //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void CpCoreIntUnlock(CpPort_ts * ptsPortV)
+{
+   VBusPort_ts *  ptsVPortT;
+
+   ptsVPortT = VBusGetPort(ptsPortV);
+   if(ptsVPortT == 0L) return;
+
+   pthread_mutex_unlock(&(ptsVPortT->tsIntLock));
+}
+
+
+//----------------------------------------------------------------------------//
+// CpCoreStatistic()                                                          //
+// return statistical information                                             //
+//----------------------------------------------------------------------------//
+CpStatus_tv CpCoreStatistic(CpPort_ts * ptsPortV, CpStatistic_ts * ptsStatsV)
+{
+   #if CP_STATISTIC > 0
+   VBusPort_ts *  ptsVPortT;
+
+   ptsVPortT = VBusGetPort(ptsPortV);
+   if(ptsVPortT == 0L) return(CpErr_CHANNEL);
+
+   ptsStatsV->ulRcvMsgCount = ptsVPortT->ulRcvCount;
+   ptsStatsV->ulTrmMsgCount = ptsVPortT->ulTrmCount;
+   ptsStatsV->ulErrMsgCount = ptsVPortT->ulErrCount;
+   return(CpErr_OK);
+   #else
+   return(CpErr_NOT_SUPPORTED);
+   #endif
+}
+
+
+//----------------------------------------------------------------------------//
+// CpVBusProcess()                                                            //
+// run bus arbitration and serve the message objects of a port                //
+//----------------------------------------------------------------------------//
+int32_t CpVBusProcess(CpPort_ts * ptsPortV)
+{
+   VBusPort_ts *  ptsVPortT;
+   VBus_ts *      ptsBusT;
+   VBusFrame_ts   atsFrameT[VBUS_RCV_CHUNK];
+   CpState_ts     tsStateT;
+   uint32_t       ulCountT;
+   uint32_t       ulFrameT;
+   int32_t        slHandledT = 0;
+
+   ptsVPortT = VBusGetPort(ptsPortV);
+   if(ptsVPortT == 0L) return(0);
+
+   ptsBusT = ptsVPortT->ptsBus;
+
+   do
+   {
+      //--------------------------------------------------------
+      // put pending frames of all nodes on the bus and copy a
+      // chunk of new frames out of the log
+      //
+      pthread_mutex_lock(&(ptsBusT->tsLock));
+
+      VBusArbitrate(ptsBusT);
+
+      ulCountT = ptsBusT->ulSeqNext - ptsVPortT->ulRcvSeq;
+      if(ulCountT > CP_VBUS_LOG_SIZE)
+      {
+         //------------------------------------------------
+         // the log has been overwritten, the lost frames
+         // are reported as overrun with the next frame
+         //
+         ptsVPortT->ulRcvSeq  = ptsBusT->ulSeqNext - CP_VBUS_LOG_SIZE;
+         ptsVPortT->ubOverrun = 1;
+         ulCountT = CP_VBUS_LOG_SIZE;
+         #if CP_STATISTIC > 0
+         ptsVPortT->ulErrCount++;
+         #endif
+      }
+      if(ulCountT > VBUS_RCV_CHUNK) ulCountT = VBUS_RCV_CHUNK;
+
+      for(ulFrameT = 0; ulFrameT < ulCountT; ulFrameT++)
+      {
+         atsFrameT[ulFrameT] = ptsBusT->atsLog[ (ptsVPortT->ulRcvSeq + ulFrameT) &
+                                                (CP_VBUS_LOG_SIZE - 1)];
+      }
+      ptsVPortT->ulRcvSeq += ulCountT;
+
+      pthread_mutex_unlock(&(ptsBusT->tsLock));
+
+      //--------------------------------------------------------
+      // serve the frames outside of the lock, the callbacks
+      // may request new transmissions
+      //
+      pthread_mutex_lock(&(ptsVPortT->tsIntLock));
+      for(ulFrameT = 0; ulFrameT < ulCountT; ulFrameT++)
+      {
+         if(ptsVPortT->ptsNode->ubMode == CP_MODE_STOP) break;
+         VBusReceive(ptsPortV, ptsVPortT, &atsFrameT[ulFrameT]);
+         slHandledT++;
+      }
+      pthread_mutex_unlock(&(ptsVPortT->tsIntLock));
+   }
+   while(ulCountT == VBUS_RCV_CHUNK);
+
+
+   //----------------------------------------------------------------
+   // a transmitter which is alone on the bus does not get an
+   // acknowledge and ends up error passive
+   //
+   if(ptsVPortT->ptsNode->ulTxPending != 0)
+   {
+      pthread_mutex_lock(&(ptsBusT->tsLock));
+      if(ptsBusT->auwActive[ptsVPortT->ptsNode->ubBaudSel] < 2)
+      {
+         if(ptsVPortT->ubTrmErrCnt < VBUS_ERR_PASSIVE)
+         {
+            ptsVPortT->ubTrmErrCnt += 8;
+         }
+         ptsVPortT->ubErrType = CP_ERR_TYPE_ACK;
+      }
+      pthread_mutex_unlock(&(ptsBusT->tsLock));
+   }
+
+
+   //----------------------------------------------------------------
+   // status change "interrupt"
+   //
+   CpCoreCanState(ptsPortV, &tsStateT);
+   if(tsStateT.ubCanErrState != ptsVPortT->ubErrStateOld)
+   {
+      ptsVPortT->ubErrStateOld = tsStateT.ubCanErrState;
+      #if CP_STATISTIC > 0
+      ptsVPortT->ulErrCount++;
+      #endif
+      if(ptsVPortT->pfnErrIntHandler)
+      {
+         pthread_mutex_lock(&(ptsVPortT->tsIntLock));
+         (* ptsVPortT->pfnErrIntHandler)(&tsStateT);
+         pthread_mutex_unlock(&(ptsVPortT->tsIntLock));
+      }
+   }
+
+   return(slHandledT);
+}
+
+
+//----------------------------------------------------------------------------//
+// CpVBusUnlink()                                                             //
+// remove the shared memory object of a bus                                   //
+//----------------------------------------------------------------------------//
+void CpVBusUnlink(uint8_t ubPhyIfV)
+{
+   char  aszNameT[64];
+
+   snprintf(aszNameT, sizeof(aszNameT), "%s%d", CP_VBUS_NAME, ubPhyIfV);
+   shm_unlink(aszNameT);
+}
+
+
+//----------------------------------------------------------------------------//
+// VBusArbitrate()                                                            //
+// put all pending frames on the bus in arbitration order, lock is held       //
+//----------------------------------------------------------------------------//
+static void VBusArbitrate(VBus_ts * ptsBusV)
+{
+   VBusNode_ts *  ptsNodeT;
+   VBusFrame_ts * ptsWinnerT;
+   VBusNode_ts *  ptsWinnerNodeT;
+   uint32_t       ulPendingT;
+   uint32_t       ulFramesT;
+   uint16_t       uwNodeT;
+   uint8_t        ubBufferT;
+
+   //----------------------------------------------------------------
+   // limit the number of frames per round, so a reader is not
+   // overrun by a single call
+   //
+   for(ulFramesT = 0; ulFramesT < (CP_VBUS_LOG_SIZE / 2); ulFramesT++)
+   {
+      ptsWinnerT     = 0L;
+      ptsWinnerNodeT = 0L;
+
+      for(uwNodeT = 0; uwNodeT < CP_VBUS_NODE_MAX; uwNodeT++)
+      {
+         ptsNodeT = &(ptsBusV->atsNode[uwNodeT]);
+         if(ptsNodeT->ulTxPending == 0)          continue;
+         if(ptsNodeT->ubMode != CP_MODE_START)   continue;
+
+         //------------------------------------------------
+         // without a second active node at the same
+         // bit-rate nobody acknowledges the frame
+         //
+         if(ptsBusV->auwActive[ptsNodeT->ubBaudSel] < 2) continue;
+
+         ulPendingT = ptsNodeT->ulTxPending;
+         ubBufferT  = 0;
+         while(ulPendingT)
+         {
+            if(ulPendingT & 1)
+            {
+               if( (ptsWinnerT == 0L) ||
+                   (ptsNodeT->atsTxFrame[ubBufferT].ulArbField <
+                    ptsWinnerT->ulArbField) )
+               {
+                  ptsWinnerT     = &(ptsNodeT->atsTxFrame[ubBufferT]);
+                  ptsWinnerNodeT = ptsNodeT;
+               }
+            }
+            ulPendingT = ulPendingT >> 1;
+            ubBufferT++;
+         }
+      }
+
+      if(ptsWinnerT == 0L) break;
+
+      //--------------------------------------------------------
+      // the winner is appended to the log and the transmit
+      // request is cleared
+      //
+      ptsWinnerT->ubBaudSel = ptsWinnerNodeT->ubBaudSel;
+      ptsBusV->atsLog[ptsBusV->ulSeqNext & (CP_VBUS_LOG_SIZE - 1)] = *ptsWinnerT;
+      ptsBusV->ulSeqNext++;
+      ptsWinnerNodeT->ulTxPending &= ~(((uint32_t) 1) <<
+                                       (ptsWinnerT->ubBuffer - 1));
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// VBusGetPort()                                                              //
+// get local state of a CAN port                                              //
+//----------------------------------------------------------------------------//
+static VBusPort_ts * VBusGetPort(CpPort_ts * ptsPortV)
+{
+   if(ptsPortV == 0L)                     return(0L);
+   if(ptsPortV->slLogIf < 0)              return(0L);
+   if(ptsPortV->slLogIf >= CP_CHANNEL_MAX) return(0L);
+   if(atsVBusPortS[ptsPortV->slLogIf].ptsBus == 0L) return(0L);
+
+   return(&atsVBusPortS[ptsPortV->slLogIf]);
+}
+
+
+//----------------------------------------------------------------------------//
+// VBusReceive()                                                              //
+// run acceptance filtering for one frame and call the handlers               //
+//----------------------------------------------------------------------------//
+static void VBusReceive(CpPort_ts * ptsPortV, VBusPort_ts * ptsVPortV,
+                        VBusFrame_ts * ptsFrameV)
+{
+   CpCanMsg_ts    tsCanMsgT;
+   VBusObj_ts *   ptsObjT;
+   uint8_t        ubBufferT;
+   uint8_t        ubDirT;
+   uint8_t        ubPollT;
+
+   //----------------------------------------------------------------
+   // a frame at a different bit-rate can not be decoded, it
+   // shows up as error frame
+   //
+   if(ptsFrameV->ubBaudSel != ptsVPortV->ptsNode->ubBaudSel)
+   {
+      if(ptsVPortV->ubRcvErrCnt < VBUS_ERR_PASSIVE)
+      {
+         ptsVPortV->ubRcvErrCnt++;
+      }
+      ptsVPortV->ubErrType = CP_ERR_TYPE_STUFF;
+      return;
+   }
+
+   if(ptsVPortV->ubRcvErrCnt > 0) ptsVPortV->ubRcvErrCnt--;
+
+   //----------------------------------------------------------------
+   // build the CANpie message
+   //
+   CpMsgClear(&tsCanMsgT);
+   if(ptsFrameV->ubMsgCtrl & CP_MASK_EXT_BIT)
+   {
+      CpMsgSetExtId(&tsCanMsgT, ptsFrameV->ulIdentifier);
+   }
+   else
+   {
+      CpMsgSetStdId(&tsCanMsgT, (uint16_t) ptsFrameV->ulIdentifier);
+   }
+   if(ptsFrameV->ubMsgCtrl & CP_MASK_RTR_BIT)
+   {
+      CpMsgSetRemote(&tsCanMsgT);
+   }
+   CpMsgSetDlc(&tsCanMsgT, ptsFrameV->ubMsgDLC);
+   memcpy(&(tsCanMsgT.tuMsgData.aubByte[0]), &(ptsFrameV->aubData[0]), 8);
+
+   ubPollT = (ptsPortV->slLogIf == 0) ? 1 : 0;
+
+   //----------------------------------------------------------------
+   // own frame: transmission was successful
+   //
+   if(ptsFrameV->uwNode == (uint16_t) ptsPortV->slQueue)
+   {
+      if(ptsVPortV->ubTrmErrCnt > 0) ptsVPortV->ubTrmErrCnt--;
+      ptsVPortV->ubErrType = CP_ERR_TYPE_NONE;
+
+      #if CP_STATISTIC > 0
+      ptsVPortV->ulTrmCount++;
+      #endif
+
+      if(ptsVPortV->pfnTrmIntHandler)
+      {
+         (* ptsVPortV->pfnTrmIntHandler)(&tsCanMsgT, ptsFrameV->ubBuffer);
+      }
+      else if(ubPollT)
+      {
+         atsCanMsgG[ptsFrameV->ubBuffer - 1] = tsCanMsgT;
+         ulCpTrmBufferFlagG |= (((uint32_t) 1) << (ptsFrameV->ubBuffer - 1));
+      }
+      return;
+   }
+
+   //----------------------------------------------------------------
+   // Search the lowest message object that matches. Data frames are
+   // accepted by receive objects, remote frames by transmit objects.
+   //
+   ubDirT = (ptsFrameV->ubMsgCtrl & CP_MASK_RTR_BIT) ? MSG_DIR_TRM :
+                                                       MSG_DIR_RCV;
+   for(ubBufferT = 0; ubBufferT < CP_BUFFER_MAX; ubBufferT++)
+   {
+      ptsObjT = &(ptsVPortV->atsObj[ubBufferT]);
+      if((ptsObjT->ubFlags & VBUS_OBJ_VALID) == 0) continue;
+      if(ptsObjT->ubDirection != ubDirT)           continue;
+      if((ptsObjT->ubMsgCtrl ^ ptsFrameV->ubMsgCtrl) & CP_MASK_EXT_BIT) continue;
+      if(((ptsObjT->ulIdentifier ^ ptsFrameV->ulIdentifier) &
+          ptsObjT->ulAccMask) != 0)                continue;
+      break;
+   }
+   if(ubBufferT == CP_BUFFER_MAX) return;
+
+   #if CP_STATISTIC > 0
+   ptsVPortV->ulRcvCount++;
+   #endif
+
+   //----------------------------------------------------------------
+   // store data in the receive object, a frame which has not been
+   // read yet is overwritten (MsgLst)
+   //
+   if(ubDirT == MSG_DIR_RCV)
+   {
+      if(ptsObjT->ubFlags & VBUS_OBJ_NEWDAT)
+      {
+         ptsVPortV->ubOverrun = 1;
+      }
+      ptsObjT->ulIdentifier = ptsFrameV->ulIdentifier;
+      ptsObjT->ubMsgDLC     = ptsFrameV->ubMsgDLC;
+      memcpy(&(ptsObjT->aubData[0]), &(ptsFrameV->aubData[0]), 8);
+      ptsObjT->ubFlags |= VBUS_OBJ_NEWDAT;
+   }
+
+   if(ptsVPortV->ubOverrun)
+   {
+      CpMsgSetOverrun(&tsCanMsgT);
+      ptsVPortV->ubOverrun = 0;
+   }
+
+   if(ptsVPortV->pfnRcvIntHandler)
+   {
+      (* ptsVPortV->pfnRcvIntHandler)(&tsCanMsgT, ubBufferT + 1);
+      ptsObjT->ubFlags &= ~VBUS_OBJ_NEWDAT;
+   }
+   else if(ubPollT)
+   {
+      if(ulCpRcvBufferFlagG & (((uint32_t) 1) << ubBufferT))
+      {
+         CpMsgSetOverrun(&tsCanMsgT);
+      }
+      atsCanMsgG[ubBufferT] = tsCanMsgT;
+      ulCpRcvBufferFlagG |= (((uint32_t) 1) << ubBufferT);
+      ptsObjT->ubFlags &= ~VBUS_OBJ_NEWDAT;
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// VBusSetMode()                                                              //
+// change mode / bit-rate of a node and update counters, lock is held         //
+//----------------------------------------------------------------------------//
+static void VBusSetMode(VBusPort_ts * ptsVPortV, uint8_t ubModeV,
+                        uint8_t ubBaudSelV)
+{
+   VBusNode_ts *  ptsNodeT = ptsVPortV->ptsNode;
+
+   if(ptsNodeT->ubMode == CP_MODE_START)
+   {
+      ptsVPortV->ptsBus->auwActive[ptsNodeT->ubBaudSel]--;
+   }
+
+   ptsNodeT->ubMode    = ubModeV;
+   ptsNodeT->ubBaudSel = ubBaudSelV;
+
+   if(ptsNodeT->ubMode == CP_MODE_START)
+   {
+      ptsVPortV->ptsBus->auwActive[ptsNodeT->ubBaudSel]++;
+   }
+}
@@ -0,0 +1,126 @@
+//****************************************************************************//
+// File:          linux_can.h                                                 //
+// Description:   Virtual CAN bus for the Linux host build of CANpie          //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+#ifndef _LINUX_CAN_H_
+#define _LINUX_CAN_H_
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include "cp_core.h"
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \file    linux_can.h
+** \brief   CANpie driver for a virtual CAN bus on a Linux host
+**
+** The virtual bus lives in a POSIX shared memory segment, so every process
+** (and every CAN channel inside a process) that calls CpCoreDriverInit()
+** with the same physical interface number is attached to the same bus.
+** Each attached controller owns one node slot with #CP_BUFFER_MAX message
+** objects inside the segment.
+**
+** A transmit request marks the message object as pending. Pending frames
+** of all nodes are put on the bus in CAN arbitration order (identifier,
+** RTR/SRR, IDE) and appended to a frame log. Every node reads the log
+** and runs the same acceptance filtering as the Bosch C_CAN message
+** handler: the lowest matching message object wins, data frames match
+** receive objects, remote frames match transmit objects.
+**
+** There is no interrupt on the host, so the application has to call
+** CpVBusProcess() from its main loop (or from one dedicated thread per
+** process). This function takes the role of the CAN interrupt handler
+** and calls the installed receive / transmit / error callbacks.
+*/
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+/*!
+** \def     CP_VBUS_NAME
+** \brief   Prefix of the shared memory object, the physical interface
+**          number is appended (e.g. "/cp_vbus0")
+*/
+#ifndef  CP_VBUS_NAME
+#define  CP_VBUS_NAME         "/cp_vbus"
+#endif
+
+
+/*!
+** \def     CP_VBUS_NODE_MAX
+** \brief   Maximum number of CAN controllers attached to one bus
+*/
+#ifndef  CP_VBUS_NODE_MAX
+#define  CP_VBUS_NODE_MAX     256
+#endif
+
+
+/*!
+** \def     CP_VBUS_LOG_SIZE
+** \brief   Number of frames kept in the bus log, must be a power of 2.
+**          A node that falls behind by more frames loses messages and
+**          reports an overrun.
+*/
+#ifndef  CP_VBUS_LOG_SIZE
+#define  CP_VBUS_LOG_SIZE     4096
+#endif
+
+
+/*----------------------------------------------------------------------------*\
+** Function prototypes                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*!
+** \brief   Run the bus and serve pending events of a CAN port
+** \param   ptsPortV       Pointer to CAN port structure
+**
+** \return  Number of frames that have been handled for this port
+**
+** This function arbitrates all pending transmit requests on the bus
+** and delivers new frames to the message objects of the port. It
+** replaces the CAN interrupt handler of the embedded targets.
+*/
+int32_t  CpVBusProcess(CpPort_ts * ptsPortV);
+
+
+/*!
+** \brief   Remove the shared memory object of a virtual bus
+** \param   ubPhyIfV       Physical interface number (bus number)
+**
+** Controllers which are still attached keep their mapping, the bus
+** is removed from the file system when the last one detaches.
+*/
+void     CpVBusUnlink(uint8_t ubPhyIfV);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* _LINUX_CAN_H_ */
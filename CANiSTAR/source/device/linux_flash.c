@@ -0,0 +1,217 @@
+//****************************************************************************//
+// File:          linux_flash.c                                               //
+// Description:   Flash memory simulation for the Linux host build            //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <string.h>
+
+#include "linux_flash.h"
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#if MC_TARGET != MC_OS_LINUX
+#error  linux_flash.c requires MC_TARGET == MC_OS_LINUX
+#endif
+
+#define  FLASH_SIM_PAGES      (FLASH_SIM_SIZE / FLASH_PAGESIZE)
+
+//-------------------------------------------------------------------
+// state of the supply for one operation
+//
+#define  FLASH_SIM_OFF        0     // supply is off, no operation
+#define  FLASH_SIM_ON         1     // operation is done
+#define  FLASH_SIM_CUT        2     // supply fails during operation
+
+
+/*----------------------------------------------------------------------------*\
+** Variables of module                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+static uint8_t    aubFlashSimMemS[FLASH_SIM_SIZE];       // flash memory
+static uint32_t   aulFlashSimEraseS[FLASH_SIM_PAGES];    // erase cycles
+static uint32_t   ulFlashSimWriteErrS;                   // invalid writes
+
+static uint8_t    ubFlashSimFailS;                       // fail is armed
+static uint8_t    ubFlashSimPowerOffS;                   // supply is off
+static uint32_t   ulFlashSimOpsS;                        // ops until fail
+
+static uint8_t    ubFlashSimInitS;                       // memory erased
+
+
+/*----------------------------------------------------------------------------*\
+** Functions                                                                  **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//----------------------------------------------------------------------------//
+// FlashSimPowerCheck()                                                       //
+// count one write / erase operation and return the supply state              //
+//----------------------------------------------------------------------------//
+static uint8_t FlashSimPowerCheck(void)
+{
+   if(ubFlashSimInitS == 0) FlashSimInit();
+
+   if(ubFlashSimPowerOffS) return(FLASH_SIM_OFF);
+
+   if(ubFlashSimFailS)
+   {
+      if(ulFlashSimOpsS == 0)
+      {
+         ubFlashSimPowerOffS = 1;
+         return(FLASH_SIM_CUT);
+      }
+      ulFlashSimOpsS--;
+   }
+
+   return(FLASH_SIM_ON);
+}
+
+
+//----------------------------------------------------------------------------//
+// FLASH_ByteWrite()                                                          //
+//                                                                            //
+//----------------------------------------------------------------------------//
+U8 FLASH_ByteWrite(FLADDR addr, U8 byte)
+{
+   if(FlashSimPowerCheck() != FLASH_SIM_ON) return(0);
+
+   if(addr >= FLASH_SIM_SIZE) return(0);
+
+   //----------------------------------------------------------------
+   // programming can only clear bits
+   //
+   if((aubFlashSimMemS[addr] & byte) != byte)
+   {
+      ulFlashSimWriteErrS++;
+   }
+   aubFlashSimMemS[addr] &= byte;
+
+   return(1);
+}
+
+
+//----------------------------------------------------------------------------//
+// FLASH_ByteRead()                                                           //
+//                                                                            //
+//----------------------------------------------------------------------------//
+U8 FLASH_ByteRead(FLADDR addr)
+{
+   if(ubFlashSimInitS == 0) FlashSimInit();
+
+   if(addr >= FLASH_SIM_SIZE) return(0xFF);
+
+   return(aubFlashSimMemS[addr]);
+}
+
+
+//----------------------------------------------------------------------------//
+// FLASH_PageErase()                                                          //
+//                                                                            //
+//----------------------------------------------------------------------------//
+U8 FLASH_PageErase(FLADDR addr)
+{
+   FLADDR   tvPageT;
+   uint8_t  ubPowerT;
+
+   if(addr >= FLASH_SIM_SIZE) return(0);
+
+   tvPageT  = addr & ~((FLADDR) (FLASH_PAGESIZE - 1));
+   ubPowerT = FlashSimPowerCheck();
+
+   //----------------------------------------------------------------
+   // the supply fails during this erase operation, the page is
+   // only partially erased
+   //
+   if(ubPowerT == FLASH_SIM_CUT)
+   {
+      memset(&aubFlashSimMemS[tvPageT], 0xFF, FLASH_PAGESIZE / 2);
+   }
+
+   if(ubPowerT != FLASH_SIM_ON) return(0);
+
+   memset(&aubFlashSimMemS[tvPageT], 0xFF, FLASH_PAGESIZE);
+   aulFlashSimEraseS[tvPageT / FLASH_PAGESIZE]++;
+
+   return(1);
+}
+
+
+//----------------------------------------------------------------------------//
+// FlashSimEraseCount()                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+uint32_t FlashSimEraseCount(FLADDR tvAddrV)
+{
+   if(tvAddrV >= FLASH_SIM_SIZE) return(0);
+
+   return(aulFlashSimEraseS[tvAddrV / FLASH_PAGESIZE]);
+}
+
+
+//----------------------------------------------------------------------------//
+// FlashSimInit()                                                             //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void FlashSimInit(void)
+{
+   memset(aubFlashSimMemS, 0xFF, sizeof(aubFlashSimMemS));
+   memset(aulFlashSimEraseS, 0, sizeof(aulFlashSimEraseS));
+   ulFlashSimWriteErrS = 0;
+   ubFlashSimFailS     = 0;
+   ubFlashSimPowerOffS = 0;
+   ulFlashSimOpsS      = 0;
+   ubFlashSimInitS     = 1;
+}
+
+
+//----------------------------------------------------------------------------//
+// FlashSimPowerFail()                                                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void FlashSimPowerFail(uint32_t ulOpsV)
+{
+   ulFlashSimOpsS  = ulOpsV;
+   ubFlashSimFailS = 1;
+}
+
+
+//----------------------------------------------------------------------------//
+// FlashSimPowerOn()                                                          //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void FlashSimPowerOn(void)
+{
+   ubFlashSimFailS     = 0;
+   ubFlashSimPowerOffS = 0;
+   ulFlashSimOpsS      = 0;
+}
+
+
+//----------------------------------------------------------------------------//
+// FlashSimWriteErrors()                                                      //
+//                                                                            //
+//----------------------------------------------------------------------------//
+uint32_t FlashSimWriteErrors(void)
+{
+   return(ulFlashSimWriteErrS);
+}
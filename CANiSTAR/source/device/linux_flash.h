@@ -0,0 +1,136 @@
+//****************************************************************************//
+// File:          linux_flash.h                                               //
+// Description:   Flash memory simulation for the Linux host build            //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+#ifndef _LINUX_FLASH_H_
+#define _LINUX_FLASH_H_
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include "compiler.h"
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \file    linux_flash.h
+** \brief   Simulation of the C8051F560 flash primitives on a Linux host
+**
+** This module replaces F560_FlashPrimitives.c in the host build. The
+** flash is an array in memory with the behaviour of the real device:
+** a page erase sets all bytes of the page to 0xFF and a byte write can
+** only clear bits. Writes which try to set a bit are counted, they
+** point to a missing erase in the driver above.
+** <p>
+** For power-fail tests FlashSimPowerFail() cuts the supply after a
+** given number of write / erase operations. The operation at that
+** point is only done partially (an erase clears only the first half of
+** the page), all later operations fail like a write with a low VDD
+** monitor. After FlashSimPowerOn() the application restarts the driver,
+** e.g. by calling McNvmInit().
+** <p>
+** The number of erase cycles is counted for every page, so the wear of
+** a storage scheme can be evaluated.
+*/
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+typedef uint8_t      U8;
+typedef uint16_t     U16;
+typedef U16          FLADDR;
+
+#ifndef FLASH_PAGESIZE
+#define FLASH_PAGESIZE 512
+#endif
+
+#ifndef FLASH_TEMP
+#define FLASH_TEMP 0x7800L             // For 32K Flash devices
+#endif
+
+#ifndef FLASH_LAST
+#define FLASH_LAST 0x7A00L             // For 32K Flash devices
+#endif
+
+/*!
+** \def     FLASH_SIM_SIZE
+** \brief   Size of the simulated flash memory
+*/
+#ifndef  FLASH_SIM_SIZE
+#define  FLASH_SIM_SIZE       0x8000L
+#endif
+
+
+/*----------------------------------------------------------------------------*\
+** Function prototypes                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+U8   FLASH_ByteWrite (FLADDR addr, U8 byte);
+U8   FLASH_ByteRead  (FLADDR addr);
+U8   FLASH_PageErase (FLADDR addr);
+
+
+/*!
+** \brief   Erase the simulated flash and clear all counters
+*/
+void     FlashSimInit(void);
+
+
+/*!
+** \brief   Cut the supply after a number of operations
+** \param   ulOpsV         Number of write / erase operations which are
+**                         still done, 0 cuts the supply immediately
+*/
+void     FlashSimPowerFail(uint32_t ulOpsV);
+
+
+/*!
+** \brief   Restore the supply
+*/
+void     FlashSimPowerOn(void);
+
+
+/*!
+** \brief   Number of erase cycles of a page
+** \param   tvAddrV        Address of any byte in the page
+** \return  Number of erase cycles since FlashSimInit()
+*/
+uint32_t FlashSimEraseCount(FLADDR tvAddrV);
+
+
+/*!
+** \brief   Number of write operations that tried to set a bit
+** \return  Number of invalid write operations since FlashSimInit()
+*/
+uint32_t FlashSimWriteErrors(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* _LINUX_FLASH_H_ */
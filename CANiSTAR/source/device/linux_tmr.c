@@ -0,0 +1,468 @@
+//****************************************************************************//
+// File:          linux_tmr.c                                                 //
+// Description:   Timer functions for the Linux host build (virtual clock)    //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include "cos_conf.h"
+#include "mc_tmr.h"
+#include "linux_tmr.h"
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#if MC_TARGET != MC_OS_LINUX
+#error  linux_tmr.c requires MC_TARGET == MC_OS_LINUX
+#endif
+
+//-------------------------------------------------------------------
+// one tick of the virtual clock has the period of the stack timer,
+// this is the same as the Timer2 reload value on the C8051F550
+//
+#define  TMR_TICK_PERIOD      ((uint32_t) COS_TIMER_PERIOD)
+
+//-------------------------------------------------------------------
+// length of one tick in nanoseconds, the time between two ticks is
+// counted in nanoseconds for the high-resolution timer
+//
+#define  TMR_TICK_NS          (TMR_TICK_PERIOD * 1000UL)
+
+
+/*----------------------------------------------------------------------------*\
+** Variables of module                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+static uint32_t      ulTmrTickS;                         // virtual clock
+static uint8_t       ubTmrRunS;                          // timer started
+static uint32_t      ulTmrSubNsS;                        // time since tick
+static uint32_t      ulTmrHResNsS;                       // period of HRes
+static uint32_t      ulTmrHResBaseS;                     // McTmrHResStart()
+
+static McTmrFunc_ts  atsTmrFuncS[MC_TMR_FUNCTION];       // function timers
+static McTmrSoft_ts  atsTmrSoftS[MC_TMR_MAX];            // software timers
+
+//-------------------------------------------------------------------
+// period of the high-resolution tick in nanoseconds, the index is
+// taken from TMR_HRES_TICK_e
+//
+static const uint32_t aulTmrHResNsC[] = {
+   50, 100, 200, 500, 1000, 2000, 5000, 10000, 20000, 50000
+};
+
+
+/*----------------------------------------------------------------------------*\
+** Functions                                                                  **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//----------------------------------------------------------------------------//
+// McTmrIntHandler()                                                          //
+// one tick of the virtual clock, replaces the Timer2 interrupt               //
+//----------------------------------------------------------------------------//
+static void McTmrIntHandler(void)
+{
+   uint8_t        ubTmrNumT;
+   McTmrFunc_ts * ptsFuncT;
+
+   ulTmrTickS++;
+   ubTimerTriggerG = 1;
+
+   //----------------------------------------------------------------
+   // software timers
+   //
+   for(ubTmrNumT = 0; ubTmrNumT < MC_TMR_MAX; ubTmrNumT++)
+   {
+      if(atsTmrSoftS[ubTmrNumT].ulTick > 0)
+      {
+         atsTmrSoftS[ubTmrNumT].ulTick--;
+      }
+   }
+
+   //----------------------------------------------------------------
+   // function timers, a function may stop or release its own timer
+   //
+   for(ubTmrNumT = 0; ubTmrNumT < MC_TMR_FUNCTION; ubTmrNumT++)
+   {
+      ptsFuncT = &atsTmrFuncS[ubTmrNumT];
+      if((ptsFuncT->fnTmrCall == 0L) ||
+         ((ptsFuncT->ulControl & eTMR_CTRL_START) == 0))
+      {
+         continue;
+      }
+
+      if(ptsFuncT->ulTickCurrent > 1)
+      {
+         ptsFuncT->ulTickCurrent--;
+         continue;
+      }
+
+      if(ptsFuncT->ulControl & eTMR_CTRL_ONESHOT)
+      {
+         ptsFuncT->ulControl &= ~((uint32_t) eTMR_CTRL_START);
+      }
+      ptsFuncT->ulTickCurrent = ptsFuncT->ulTickPeriod;
+
+      (*ptsFuncT->fnTmrCall)();
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// McTmrAdvance()                                                             //
+// advance the virtual clock                                                  //
+//----------------------------------------------------------------------------//
+uint32_t McTmrAdvance(uint32_t ulTicksV)
+{
+   uint32_t ulCountT;
+
+   for(ulCountT = 0; ulCountT < ulTicksV; ulCountT++)
+   {
+      //--------------------------------------------------------
+      // a timer function may stop the clock
+      //
+      if(ubTmrRunS == 0) break;
+
+      McTmrIntHandler();
+   }
+
+   return(ulCountT);
+}
+
+
+//----------------------------------------------------------------------------//
+// McTmrHResAdvance()                                                         //
+// advance the virtual clock by high-resolution ticks                         //
+//----------------------------------------------------------------------------//
+uint32_t McTmrHResAdvance(uint32_t ulTicksV)
+{
+   uint64_t uqNsT;
+   uint32_t ulCountT = 0;
+
+   if((ubTmrRunS == 0) || (ulTmrHResNsS == 0)) return(0);
+
+   //----------------------------------------------------------------
+   // every completed tick runs the timer interrupt, the rest is
+   // kept for the next call; the time after a timer function has
+   // stopped the clock is lost
+   //
+   uqNsT = ((uint64_t) ulTicksV * ulTmrHResNsS) + ulTmrSubNsS;
+   while(uqNsT >= TMR_TICK_NS)
+   {
+      McTmrIntHandler();
+      ulCountT++;
+      uqNsT = uqNsT - TMR_TICK_NS;
+
+      if(ubTmrRunS == 0)
+      {
+         uqNsT = 0;
+         break;
+      }
+   }
+   ulTmrSubNsS = (uint32_t) uqNsT;
+
+   return(ulCountT);
+}
+
+
+//----------------------------------------------------------------------------//
+// McTmrHResInit()                                                            //
+//                                                                            //
+//----------------------------------------------------------------------------//
+Status_tv McTmrHResInit(uint8_t ubTickPeriodV)
+{
+   if((ubTickPeriodV < eTMR_HRES_TICK_50ns) ||
+      (ubTickPeriodV > eTMR_HRES_TICK_50us))
+   {
+      return(-eTMR_ERR_RES_INVALID);
+   }
+
+   ulTmrHResNsS   = aulTmrHResNsC[ubTickPeriodV - eTMR_HRES_TICK_50ns];
+   ulTmrHResBaseS = 0;
+
+   return(eTMR_ERR_OK);
+}
+
+
+//----------------------------------------------------------------------------//
+// McTmrHResStart()                                                           //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void McTmrHResStart(void)
+{
+   ulTmrHResBaseS = 0;
+   ulTmrHResBaseS = McTmrHResTick();
+}
+
+
+//----------------------------------------------------------------------------//
+// McTmrHResTick()                                                            //
+// virtual time in high-resolution ticks                                      //
+//----------------------------------------------------------------------------//
+uint32_t McTmrHResTick(void)
+{
+   uint64_t uqNsT;
+
+   if(ulTmrHResNsS == 0) return(0);
+
+   uqNsT = ((uint64_t) ulTmrTickS * TMR_TICK_NS) + ulTmrSubNsS;
+
+   return((uint32_t) (uqNsT / ulTmrHResNsS) - ulTmrHResBaseS);
+}
+
+
+//----------------------------------------------------------------------------//
+// McTmrDelayTicks()                                                          //
+// nothing else runs during the delay, so the clock simply moves on           //
+//----------------------------------------------------------------------------//
+Status_tv McTmrDelayTicks(uint32_t ulTicksV)
+{
+   if(ubTmrRunS == 0) return(-eTMR_ERR_START);
+
+   McTmrAdvance(ulTicksV);
+
+   return(eTMR_ERR_OK);
+}
+
+
+//----------------------------------------------------------------------------//
+// McTmrFunctionInit()                                                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+Status_tv McTmrFunctionInit(TmrHandler_fn fnHandlerV,
+                            uint32_t ulTicksV, uint8_t ubControlV)
+{
+   uint8_t  ubTmrNumT;
+
+   if((fnHandlerV == 0L) || (ulTicksV == 0)) return(-eTMR_ERR_PARM_INVALID);
+
+   for(ubTmrNumT = 0; ubTmrNumT < MC_TMR_FUNCTION; ubTmrNumT++)
+   {
+      if(atsTmrFuncS[ubTmrNumT].fnTmrCall == 0L)
+      {
+         atsTmrFuncS[ubTmrNumT].ulControl     = ubControlV;
+         atsTmrFuncS[ubTmrNumT].ulTickCurrent = ulTicksV;
+         atsTmrFuncS[ubTmrNumT].ulTickPeriod  = ulTicksV;
+         atsTmrFuncS[ubTmrNumT].fnTmrCall     = fnHandlerV;
+
+         //----------------------------------------------------
+         // timer numbers start at 1
+         //
+         return((Status_tv) (ubTmrNumT + 1));
+      }
+   }
+
+   return(-eTMR_ERR_RES_FULL);
+}
+
+
+//----------------------------------------------------------------------------//
+// McTmrFunctionRelease()                                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+Status_tv McTmrFunctionRelease(uint8_t ubTmrNumV)
+{
+   if((ubTmrNumV == 0) || (ubTmrNumV > MC_TMR_FUNCTION))
+   {
+      return(-eTMR_ERR_RES_INVALID);
+   }
+
+   atsTmrFuncS[ubTmrNumV - 1].ulControl = eTMR_CTRL_STOP;
+   atsTmrFuncS[ubTmrNumV - 1].fnTmrCall = 0L;
+
+   return(eTMR_ERR_OK);
+}
+
+
+//----------------------------------------------------------------------------//
+// McTmrFunctionStart()                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+Status_tv McTmrFunctionStart(uint8_t ubTmrNumV)
+{
+   McTmrFunc_ts * ptsFuncT;
+
+   if((ubTmrNumV == 0) || (ubTmrNumV > MC_TMR_FUNCTION))
+   {
+      return(-eTMR_ERR_RES_INVALID);
+   }
+
+   ptsFuncT = &atsTmrFuncS[ubTmrNumV - 1];
+   if(ptsFuncT->fnTmrCall == 0L) return(-eTMR_ERR_RES_INVALID);
+
+   ptsFuncT->ulTickCurrent = ptsFuncT->ulTickPeriod;
+   ptsFuncT->ulControl    |= eTMR_CTRL_START;
+
+   return(eTMR_ERR_OK);
+}
+
+
+//----------------------------------------------------------------------------//
+// McTmrFunctionStop()                                                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+Status_tv McTmrFunctionStop(uint8_t ubTmrNumV)
+{
+   if((ubTmrNumV == 0) || (ubTmrNumV > MC_TMR_FUNCTION))
+   {
+      return(-eTMR_ERR_RES_INVALID);
+   }
+
+   atsTmrFuncS[ubTmrNumV - 1].ulControl &= ~((uint32_t) eTMR_CTRL_START);
+
+   return(eTMR_ERR_OK);
+}
+
+
+//----------------------------------------------------------------------------//
+// McTmrInit()                                                                //
+// reset the virtual clock and start it                                       //
+//----------------------------------------------------------------------------//
+void McTmrInit(void)
+{
+   uint8_t  ubTmrNumT;
+
+   ubTimerTriggerG = 0;
+   ulTmrTickS      = 0;
+   ulTmrSubNsS     = 0;
+
+   for(ubTmrNumT = 0; ubTmrNumT < MC_TMR_FUNCTION; ubTmrNumT++)
+   {
+      atsTmrFuncS[ubTmrNumT].ulControl = eTMR_CTRL_STOP;
+      atsTmrFuncS[ubTmrNumT].fnTmrCall = 0L;
+   }
+
+   for(ubTmrNumT = 0; ubTmrNumT < MC_TMR_MAX; ubTmrNumT++)
+   {
+      atsTmrSoftS[ubTmrNumT].ubState = 0;
+      atsTmrSoftS[ubTmrNumT].ulTick  = 0;
+   }
+
+   ubTmrRunS = 1;
+}
+
+
+//----------------------------------------------------------------------------//
+// McTmrPeriodRelease()                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+Status_tv McTmrPeriodRelease(uint8_t ubTmrNumV)
+{
+   if((ubTmrNumV == 0) || (ubTmrNumV > MC_TMR_MAX))
+   {
+      return(-eTMR_ERR_RES_INVALID);
+   }
+
+   atsTmrSoftS[ubTmrNumV - 1].ubState = 0;
+   atsTmrSoftS[ubTmrNumV - 1].ulTick  = 0;
+
+   return(eTMR_ERR_OK);
+}
+
+
+//----------------------------------------------------------------------------//
+// McTmrPeriodExpired()                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+Status_tv McTmrPeriodExpired(uint8_t ubTmrNumV)
+{
+   if((ubTmrNumV == 0) || (ubTmrNumV > MC_TMR_MAX))
+   {
+      return(-eTMR_ERR_RES_INVALID);
+   }
+
+   if(atsTmrSoftS[ubTmrNumV - 1].ubState == 0) return(-eTMR_ERR_START);
+
+   if(atsTmrSoftS[ubTmrNumV - 1].ulTick > 0)   return(-eTMR_ERR_RUN);
+
+   return(eTMR_ERR_OK);
+}
+
+
+//----------------------------------------------------------------------------//
+// McTmrPeriodStart()                                                         //
+//                                                                            //
+//----------------------------------------------------------------------------//
+Status_tv McTmrPeriodStart(uint32_t ulTicksV)
+{
+   uint8_t  ubTmrNumT;
+
+   for(ubTmrNumT = 0; ubTmrNumT < MC_TMR_MAX; ubTmrNumT++)
+   {
+      if(atsTmrSoftS[ubTmrNumT].ubState == 0)
+      {
+         atsTmrSoftS[ubTmrNumT].ubState = 1;
+         atsTmrSoftS[ubTmrNumT].ulTick  = ulTicksV;
+         return((Status_tv) (ubTmrNumT + 1));
+      }
+   }
+
+   return(-eTMR_ERR_RES_FULL);
+}
+
+
+//----------------------------------------------------------------------------//
+// McTmrStart()                                                               //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void McTmrStart(void)
+{
+   ubTmrRunS = 1;
+}
+
+
+//----------------------------------------------------------------------------//
+// McTmrStop()                                                                //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void McTmrStop(void)
+{
+   ubTmrRunS = 0;
+}
+
+
+//----------------------------------------------------------------------------//
+// McTmrTick()                                                                //
+//                                                                            //
+//----------------------------------------------------------------------------//
+uint32_t McTmrTick(void)
+{
+   return(ulTmrTickS);
+}
+
+
+//----------------------------------------------------------------------------//
+// McTmrTicksToTime()                                                         //
+//                                                                            //
+//----------------------------------------------------------------------------//
+uint32_t McTmrTicksToTime(uint32_t ulTickV)
+{
+   return(ulTickV * TMR_TICK_PERIOD);
+}
+
+
+//----------------------------------------------------------------------------//
+// McTmrTimeToTicks()                                                         //
+//                                                                            //
+//----------------------------------------------------------------------------//
+uint32_t McTmrTimeToTicks(uint32_t ulTimeV)
+{
+   return(ulTimeV / TMR_TICK_PERIOD);
+}
@@ -0,0 +1,101 @@
+//****************************************************************************//
+// File:          linux_tmr.h                                                 //
+// Description:   Virtual timer for the Linux host build                      //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+#ifndef _LINUX_TMR_H_
+#define _LINUX_TMR_H_
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include "mc_tmr.h"
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \file    linux_tmr.h
+** \brief   MCL timer driven by a virtual clock on a Linux host
+**
+** The host build has no hardware timer and does not use the clock of
+** the operating system. Time only passes when the application (or a
+** test driver) calls McTmrAdvance(). Each tick runs the same code as
+** the Timer2 interrupt of the C8051F550: the tick counter is
+** incremented, #ubTimerTriggerG is set, the software timers are
+** decremented and the function timers are called.
+** <p>
+** One tick has the length of #COS_TIMER_PERIOD microseconds, so one
+** call of CosTmrEvent() per tick gives the stack the same timing as on
+** the target. The stack timer can be called in two ways:
+** - register CosTmrEvent() with McTmrFunctionInit() and a period of
+**   1 tick (like COS_TMR_INT == 1), then McTmrAdvance() can run any
+**   number of ticks with one call
+** - poll #ubTimerTriggerG in the main loop (like COS_TMR_INT == 0),
+**   then the main loop must run once after each McTmrAdvance(1)
+** <p>
+** McTmrHResAdvance() moves the clock by high-resolution ticks, the
+** time between two ticks is kept, so McTmrHResTick() measures times
+** below one tick. The high-resolution tick supports all periods of
+** TMR_HRES_TICK_e.
+** <p>
+** The clock is deterministic: two runs with the same sequence of
+** calls produce the same sequence of timer events.
+*/
+
+
+/*----------------------------------------------------------------------------*\
+** Function prototypes                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*!
+** \brief   Advance the virtual clock
+** \param   ulTicksV       Number of timer ticks
+**
+** \return  Number of ticks that have been executed
+**
+** The function runs the timer interrupt \a ulTicksV times. Nothing is
+** executed while the timer is stopped (McTmrStop()), in this case the
+** function returns 0.
+*/
+uint32_t McTmrAdvance(uint32_t ulTicksV);
+
+
+/*!
+** \brief   Advance the virtual clock by high-resolution ticks
+** \param   ulTicksV       Number of high-resolution ticks
+**
+** \return  Number of timer ticks that have been executed
+**
+** The function moves the clock by \a ulTicksV ticks of the period
+** selected by McTmrHResInit() and runs the timer interrupt for every
+** completed timer tick. Nothing is executed while the timer is stopped
+** or before McTmrHResInit(), in this case the function returns 0.
+*/
+uint32_t McTmrHResAdvance(uint32_t ulTicksV);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* _LINUX_TMR_H_ */
@@ -198,6 +198,22 @@
 #define  CP_CHANNEL_MAX             1
 #endif
 
+/*-------------------------------------------------------------------*/
+/*!
+** \def  CP_FIFO_RCV_SIZE
+** \ingroup CP_CONF
+**
+** This symbol defines the number of messages in the software receive
+** FIFO of the driver. A receive callback returning
+** #CP_CALLBACK_PUSH_FIFO puts the message into this FIFO, it is read
+** by CpCoreMsgRead(). The value must be a power of 2 (max. 128).
+** - 0 = no receive FIFO (not supported by driver)
+** - n = receive FIFO with n messages
+*/
+#ifndef  CP_FIFO_RCV_SIZE
+#define  CP_FIFO_RCV_SIZE           0
+#endif
+
 /*-------------------------------------------------------------------*/
 /*!
 ** \def  CP_SMALL_CODE
@@ -436,6 +452,10 @@ enum CpErr {
    */
    CpErr_PARAM,
 
+   /*!   Automatic bitrate detection is listening (45dec / 2Dhex)
+   */
+   CpErr_BAUDRATE_WAIT,
+
    /*!   Function is not supported (50dec / 32hex)
    */
    CpErr_NOT_SUPPORTED = 50
@@ -1014,6 +1034,16 @@ struct CpStatistic_s {
    */
    uint32_t     ulErrMsgCount;
 
+#if CP_FIFO_RCV_SIZE > 0
+   /*!   Number of messages lost because the receive FIFO was full
+   */
+   uint32_t     ulFifoOverrunCount;
+
+   /*!   Highest number of messages in the receive FIFO
+   */
+   uint32_t     ulFifoLevelMax;
+#endif
+
 };
 
 typedef struct CpStatistic_s CpStatistic_ts;  // new style to be C99 conform
@@ -102,6 +102,11 @@
 **
 ** <p>
 **
+** \def CPP_BIG_ENDIAN
+** The symbol \c CPP_BIG_ENDIAN is 1 for a CPU which stores the most
+** significant byte of a value at the lowest address, else 0. The value
+** is 0 if the compiler section below does not define it.
+**
 ** \def CPP_CONST
 ** The symbol \c CPP_CONST defines the expression for keeping data
 ** in the flash area.
@@ -368,6 +373,7 @@ typedef  int32_t              _S32;
 
 #include <stdint.h>           // data types uint8_t ... uint64_t
 
+#define  CPP_BIG_ENDIAN       1
 #define  CPP_CONST            const
 #define  CPP_DATA_SIZE        64
 #define  CPP_INLINE           inline
@@ -449,6 +455,26 @@ typedef  int64_t              _S64;
 
 #include <types/VxTypes.h>
 
+//--------------------------------------------------------------
+// PowerPC runs in both byte orders, the byte order is taken from
+// the compiler (__BYTE_ORDER__) or from the VxWorks architecture
+// header (_BYTE_ORDER), big endian is the default of the BSPs
+//
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__)
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define  CPP_BIG_ENDIAN       0
+#else
+#define  CPP_BIG_ENDIAN       1
+#endif
+#elif defined(_BYTE_ORDER) && defined(_LITTLE_ENDIAN)
+#if _BYTE_ORDER == _LITTLE_ENDIAN
+#define  CPP_BIG_ENDIAN       0
+#else
+#define  CPP_BIG_ENDIAN       1
+#endif
+#else
+#define  CPP_BIG_ENDIAN       1
+#endif
 #define  CPP_CONST            const
 #define  CPP_DATA_SIZE        64
 #define  CPP_INLINE           inline
@@ -596,6 +622,7 @@ typedef  long                 _S32;
 #ifdef __C51__
 
 #include <stdint.h>
+#define  CPP_BIG_ENDIAN       1
 #define  CPP_CONST            const
 #define  CPP_DATA_SIZE        32
 #define  CPP_INLINE
@@ -990,5 +1017,9 @@ typedef  long                 _S32;
 #error   Data types are not defined! Please check compiler definition.
 #endif
 
+#ifndef  CPP_BIG_ENDIAN
+#define  CPP_BIG_ENDIAN       0
+#endif
+
 
 #endif      // COMPILER_H_
@@ -185,7 +185,9 @@ typedef int32_t                  _TvCpStatus;   // deprecated
 #define CP_AUTOBAUD              0
 #define CP_BUFFER_MAX            32
 
+#ifndef  CP_CHANNEL_MAX
 #define CP_CHANNEL_MAX           2
+#endif
 #define CP_GLOBAL_RCV_ENABLE     0
 #define CP_SMALL_CODE            0
 #define CP_STATISTIC             1
@@ -771,7 +773,7 @@ typedef uint8_t                  _TsCpPort;     // deprecated
 typedef uint8_t                  CpStatus_tv;
 typedef uint8_t                  _TvCpStatus;   // deprecated
 
-#define CP_AUTOBAUD              0
+#define CP_AUTOBAUD              1
 #define CP_BUFFER_MAX            32
 
 #define CP_SMALL_CODE            1
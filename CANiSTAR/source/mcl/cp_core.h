@@ -131,10 +131,12 @@ extern "C" {                                                         //
 #define  CpCoreBittiming(CH, A)              CpCoreBittiming(A)
 
 #define  CpCoreBufferAccMask(CH, A, B)       CpCoreBufferAccMask(A, B)
+#define  CpCoreBufferCommit(CH, A, B)        CpCoreBufferCommit(A, B)
 #define  CpCoreBufferGetData(CH, A, B)       CpCoreBufferGetData(A, B)
 #define  CpCoreBufferGetDlc(CH, A, B)        CpCoreBufferGetDlc(A, B)
 #define  CpCoreBufferInit(CH, A, B, C)       CpCoreBufferInit(A, B, C)
 #define  CpCoreBufferRelease(CH, A)          CpCoreBufferRelease(A)
+#define  CpCoreBufferReserve(CH, A, B)       CpCoreBufferReserve(A, B)
 #define  CpCoreBufferSetData(CH, A, B)       CpCoreBufferSetData(A, B)
 #define  CpCoreBufferSetDlc(CH, A, B)        CpCoreBufferSetDlc(A, B)
 #define  CpCoreBufferSend(CH, A)             CpCoreBufferSend(A)
@@ -165,6 +167,29 @@ extern "C" {                                                         //
 
 CpStatus_tv CpCoreAccMask(CpPort_ts * ptsPortV, uint32_t ulAccMaskV);
 
+
+/*!
+** \brief   Automatic bitrate detection
+** \param   ptsPortV       Pointer to CAN port structure
+** \param   pubBaudSelV    Pointer to bitrate selection
+** \param   puwWaitV       Pointer to listen time in timer ticks
+**
+** \return  Error code taken from the #CpErr enumeration. The function
+**          returns \c CpErr_OK if the bitrate was detected,
+**          \c CpErr_BAUDRATE if the tested bitrate is not valid and
+**          \c CpErr_BAUDRATE_WAIT while the bitrate is tested.
+**
+** The function does not block, each call checks the bus once. The CAN
+** controller listens to the bus without sending acknowledge or error
+** frames for at most \e puwWaitV timer ticks per bitrate. A valid
+** bitrate in \e pubBaudSelV is tested first, with #CP_BAUD_AUTO the
+** next bitrate of the detection order of the driver is tested. On
+** success \e pubBaudSelV holds the detected bitrate and the controller
+** stays in initialisation mode, else \e pubBaudSelV is set to
+** #CP_BAUD_AUTO. A listen time of 0 ends a running detection. The
+** function is called before CpCoreBaudrate() and requires a running
+** timer (McTmrTick()).
+*/
 CpStatus_tv CpCoreAutobaud(CpPort_ts * ptsPortV, uint8_t * pubBaudSelV,
                            uint16_t * puwWaitV);
 
@@ -219,6 +244,26 @@ CpStatus_tv CpCoreBittiming(CpPort_ts * ptsPortV, CpBitTiming_ts * ptsBitrateV);
 CpStatus_tv CpCoreBufferAccMask( CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
                                  uint32_t ulAccMaskV);
 
+
+/*!
+** \brief   Transfer reserved data to message buffer
+** \param   ptsPortV       Pointer to CAN port structure
+** \param   ubBufferIdxV   Buffer number
+** \param   ubSendV        1 = transmit the message buffer
+**
+** \return  Error code taken from the #CpErr enumeration. If no error
+**          occurred, the function will return \c CpErr_OK.
+**
+** \see     CpCoreBufferReserve()
+**
+** This function copies the data area returned by CpCoreBufferReserve()
+** into the message buffer \a ubBufferIdxV. With \a ubSendV set to 1 the
+** transmit request is set in the same access, this replaces the
+** sequence CpCoreBufferSetData() / CpCoreBufferSend().
+*/
+CpStatus_tv CpCoreBufferCommit(  CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
+                                 uint8_t ubSendV);
+
 /*!
 ** \brief   Get data from message buffer
 ** \param   ptsPortV       Pointer to CAN port structure
@@ -297,6 +342,31 @@ CpStatus_tv CpCoreBufferInit( CpPort_ts * ptsPortV, CpCanMsg_ts * ptsCanMsgV,
 CpStatus_tv CpCoreBufferRelease( CpPort_ts * ptsPortV, uint8_t ubBufferIdxV);
 
 
+/*!
+** \brief   Get write access to the data of a message buffer
+** \param   ptsPortV       Pointer to CAN port structure
+** \param   ubBufferIdxV   Buffer number
+** \param   ppubDataV      Pointer to the data area (8 bytes)
+**
+** \return  Error code taken from the #CpErr enumeration. If no error
+**          occurred, the function will return \c CpErr_OK.
+**
+** \see     CpCoreBufferCommit()
+**
+** This function returns a pointer to the data area of the message
+** buffer \a ubBufferIdxV, the producer of a message writes its payload
+** there directly instead of using an intermediate array. The pointer
+** stays valid until the buffer is released, the data is passed to the
+** CAN controller by CpCoreBufferCommit(). The function is only
+** available when the message buffers of the driver are located in RAM.
+** Drivers which access the message buffers through registers (e.g.
+** the C8051F550) return #CpErr_NOT_SUPPORTED, the producer writes the
+** data by CpCoreBufferSetData() then.
+*/
+CpStatus_tv CpCoreBufferReserve( CpPort_ts * ptsPortV, uint8_t ubBufferIdxV,
+                                 uint8_t ** ppubDataV);
+
+
 /*!
 ** \brief   Send message from message buffer
 ** \param   ptsPortV       Pointer to CAN port structure
@@ -537,6 +607,50 @@ CpStatus_tv CpCoreIntFunctions(  CpPort_ts * ptsPortV,
                /*@null@*/ uint8_t (* pfnErrHandler) (CpState_ts *)      );
 
 
+//-------------------------------------------------------------------
+// When the option CP_SMALL_CODE is set, the following functions
+// have no parameters. Inside the header file they must have the
+// parameter type *void* then. The functions are re-defined after-
+// wards!
+//
+#if   CP_SMALL_CODE == 1
+#define  CpCoreIntLock(CH)                   CpCoreIntLock(void)
+#define  CpCoreIntUnlock(CH)                 CpCoreIntUnlock(void)
+#endif
+/*!
+** \brief   Lock the CAN interrupt
+** \param   ptsPortV       Pointer to CAN port structure
+**
+** \see     CpCoreIntUnlock()
+**
+** The callback handlers installed by CpCoreIntFunctions() are not
+** called until CpCoreIntUnlock() is called. Data which is changed by
+** a callback handler and by the application can be accessed
+** consistently then. The lock must be short and must not be nested,
+** no other function of the driver may be called while it is held.
+** A callback handler may call the function, it has no effect there.
+*/
+void        CpCoreIntLock(CpPort_ts * ptsPortV);
+
+
+/*!
+** \brief   Unlock the CAN interrupt
+** \param   ptsPortV       Pointer to CAN port structure
+**
+** \see     CpCoreIntLock()
+*/
+void        CpCoreIntUnlock(CpPort_ts * ptsPortV);
+//-------------------------------------------------------------------
+// Re-define the functions for proper compilation.
+//
+#if   CP_SMALL_CODE == 1
+#undef   CpCoreIntLock
+#undef   CpCoreIntUnlock
+#define  CpCoreIntLock(CH)                   CpCoreIntLock()
+#define  CpCoreIntUnlock(CH)                 CpCoreIntUnlock()
+#endif
+
+
 /*!
 ** \brief   Read a CAN message from controller
 ** \param   ptsPortV       Pointer to CAN port structure
@@ -547,6 +661,11 @@ CpStatus_tv CpCoreIntFunctions(  CpPort_ts * ptsPortV,
 **          occurred, the function will return \c CpErr_OK.
 **
 ** This function reads the receive queue from a CAN controller.
+** Drivers with a software receive FIFO (#CP_FIFO_RCV_SIZE) return
+** the data of the message read last by CpCoreBufferGetData() and
+** CpCoreBufferGetDlc() for its buffer, until the next call of this
+** function. A call with \a pulBufferSizeV pointing to 0 releases the
+** message without reading a new one.
 */
 CpStatus_tv CpCoreMsgRead( CpPort_ts * ptsPortV, CpCanMsg_ts * ptsBufferV,
                            uint32_t * pulBufferSizeV);
@@ -438,7 +438,7 @@ void  CpMsgSetTime(CpCanMsg_ts * ptsCanMsgV, CpTime_ts * ptsTimeV);
 
 #define  CpMsgSetExtId(MSG_PTR, VAL)                              \
          do {                                                     \
-            (MSG_PTR)->tuMsgId.ulExt = VAL & CP_MASK_EXT_FRAME;   \
+            (MSG_PTR)->tuMsgId.ulExt = (VAL) & CP_MASK_EXT_FRAME; \
             (MSG_PTR)->ubMsgCtrl |= CP_MASK_EXT_BIT;              \
          } while(0)
 
@@ -454,7 +454,7 @@ void  CpMsgSetTime(CpCanMsg_ts * ptsCanMsgV, CpTime_ts * ptsTimeV);
 
 #define  CpMsgSetStdId(MSG_PTR, VAL)                              \
          do {                                                     \
-            (MSG_PTR)->tuMsgId.uwStd = VAL & CP_MASK_STD_FRAME;   \
+            (MSG_PTR)->tuMsgId.uwStd = (VAL) & CP_MASK_STD_FRAME; \
             (MSG_PTR)->ubMsgCtrl &= ~CP_MASK_EXT_BIT;             \
          } while(0)
 
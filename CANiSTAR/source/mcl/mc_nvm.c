@@ -55,16 +55,107 @@
 #define  MC_NVM_ADDR_MAX      0xFF
 
 
+//-------------------------------------------------------------------
+// McNvmBuildChecksum() stores the intermediate checksum value every
+// MC_NVM_CHECKSUM_STEP words. McNvmWrite() invalidates only the
+// values behind the first changed word, so the next checksum
+// calculation restarts there instead of at the start address.
+// A value of 0 disables the cache.
+//
+#define  MC_NVM_CHECKSUM_STEP 8
+
+
+//-------------------------------------------------------------------
+// The data is stored in a journal inside MC_NVM_FLASH_PAGES pages of
+// the program flash, starting at MC_NVM_FLASH_BASE. A page holds a
+// header, an image of the complete memory and a log of the records
+// appended by McNvmWrite(). When the log is full the image is copied
+// to the next page (compaction), so the erase cycles are spread over
+// all pages. The header is completed as the last step of a
+// compaction, the previous page stays valid until then.
+//
+#ifndef  MC_NVM_FLASH_BASE
+#define  MC_NVM_FLASH_BASE    0x7400
+#endif
+
+#ifndef  MC_NVM_FLASH_PAGES
+#define  MC_NVM_FLASH_PAGES   2
+#endif
+
+//-------------------------------------------------------------------
+// maximum number of data bytes inside one log record
+//
+#define  MC_NVM_REC_MAX       16
+
+//-------------------------------------------------------------------
+// The former driver wrote the memory byte by byte to the flash at
+// MC_NVM_LEGACY_BASE. If no journal page is found, McNvmLoad() takes
+// these bytes as the image of the first page (one-time import). The
+// old area is not erased, the journal page replaces it from then on.
+// A value of 0 for MC_NVM_LEGACY_IMPORT disables the import.
+//
+#ifndef  MC_NVM_LEGACY_IMPORT
+#define  MC_NVM_LEGACY_IMPORT 1
+#endif
+
+#ifndef  MC_NVM_LEGACY_BASE
+#define  MC_NVM_LEGACY_BASE   0x0000
+#endif
+
+
 /*----------------------------------------------------------------------------*\
 ** Include files                                                              **
 **                                                                            **
 \*----------------------------------------------------------------------------*/
 
 #include "mc_nvm.h"
+#if MC_TARGET == MC_OS_LINUX
+#include "linux_flash.h"
+#else
 #include <SI_C8051F550_Defs.h>
 #include <SI_C8051F550_Register_Enums.h>
 #include "F560_FlashPrimitives.h"
 #include "F560_FlashUtils.h"
+#endif
+
+
+//-------------------------------------------------------------------
+// layout of a flash page
+//
+#define  NVM_PAGE_SEQ         0     // sequence number (2 bytes)
+#define  NVM_PAGE_MAGIC       3     // marks a valid page
+#define  NVM_PAGE_IMAGE       4     // image of the memory
+#define  NVM_PAGE_LOG         (NVM_PAGE_IMAGE + MC_NVM_ADDR_MAX + 1)
+
+#define  NVM_PAGE_ADDR(PAGE)  ((FLADDR) (MC_NVM_FLASH_BASE + \
+                                         (PAGE) * FLASH_PAGESIZE))
+#define  NVM_PAGE_NONE        0xFF
+
+#define  NVM_MAGIC            0xA5
+
+//-------------------------------------------------------------------
+// a log record holds the address (MSB first), the number of data
+// bytes, the data and a commit byte which is written last
+//
+#define  NVM_REC_HEAD         3
+#define  NVM_REC_SIZE(DATA)   (NVM_REC_HEAD + (DATA) + 1)
+#define  NVM_REC_COMMIT       0x00
+
+
+#if MC_NVM_FLASH_PAGES < 2
+#error  MC_NVM_FLASH_PAGES must be 2 or more
+#endif
+
+#if (NVM_PAGE_LOG + NVM_REC_SIZE(MC_NVM_REC_MAX)) > FLASH_PAGESIZE
+#error  MC_NVM_ADDR_MAX is too big for one flash page
+#endif
+
+#if (MC_NVM_LEGACY_IMPORT > 0) && \
+    ((MC_NVM_LEGACY_BASE + MC_NVM_ADDR_MAX) >= MC_NVM_FLASH_BASE) && \
+    (MC_NVM_LEGACY_BASE < \
+                     (MC_NVM_FLASH_BASE + MC_NVM_FLASH_PAGES * FLASH_PAGESIZE))
+#error  MC_NVM_LEGACY_BASE overlaps the journal pages
+#endif
 
 
 
@@ -75,6 +166,29 @@
 
 static Status_tv  tvMcNvmStatusS;           // status of EEPROM
 
+static uint8_t    aubMcNvmImageS[MC_NVM_ADDR_MAX + 1];   // memory data
+static uint16_t   uwMcNvmLogPosS;           // free position inside page
+static uint16_t   uwMcNvmSeqS;              // sequence number of page
+static uint8_t    ubMcNvmPageS;             // active page
+static uint8_t    ubMcNvmLoadS;             // image is loaded
+
+#if MC_NVM_CHECKSUM_STEP > 0
+#define  MC_NVM_CHECKSUM_POINTS  (((MC_NVM_ADDR_MAX + 1) / \
+                                   (2 * MC_NVM_CHECKSUM_STEP)) + 1)
+
+static uint16_t   auwMcNvmChecksumS[MC_NVM_CHECKSUM_POINTS];
+static NvmAddr_tv tvMcNvmChecksumStartS;    // start address of cache
+static uint8_t    ubMcNvmChecksumValidS;    // number of valid values
+#endif
+
+
+//-------------------------------------------------------------------
+// declaration of internal functions
+//
+static uint8_t    McNvmAppend(NvmAddr_tv tvAddressV, uint8_t ubSizeV);
+static uint8_t    McNvmCompact(void);
+static void       McNvmLoad(void);
+
 
 
 /*----------------------------------------------------------------------------*\
@@ -83,6 +197,54 @@ static Status_tv  tvMcNvmStatusS;           // status of EEPROM
 \*----------------------------------------------------------------------------*/
 
 
+//----------------------------------------------------------------------------//
+// McNvmAppend()                                                              //
+// append ubSizeV bytes of the image to the log of the active page            //
+//----------------------------------------------------------------------------//
+static uint8_t McNvmAppend(NvmAddr_tv tvAddressV, uint8_t ubSizeV)
+{
+   FLADDR   tvPosT;
+   uint8_t  ubCountT;
+   uint8_t  ubDoneT;
+
+   //----------------------------------------------------------------
+   // a full log (or a log with a broken record) is replaced by a
+   // new page, the image already contains the new data
+   //
+   if((ubMcNvmPageS == NVM_PAGE_NONE) ||
+      (uwMcNvmLogPosS + NVM_REC_SIZE(ubSizeV) > FLASH_PAGESIZE))
+   {
+      return(McNvmCompact());
+   }
+
+   tvPosT  = NVM_PAGE_ADDR(ubMcNvmPageS) + uwMcNvmLogPosS;
+   uwMcNvmLogPosS += NVM_REC_SIZE(ubSizeV);
+
+   ubDoneT = FLASH_ByteWrite(tvPosT++, (uint8_t) (tvAddressV >> 8));
+   ubDoneT&= FLASH_ByteWrite(tvPosT++, (uint8_t) (tvAddressV));
+   ubDoneT&= FLASH_ByteWrite(tvPosT++, ubSizeV);
+   for(ubCountT = 0; ubCountT < ubSizeV; ubCountT++)
+   {
+      ubDoneT &= FLASH_ByteWrite(tvPosT++, aubMcNvmImageS[tvAddressV++]);
+   }
+
+   //----------------------------------------------------------------
+   // the record is valid after the commit byte has been written
+   //
+   if(ubDoneT)
+   {
+      ubDoneT = FLASH_ByteWrite(tvPosT, NVM_REC_COMMIT);
+   }
+
+   if(ubDoneT == 0)
+   {
+      uwMcNvmLogPosS = FLASH_PAGESIZE;
+   }
+
+   return(ubDoneT);
+}
+
+
 //----------------------------------------------------------------------------//
 // McNvmBuildChecksum()                                                       //
 // Build checksum over given address range                                    //
@@ -92,6 +254,10 @@ uint16_t  McNvmBuildChecksum( NvmAddr_tv tvStartAddressV,
 {
    register uint16_t  uwChecksumT = 0;
    uint16_t           uwValueT    = 0;
+   #if MC_NVM_CHECKSUM_STEP > 0
+   NvmSize_tv         tvWordT;
+   uint8_t            ubPointT;
+   #endif
 
 
    //----------------------------------------------------------------
@@ -110,6 +276,31 @@ uint16_t  McNvmBuildChecksum( NvmAddr_tv tvStartAddressV,
    // the start address must be an even address
    //
    tvDataCountV = tvDataCountV >> 1;
+
+   #if MC_NVM_CHECKSUM_STEP > 0
+   //----------------------------------------------------------------
+   // the cached values are only valid for the same start address,
+   // continue behind the last valid value inside the range
+   //
+   if((tvStartAddressV != tvMcNvmChecksumStartS) ||
+      (ubMcNvmChecksumValidS == 0))
+   {
+      tvMcNvmChecksumStartS  = tvStartAddressV;
+      auwMcNvmChecksumS[0]   = 0;
+      ubMcNvmChecksumValidS  = 1;
+   }
+
+   ubPointT = ubMcNvmChecksumValidS - 1;
+   if(ubPointT > (tvDataCountV / MC_NVM_CHECKSUM_STEP))
+   {
+      ubPointT = tvDataCountV / MC_NVM_CHECKSUM_STEP;
+   }
+   tvWordT          = ubPointT * MC_NVM_CHECKSUM_STEP;
+   uwChecksumT      = auwMcNvmChecksumS[ubPointT];
+   tvStartAddressV  = tvStartAddressV + (tvWordT << 1);
+   tvDataCountV     = tvDataCountV - tvWordT;
+   #endif
+
    while(tvDataCountV)
    {
       McNvmRead(tvStartAddressV, &uwValueT, 2);
@@ -117,6 +308,23 @@ uint16_t  McNvmBuildChecksum( NvmAddr_tv tvStartAddressV,
       uwChecksumT = uwChecksumT + 5;
       tvStartAddressV = tvStartAddressV + 2;
       tvDataCountV--;
+
+      #if MC_NVM_CHECKSUM_STEP > 0
+      //--------------------------------------------------------
+      // store the checksum of all words in front of a step
+      //
+      tvWordT++;
+      if(((tvWordT % MC_NVM_CHECKSUM_STEP) == 0) &&
+         ((tvWordT / MC_NVM_CHECKSUM_STEP) < MC_NVM_CHECKSUM_POINTS))
+      {
+         ubPointT = tvWordT / MC_NVM_CHECKSUM_STEP;
+         auwMcNvmChecksumS[ubPointT] = uwChecksumT;
+         if(ubPointT >= ubMcNvmChecksumValidS)
+         {
+            ubMcNvmChecksumValidS = ubPointT + 1;
+         }
+      }
+      #endif
    }
 
    //----------------------------------------------------------------
@@ -130,16 +338,115 @@ uint16_t  McNvmBuildChecksum( NvmAddr_tv tvStartAddressV,
 
 
 
+//----------------------------------------------------------------------------//
+// McNvmCompact()                                                             //
+// write the image to the next page                                           //
+//----------------------------------------------------------------------------//
+static uint8_t McNvmCompact(void)
+{
+   FLADDR      tvPageT;
+   NvmSize_tv  tvCountT;
+   uint16_t    uwSeqT;
+   uint8_t     ubPageT;
+   uint8_t     ubDoneT;
+
+   //----------------------------------------------------------------
+   // the pages are used in a ring
+   //
+   ubPageT = 0;
+   if(ubMcNvmPageS != NVM_PAGE_NONE)
+   {
+      ubPageT = ubMcNvmPageS + 1;
+      if(ubPageT >= MC_NVM_FLASH_PAGES) ubPageT = 0;
+   }
+   tvPageT = NVM_PAGE_ADDR(ubPageT);
+   uwSeqT  = uwMcNvmSeqS + 1;
+
+   if(FLASH_PageErase(tvPageT) == 0) return(0);
+
+   ubDoneT = FLASH_ByteWrite(tvPageT + NVM_PAGE_SEQ, (uint8_t) uwSeqT);
+   ubDoneT&= FLASH_ByteWrite(tvPageT + NVM_PAGE_SEQ + 1,
+                             (uint8_t) (uwSeqT >> 8));
+
+   //----------------------------------------------------------------
+   // erased bytes have the value 0xFF already
+   //
+   for(tvCountT = 0; tvCountT <= MC_NVM_ADDR_MAX; tvCountT++)
+   {
+      if(aubMcNvmImageS[tvCountT] != 0xFF)
+      {
+         ubDoneT &= FLASH_ByteWrite(tvPageT + NVM_PAGE_IMAGE + tvCountT,
+                                    aubMcNvmImageS[tvCountT]);
+      }
+   }
+
+   //----------------------------------------------------------------
+   // the magic value makes the page valid, from now on it replaces
+   // the previous page
+   //
+   if(ubDoneT)
+   {
+      ubDoneT = FLASH_ByteWrite(tvPageT + NVM_PAGE_MAGIC, NVM_MAGIC);
+   }
+
+   if(ubDoneT)
+   {
+      ubMcNvmPageS   = ubPageT;
+      uwMcNvmSeqS    = uwSeqT;
+      uwMcNvmLogPosS = NVM_PAGE_LOG;
+   }
+
+   return(ubDoneT);
+}
+
+
 //----------------------------------------------------------------------------//
 // McNvmEraseDevice()                                                         //
 // Erase the complete memory                                                  //
 //----------------------------------------------------------------------------//
 Status_tv  McNvmEraseDevice(void)
 {
+   uint8_t     ubPageT;
+   NvmSize_tv  tvCountT;
+
+   #if MC_NVM_CHECKSUM_STEP > 0
+   ubMcNvmChecksumValidS = 0;
+   #endif
+
    //----------------------------------------------------------------
-   // operation success
+   // erase all pages, the next write operation starts a new page
    //
    tvMcNvmStatusS = eNVM_ERR_OK;
+   for(ubPageT = 0; ubPageT < MC_NVM_FLASH_PAGES; ubPageT++)
+   {
+      if(FLASH_PageErase(NVM_PAGE_ADDR(ubPageT)) == 0)
+      {
+         tvMcNvmStatusS = -eNVM_ERR_ERASE;
+      }
+   }
+
+   for(tvCountT = 0; tvCountT <= MC_NVM_ADDR_MAX; tvCountT++)
+   {
+      aubMcNvmImageS[tvCountT] = 0xFF;
+   }
+   ubMcNvmPageS   = NVM_PAGE_NONE;
+   uwMcNvmLogPosS = FLASH_PAGESIZE;
+   ubMcNvmLoadS   = 1;
+
+   #if MC_NVM_LEGACY_IMPORT > 0
+   //----------------------------------------------------------------
+   // an empty page marks the memory as erased, the data of the
+   // former driver is not imported again
+   //
+   if(McNvmCompact() == 0)
+   {
+      tvMcNvmStatusS = -eNVM_ERR_ERASE;
+   }
+   #endif
+
+   //----------------------------------------------------------------
+   // operation success
+   //
 
    return(tvMcNvmStatusS);
 }
@@ -188,9 +495,137 @@ Status_tv  McNvmInit(void)
    //
    tvMcNvmStatusS = eNVM_ERR_OK;
 
+   //----------------------------------------------------------------
+   // read the image and the log from flash
+   //
+   McNvmLoad();
+
    return(tvMcNvmStatusS);
 }
 
+//----------------------------------------------------------------------------//
+// McNvmLoad()                                                                //
+// read the image of the newest page and apply the log                        //
+//----------------------------------------------------------------------------//
+static void McNvmLoad(void)
+{
+   FLADDR      tvPageT;
+   NvmAddr_tv  tvAddressT;
+   NvmSize_tv  tvCountT;
+   uint16_t    uwSeqT;
+   uint16_t    uwPosT;
+   uint8_t     ubPageT;
+   uint8_t     ubSizeT;
+   #if MC_NVM_LEGACY_IMPORT > 0
+   uint8_t     ubImportT;
+   #endif
+
+   //----------------------------------------------------------------
+   // search the valid page with the highest sequence number
+   //
+   ubMcNvmPageS = NVM_PAGE_NONE;
+   for(ubPageT = 0; ubPageT < MC_NVM_FLASH_PAGES; ubPageT++)
+   {
+      tvPageT = NVM_PAGE_ADDR(ubPageT);
+      if(FLASH_ByteRead(tvPageT + NVM_PAGE_MAGIC) != NVM_MAGIC) continue;
+
+      uwSeqT = FLASH_ByteRead(tvPageT + NVM_PAGE_SEQ + 1);
+      uwSeqT = (uwSeqT << 8) | FLASH_ByteRead(tvPageT + NVM_PAGE_SEQ);
+      if((ubMcNvmPageS == NVM_PAGE_NONE) ||
+         ((int16_t) (uwSeqT - uwMcNvmSeqS) > 0))
+      {
+         ubMcNvmPageS = ubPageT;
+         uwMcNvmSeqS  = uwSeqT;
+      }
+   }
+
+   ubMcNvmLoadS = 1;
+
+   //----------------------------------------------------------------
+   // nothing stored yet, the first write operation starts a page
+   //
+   if(ubMcNvmPageS == NVM_PAGE_NONE)
+   {
+      uwMcNvmSeqS    = 0;
+      uwMcNvmLogPosS = FLASH_PAGESIZE;
+
+      #if MC_NVM_LEGACY_IMPORT > 0
+      //--------------------------------------------------------
+      // one-time import of the data of the former driver, it is
+      // written as the first page; if this fails the import is
+      // repeated with the next start
+      //
+      ubImportT = 0;
+      for(tvCountT = 0; tvCountT <= MC_NVM_ADDR_MAX; tvCountT++)
+      {
+         aubMcNvmImageS[tvCountT] = FLASH_ByteRead(MC_NVM_LEGACY_BASE +
+                                                   tvCountT);
+         if(aubMcNvmImageS[tvCountT] != 0xFF) ubImportT = 1;
+      }
+      if(ubImportT) McNvmCompact();
+      #else
+      for(tvCountT = 0; tvCountT <= MC_NVM_ADDR_MAX; tvCountT++)
+      {
+         aubMcNvmImageS[tvCountT] = 0xFF;
+      }
+      #endif
+
+      #if MC_NVM_CHECKSUM_STEP > 0
+      ubMcNvmChecksumValidS = 0;
+      #endif
+      return;
+   }
+
+   tvPageT = NVM_PAGE_ADDR(ubMcNvmPageS);
+   for(tvCountT = 0; tvCountT <= MC_NVM_ADDR_MAX; tvCountT++)
+   {
+      aubMcNvmImageS[tvCountT] = FLASH_ByteRead(tvPageT + NVM_PAGE_IMAGE +
+                                                tvCountT);
+   }
+
+   //----------------------------------------------------------------
+   // apply all complete records, the log ends at the first
+   // free location
+   //
+   uwPosT = NVM_PAGE_LOG;
+   while(uwPosT + NVM_REC_SIZE(1) <= FLASH_PAGESIZE)
+   {
+      tvAddressT = FLASH_ByteRead(tvPageT + uwPosT);
+      tvAddressT = (tvAddressT << 8) | FLASH_ByteRead(tvPageT + uwPosT + 1);
+      ubSizeT    = FLASH_ByteRead(tvPageT + uwPosT + 2);
+
+      if((tvAddressT == 0xFFFF) && (ubSizeT == 0xFF)) break;
+
+      //--------------------------------------------------------
+      // a record which has been interrupted by a power fail
+      // ends the log, the next write starts a new page
+      //
+      if((ubSizeT == 0) || (ubSizeT > MC_NVM_REC_MAX) ||
+         (tvAddressT + ubSizeT > MC_NVM_ADDR_MAX + 1) ||
+         (uwPosT + NVM_REC_SIZE(ubSizeT) > FLASH_PAGESIZE) ||
+         (FLASH_ByteRead(tvPageT + uwPosT + NVM_REC_HEAD + ubSizeT) !=
+                                                         NVM_REC_COMMIT))
+      {
+         uwPosT = FLASH_PAGESIZE;
+         break;
+      }
+
+      for(tvCountT = 0; tvCountT < ubSizeT; tvCountT++)
+      {
+         aubMcNvmImageS[tvAddressT + tvCountT] =
+               FLASH_ByteRead(tvPageT + uwPosT + NVM_REC_HEAD + tvCountT);
+      }
+      uwPosT += NVM_REC_SIZE(ubSizeT);
+   }
+
+   uwMcNvmLogPosS = uwPosT;
+
+   #if MC_NVM_CHECKSUM_STEP > 0
+   ubMcNvmChecksumValidS = 0;
+   #endif
+}
+
+
 //----------------------------------------------------------------------------//
 // McNvmRead()                                                                //
 // read tvSizeV bytes from the supplied address                               //
@@ -209,15 +644,16 @@ Status_tv McNvmRead(NvmAddr_tv tvAddressV, void * pvdDataV, NvmSize_tv tvSizeV)
    }
 
    //----------------------------------------------------------------
-   // read value from EEPROM
+   // read value from the image of the memory
    //
    //
+   if(ubMcNvmLoadS == 0) McNvmLoad();
+
    pubDataT = pvdDataV;
    while(tvSizeV)
    {
-	   (*pubDataT) = FLASH_ByteRead (tvAddressV);
-
-//	   (*pubDataT) = 0x00;  // set to 0x00 in sample code
+      (*pubDataT) = aubMcNvmImageS[tvAddressV];
+      tvAddressV++;
       pubDataT++;
       tvSizeV--;
    }
@@ -241,6 +677,13 @@ Status_tv McNvmWrite(NvmAddr_tv tvAddressV, void * pvdDataV,
 {
    uint8_t *pubDataT;
    uint16_t tvAddressT = tvAddressV;
+   uint16_t tvStartT;
+   uint8_t  ubCountT;
+   uint8_t  ubSizeT;
+   uint8_t  ubFailT = 0;
+   #if MC_NVM_CHECKSUM_STEP > 0
+   NvmSize_tv tvWordT;
+   #endif
 
    //----------------------------------------------------------------
    // check address value
@@ -253,25 +696,75 @@ Status_tv McNvmWrite(NvmAddr_tv tvAddressV, void * pvdDataV,
 
 
    //----------------------------------------------------------------
-   // write data to EEPROM
+   // write data to the image and append the changes to the log
    //
    //
+   if(ubMcNvmLoadS == 0) McNvmLoad();
+
    pubDataT = pvdDataV;
    while(tvSizeV)
    {
       //---------------------------------------------------
+      // bytes which do not change are not written, they
+      // also keep the checksum cache valid
+      //
+      if(aubMcNvmImageS[tvAddressT] == *pubDataT)
+      {
+         tvAddressT++;
+         pubDataT++;
+         tvSizeV--;
+         continue;
+      }
+
       //---------------------------------------------------
-	  // read data from EEPROM here
-	  //
+      // one record starts at a changed byte and ends at the
+      // last changed byte within MC_NVM_REC_MAX bytes
+      //
+      tvStartT = tvAddressT;
+      ubCountT = 0;
+      ubSizeT  = 0;
+      while(tvSizeV && (ubCountT < MC_NVM_REC_MAX))
+      {
+         if(aubMcNvmImageS[tvAddressT] != *pubDataT)
+         {
+            aubMcNvmImageS[tvAddressT] = *pubDataT;
+            ubSizeT = ubCountT + 1;
+
+            #if MC_NVM_CHECKSUM_STEP > 0
+            if(tvAddressT >= tvMcNvmChecksumStartS)
+            {
+               tvWordT = (tvAddressT - tvMcNvmChecksumStartS) >> 1;
+               if((tvWordT / MC_NVM_CHECKSUM_STEP) < ubMcNvmChecksumValidS)
+               {
+                  ubMcNvmChecksumValidS = (tvWordT / MC_NVM_CHECKSUM_STEP) + 1;
+               }
+            }
+            #endif
+         }
+
+         tvAddressT++;
+         pubDataT++;
+         tvSizeV--;
+         ubCountT++;
+      }
+
+      if(McNvmAppend(tvStartT, ubSizeT) == 0)
+      {
+         ubFailT = 1;
+      }
+   }
 
-	  FLASH_ByteWrite( tvAddressT,* pubDataT);
 
-	  tvAddressT++;
-	  pubDataT++;
-      tvSizeV--;
+   //----------------------------------------------------------------
+   // the image holds the new data even if the flash write failed,
+   // it is stored with the next successful write operation
+   //
+   if(ubFailT)
+   {
+      tvMcNvmStatusS = -eNVM_ERR_WRITE;
+      return(tvMcNvmStatusS);
    }
 
-
    //--- operation success ------------------------------------------
    tvMcNvmStatusS = eNVM_ERR_OK;
 
@@ -389,7 +389,9 @@
 //-------------------------------------------------------------------//
 #define  MC_OS_LINUX                                  (0x80020000)
 
+#ifndef  MC_TARGET
 #define MC_TARGET MC_MCU_C8051F550
+#endif
 
 #endif   /* MC_TARGET_DEFS_   */
 
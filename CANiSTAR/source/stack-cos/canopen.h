@@ -656,8 +656,15 @@ enum LssCmd_e {
    eLSS_CMD_MODE_SEL_RESPONSE,
 
    eLSS_CMD_IDENT_SLAVE_NCFG_REQ    = 76,
+
+   /*! Identify slave response (4Fh - 79dec)             */
+   eLSS_CMD_IDENT_SLAVE_RES         = 79,
+
    eLSS_CMD_IDENT_SLAVE_NCFG_RES    = 80,
 
+   /*! LSS Fastscan command (51h - 81dec)                */
+   eLSS_CMD_FASTSCAN                = 81,
+
    eLSS_CMD_INQUIRE_VENDOR_ID       = 90,
    eLSS_CMD_INQUIRE_PRODUCT_CODE,
    eLSS_CMD_INQUIRE_REVISION_NUM,
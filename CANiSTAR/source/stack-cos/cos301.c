@@ -56,6 +56,7 @@
 ** Variables of module                                                        **
 **                                                                            **
 \*----------------------------------------------------------------------------*/
+#if COS_INSTANCE_MAX == 1
 uint8_t     ubIdx1001_ErrorRegisterG;     // error register
 uint32_t    ulIdx1002_StatusRegisterG;    // status register
 
@@ -63,6 +64,7 @@ uint32_t    ulIdx1002_StatusRegisterG;    // status register
 uint8_t     ubCos301ParmSaveG;            // requested save operation
 uint8_t     ubCos301ParmLoadG;            // requested load operation
 #endif
+#endif
 
 
 #if COS_DICT_OBJ_1016 != 0
@@ -71,8 +73,13 @@ extern uint16_t   auwCosNmtHbConsTimeG[];
 #endif
 
 #if COS_DICT_OBJ_1020 == 1
+#if COS_INSTANCE_MAX == 1
 static uint32_t   ulIdx1020_DateS;
 static uint32_t   ulIdx1020_TimeS;
+#else
+#define  ulIdx1020_DateS      (ptsCosInstG->ulIdx1020_Date)
+#define  ulIdx1020_TimeS      (ptsCosInstG->ulIdx1020_Time)
+#endif
 #endif
 
 #if COS_DICT_OBJ_1021 > 0
@@ -110,6 +117,38 @@ void Cos301_ClearVerifyConfiguration(void)
 #endif
 
 
+//----------------------------------------------------------------------------//
+// Cos301_Idx1001()                                                           //
+// error register of the selected instance                                    //
+//----------------------------------------------------------------------------//
+#if COS_INSTANCE_MAX > 1
+uint8_t Cos301_Idx1001(uint8_t ubSubIndexV, uint8_t ubReqCodeV)
+{
+   if(ubReqCodeV != eSDO_READ_REQ) return(eCosSdo_ERR_ACCESS_RO);
+   if(ubSubIndexV != 0)            return(eCosSdo_ERR_NO_SUB_INDEX);
+
+   CosSdoCopyValueToMessage( (void *)&ubIdx1001_ErrorRegisterG,
+                              CoDT_UNSIGNED8);
+   return(eCosSdo_READ1_OK);
+}
+
+
+//----------------------------------------------------------------------------//
+// Cos301_Idx1002()                                                           //
+// status register of the selected instance                                   //
+//----------------------------------------------------------------------------//
+uint8_t Cos301_Idx1002(uint8_t ubSubIndexV, uint8_t ubReqCodeV)
+{
+   if(ubReqCodeV != eSDO_READ_REQ) return(eCosSdo_ERR_ACCESS_RO);
+   if(ubSubIndexV != 0)            return(eCosSdo_ERR_NO_SUB_INDEX);
+
+   CosSdoCopyValueToMessage( (void *)&ulIdx1002_StatusRegisterG,
+                              CoDT_UNSIGNED32);
+   return(eCosSdo_READ4_OK);
+}
+#endif
+
+
 //----------------------------------------------------------------------------//
 // Cos301_Idx1010()                                                           //
 // store parameters                                                           //
@@ -632,6 +671,9 @@ void Cos301_ParmInit(void)
       auwCosNmtHbConsTimeG[ubObjCntT] = 0x0000;
       aubCosNmtHbConsNodeG[ubObjCntT] = 0x00;
    }
+   #if COS_NMT_HBC_MERGE > 0
+   CosMgrHbcFilter();
+   #endif
    #endif
 
 
@@ -845,6 +887,9 @@ uint8_t  Cos301_ParmLoad(void)
       uwHbConsTimeT = CosTmrCalcTime(uwHbConsTimeT);
       CosNmtSetHeartbeatCons(ubObjCntT, ubHbConsNodeT, uwHbConsTimeT);
    }
+   #if COS_NMT_HBC_MERGE > 0
+   CosMgrHbcFilter();
+   #endif
    #endif
 
 
@@ -89,7 +89,9 @@ extern uint32_t ulIdx1000_DeviceTypeC;
 ** The variable ubIdx1001_ErrorRegisterG holds the error status of the
 ** device. It must be set by the application program.
 */
+#if COS_INSTANCE_MAX == 1
 extern uint8_t ubIdx1001_ErrorRegisterG;
+#endif
 
 
 /*!
@@ -99,7 +101,9 @@ extern uint8_t ubIdx1001_ErrorRegisterG;
 ** The variable ulIdx1002_StatusRegisterG holds a manufacturer
 ** specific value (32 bit). It must be set by the application program.
 */
+#if COS_INSTANCE_MAX == 1
 extern uint32_t ulIdx1002_StatusRegisterG;
+#endif
 
 
 /*!
@@ -188,6 +192,33 @@ extern uint8_t   ubIdx1022_EdsTypeC;
 
 void  Cos301_ClearVerifyConfiguration(void);
 
+//-------------------------------------------------------------------
+/*!
+** \brief   Index 1001 - Error register
+** \param   ubSubIndexV    sub-index
+** \param   ubReqCodeV     read / write access
+** \return  SDO response code (enumeration #CosSdo_e)
+**
+** Read access to #ubIdx1001_ErrorRegisterG of the selected instance.
+** The function is only available for #COS_INSTANCE_MAX > 1, where the
+** address of the variable depends on the instance.
+*/
+uint8_t  Cos301_Idx1001(uint8_t ubSubIndexV, uint8_t ubReqCodeV);
+
+
+//-------------------------------------------------------------------
+/*!
+** \brief   Index 1002 - Manufacturer status register
+** \param   ubSubIndexV    sub-index
+** \param   ubReqCodeV     read / write access
+** \return  SDO response code (enumeration #CosSdo_e)
+**
+** Read access to #ulIdx1002_StatusRegisterG of the selected instance.
+** The function is only available for #COS_INSTANCE_MAX > 1.
+*/
+uint8_t  Cos301_Idx1002(uint8_t ubSubIndexV, uint8_t ubReqCodeV);
+
+
 //-------------------------------------------------------------------
 /*!
 ** \brief   Index 1010 - Store Parameters
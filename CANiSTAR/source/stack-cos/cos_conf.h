@@ -428,7 +428,9 @@
 ** not included. A value of 1 means they are included.
 **
 */
+#ifndef  COS_DICT_MAN
 #define  COS_DICT_MAN                  0
+#endif
 
 
 //-------------------------------------------------------------------
@@ -442,7 +444,32 @@
 ** means the fast search algorithm is used.
 **
 */
+#ifndef  COS_DICT_SEARCH_FAST
 #define  COS_DICT_SEARCH_FAST          1
+#endif
+
+
+//-------------------------------------------------------------------
+/*!
+** \def     COS_DICT_SEARCH_HASH
+** \brief   Use hash table for dictionary search
+**
+** This symbol defines the number of slots of a hash table which
+** holds the position of the first entry of every index inside the
+** dictionary. Collisions are resolved by linear probing, so the
+** search time grows with the fill level of the table. The table is
+** built by CosDictInit() during CosMgrInit() and requires 2 byte RAM
+** per slot. The sub-index is then found by direct addressing inside
+** the entries of the index. The value must be a power of 2 and
+** should be at least twice the number of indices in the dictionary.
+** Indices which do not fit into the table are searched linearly.
+** A value of 0 disables the hash table, the search method is then
+** selected by #COS_DICT_SEARCH_FAST.
+**
+*/
+#ifndef  COS_DICT_SEARCH_HASH
+#define  COS_DICT_SEARCH_HASH          0
+#endif
 
 
 //-------------------------------------------------------------------
@@ -557,7 +584,9 @@
 ** The value must be in the range from 0 to 4.
 **
 */
+#ifndef  COS_DICT_OBJ_1010
 #define  COS_DICT_OBJ_1010             0
+#endif
 
 
 //-------------------------------------------------------------------
@@ -572,7 +601,9 @@
 ** The value must be in the range from 0 to 4.
 **
 */
+#ifndef  COS_DICT_OBJ_1011
 #define  COS_DICT_OBJ_1011             0
+#endif
 
 
 //-------------------------------------------------------------------
@@ -613,10 +644,13 @@
 ** \brief   Emergency message
 **
 ** The symbol defines if the object 1014h is supported and how
-** many emergency messages can be queued.
+** many emergency messages can be queued. The queue is sorted by
+** the priority of the error code, see CosEmcySend().
 **
 */
+#ifndef  COS_DICT_OBJ_1014
 #define  COS_DICT_OBJ_1014             1
+#endif
 
 
 //-------------------------------------------------------------------
@@ -642,10 +676,62 @@
 ** many sub-indices are used. A value of 0 means the object is
 ** not supported, i.e. the device has no consumer heartbeat.
 ** A value greater 0 denotes the highest supported sub-index.
-** The maximum number of entries is limited to 4.
+** The maximum number of entries is limited to 4, unless the
+** consumers share one message buffer (#COS_NMT_HBC_MERGE).
 **
 */
+#ifndef  COS_DICT_OBJ_1016
 #define  COS_DICT_OBJ_1016             0
+#endif
+
+
+//-------------------------------------------------------------------
+/*!
+** \def     COS_NMT_HBC_MERGE
+** \brief   Shared message buffer for heartbeat consumers
+**
+** By default every entry of index 1016h occupies its own message
+** buffer with an exact identifier match. With this option all
+** heartbeat consumers use the single buffer eCosBuf_NMT_HBC. Its
+** acceptance mask is calculated by CosMgrHbcFilter() from the
+** monitored node-IDs, so the buffer only accepts identifiers that
+** share the common bits of these node-IDs. The received node-ID is
+** then assigned to the consumer entry by a table of 128 bytes, which
+** is indexed by the node-ID. This releases
+** (COS_DICT_OBJ_1016 - 1) message buffers and allows more than 4
+** consumers.
+**
+** \li   0 : one message buffer for each heartbeat consumer
+** \li   1 : one message buffer for all heartbeat consumers
+**
+*/
+#ifndef  COS_NMT_HBC_MERGE
+#define  COS_NMT_HBC_MERGE             0
+#endif
+
+
+//-------------------------------------------------------------------
+/*!
+** \def     COS_NMT_HBC_WHEEL
+** \brief   Timing wheel for heartbeat consumers
+**
+** With a shared message buffer (#COS_NMT_HBC_MERGE = 1) the timeouts
+** of all heartbeat consumers can be supervised by one hashed timing
+** wheel (cos_hbw.h) instead of one timer per consumer. The symbol
+** defines the number of slots of the wheel, it must be a power of 2.
+** Per timer tick only the consumers of one slot are checked, so the
+** run-time does not grow with the number of entries of index 1016h.
+** A consumer time up to (slots * #COS_TIMER_PERIOD) is checked
+** exactly once, when it expires.
+**
+** \li   0 : timeouts are handled by the NMT module
+** \li   8, 16, 32, 64, 128 : number of slots
+**
+*/
+#ifndef  COS_NMT_HBC_WHEEL
+#define  COS_NMT_HBC_WHEEL             0
+#endif
+
 
 //-------------------------------------------------------------------
 /*!
@@ -833,7 +919,9 @@
 ** is 127 blocks.
 **
 */
+#ifndef  COS_SDO_BLOCK
 #define  COS_SDO_BLOCK                 0
+#endif
 
 
 //-------------------------------------------------------------------
@@ -849,6 +937,26 @@
 #define  COS_SDO_CLIENT                0
 
 
+//-------------------------------------------------------------------
+/*!
+** \def     COS_SDO_STAT
+** \brief   SDO server statistic
+**
+** With a value of 1 the CANopen manager counts the SDO request and
+** response frames of the SDO server and measures the time from a
+** request until the response has been transmitted. The values can be
+** read with CosMgrSdoStatistic(). The times are measured in
+** microseconds with the high-resolution timer (McTmrHResTick()),
+** which is started by CosMgrInit().
+**
+** \li   0 : no SDO statistic
+** \li   1 : collect SDO statistic
+*/
+#ifndef  COS_SDO_STAT
+#define  COS_SDO_STAT                  0
+#endif
+
+
 /*----------------------------------------------------------------------------*\
 ** PDO Configuration Options                                                  **
 **                                                                            **
@@ -863,7 +971,9 @@
 ** CANopen slave. The number may vary between 0 (no receive PDO)
 ** and 4.
 */
+#ifndef  COS_PDO_RCV_NUMBER
 #define  COS_PDO_RCV_NUMBER            0
+#endif
 
 //-------------------------------------------------------------------
 /*!
@@ -912,7 +1022,9 @@
 ** This symbol defines if an inhibit time is supported for
 ** transmit PDOs.
 */
+#ifndef  COS_PDO_INHIBIT
 #define  COS_PDO_INHIBIT               0
+#endif
 
 
 //-------------------------------------------------------------------
@@ -939,8 +1051,38 @@
 ** \li   0 : use fixed PDO mapping
 ** \li   1 : use variable PDO mapping
 **
+** The variable PDO mapping translates each mapping into a copy plan
+** (see cos_pmap.h), so the dictionary is not searched for every PDO.
 */
+#ifndef  COS_PDO_MAPPING
 #define  COS_PDO_MAPPING               0
+#endif
+
+
+//-------------------------------------------------------------------
+/*!
+** \def     COS_PDO_SCHED
+** \brief   Transmit PDO scheduler
+**
+** With this option the module cos_psch.c decides when a transmit PDO
+** is sent, based on its transmission type (index 180xh, sub-index 2):
+** \li   0 : after the next SYNC if an application event is pending
+** \li   1 .. 240 : after every n-th SYNC
+** \li   254, 255 : on application event or event timer expiry, both
+**       limited by the inhibit time
+** <p>
+** All synchronous PDOs due for a SYNC are sampled and handed to the
+** CAN controller inside the SYNC receive callback, so they leave the
+** node directly after the SYNC message. A PDO whose previous frame
+** is still pending is queued until the transmit interrupt of that
+** frame. CosPschTmrEvent() must be called once per timer tick.
+**
+** \li   0 : transmission handled by the PDO module
+** \li   1 : transmission handled by the PDO scheduler
+*/
+#ifndef  COS_PDO_SCHED
+#define  COS_PDO_SCHED                 0
+#endif
 
 
 /*----------------------------------------------------------------------------*\
@@ -972,7 +1114,29 @@
 ** \li   1 : support LSS slave
 ** \li   2 : support LSS master
 */
+#ifndef  COS_LSS_SUPPORT
 #define  COS_LSS_SUPPORT               0
+#endif
+
+
+//-------------------------------------------------------------------
+/*!
+** \def     COS_LSS_FASTSCAN
+** \brief   Support of the LSS Fastscan service
+**
+** With LSS Fastscan the LSS master identifies the LSS address
+** (index 1018h) of an unconfigured slave by a binary search, one
+** bit per request. The LSS address need not be known in advance.
+** Only slaves in LSS waiting state without a valid node-ID
+** (value FFh) take part in the scan. The symbol requires LSS slave
+** support (#COS_LSS_SUPPORT > 0).
+**
+** \li   0 : do not support LSS Fastscan
+** \li   1 : support LSS Fastscan
+*/
+#ifndef  COS_LSS_FASTSCAN
+#define  COS_LSS_FASTSCAN              0
+#endif
 
 
 //-------------------------------------------------------------------
@@ -1008,6 +1172,42 @@
 #define  COS_BUS_EMCY                  1
 
 
+//-------------------------------------------------------------------
+/*!
+** \def     COS_EMCY_COALESCE
+** \brief   Coalesce repeated emergency messages
+**
+** With a value of 1 an emergency message which is identical to a
+** message waiting in the queue is not queued again. The last byte
+** of the manufacturer specific error field counts the repetitions,
+** so the application must not use this byte. This requires a queue
+** (#COS_DICT_OBJ_1014 > 1).
+**
+** \li   0 : queue every emergency message
+** \li   1 : coalesce repeated emergency messages
+*/
+#define  COS_EMCY_COALESCE             0
+
+
+//-------------------------------------------------------------------
+/*!
+** \def     COS_EMCY_STAT
+** \brief   Statistic of the emergency queue
+**
+** With a value of 1 the number of dropped and coalesced emergency
+** messages is counted. The values can be read from the manufacturer
+** specific object 2010h (CosEmcyStatistic()). This requires a queue
+** (#COS_DICT_OBJ_1014 > 1) and the manufacturer specific objects
+** (#COS_DICT_MAN = 1).
+**
+** \li   0 : no statistic
+** \li   1 : count dropped and coalesced emergency messages
+*/
+#ifndef  COS_EMCY_STAT
+#define  COS_EMCY_STAT                 0
+#endif
+
+
 
 
 //-------------------------------------------------------------------
@@ -1024,7 +1224,72 @@
 ** \li   0 : Run CAN message handler in Poll-Mode
 ** \li   1 : Run CAN message handler in IRQ-Mode
 */
+#ifndef  COS_MGR_INT
 #define  COS_MGR_INT                   1
+#endif
+
+
+//-------------------------------------------------------------------
+/*!
+** \def     COS_MGR_FIFO
+** \brief   Handle messages via receive FIFO
+**
+** With a value greater 0 the CAN IRQ handler only processes the
+** time critical services (NMT, SYNC, TIME, node guarding, PDO).
+** Messages of SDO, LSS and heartbeat consumer are put into the
+** receive FIFO of the CAN driver and processed by CosMgrProcess()
+** in the main loop. Every call of CosMgrProcess() drains the FIFO,
+** up to CP_FIFO_RCV_SIZE messages are processed in one call.
+** This requires the IRQ-mode (#COS_MGR_INT = 1) and a CAN driver
+** with receive FIFO (CP_FIFO_RCV_SIZE > 0).
+**
+** \li   0 : all messages are processed inside the CAN IRQ-handler
+** \li   1 : process the messages from the FIFO in the main loop
+*/
+#ifndef  COS_MGR_FIFO
+#define  COS_MGR_FIFO                  0
+#endif
+
+
+//-------------------------------------------------------------------
+/*!
+** \def     COS_MGR_STAT
+** \brief   Main loop statistic
+**
+** With a value of 1 the CANopen manager measures the duration of
+** every call of CosMgrProcess(). The values can be read with
+** CosMgrStatistic(). The time is measured in microseconds with the
+** high-resolution timer (McTmrHResTick()).
+**
+** \li   0 : no main loop statistic
+** \li   1 : collect main loop statistic
+*/
+#ifndef  COS_MGR_STAT
+#define  COS_MGR_STAT                  0
+#endif
+
+
+//-------------------------------------------------------------------
+/*!
+** \def     COS_BUS_STAT
+** \brief   Bus load and message buffer statistic
+**
+** With a value of 1 the CANopen manager counts the frames of every
+** message buffer inside the CAN callback handlers, measures the
+** jitter of the frame intervals and estimates the bus load. Only
+** frames which are sent or received by a message buffer of the node
+** are counted. The values can be read with CosMgrBusStatistic() and
+** via the manufacturer specific objects 2011h .. 2014h. The times are
+** measured in microseconds with the high-resolution timer
+** (McTmrHResTick()). The counters need 18 bytes of RAM for every
+** message buffer of the stack (#COS_BUFFER_MAX).
+**
+** \li   0 : no bus statistic
+** \li   1 : collect bus statistic
+*/
+#ifndef  COS_BUS_STAT
+#define  COS_BUS_STAT                  0
+#endif
 
 
 //-------------------------------------------------------------------
@@ -1044,6 +1309,26 @@
 #define  COS_TMR_INT                   0
 
 
+//-------------------------------------------------------------------
+/*!
+** \def     COS_INSTANCE_MAX
+** \brief   Number of CANopen slave instances in one program
+**
+** With a value greater than 1 the state of the CANopen slave is kept
+** in a separate data set for every instance (see cos_inst.h). The
+** application selects the active instance with CosInstSelect() before
+** it calls any function of the stack for that node. This mode is
+** intended for host simulations that run a complete network segment
+** inside one process.
+**
+** \li   1 : single node (default)
+** \li   n : n node instances, requires COS_MGR_INT = 1
+*/
+#ifndef  COS_INSTANCE_MAX
+#define  COS_INSTANCE_MAX              1
+#endif
+
+
 /*----------------------------------------------------------------------------*\
 ** Generation of additional symbols                                           **
 **                                                                            **
@@ -1136,10 +1421,22 @@
 #error Value for symbol COS_DICT_OBJ_1012 out of range
 #endif
 
-#if COS_DICT_OBJ_1016 > 4
+#if COS_DICT_OBJ_1016 > 4 && COS_NMT_HBC_MERGE == 0
+#error More than 4 heartbeat consumers require COS_NMT_HBC_MERGE = 1
+#endif
+
+#if COS_DICT_OBJ_1016 > 127
 #error Value for symbol COS_DICT_OBJ_1016 out of range
 #endif
 
+#if COS_NMT_HBC_WHEEL > 0 && COS_NMT_HBC_MERGE == 0
+#error COS_NMT_HBC_WHEEL requires COS_NMT_HBC_MERGE = 1
+#endif
+
+#if COS_NMT_HBC_WHEEL > 128 || (COS_NMT_HBC_WHEEL & (COS_NMT_HBC_WHEEL - 1))
+#error Value for symbol COS_NMT_HBC_WHEEL out of range
+#endif
+
 #if COS_DICT_OBJ_1029 > 4
 #error Value for symbol COS_DICT_OBJ_1029 out of range
 #endif
@@ -1156,5 +1453,41 @@
 #error LSS support requires support of object 1010h (COS_DICT_OBJ_1010 > 0)
 #endif
 
+#if COS_LSS_FASTSCAN > 0 && COS_LSS_SUPPORT == 0
+#error LSS Fastscan requires LSS support (COS_LSS_SUPPORT > 0)
+#endif
+
+#if (COS_DICT_SEARCH_HASH & (COS_DICT_SEARCH_HASH - 1)) != 0
+#error Value for symbol COS_DICT_SEARCH_HASH must be a power of 2
+#endif
+
+#if COS_MGR_FIFO > 0 && COS_MGR_INT == 0
+#error The receive FIFO (COS_MGR_FIFO > 0) requires COS_MGR_INT = 1
+#endif
+
+#if COS_MGR_FIFO > 0 && CP_FIFO_RCV_SIZE == 0
+#error The receive FIFO (COS_MGR_FIFO > 0) requires CP_FIFO_RCV_SIZE > 0
+#endif
+
+#if COS_INSTANCE_MAX > 1 && COS_MGR_INT == 0
+#error Multiple instances (COS_INSTANCE_MAX > 1) require COS_MGR_INT = 1
+#endif
+
+#if COS_INSTANCE_MAX > 127
+#error Value for symbol COS_INSTANCE_MAX out of range
+#endif
+
+#if (COS_EMCY_COALESCE > 0 || COS_EMCY_STAT > 0) && COS_DICT_OBJ_1014 < 2
+#error The EMCY queue options require a queue (COS_DICT_OBJ_1014 > 1)
+#endif
+
+#if COS_EMCY_STAT > 0 && COS_DICT_MAN == 0
+#error The EMCY statistic (COS_EMCY_STAT > 0) requires COS_DICT_MAN = 1
+#endif
+
+#if COS_DICT_OBJ_1014 > 255
+#error Value for symbol COS_DICT_OBJ_1014 out of range
+#endif
+
 #endif   //  COS_CONF_H_
 
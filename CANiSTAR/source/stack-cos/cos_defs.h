@@ -93,6 +93,41 @@
 **                                                                            **
 \*----------------------------------------------------------------------------*/
 
+//-------------------------------------------------------------------
+// number of message buffers of the optional services
+//
+#if COS_LSS_SUPPORT > 0
+#define  COS_BUF_LSS_NUMBER         2
+#else
+#define  COS_BUF_LSS_NUMBER         0
+#endif
+
+#if COS_SDO_CLIENT > 0
+#define  COS_BUF_SDOC_NUMBER        2
+#else
+#define  COS_BUF_SDOC_NUMBER        0
+#endif
+
+//-------------------------------------------------------------------
+/*!
+** \def     COS_BUF_HBC_NUMBER
+** \brief   Number of message buffers for the heartbeat consumers
+**
+** \def     COS_BUF_HBC
+** \brief   Message buffer of heartbeat consumer \a ENTRY (0 .. n-1)
+**
+** With #COS_NMT_HBC_MERGE all consumers share buffer eCosBuf_NMT_HBC.
+** Code outside of this tree, e.g. the NMT module, must use
+** COS_BUF_HBC(n) instead of eCosBuf_NMT_HBC + n: the buffers after
+** eCosBuf_NMT_HBC belong to other services in this configuration.
+*/
+#if (COS_NMT_HBC_MERGE > 0) && (COS_DICT_OBJ_1016 > 0)
+#define  COS_BUF_HBC_NUMBER         1
+#define  COS_BUF_HBC(ENTRY)         (eCosBuf_NMT_HBC)
+#else
+#define  COS_BUF_HBC_NUMBER         COS_DICT_OBJ_1016
+#define  COS_BUF_HBC(ENTRY)         (eCosBuf_NMT_HBC + (ENTRY))
+#endif
 
 
 //-------------------------------------------------------------------
@@ -157,7 +192,7 @@ enum CosBuf_e {
 
 
    /*!
-   ** Heartbeat consumer, (Buffer 8)
+   ** Heartbeat consumer, (Buffer 8), refer to #COS_BUF_HBC()
    */
    #if COS_DICT_OBJ_1016 > 0
    eCosBuf_NMT_HBC,
@@ -167,20 +202,21 @@ enum CosBuf_e {
    ** TIME producer / consumer, (Buffer 9)
    */
    #if COS_DICT_OBJ_1012 > 0
-   eCosBuf_TIME = eCosBuf_NMT_ERR + COS_DICT_OBJ_1016 + 1,
+   eCosBuf_TIME = eCosBuf_NMT_ERR + COS_BUF_HBC_NUMBER + 1,
    #endif
 
    /*!
    ** Buffer for first Receive PDO
    */
    #if COS_PDO_RCV_NUMBER > 0
-   eCosBuf_PDO1_RCV = eCosBuf_NMT_ERR + COS_DICT_OBJ_1016 + COS_DICT_OBJ_1012 + 1,
+   eCosBuf_PDO1_RCV = eCosBuf_NMT_ERR + COS_BUF_HBC_NUMBER + COS_DICT_OBJ_1012 + 1,
    #endif
 
    /*!
    ** Buffer for first Transmit PDO
    */
-   eCosBuf_PDO1_TRM = eCosBuf_NMT_ERR + COS_DICT_OBJ_1016 + COS_PDO_RCV_NUMBER + 1,
+   eCosBuf_PDO1_TRM = eCosBuf_NMT_ERR + COS_BUF_HBC_NUMBER + COS_DICT_OBJ_1012 +
+                      COS_PDO_RCV_NUMBER + 1,
 
    /*!
    ** Buffer for emergency service
@@ -189,14 +225,40 @@ enum CosBuf_e {
 
 };
 
+//-------------------------------------------------------------------
+/*!
+** \def     COS_BUFFER_MAX
+** \brief   Number of message buffers used by the stack
+**
+** The value is the index of the last buffer (eCosBuf_EMCY). It is
+** calculated from the stack configuration:
+** \li   6 buffers for NMT, SYNC, SDO (2), heartbeat producer, EMCY
+** \li   2 buffers for LSS (#COS_LSS_SUPPORT)
+** \li   2 buffers for the SDO client (#COS_SDO_CLIENT)
+** \li   #COS_BUF_HBC_NUMBER buffers for the heartbeat consumers
+** \li   1 buffer for TIME (#COS_DICT_OBJ_1012)
+** \li   one buffer for every RPDO and every TPDO
+**
+** The buffers from COS_BUFFER_MAX + 1 up to #CP_BUFFER_MAX
+** (#COS_BUFFER_FREE buffers) can be used by the application.
+*/
+#define COS_BUFFER_MAX     (6 + COS_BUF_LSS_NUMBER + COS_BUF_SDOC_NUMBER +  \
+                            COS_BUF_HBC_NUMBER + COS_DICT_OBJ_1012      +  \
+                            COS_PDO_RCV_NUMBER + COS_PDO_TRM_NUMBER)
+
+/*!
+** \def     COS_BUFFER_FREE
+** \brief   Number of message buffers left for the application
+*/
+#define COS_BUFFER_FREE    (CP_BUFFER_MAX - COS_BUFFER_MAX)
+
 //-------------------------------------------------------------------
 // Test if the buffer allocation fits in the scheme of the
 // CANpie driver. If this error occurs, more buffers are allocated
 // for the CANopen Slave stack than the CAN driver actually
 // supports. Check the CAN driver settings and / or the settings
-// of the CANopen Slave stack.
+// of the CANopen Slave stack, e.g. COS_NMT_HBC_MERGE.
 //
-#define COS_BUFFER_MAX     (6 + COS_DICT_OBJ_1016 + COS_PDO_RCV_NUMBER + COS_PDO_TRM_NUMBER)
 #if CP_BUFFER_MAX < COS_BUFFER_MAX
 #error CAN buffer overflow, check CANpie driver / Slave stack configuration
 #endif
@@ -533,4 +595,54 @@ enum CosCOB_ID_Store_e {
 
 };
 
+
+/*----------------------------------------------------------------------------*\
+** PDO copy plans (cos_pmap.c)                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------
+/*!
+** \struct  CosPmapOp_s
+** \brief   One copy operation of a plan
+*/
+struct CosPmapOp_s {
+   /*!   address of the mapped object, 0L for a dummy entry       */
+   uint8_t *   pubValue;
+
+   /*!   number of bytes                                          */
+   uint8_t     ubSize;
+
+   /*!   1 if the byte order is reversed during the copy operation,
+   **    this is set for numeric values on a big endian CPU only    */
+   uint8_t     ubSwap;
+};
+
+typedef struct CosPmapOp_s    CosPmapOp_ts;
+
+
+//-------------------------------------------------------------------
+/*!
+** \struct  CosPmap_s
+** \brief   Copy plan of one PDO
+*/
+struct CosPmap_s {
+   /*!   number of copy operations, 0 means the PDO is disabled   */
+   uint8_t        ubCount;
+
+   /*!   data length code of the PDO (sum of all sizes)           */
+   uint8_t        ubDlc;
+
+   /*!   copy operations in the order of the mapping entries      */
+   CosPmapOp_ts   atsOp[8];
+};
+
+typedef struct CosPmap_s      CosPmap_ts;
+
+
+//----------------------------------------------------------------------------//
+// instance data of the CANopen Slave (COS_INSTANCE_MAX > 1)                  //
+//----------------------------------------------------------------------------//
+#include "cos_inst.h"
+
 #endif   // COS_DEFS_H_
@@ -125,13 +125,23 @@ CPP_CONST CosDicEntry_ts aDicTableG[] = {
 
 
    //--- Index 1001, error register -----------------------
+   #if COS_INSTANCE_MAX == 1
    {  0x1001, 0x00, CoATTR_ACC_RO      ,
       CoDT_UNSIGNED8       ,  (void *) &ubIdx1001_ErrorRegisterG     },
+   #else
+   {  0x1001, 0x00, CoATTR_ACC_RO | CoATTR_FUNCTION,
+      CoDT_UNSIGNED8       , (void *) Cos301_Idx1001                 },
+   #endif
 
 
    //--- Index 1002, manufacturer status register ---------
+   #if COS_INSTANCE_MAX == 1
    {  0x1002, 0x00, CoATTR_ACC_RO      ,
       CoDT_UNSIGNED32      , (void *) &ulIdx1002_StatusRegisterG     },
+   #else
+   {  0x1002, 0x00, CoATTR_ACC_RO | CoATTR_FUNCTION,
+      CoDT_UNSIGNED32      , (void *) Cos301_Idx1002                 },
+   #endif
 
 
    //--- Index 1003, pre-defined error field --------------
@@ -424,6 +434,24 @@ CPP_CONST CosDicEntry_ts aDicTableG[] = {
 static uint16_t uwDicTableSizeS = sizeof(aDicTableG) / sizeof(CosDicEntry_ts);
 
 
+#if COS_DICT_SEARCH_HASH > 0
+//-------------------------------------------------------------------
+// hash table: position of the first entry of an index inside
+// aDicTableG, the value 0 (dummy entry) marks an empty slot
+//
+static uint16_t auwDicHashS[COS_DICT_SEARCH_HASH];
+
+//-------------------------------------------------------------------
+// position of the first entry which did not fit into the hash table,
+// the value 0 means that all indices are stored
+//
+static uint16_t uwDicHashOverS;
+
+#define  DICT_HASH_MASK             (COS_DICT_SEARCH_HASH - 1)
+#define  DICT_HASH(IDX)             ((((IDX) >> 8) * 13 + (IDX)) & DICT_HASH_MASK)
+#endif
+
+
 
 /*----------------------------------------------------------------------------*\
 ** Functions                                                                  **
@@ -432,11 +460,163 @@ static uint16_t uwDicTableSizeS = sizeof(aDicTableG) / sizeof(CosDicEntry_ts);
 
 
 
+//----------------------------------------------------------------------------//
+// CosDictInit()                                                              //
+// store the position of every index in the hash table                        //
+//----------------------------------------------------------------------------//
+void CosDictInit(void)
+{
+   #if COS_DICT_SEARCH_HASH > 0
+   uint16_t  uwPosEntryT;
+   uint16_t  uwIndexT;
+   uint16_t  uwSlotT;
+   uint16_t  uwProbeT;
+
+
+   for(uwSlotT = 0; uwSlotT < COS_DICT_SEARCH_HASH; uwSlotT++)
+   {
+      auwDicHashS[uwSlotT] = 0;
+   }
+   uwDicHashOverS = 0;
+
+   //----------------------------------------------------------------
+   // the table is sorted, only the first entry of an index is stored
+   // and collisions are resolved by linear probing
+   //
+   uwIndexT = aDicTableG[0].uwIndex;
+   for(uwPosEntryT = 1; uwPosEntryT < uwDicTableSizeS; uwPosEntryT++)
+   {
+      if(aDicTableG[uwPosEntryT].uwIndex == uwIndexT) continue;
+
+      uwIndexT = aDicTableG[uwPosEntryT].uwIndex;
+      uwSlotT  = DICT_HASH(uwIndexT);
+      for(uwProbeT = 0; uwProbeT < COS_DICT_SEARCH_HASH; uwProbeT++)
+      {
+         if(auwDicHashS[uwSlotT] == 0)
+         {
+            auwDicHashS[uwSlotT] = uwPosEntryT;
+            break;
+         }
+         uwSlotT = (uwSlotT + 1) & DICT_HASH_MASK;
+      }
+
+      //--- table is full, remaining indices use linear search ---
+      if(uwProbeT == COS_DICT_SEARCH_HASH)
+      {
+         uwDicHashOverS = uwPosEntryT;
+         break;
+      }
+   }
+   #endif
+}
+
+
+#if COS_DICT_SEARCH_HASH > 0
+
+
+//----------------------------------------------------------------------------//
+// CosDictFindEntry()                                                         //
+// find entry in dictionary, hash table for index                             //
+//----------------------------------------------------------------------------//
+CPP_CONST CosDicEntry_ts * CosDictFindEntry( uint16_t uwIndexV,
+                                             uint8_t ubSubIndexV,
+                                             uint8_t * pubStatusV)
+{
+   uint16_t  uwPosEntryT = 0;
+   uint16_t  uwSlotT;
+   uint16_t  uwProbeT;
+   uint8_t   ubSearchStatusT = eCosDict_FAIL_INDEX;
+   CPP_CONST CosDicEntry_ts *  ptsDicEntryT = 0L;
+
+
+   //----------------------------------------------------------------
+   // first level: get position of the index from the hash table,
+   // an empty slot terminates the search
+   //
+   uwSlotT = DICT_HASH(uwIndexV);
+   for(uwProbeT = 0; uwProbeT < COS_DICT_SEARCH_HASH; uwProbeT++)
+   {
+      uwPosEntryT = auwDicHashS[uwSlotT];
+      if(uwPosEntryT == 0) break;
+      if(aDicTableG[uwPosEntryT].uwIndex == uwIndexV) break;
+      uwPosEntryT = 0;
+      uwSlotT = (uwSlotT + 1) & DICT_HASH_MASK;
+   }
+
+   //--- index not stored in hash table ----------------------
+   if((uwPosEntryT == 0) && (uwDicHashOverS != 0))
+   {
+      for(uwPosEntryT = uwDicHashOverS; uwPosEntryT < uwDicTableSizeS;
+          uwPosEntryT++)
+      {
+         if(aDicTableG[uwPosEntryT].uwIndex == uwIndexV) break;
+      }
+      if(uwPosEntryT == uwDicTableSizeS) uwPosEntryT = 0;
+   }
+
+
+   //----------------------------------------------------------------
+   // second level: the sub-indices of an object are usually
+   // contiguous and start at 0, so test the direct position first
+   // and fall back to the entries of this index
+   //
+   if(uwPosEntryT != 0)
+   {
+      ubSearchStatusT = eCosDict_FAIL_SUBINDEX;
+      ptsDicEntryT = &(aDicTableG[uwPosEntryT]);
+
+      if(ptsDicEntryT->ubAttribute & CoATTR_FUNCTION)
+      {
+         ubSearchStatusT = eCosDict_FOUND_OBJECT;
+      }
+      else
+      {
+         if( ((uwPosEntryT + ubSubIndexV) < uwDicTableSizeS)          &&
+             (ptsDicEntryT[ubSubIndexV].uwIndex == uwIndexV)          &&
+             (ptsDicEntryT[ubSubIndexV].ubSubIndex == ubSubIndexV)    )
+         {
+            ptsDicEntryT = &(ptsDicEntryT[ubSubIndexV]);
+            ubSearchStatusT = eCosDict_FOUND_OBJECT;
+         }
+         else
+         {
+            while( (uwPosEntryT < uwDicTableSizeS) &&
+                   (ptsDicEntryT->uwIndex == uwIndexV) )
+            {
+               if( (ptsDicEntryT->ubSubIndex == ubSubIndexV) ||
+                   (ptsDicEntryT->ubAttribute & CoATTR_FUNCTION) )
+               {
+                  ubSearchStatusT = eCosDict_FOUND_OBJECT;
+                  break;
+               }
+               uwPosEntryT++;
+               ptsDicEntryT++;
+            }
+         }
+      }
+
+      if(ubSearchStatusT != eCosDict_FOUND_OBJECT)
+      {
+         ptsDicEntryT = 0L;
+      }
+   }
+
+   //----------------------------------------------------------------
+   // provide status information
+   //
+   if(pubStatusV)
+   {
+      *pubStatusV = ubSearchStatusT;
+   }
+   return(ptsDicEntryT);
+}
+#elif COS_DICT_SEARCH_FAST == 1
+
+
 //----------------------------------------------------------------------------//
 // CosDictFindEntry()                                                         //
 // find entry in dictionary, divide-and-conquer routine                       //
 //----------------------------------------------------------------------------//
-#if COS_DICT_SEARCH_FAST == 1
 CPP_CONST CosDicEntry_ts * CosDictFindEntry( uint16_t uwIndexV,
                                              uint8_t ubSubIndexV,
                                              uint8_t * pubStatusV)
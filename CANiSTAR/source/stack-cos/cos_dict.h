@@ -186,6 +186,17 @@ CPP_CONST CosDicEntry_ts * CosDictFindEntry( uint16_t uwIndexV,
                                              uint8_t *pubStatusV);
 
 
+/*!
+** \brief   Initialise the dictionary search
+**
+** With #COS_DICT_SEARCH_HASH > 0 this routine fills the hash table
+** with the position of every index. It is called by CosMgrInit(),
+** before the first access to the dictionary. Without hash table the
+** routine has no function.
+*/
+void CosDictInit(void);
+
+
 //-------------------------------------------------------------------//
 #ifdef __cplusplus                                                   //
 }                                                                    //
@@ -55,8 +55,12 @@
 **                                                                            **
 \*----------------------------------------------------------------------------*/
 
+#if COS_INSTANCE_MAX == 1
 uint32_t  ulCosEmcyIdentifierG;
+#endif
+
 
+#if COS_INSTANCE_MAX == 1
 
 #if COS_DICT_OBJ_1003 > 0
 static uint32_t ulCosEmcyErrorFieldS[COS_DICT_OBJ_1003];
@@ -69,15 +73,68 @@ uint16_t        uwCosEmcyInhibitTimeG;     // inhibit timer value for EMCY
 static uint16_t uwCosEmcyInhibitTickS;     // ticks value for EMCY
 #endif
 
+#else
+
+#define  ulCosEmcyErrorFieldS    (ptsCosInstG->aulEmcyErrorField)
+#define  ubCosEmcyErrorCountS    (ptsCosInstG->ubEmcyErrorCount)
+#define  ubCosEmcyErrorNewPosS   (ptsCosInstG->ubEmcyErrorNewPos)
+#define  uwCosEmcyInhibitTickS   (ptsCosInstG->uwEmcyInhibitTick)
+
+#endif
+
 //-------------------------------------------------------------------
-// queue for EMCY data to be send
+// queue for EMCY data to be send, the messages are sorted by
+// priority, entry 0 is transmitted next
 //
 #if COS_DICT_OBJ_1014 > 1
-static uint8_t ubCosEmcyHeadS;
-static uint8_t ubCosEmcyTailS;
+#if COS_INSTANCE_MAX == 1
+static uint8_t ubCosEmcyCountS;
+static uint8_t ubCosEmcyTrmPendS;
 static uint8_t aubCosEmcyQueueS[COS_DICT_OBJ_1014][8];
+#if COS_EMCY_STAT > 0
+static uint32_t ulCosEmcyDropS;              // dropped messages
+static uint32_t ulCosEmcyMergeS;             // coalesced messages
+static uint8_t  ubCosEmcyLevelMaxS;          // highest queue level
+#endif
+#else
+#define  ubCosEmcyCountS         (ptsCosInstG->ubEmcyCount)
+#define  ubCosEmcyTrmPendS       (ptsCosInstG->ubEmcyTrmPend)
+#define  aubCosEmcyQueueS        (ptsCosInstG->aubEmcyQueue)
+#define  ulCosEmcyDropS          (ptsCosInstG->ulEmcyDrop)
+#define  ulCosEmcyMergeS         (ptsCosInstG->ulEmcyMerge)
+#define  ubCosEmcyLevelMaxS      (ptsCosInstG->ubEmcyLevelMax)
+#endif
+#endif
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------
+// priority of an EMCY message inside the queue
+//
+#define  EMCY_PRIO_LOW           0     // communication errors
+#define  EMCY_PRIO_MID           1     // monitoring / external errors
+#define  EMCY_PRIO_HIGH          2     // error reset and device errors
+
+//-------------------------------------------------------------------
+// number of timer ticks to wait for the transmission of an EMCY
+// message, afterwards the next message is written to the buffer
+//
+#define  EMCY_TRM_TIMEOUT        10
+
+//-------------------------------------------------------------------
+// declaration of internal functions
+//
+#if COS_DICT_OBJ_1014 > 1
+static uint8_t CosEmcyPriority(uint8_t * pubEmcyDataV);
+static void    CosEmcyQueueAdd(uint8_t * pubEmcyDataV);
+static void    CosEmcyQueueMove(uint8_t ubDstV, uint8_t ubSrcV);
 #endif
 
+
 /*----------------------------------------------------------------------------*\
 ** Functions                                                                  **
 **                                                                            **
@@ -172,8 +229,10 @@ uint8_t CosEmcyErrorField(uint8_t ubSubIndexV, uint8_t ubReqCodeV)
          }
          else
          {
+            CpCoreIntLock(&tsCanPortG);
             ubCosEmcyErrorCountS    = 0;
             ubCosEmcyErrorNewPosS   = 0;
+            CpCoreIntUnlock(&tsCanPortG);
             ubHandlerCodeT = eCosSdo_WRITE_OK;
          }
       }
@@ -401,8 +460,13 @@ void  CosEmcyInit(void)
    #endif
 
    #if COS_DICT_OBJ_1014 > 1
-   ubCosEmcyHeadS = 0;
-   ubCosEmcyTailS = 0;
+   ubCosEmcyCountS   = 0;
+   ubCosEmcyTrmPendS = 0;
+   #if COS_EMCY_STAT > 0
+   ulCosEmcyDropS     = 0;
+   ulCosEmcyMergeS    = 0;
+   ubCosEmcyLevelMaxS = 0;
+   #endif
    #endif
 
    #if COS_DICT_OBJ_1015 > 0
@@ -412,6 +476,184 @@ void  CosEmcyInit(void)
 }
 
 
+//----------------------------------------------------------------------------//
+// CosEmcyPriority()                                                          //
+// priority of an EMCY message inside the transmit queue                      //
+//----------------------------------------------------------------------------//
+#if COS_DICT_OBJ_1014 > 1
+static uint8_t CosEmcyPriority(uint8_t * pubEmcyDataV)
+{
+   uint16_t  uwEmcyCodeT;
+
+   uwEmcyCodeT = pubEmcyDataV[1];
+   uwEmcyCodeT = (uwEmcyCodeT << 8) | pubEmcyDataV[0];
+
+   //----------------------------------------------------------------
+   // communication and protocol errors (81xxh, 82xxh) are caused
+   // by the network, e.g. a CAN overrun, and occur in bursts
+   //
+   if( (uwEmcyCodeT >= 0x8100) && (uwEmcyCodeT <= 0x82FF) )
+   {
+      return(EMCY_PRIO_LOW);
+   }
+
+   //----------------------------------------------------------------
+   // other monitoring, external and device specific errors
+   //
+   if(uwEmcyCodeT >= 0x8000)
+   {
+      return(EMCY_PRIO_MID);
+   }
+
+   //----------------------------------------------------------------
+   // error reset and device errors (current, voltage, ...)
+   //
+   return(EMCY_PRIO_HIGH);
+}
+
+
+//----------------------------------------------------------------------------//
+// CosEmcyQueueAdd()                                                          //
+// insert EMCY message into the transmit queue                                //
+//----------------------------------------------------------------------------//
+static void CosEmcyQueueAdd(uint8_t * pubEmcyDataV)
+{
+   uint8_t   ubPosT;
+   uint8_t   ubPrioT;
+   uint8_t   ubLowPosT;
+   uint8_t   ubLowPrioT;
+   uint8_t   ubCntT;
+   #if COS_EMCY_COALESCE > 0
+   uint8_t   ubDataCntT;
+   uint8_t * pubEntryT;
+   #endif
+
+   ubPrioT = CosEmcyPriority(pubEmcyDataV);
+
+   #if COS_EMCY_COALESCE > 0
+   //----------------------------------------------------------------
+   // an identical message (error code and manufacturer bytes 3 .. 6)
+   // is still waiting: count the repetition in byte 7 and take the
+   // new error register, the search stops at an error reset so that
+   // an error is never moved in front of a reset
+   //
+   ubPosT = ubCosEmcyCountS;
+   while(ubPosT > 0)
+   {
+      ubPosT--;
+      pubEntryT = &aubCosEmcyQueueS[ubPosT][0];
+
+      for(ubDataCntT = 0; ubDataCntT < 7; ubDataCntT++)
+      {
+         if(ubDataCntT == 2) continue;
+         if(pubEntryT[ubDataCntT] != pubEmcyDataV[ubDataCntT]) break;
+      }
+
+      if(ubDataCntT == 7)
+      {
+         pubEntryT[2] = pubEmcyDataV[2];
+         if(pubEntryT[7] < 0xFF)
+         {
+            pubEntryT[7]++;
+         }
+
+         #if COS_EMCY_STAT > 0
+         ulCosEmcyMergeS++;
+         #endif
+         return;
+      }
+
+      if( (pubEntryT[0] == 0x00) && (pubEntryT[1] == 0x00) ) break;
+   }
+
+   //----------------------------------------------------------------
+   // first occurrence of this message
+   //
+   pubEmcyDataV[7] = 0;
+   #endif
+
+   //----------------------------------------------------------------
+   // the queue is full: the newest message with the lowest priority
+   // is dropped, this may be the new message
+   //
+   if(ubCosEmcyCountS == COS_DICT_OBJ_1014)
+   {
+      ubLowPosT  = 0;
+      ubLowPrioT = EMCY_PRIO_HIGH + 1;
+      for(ubPosT = 0; ubPosT < COS_DICT_OBJ_1014; ubPosT++)
+      {
+         ubCntT = CosEmcyPriority(&aubCosEmcyQueueS[ubPosT][0]);
+         if(ubCntT <= ubLowPrioT)
+         {
+            ubLowPrioT = ubCntT;
+            ubLowPosT  = ubPosT;
+         }
+      }
+
+      #if COS_EMCY_STAT > 0
+      ulCosEmcyDropS++;
+      #endif
+
+      if(ubLowPrioT >= ubPrioT) return;
+
+      for(ubPosT = ubLowPosT + 1; ubPosT < COS_DICT_OBJ_1014; ubPosT++)
+      {
+         CosEmcyQueueMove(ubPosT - 1, ubPosT);
+      }
+      ubCosEmcyCountS--;
+   }
+
+   //----------------------------------------------------------------
+   // insert the message behind all messages with the same or a
+   // higher priority, an error reset is always appended
+   //
+   ubPosT = ubCosEmcyCountS;
+   if( (pubEmcyDataV[0] != 0x00) || (pubEmcyDataV[1] != 0x00) )
+   {
+      while( (ubPosT > 0) &&
+             (CosEmcyPriority(&aubCosEmcyQueueS[ubPosT - 1][0]) < ubPrioT) )
+      {
+         ubPosT--;
+      }
+   }
+
+   for(ubCntT = ubCosEmcyCountS; ubCntT > ubPosT; ubCntT--)
+   {
+      CosEmcyQueueMove(ubCntT, ubCntT - 1);
+   }
+
+   for(ubCntT = 0; ubCntT < 8; ubCntT++)
+   {
+      aubCosEmcyQueueS[ubPosT][ubCntT] = pubEmcyDataV[ubCntT];
+   }
+   ubCosEmcyCountS++;
+
+   #if COS_EMCY_STAT > 0
+   if(ubCosEmcyCountS > ubCosEmcyLevelMaxS)
+   {
+      ubCosEmcyLevelMaxS = ubCosEmcyCountS;
+   }
+   #endif
+}
+
+
+//----------------------------------------------------------------------------//
+// CosEmcyQueueMove()                                                         //
+// copy one entry of the transmit queue                                       //
+//----------------------------------------------------------------------------//
+static void CosEmcyQueueMove(uint8_t ubDstV, uint8_t ubSrcV)
+{
+   uint8_t  ubDataCntT;
+
+   for(ubDataCntT = 0; ubDataCntT < 8; ubDataCntT++)
+   {
+      aubCosEmcyQueueS[ubDstV][ubDataCntT] =
+                                    aubCosEmcyQueueS[ubSrcV][ubDataCntT];
+   }
+}
+#endif
+
+
 //----------------------------------------------------------------------------//
 // CosEmcySend()                                                              //
 // transmit emergency message                                                 //
@@ -482,6 +724,13 @@ void  CosEmcySend(uint16_t uwEmcyCodeV, uint8_t * pubCustomerCodeV)
    }
 
 
+   //----------------------------------------------------------------
+   // the function is also called by the CAN interrupt handler, the
+   // error list and the queue are changed with the CAN interrupt
+   // locked
+   //
+   CpCoreIntLock(&tsCanPortG);
+
    //----------------------------------------------------------------
    // store message in list
    //
@@ -492,43 +741,20 @@ void  CosEmcySend(uint16_t uwEmcyCodeV, uint8_t * pubCustomerCodeV)
 
 
    //----------------------------------------------------------------
-   // Do FIFO operation or send immediately
+   // Do queue operation or send immediately
    //
    //----------------------------------------------------------------
    #if COS_DICT_OBJ_1014 > 1
 
    //----------------------------------------------------------------
-   // test if FIFO is full:
-   //
-   if( (ubCosEmcyHeadS == 0) && (ubCosEmcyTailS == COS_DICT_OBJ_1014 - 1) )
-   {
-      return;
-   }
-
-   if(ubCosEmcyHeadS == ubCosEmcyTailS + 1)
-   {
-      return;
-   }
-
-
-
-   //----------------------------------------------------------------
-   // FIFO is not full, insert the message
+   // insert the message into the queue, it is sent by
+   // CosEmcyTmrEvent()
    //
-   for(ubDataCntT = 0; ubDataCntT < 8; ubDataCntT++)
-   {
-      aubCosEmcyQueueS[ubCosEmcyTailS][ubDataCntT] = aubEmcyDataT[ubDataCntT];
-   }
-
-   //----------------------------------------------------------------
-   // increment tail position
-   //
-   ubCosEmcyTailS += 1;
-   if(ubCosEmcyTailS == COS_DICT_OBJ_1014)
-   {
-      ubCosEmcyTailS = 0;
-   }
+   CosEmcyQueueAdd(&aubEmcyDataT[0]);
+   CpCoreIntUnlock(&tsCanPortG);
    #else
+   CpCoreIntUnlock(&tsCanPortG);
+
    //----------------------------------------------------------------
    // check for operational state
    //
@@ -550,6 +776,92 @@ void  CosEmcySend(uint16_t uwEmcyCodeV, uint8_t * pubCustomerCodeV)
 }
 
 
+//----------------------------------------------------------------------------//
+// CosEmcyStatistic()                                                         //
+// get statistic of the EMCY transmit queue                                   //
+//----------------------------------------------------------------------------//
+#if COS_EMCY_STAT > 0
+uint8_t CosEmcyStatistic(uint8_t ubSubIndexV, uint8_t ubReqCodeV)
+{
+   uint8_t  ubValueT;
+   uint32_t ulValueT;
+
+
+   //----------------------------------------------------------------
+   // test the maximum sub-index
+   //
+   if(ubSubIndexV > 3)
+   {
+      return(eCosSdo_ERR_NO_SUB_INDEX);
+   }
+
+
+   //----------------------------------------------------------------
+   // write access: only a value of 0 to sub-index 0 is allowed,
+   // it clears the statistic
+   //
+   if(ubReqCodeV != eSDO_READ_REQ)
+   {
+      if(ubSubIndexV != 0)
+      {
+         return(eCosSdo_ERR_ACCESS_RO);
+      }
+
+      if( (ubReqCodeV != eSDO_WRITE_REQ_0) &&
+          (ubReqCodeV != eSDO_WRITE_REQ_1) )
+      {
+         return(eCosSdo_ERR_DATATYPE);
+      }
+
+      CosSdoCopyMessageToValue( (void *)&ubValueT, CoDT_UNSIGNED8);
+      if(ubValueT > 0)
+      {
+         return(eCosSdo_ERR_VALUE_HIGH);
+      }
+
+      CpCoreIntLock(&tsCanPortG);
+      ulCosEmcyDropS     = 0;
+      ulCosEmcyMergeS    = 0;
+      ubCosEmcyLevelMaxS = ubCosEmcyCountS;
+      CpCoreIntUnlock(&tsCanPortG);
+
+      return(eCosSdo_WRITE_OK);
+   }
+
+
+   //----------------------------------------------------------------
+   // read access, the 32 bit counters are copied with the CAN
+   // interrupt locked
+   //
+   switch(ubSubIndexV)
+   {
+      case 1:
+         CpCoreIntLock(&tsCanPortG);
+         ulValueT = ulCosEmcyDropS;
+         CpCoreIntUnlock(&tsCanPortG);
+         CosSdoCopyValueToMessage((void *) &ulValueT, CoDT_UNSIGNED32);
+         return(eCosSdo_READ4_OK);
+
+      case 2:
+         CpCoreIntLock(&tsCanPortG);
+         ulValueT = ulCosEmcyMergeS;
+         CpCoreIntUnlock(&tsCanPortG);
+         CosSdoCopyValueToMessage((void *) &ulValueT, CoDT_UNSIGNED32);
+         return(eCosSdo_READ4_OK);
+
+      case 3:
+         CosSdoCopyValueToMessage((void *) &ubCosEmcyLevelMaxS, CoDT_UNSIGNED8);
+         return(eCosSdo_READ1_OK);
+
+      default:
+         ubValueT = 3;
+         CosSdoCopyValueToMessage((void *) &ubValueT, CoDT_UNSIGNED8);
+         return(eCosSdo_READ1_OK);
+   }
+}
+#endif
+
+
 //----------------------------------------------------------------------------//
 // CosEmcyTmrEvent()                                                          //
 // transmit emergency message                                                 //
@@ -557,6 +869,9 @@ void  CosEmcySend(uint16_t uwEmcyCodeV, uint8_t * pubCustomerCodeV)
 void  CosEmcyTmrEvent(void)
 {
    #if COS_DICT_OBJ_1014 > 1
+   uint8_t  ubPosT;
+   uint8_t  aubEmcyDataT[8];
+
    //----------------------------------------------------------------
    // test inhibit timer value for EMCY
    //
@@ -568,37 +883,55 @@ void  CosEmcyTmrEvent(void)
    }
    #endif
 
+   //----------------------------------------------------------------
+   // the last message has not been transmitted yet, it would be
+   // overwritten by the next one
+   //
+   if(ubCosEmcyTrmPendS > 0)
+   {
+      ubCosEmcyTrmPendS--;
+      return;
+   }
+
    //----------------------------------------------------------------
    // check for operational state
    //
    if(CosNmtGetNodeState() == NODE_STATE_STOPPED) return;
 
    //-----------------------------------------------------------------
-   // test if FIFO is empty
+   // CosEmcySend() may insert a message from the CAN interrupt:
+   // take the message with the highest priority out of the queue
+   // with the interrupt locked, the driver functions below lock
+   // the interrupt by themselves
    //
-   if(ubCosEmcyHeadS == ubCosEmcyTailS)
+   CpCoreIntLock(&tsCanPortG);
+   if(ubCosEmcyCountS == 0)
    {
+      CpCoreIntUnlock(&tsCanPortG);
       return;
    }
 
+   for(ubPosT = 0; ubPosT < 8; ubPosT++)
+   {
+      aubEmcyDataT[ubPosT] = aubCosEmcyQueueS[0][ubPosT];
+   }
+
+   ubCosEmcyCountS--;
+   for(ubPosT = 0; ubPosT < ubCosEmcyCountS; ubPosT++)
+   {
+      CosEmcyQueueMove(ubPosT, ubPosT + 1);
+   }
+   CpCoreIntUnlock(&tsCanPortG);
+
    //-----------------------------------------------------------------
-   // get message from FIFO and copy into CAN message buffer
+   // copy the message into CAN message buffer
    //
    CpCoreBufferSetData( &tsCanPortG, eCosBuf_EMCY,
-                        &aubCosEmcyQueueS[ubCosEmcyHeadS][0] );
+                        &aubEmcyDataT[0] );
 
    //--- send the message -------------------------------------------
    CpCoreBufferSend(&tsCanPortG, eCosBuf_EMCY);
-
-
-   //----------------------------------------------------------------
-   // increment head position
-   //
-   ubCosEmcyHeadS += 1;
-   if(ubCosEmcyHeadS == COS_DICT_OBJ_1014)
-   {
-      ubCosEmcyHeadS = 0;
-   }
+   ubCosEmcyTrmPendS = EMCY_TRM_TIMEOUT;
 
    //----------------------------------------------------------------
    // reload inhibit timer value for EMCY
@@ -609,3 +942,15 @@ void  CosEmcyTmrEvent(void)
 
    #endif   // COS_DICT_OBJ_1014 > 1
 }
+
+
+//----------------------------------------------------------------------------//
+// CosEmcyTrmEvent()                                                          //
+// emergency message has been transmitted                                     //
+//----------------------------------------------------------------------------//
+void  CosEmcyTrmEvent(void)
+{
+   #if COS_DICT_OBJ_1014 > 1
+   ubCosEmcyTrmPendS = 0;
+   #endif
+}
@@ -304,11 +304,13 @@ extern "C" {                                                         //
 **                                                                            **
 \*----------------------------------------------------------------------------*/
 
+#if COS_INSTANCE_MAX == 1
 extern uint32_t ulCosEmcyIdentifierG;
 
 #if COS_DICT_OBJ_1015 > 0
 extern uint16_t uwCosEmcyInhibitTimeG;
 #endif
+#endif
 
 
 /*----------------------------------------------------------------------------*\
@@ -408,12 +410,53 @@ void  CosEmcyInit(void);
 **
 ** This function is called by the application program
 **
+** With a queue (#COS_DICT_OBJ_1014 > 1) the messages are sorted by
+** priority: error reset and device errors first, then monitoring
+** and external errors, communication errors (81xxh, 82xxh) last.
+** Messages of the same priority keep their order and no message is
+** moved in front of an error reset. When the queue is full the
+** newest message with the lowest priority is dropped.
+** With #COS_EMCY_COALESCE = 1 a message that is identical to a
+** waiting one (error code and bytes 3 .. 6) is not queued again,
+** the last byte of the manufacturer specific error field counts the
+** repetitions instead.
 */
 void  CosEmcySend(uint16_t uwEmcyCodeV, uint8_t * pubCustomerCodeV);
 
 
+#if COS_EMCY_STAT > 0
+/*!
+** \brief   EMCY queue statistic
+** \param   ubSubIndexV    sub-index
+** \param   ubReqCodeV     read / write access
+** \return  SDO response code (enumeration #CosSdo_e)
+**
+** The object holds the statistic of the EMCY transmit queue:
+** \li   sub-index 1: number of dropped messages (UNSIGNED32)
+** \li   sub-index 2: number of coalesced messages (UNSIGNED32)
+** \li   sub-index 3: highest number of waiting messages (UNSIGNED8)
+**
+** Writing a 0 to sub-index 0 clears the statistic. This function is
+** called by the CANopen slave framework on reception on a SDO
+** message (callback).
+*/
+uint8_t  CosEmcyStatistic(uint8_t ubSubIndexV, uint8_t ubReqCodeV);
+#endif
+
+
 void  CosEmcyTmrEvent(void);
 
+
+/*!
+** \brief   Emergency message transmitted
+**
+** The function is called by the CAN transmit handler of the stack
+** after the EMCY message has been sent. The next message of the
+** queue is written to the CAN buffer only after this event (or a
+** timeout), so a waiting message is not overwritten.
+*/
+void  CosEmcyTrmEvent(void);
+
 //-------------------------------------------------------------------//
 #ifdef __cplusplus                                                   //
 }                                                                    //
@@ -0,0 +1,254 @@
+//****************************************************************************//
+// File:          cos_hbw.c                                                   //
+// Description:   Timing wheel for the heartbeat consumers                    //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include "cos_hbw.h"       // heartbeat consumer timing wheel
+#include "cos_mgr.h"       // CAN interface
+
+
+//------------------------------------------------------------------#
+// test if the timing wheel is enabled
+#if (COS_DICT_OBJ_1016 > 0) && (COS_NMT_HBC_WHEEL > 0)
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------
+// end of a slot list / entry is not linked into the wheel
+//
+#define  HBW_NONE          0xFF
+
+#define  HBW_SLOT_MASK     (COS_NMT_HBC_WHEEL - 1)
+
+//-------------------------------------------------------------------
+// list of the expired consumers, behind the slots of the wheel
+//
+#define  HBW_EXPIRED       COS_NMT_HBC_WHEEL
+
+
+/*----------------------------------------------------------------------------*\
+** Variables of module                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#if COS_INSTANCE_MAX == 1
+static uint16_t   auwCosHbwRoundS[COS_DICT_OBJ_1016];    // remaining turns
+static uint8_t    aubCosHbwNextS[COS_DICT_OBJ_1016];     // next in slot
+static uint8_t    aubCosHbwPrevS[COS_DICT_OBJ_1016];     // previous in slot
+static uint8_t    aubCosHbwSlotS[COS_DICT_OBJ_1016];     // slot of entry
+static uint8_t    aubCosHbwHeadS[COS_NMT_HBC_WHEEL + 1]; // first of slot
+static uint8_t    ubCosHbwCursorS;                       // current slot
+#else
+#define  auwCosHbwRoundS      (ptsCosInstG->auwHbwRound)
+#define  aubCosHbwNextS       (ptsCosInstG->aubHbwNext)
+#define  aubCosHbwPrevS       (ptsCosInstG->aubHbwPrev)
+#define  aubCosHbwSlotS       (ptsCosInstG->aubHbwSlot)
+#define  aubCosHbwHeadS       (ptsCosInstG->aubHbwHead)
+#define  ubCosHbwCursorS      (ptsCosInstG->ubHbwCursor)
+#endif
+
+
+/*----------------------------------------------------------------------------*\
+** Function prototypes                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+static void CosHbwLink(uint8_t ubEntryV, uint8_t ubSlotV);
+static void CosHbwUnlink(uint8_t ubEntryV);
+
+
+/*----------------------------------------------------------------------------*\
+** Functions                                                                  **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//----------------------------------------------------------------------------//
+// CosHbwInit()                                                               //
+// stop all consumer times                                                    //
+//----------------------------------------------------------------------------//
+void CosHbwInit(void)
+{
+   uint8_t  ubCntT;
+
+   for(ubCntT = 0; ubCntT <= HBW_EXPIRED; ubCntT++)
+   {
+      aubCosHbwHeadS[ubCntT] = HBW_NONE;
+   }
+
+   for(ubCntT = 0; ubCntT < COS_DICT_OBJ_1016; ubCntT++)
+   {
+      aubCosHbwSlotS[ubCntT] = HBW_NONE;
+   }
+
+   ubCosHbwCursorS = 0;
+}
+
+
+//----------------------------------------------------------------------------//
+// CosHbwLink()                                                               //
+// insert a consumer at the head of a slot list                               //
+//----------------------------------------------------------------------------//
+static void CosHbwLink(uint8_t ubEntryV, uint8_t ubSlotV)
+{
+   aubCosHbwSlotS[ubEntryV] = ubSlotV;
+   aubCosHbwPrevS[ubEntryV] = HBW_NONE;
+   aubCosHbwNextS[ubEntryV] = aubCosHbwHeadS[ubSlotV];
+   if(aubCosHbwHeadS[ubSlotV] != HBW_NONE)
+   {
+      aubCosHbwPrevS[aubCosHbwHeadS[ubSlotV]] = ubEntryV;
+   }
+   aubCosHbwHeadS[ubSlotV] = ubEntryV;
+}
+
+
+//----------------------------------------------------------------------------//
+// CosHbwUnlink()                                                             //
+// remove a consumer from its slot list                                       //
+//----------------------------------------------------------------------------//
+static void CosHbwUnlink(uint8_t ubEntryV)
+{
+   uint8_t  ubNextT;
+   uint8_t  ubPrevT;
+
+   if(aubCosHbwSlotS[ubEntryV] == HBW_NONE) return;
+
+   ubNextT = aubCosHbwNextS[ubEntryV];
+   ubPrevT = aubCosHbwPrevS[ubEntryV];
+
+   if(ubPrevT == HBW_NONE)
+   {
+      aubCosHbwHeadS[aubCosHbwSlotS[ubEntryV]] = ubNextT;
+   }
+   else
+   {
+      aubCosHbwNextS[ubPrevT] = ubNextT;
+   }
+
+   if(ubNextT != HBW_NONE)
+   {
+      aubCosHbwPrevS[ubNextT] = ubPrevT;
+   }
+
+   aubCosHbwSlotS[ubEntryV] = HBW_NONE;
+}
+
+
+//----------------------------------------------------------------------------//
+// CosHbwStart()                                                              //
+// link a consumer into the slot of its expiry tick                           //
+//----------------------------------------------------------------------------//
+void CosHbwStart(uint8_t ubEntryV, uint16_t uwTicksV)
+{
+   uint8_t  ubSlotT;
+
+   if(ubEntryV >= COS_DICT_OBJ_1016) return;
+
+   CpCoreIntLock(&tsCanPortG);
+   CosHbwUnlink(ubEntryV);
+   if(uwTicksV > 0)
+   {
+      //--------------------------------------------------------
+      // The wheel is moved before a slot is checked, so the slot
+      // is reached the first time after ((uwTicksV - 1) % slots)
+      // + 1 ticks and then after every full turn.
+      //
+      ubSlotT = (uint8_t) ((ubCosHbwCursorS + uwTicksV) & HBW_SLOT_MASK);
+      auwCosHbwRoundS[ubEntryV] = (uwTicksV - 1) / COS_NMT_HBC_WHEEL;
+      CosHbwLink(ubEntryV, ubSlotT);
+   }
+   CpCoreIntUnlock(&tsCanPortG);
+}
+
+
+//----------------------------------------------------------------------------//
+// CosHbwStop()                                                               //
+// unlink a consumer from its slot                                            //
+//----------------------------------------------------------------------------//
+void CosHbwStop(uint8_t ubEntryV)
+{
+   if(ubEntryV >= COS_DICT_OBJ_1016) return;
+
+   CpCoreIntLock(&tsCanPortG);
+   CosHbwUnlink(ubEntryV);
+   CpCoreIntUnlock(&tsCanPortG);
+}
+
+
+//----------------------------------------------------------------------------//
+// CosHbwTmrEvent()                                                           //
+// move the wheel by one slot and check the consumers of this slot            //
+//----------------------------------------------------------------------------//
+void CosHbwTmrEvent(void)
+{
+   uint8_t  ubEntryT;
+   uint8_t  ubNextT;
+
+   //----------------------------------------------------------------
+   // CosHbwStart() is called by the CAN interrupt: the slot is
+   // checked with the interrupt locked, expired consumers are moved
+   // to the list of expired consumers
+   //
+   CpCoreIntLock(&tsCanPortG);
+   ubCosHbwCursorS = (ubCosHbwCursorS + 1) & HBW_SLOT_MASK;
+
+   ubEntryT = aubCosHbwHeadS[ubCosHbwCursorS];
+   while(ubEntryT != HBW_NONE)
+   {
+      ubNextT = aubCosHbwNextS[ubEntryT];
+
+      if(auwCosHbwRoundS[ubEntryT] == 0)
+      {
+         CosHbwUnlink(ubEntryT);
+         CosHbwLink(ubEntryT, HBW_EXPIRED);
+      }
+      else
+      {
+         auwCosHbwRoundS[ubEntryT]--;
+      }
+
+      ubEntryT = ubNextT;
+   }
+   CpCoreIntUnlock(&tsCanPortG);
+
+   //----------------------------------------------------------------
+   // The NMT module is called without the lock, it may send an
+   // EMCY message. A heartbeat received in the meantime restarts
+   // the consumer and removes it from the expired list, so it is
+   // not reported.
+   //
+   for(;;)
+   {
+      CpCoreIntLock(&tsCanPortG);
+      ubEntryT = aubCosHbwHeadS[HBW_EXPIRED];
+      if(ubEntryT != HBW_NONE)
+      {
+         CosHbwUnlink(ubEntryT);
+      }
+      CpCoreIntUnlock(&tsCanPortG);
+
+      if(ubEntryT == HBW_NONE) break;
+      CosNmtHBConsTimeout(ubEntryT);
+   }
+}
+
+
+#endif   // (COS_DICT_OBJ_1016 > 0) && (COS_NMT_HBC_WHEEL > 0)
@@ -0,0 +1,128 @@
+//****************************************************************************//
+// File:          cos_hbw.h                                                   //
+// Description:   Timing wheel for the heartbeat consumers                    //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+#ifndef  COS_HBW_H_
+#define  COS_HBW_H_
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include "cos_defs.h"      // CANopen Slave definition file
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \file    cos_hbw.h
+** \brief   Timing wheel for the heartbeat consumers
+**
+** The consumer times of index 1016h are supervised by a hashed timing
+** wheel with #COS_NMT_HBC_WHEEL slots. A running consumer is linked
+** into the slot of its expiry tick, together with the number of full
+** turns of the wheel that remain. CosHbwTmrEvent() moves the wheel by
+** one slot per timer tick and only checks the consumers of this slot.
+** Starting, restarting and stopping a consumer time is a constant
+** time operation, independent of the number of consumers.
+** <p>
+** The functions are called as follows:
+** \li CosHbwInit() by CosMgrStart()
+** \li CosHbwStart() by CosMgrHbcHandler() for every heartbeat of a
+**     monitored node, the consumer time is counted from here on
+** \li CosHbwStop() by CosMgrHbcFilter() for all inactive entries
+** \li CosHbwTmrEvent() by CosTmrEvent() once per timer tick
+** <p>
+** An expired consumer time is reported to the NMT module by
+** CosNmtHBConsTimeout(), the consumer is stopped until it receives
+** the next heartbeat. The lists of the wheel are changed with the CAN
+** interrupt locked (CpCoreIntLock()), so CosHbwStart() may be called
+** by the CAN interrupt handler while CosHbwTmrEvent() runs in the
+** main loop or in the timer interrupt. CosNmtHBConsTimeout() is called
+** without the lock.
+*/
+
+
+/*----------------------------------------------------------------------------*\
+** Function prototypes                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------//
+// take precautions if compiled with C++ compiler                    //
+#ifdef __cplusplus                                                   //
+extern "C" {                                                         //
+#endif                                                               //
+//-------------------------------------------------------------------//
+
+
+#if (COS_DICT_OBJ_1016 > 0) && (COS_NMT_HBC_WHEEL > 0)
+
+/*!
+** \brief   Initialise the timing wheel
+**
+** All consumer times are stopped.
+*/
+void  CosHbwInit(void);
+
+
+/*!
+** \brief   Start or restart a consumer time
+** \param   ubEntryV       Entry of index 1016h, starting with 0
+** \param   uwTicksV       Consumer time in timer ticks
+**
+** The consumer time expires after \a uwTicksV timer ticks, unless it
+** is restarted before. A value of 0 for \a uwTicksV stops the
+** consumer time.
+*/
+void  CosHbwStart(uint8_t ubEntryV, uint16_t uwTicksV);
+
+
+/*!
+** \brief   Stop a consumer time
+** \param   ubEntryV       Entry of index 1016h, starting with 0
+*/
+void  CosHbwStop(uint8_t ubEntryV);
+
+
+/*!
+** \brief   Timer event
+**
+** The function is called by CosTmrEvent() once per timer tick.
+*/
+void  CosHbwTmrEvent(void);
+
+
+/*!
+** \brief   Consumer time expired
+** \param   ubEntryV       Entry of index 1016h, starting with 0
+**
+** This function is implemented by the NMT module. It is called by
+** CosHbwTmrEvent() when no heartbeat was received within the
+** consumer time, it sets the heartbeat event of the entry.
+*/
+void  CosNmtHBConsTimeout(uint8_t ubEntryV);
+
+#endif
+
+
+//-------------------------------------------------------------------//
+#ifdef __cplusplus                                                   //
+}                                                                    //
+#endif                                                               //
+// end of C++ compiler wrapper                                       //
+//-------------------------------------------------------------------//
+
+#endif   // COS_HBW_H_
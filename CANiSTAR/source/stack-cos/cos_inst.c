@@ -0,0 +1,72 @@
+//****************************************************************************//
+// File:          cos_inst.c                                                  //
+// Description:   Instance data of the CANopen Slave                          //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include "cos_inst.h"      // instance data
+
+
+//------------------------------------------------------------------#
+// test if multiple instances are enabled
+#if COS_INSTANCE_MAX > 1
+
+
+/*----------------------------------------------------------------------------*\
+** Variables of module                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+static CosInst_ts    atsCosInstS[COS_INSTANCE_MAX];      // data sets
+static uint8_t       ubCosInstSelS;                      // selected instance
+
+CosInst_ts *         ptsCosInstG = &atsCosInstS[0];      // selected data set
+
+
+
+/*----------------------------------------------------------------------------*\
+** Function implementation                                                    **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------//
+// CosInstSelect()                                                            //
+// point to the data set of the selected instance                             //
+//----------------------------------------------------------------------------//
+uint8_t  CosInstSelect(uint8_t ubInstV)
+{
+   if(ubInstV >= COS_INSTANCE_MAX) return(eCosErr_VALUE_NODE_ID);
+
+   ptsCosInstG   = &atsCosInstS[ubInstV];
+   ubCosInstSelS = ubInstV;
+
+   return(eCosErr_OK);
+}
+
+
+//----------------------------------------------------------------------------//
+// CosInstSelected()                                                          //
+// return the selected instance                                               //
+//----------------------------------------------------------------------------//
+uint8_t  CosInstSelected(void)
+{
+   return(ubCosInstSelS);
+}
+
+
+#endif   // COS_INSTANCE_MAX > 1
@@ -0,0 +1,266 @@
+//****************************************************************************//
+// File:          cos_inst.h                                                  //
+// Description:   Instance data of the CANopen Slave                          //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+#ifndef  COS_INST_H_
+#define  COS_INST_H_
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include "cos_defs.h"      // CANopen Slave definition file
+
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \file    cos_inst.h
+** \brief   Instance data of the CANopen Slave
+**
+** With the symbol #COS_INSTANCE_MAX set to a value greater 1 the
+** complete run-time state of the CANopen slave (manager, CiA 301
+** objects, EMCY, LSS and LED management) is held in one structure of
+** type #CosInst_ts per node. All instances are stored in one array, so
+** the data of a node is contiguous in memory.
+** <p>
+** The stack works on the data set the pointer #ptsCosInstG points to.
+** The global variable names of the single instance build (e.g.
+** ubCosMgrStatusG) are mapped to members of this data set, so the code
+** of the stack is the same for every node. CosInstSelect() only sets
+** the pointer, no data is copied. The objects 1001h and 1002h of the
+** object dictionary are accessed by a function in this case, as their
+** address depends on the selected instance.
+** <p>
+** The application must select the instance before it calls a function
+** of the stack for this node, i.e. before CosMgrInit(), CosMgrStart(),
+** CosMgrProcess(), CosTmrEvent() and before it serves the CAN port of
+** the node (the CAN callbacks run on the selected data set). All these
+** calls must be done from one thread.
+** <p>
+** With #COS_INSTANCE_MAX equal to 1 (default) this file has no effect.
+*/
+
+
+#if COS_INSTANCE_MAX > 1
+
+/*----------------------------------------------------------------------------*\
+** Structures                                                                 **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+
+//---------------------------------------------------------
+/*!
+** \struct  CosInst_s
+** \brief   Run-time data of one CANopen Slave instance
+**
+*/
+struct CosInst_s {
+
+   //--- manager (cos_mgr.c) ---------------------------------
+   #if CP_SMALL_CODE == 0
+   CpPort_ts   tsMgrCanPort;              // CAN interface
+   #endif
+   uint16_t    uwMgrConfig;               // configuration of CANopen stack
+   uint8_t     ubMgrNodeAddress;          // node address
+   uint8_t     ubMgrBaudrate;             // baudrate
+   uint8_t     ubMgrStatus;               // status of CANopen stack
+   uint8_t     ubMgrErrState;             // last CAN error state
+   #if COS_DICT_OBJ_1010 > 0
+   uint16_t    uwMgrNvmSel;               // parameter selection
+   uint8_t     ubMgrNvmStep;              // step of NVM operation
+   uint8_t     ubMgrNvmGroup;             // parameter group to save
+   uint8_t     ubMgrNvmFail;              // failed NVM accesses
+   #endif
+   #if (COS_DICT_OBJ_1016 > 0) && (COS_NMT_HBC_MERGE > 0)
+   uint8_t     aubMgrHbcEntry[128];       // consumer entry of node-ID
+   #endif
+
+   //--- CiA 301 objects (cos301.c) --------------------------
+   uint32_t    ulIdx1002_StatusRegister;  // status register
+   uint8_t     ubIdx1001_ErrorRegister;   // error register
+   #if COS_DICT_OBJ_1010 > 0
+   uint8_t     ub301ParmSave;             // requested save operation
+   uint8_t     ub301ParmLoad;             // requested load operation
+   #endif
+   #if COS_DICT_OBJ_1020 == 1
+   uint32_t    ulIdx1020_Date;            // configuration date
+   uint32_t    ulIdx1020_Time;            // configuration time
+   #endif
+
+   //--- emergency (cos_emcy.c) ------------------------------
+   uint32_t    ulEmcyIdentifier;          // COB-ID of EMCY
+   #if COS_DICT_OBJ_1003 > 0
+   uint32_t    aulEmcyErrorField[COS_DICT_OBJ_1003];
+   uint8_t     ubEmcyErrorCount;
+   uint8_t     ubEmcyErrorNewPos;
+   #endif
+   #if COS_DICT_OBJ_1015 > 0
+   uint16_t    uwEmcyInhibitTime;         // inhibit timer value for EMCY
+   uint16_t    uwEmcyInhibitTick;         // ticks value for EMCY
+   #endif
+   #if COS_DICT_OBJ_1014 > 1
+   uint8_t     ubEmcyCount;
+   uint8_t     ubEmcyTrmPend;
+   uint8_t     aubEmcyQueue[COS_DICT_OBJ_1014][8];
+   #if COS_EMCY_STAT > 0
+   uint32_t    ulEmcyDrop;                // dropped EMCY messages
+   uint32_t    ulEmcyMerge;               // coalesced EMCY messages
+   uint8_t     ubEmcyLevelMax;            // highest EMCY queue level
+   #endif
+   #endif
+
+   //--- PDO copy plans (cos_pmap.c) -------------------------
+   #if (COS_PDO_MAPPING > 0) && (COS_PDO_RCV_NUMBER > 0)
+   CosPmap_ts  atsPmapRcv[COS_PDO_RCV_NUMBER];
+   #endif
+   #if (COS_PDO_MAPPING > 0) && (COS_PDO_TRM_NUMBER > 0)
+   CosPmap_ts  atsPmapTrm[COS_PDO_TRM_NUMBER];
+   #endif
+
+   //--- transmit PDO scheduler (cos_psch.c) -----------------
+   #if (COS_PDO_SCHED > 0) && (COS_PDO_TRM_NUMBER > 0)
+   uint32_t    aulPschEvent[COS_PDO_TRM_NUMBER];
+   uint16_t    auwPschInhibit[COS_PDO_TRM_NUMBER];
+   uint8_t     aubPschSync[COS_PDO_TRM_NUMBER];
+   uint8_t     aubPschPend[COS_PDO_TRM_NUMBER];
+   uint8_t     aubPschQueue[COS_PDO_TRM_NUMBER];
+   uint8_t     aubPschTrmPend[COS_PDO_TRM_NUMBER];
+   #if COS_PDO_MAPPING > 0
+   uint8_t     aubPschData[COS_PDO_TRM_NUMBER][8];
+   uint8_t     aubPschDlc[COS_PDO_TRM_NUMBER];
+   #endif
+   #endif
+
+   //--- heartbeat consumer timing wheel (cos_hbw.c) ---------
+   #if (COS_DICT_OBJ_1016 > 0) && (COS_NMT_HBC_WHEEL > 0)
+   uint16_t    auwHbwRound[COS_DICT_OBJ_1016];
+   uint8_t     aubHbwNext[COS_DICT_OBJ_1016];
+   uint8_t     aubHbwPrev[COS_DICT_OBJ_1016];
+   uint8_t     aubHbwSlot[COS_DICT_OBJ_1016];
+   uint8_t     aubHbwHead[COS_NMT_HBC_WHEEL + 1];
+   uint8_t     ubHbwCursor;
+   #endif
+
+   //--- layer setting services (cos_lss.c) ------------------
+   #if COS_LSS_SUPPORT > 0
+   uint8_t     ubLssMode;
+   uint8_t     ubLssBaudrate;
+   uint8_t     ubLssNodeId;
+   uint8_t     aubLssRcvData[8];
+   uint8_t     aubLssTrmData[8];
+   #if COS_LSS_FASTSCAN > 0
+   uint8_t     ubLssFastPos;
+   #endif
+   #endif
+
+   //--- LED management (cos_led.c) --------------------------
+   #if COS_LED_SUPPORT > 0
+   uint32_t    ulLedNetRedPattern;        // pattern for red network LED
+   uint32_t    ulLedNetGrnPattern;        // pattern for green network LED
+   uint8_t     ubLedEventCounter;         // counter for timer events
+   uint8_t     ubLedNetStatus;            // current network status
+   uint8_t     ubLedNetError;             // current network error
+   uint8_t     ubLedNetCode;              // current blinking of LEDs
+   #endif
+   #if COS_LED_SUPPORT > 1
+   uint32_t    ulLedModRedPattern;        // pattern for red module LED
+   uint32_t    ulLedModGrnPattern;        // pattern for green module LED
+   uint8_t     ubLedModStatus;            // current module status
+   #endif
+};
+
+typedef struct CosInst_s   CosInst_ts;
+
+
+/*----------------------------------------------------------------------------*\
+** Variables of module for external use                                       **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+extern CosInst_ts *  ptsCosInstG;         // data set of selected instance
+
+
+//-------------------------------------------------------------------
+// map the global variables of the stack to the selected data set
+//
+#define  ubCosMgrNodeAddressG       (ptsCosInstG->ubMgrNodeAddress)
+#define  ubCosMgrBaudrateG          (ptsCosInstG->ubMgrBaudrate)
+#define  ubCosMgrStatusG            (ptsCosInstG->ubMgrStatus)
+#define  uwCosMgrConfigG            (ptsCosInstG->uwMgrConfig)
+#if CP_SMALL_CODE == 0
+#define  tsCanPortG                 (ptsCosInstG->tsMgrCanPort)
+#endif
+
+#define  ubIdx1001_ErrorRegisterG   (ptsCosInstG->ubIdx1001_ErrorRegister)
+#define  ulIdx1002_StatusRegisterG  (ptsCosInstG->ulIdx1002_StatusRegister)
+#if COS_DICT_OBJ_1010 > 0
+#define  ubCos301ParmSaveG          (ptsCosInstG->ub301ParmSave)
+#define  ubCos301ParmLoadG          (ptsCosInstG->ub301ParmLoad)
+#endif
+
+#define  ulCosEmcyIdentifierG       (ptsCosInstG->ulEmcyIdentifier)
+#if COS_DICT_OBJ_1015 > 0
+#define  uwCosEmcyInhibitTimeG      (ptsCosInstG->uwEmcyInhibitTime)
+#endif
+
+
+
+/*----------------------------------------------------------------------------*\
+** Function prototypes                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------//
+// take precautions if compiled with C++ compiler                    //
+#ifdef __cplusplus                                                   //
+extern "C" {                                                         //
+#endif                                                               //
+//-------------------------------------------------------------------//
+
+
+/*!
+** \brief   Select CANopen Slave instance
+** \param   ubInstV     Instance number, 0 .. COS_INSTANCE_MAX - 1
+**
+** \return  Error code taken from the #CosErr_e enumeration
+**
+** The pointer #ptsCosInstG is set to the data set of the instance
+** \a ubInstV. Instance 0 is selected after program start.
+*/
+uint8_t  CosInstSelect(uint8_t ubInstV);
+
+
+/*!
+** \brief   Get selected CANopen Slave instance
+**
+** \return  Number of the selected instance
+*/
+uint8_t  CosInstSelected(void);
+
+
+
+//-------------------------------------------------------------------//
+#ifdef __cplusplus                                                   //
+}                                                                    //
+#endif                                                               //
+// end of C++ compiler wrapper                                       //
+//-------------------------------------------------------------------//
+
+#endif   // COS_INSTANCE_MAX > 1
+
+#endif   // COS_INST_H_
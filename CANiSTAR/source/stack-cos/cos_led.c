@@ -68,6 +68,7 @@
 **                                                                            **
 \*----------------------------------------------------------------------------*/
 
+#if COS_INSTANCE_MAX == 1
 
 static uint8_t  ubLedEventCounterS;    // counter for timer events
 
@@ -85,6 +86,20 @@ static uint32_t  ulLedModRedPatternS;    // pattern for red module LED
 static uint32_t  ulLedModGrnPatternS;    // pattern for green module LED
 #endif
 
+#else
+
+#define  ubLedEventCounterS   (ptsCosInstG->ubLedEventCounter)
+#define  ubLedNetStatusS      (ptsCosInstG->ubLedNetStatus)
+#define  ubLedNetErrorS       (ptsCosInstG->ubLedNetError)
+#define  ubLedNetCodeS        (ptsCosInstG->ubLedNetCode)
+#define  ulLedNetRedPatternS  (ptsCosInstG->ulLedNetRedPattern)
+#define  ulLedNetGrnPatternS  (ptsCosInstG->ulLedNetGrnPattern)
+#define  ubLedModStatusS      (ptsCosInstG->ubLedModStatus)
+#define  ulLedModRedPatternS  (ptsCosInstG->ulLedModRedPattern)
+#define  ulLedModGrnPatternS  (ptsCosInstG->ulLedModGrnPattern)
+
+#endif
+
 
 /*----------------------------------------------------------------------------*\
 ** Functions                                                                  **
@@ -101,9 +116,10 @@ static uint32_t  ulLedModGrnPatternS;    // pattern for green module LED
 void  CosLedInit(void)
 {
    //----------------------------------------------------------------
-   // setup event counter for LED blinking
+   // setup event counter for LED blinking, the call which finds the
+   // counter at 0 is the last one of the period
    //
-   ubLedEventCounterS  = COS_LED_PERIOD / COS_TIMER_PERIOD;
+   ubLedEventCounterS  = (COS_LED_PERIOD / COS_TIMER_PERIOD) - 1;
 
 
    //----------------------------------------------------------------
@@ -111,6 +127,7 @@ void  CosLedInit(void)
    //
    ubLedNetStatusS = eCosLedNet_INIT;
    ubLedNetErrorS  = eCosLedErr_OK;
+   ubLedNetCodeS   = 0xFF;
    ulLedNetRedPatternS = NET_RED_OFF;
    ulLedNetGrnPatternS = NET_GRN_INIT;
 
@@ -366,9 +383,10 @@ void  CosLedTmrEvent(void)
    #endif
 
    //----------------------------------------------------------------
-   // reload event counter for LED blinking
+   // reload event counter for LED blinking, this call counts as
+   // the last one of the period
    //
-   ubLedEventCounterS  = COS_LED_PERIOD / COS_TIMER_PERIOD;
+   ubLedEventCounterS  = (COS_LED_PERIOD / COS_TIMER_PERIOD) - 1;
 }
 
 
@@ -52,11 +52,23 @@
 ** Variables of module for internal use                                       **
 **                                                                            **
 \*----------------------------------------------------------------------------*/
+#if COS_INSTANCE_MAX == 1
 static uint8_t ubCosLssModeS;
 static uint8_t ubCosLssBaudrateS;
 static uint8_t ubCosLssNodeIdS;
 static uint8_t aubCosLssRcvDataS[8];
 static uint8_t aubCosLssTrmDataS[8];
+#if COS_LSS_FASTSCAN > 0
+static uint8_t ubCosLssFastPosS;          // LSS address part to be scanned
+#endif
+#else
+#define  ubCosLssModeS        (ptsCosInstG->ubLssMode)
+#define  ubCosLssBaudrateS    (ptsCosInstG->ubLssBaudrate)
+#define  ubCosLssNodeIdS      (ptsCosInstG->ubLssNodeId)
+#define  aubCosLssRcvDataS    (ptsCosInstG->aubLssRcvData)
+#define  aubCosLssTrmDataS    (ptsCosInstG->aubLssTrmData)
+#define  ubCosLssFastPosS     (ptsCosInstG->ubLssFastPos)
+#endif
 
 /*----------------------------------------------------------------------------*\
 ** Definitions                                                                **
@@ -66,12 +78,26 @@ static uint8_t aubCosLssTrmDataS[8];
 #define  ID_LSS_RCV     0x07E5   // identifier for reception (from LSS master)
 #define  ID_LSS_TRM     0x07E4   // identifier for transmission (to LSS master)
 
+#define  LSS_NODE_ID_INVALID  0xFF    // node-ID not configured
+#define  LSS_FASTSCAN_RESET   0x80    // BitChecked: restart the scan
+
+
 
 /*----------------------------------------------------------------------------*\
 ** Functions                                                                  **
 **                                                                            **
 \*----------------------------------------------------------------------------*/
 
+//----------------------------------------------------------------------------//
+// CosLssTrmResponse()                                                        //
+// send the response prepared in aubCosLssTrmDataS[]                          //
+//----------------------------------------------------------------------------//
+static void CosLssTrmResponse(void)
+{
+   CpCoreBufferSetData(&tsCanPortG, eCosBuf_LSS_TRM, &aubCosLssTrmDataS[0]);
+   CpCoreBufferSend(&tsCanPortG, eCosBuf_LSS_TRM);
+}
+
 
 //----------------------------------------------------------------------------//
 // CosLssConfigureNodeId()                                                    //
@@ -124,8 +150,7 @@ void  CosLssConfigureBitTiming(void)
    //----------------------------------------------------------------
    // send response message
    //
-   CpCoreBufferSetData(&tsCanPortG, eCosBuf_LSS_TRM, &aubCosLssTrmDataS[0]);
-   CpCoreBufferSend(&tsCanPortG, eCosBuf_LSS_TRM);
+   CosLssTrmResponse();
 }
 
 
@@ -172,11 +197,116 @@ void  CosLssConfigureNodeId(void)
    //----------------------------------------------------------------
    // send response message
    //
-   CpCoreBufferSetData(&tsCanPortG, eCosBuf_LSS_TRM, &aubCosLssTrmDataS[0]);
-   CpCoreBufferSend(&tsCanPortG, eCosBuf_LSS_TRM);
+   CosLssTrmResponse();
 }
 
 
+#if COS_LSS_FASTSCAN > 0
+//----------------------------------------------------------------------------//
+// CosLssFastscan()                                                           //
+// compare a part of the LSS address with the value of the LSS master         //
+//----------------------------------------------------------------------------//
+void  CosLssFastscan(void)
+{
+   uint32_t ulIdNumberT;         // value of the LSS master
+   uint32_t ulIdentityT;         // value of object 1018h
+   uint8_t  ubBitCheckedT;       // lowest bit to compare
+   uint8_t  ubLssSubT;           // part of the LSS address to compare
+   uint8_t  ubLssNextT;          // part of the LSS address to scan next
+   uint8_t  ubDataCntT;          // counter for response message
+
+
+   //----------------------------------------------------------------
+   // only unconfigured slaves in LSS waiting state take part
+   //
+   if(ubCosLssModeS != eLSS_MODE_WAIT)          return;
+   if(ubCosLssNodeIdS != LSS_NODE_ID_INVALID)   return;
+
+   ubBitCheckedT = aubCosLssRcvDataS[5];
+   ubLssSubT     = aubCosLssRcvDataS[6];
+   ubLssNextT    = aubCosLssRcvDataS[7];
+
+   if(ubBitCheckedT == LSS_FASTSCAN_RESET)
+   {
+      //--------------------------------------------------------
+      // start of a new scan, every slave confirms its presence
+      //
+      ubCosLssFastPosS = 0;
+   }
+   else
+   {
+      if((ubBitCheckedT > 31) || (ubLssSubT > 3) || (ubLssNextT > 3)) return;
+
+      //--------------------------------------------------------
+      // a slave that did not match a previous part of the
+      // LSS address does not answer any more
+      //
+      if(ubLssSubT != ubCosLssFastPosS) return;
+
+      switch(ubLssSubT)
+      {
+         case 0:
+            ulIdentityT = ulIdx1018_VendorIdC;
+            break;
+
+         case 1:
+            ulIdentityT = ulIdx1018_ProductCodeC;
+            break;
+
+         case 2:
+            ulIdentityT = ulIdx1018_RevisionNumC;
+            break;
+
+         default:
+            ulIdentityT = CosMgrGetSerialNumber();
+            break;
+      }
+
+      ulIdNumberT = aubCosLssRcvDataS[4];
+      ulIdNumberT = ulIdNumberT << 8;
+      ulIdNumberT = ulIdNumberT | aubCosLssRcvDataS[3];
+      ulIdNumberT = ulIdNumberT << 8;
+      ulIdNumberT = ulIdNumberT | aubCosLssRcvDataS[2];
+      ulIdNumberT = ulIdNumberT << 8;
+      ulIdNumberT = ulIdNumberT | aubCosLssRcvDataS[1];
+
+      //--------------------------------------------------------
+      // compare bit 31 down to bit BitChecked
+      //
+      if((ulIdNumberT ^ ulIdentityT) & (0xFFFFFFFF << ubBitCheckedT)) return;
+
+      //--------------------------------------------------------
+      // this part of the LSS address is complete, a wrap-around
+      // of LSSNext means the complete LSS address matches
+      //
+      if(ubBitCheckedT == 0)
+      {
+         ubCosLssFastPosS = ubLssNextT;
+         if(ubLssNextT < ubLssSubT)
+         {
+            ubCosLssModeS = eLSS_MODE_CONFIG;
+         }
+      }
+   }
+
+
+   //----------------------------------------------------------------
+   // prepare response message
+   //
+   aubCosLssTrmDataS[0] = eLSS_CMD_IDENT_SLAVE_RES;
+   for(ubDataCntT = 1; ubDataCntT < 8; ubDataCntT++)
+   {
+      aubCosLssTrmDataS[ubDataCntT] = 0x00;
+   }
+
+   //----------------------------------------------------------------
+   // send response message
+   //
+   CosLssTrmResponse();
+}
+#endif
+
+
 //----------------------------------------------------------------------------//
 // CosLssInit()                                                               //
 // initialize the LSS module                                                  //
@@ -217,6 +347,9 @@ void  CosLssInit(void)
    // default mode is LSS waiting
    //
    ubCosLssModeS = eLSS_MODE_WAIT;
+   #if COS_LSS_FASTSCAN > 0
+   ubCosLssFastPosS = 0;
+   #endif
 }
 
 
@@ -274,8 +407,7 @@ void  CosLssInquiryService(uint8_t ubServiceV)
    //----------------------------------------------------------------
    // send response message
    //
-   CpCoreBufferSetData(&tsCanPortG, eCosBuf_LSS_TRM, &aubCosLssTrmDataS[0]);
-   CpCoreBufferSend(&tsCanPortG, eCosBuf_LSS_TRM);
+   CosLssTrmResponse();
 
 }
 
@@ -350,6 +482,13 @@ void  CosLssMessageHandler(void)
          }
          break;
 
+      //--- LSS Fastscan ----------------------------------
+      #if COS_LSS_FASTSCAN > 0
+      case eLSS_CMD_FASTSCAN:
+         CosLssFastscan();
+         break;
+      #endif
+
       //--- Unknown command -------------------------------
       default:
 
@@ -401,8 +540,7 @@ void  CosLssStoreConfiguration(void)
       aubCosLssTrmDataS[ubDataCntT] = 0x00;
    }
 
-   CpCoreBufferSetData(&tsCanPortG, eCosBuf_LSS_TRM, &aubCosLssTrmDataS[0]);
-   CpCoreBufferSend(&tsCanPortG, eCosBuf_LSS_TRM);
+   CosLssTrmResponse();
 
 
 }
@@ -503,8 +641,7 @@ void  CosLssSwitchModeSelective(uint8_t ubServiceV)
       //--------------------------------------------------------
       // send response message
       //
-      CpCoreBufferSetData(&tsCanPortG, eCosBuf_LSS_TRM, &aubCosLssTrmDataS[0]);
-      CpCoreBufferSend(&tsCanPortG, eCosBuf_LSS_TRM);
+      CosLssTrmResponse();
 
    }
 }
@@ -130,6 +130,21 @@ void  CosLssConfigureBitTiming(void);
 void  CosLssConfigureNodeId(void);
 
 
+#if COS_LSS_FASTSCAN > 0
+/*!
+** \brief   LSS Fastscan
+**
+** By means of the LSS Fastscan service the LSS master identifies the
+** LSS address of an unconfigured LSS Slave bit by bit. The slave
+** answers with the identify slave response if the bits 31 .. BitChecked
+** of the requested part of its LSS address match. After the last part
+** of the LSS address has matched the slave is in configuration mode.
+** The serial number is taken from CosMgrGetSerialNumber().
+*/
+void  CosLssFastscan(void);
+#endif
+
+
 /*!
 ** \brief   Initialize the LSS service
 **
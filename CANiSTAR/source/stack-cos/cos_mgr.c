@@ -44,11 +44,13 @@
 
 #include "cos_dict.h"            // object dictionary
 #include "cos_emcy.h"            // Emergency service
+#include "cos_hbw.h"             // Heartbeat consumer timing wheel
 #include "cos_led.h"             // LED support
 #include "cos_lss.h"             // LSS support
 #include "cos_nmt.h"             // NMT service
 #include "cos_nvm.h"             // Non-volatile memory access
 #include "cos_pdo.h"             // PDO service
+#include "cos_psch.h"            // PDO scheduler
 #include "cos_sdo.h"             // SDO services
 #include "cos_sync.h"            // SYNC service
 #include "cos_time.h"            // TIME service
@@ -106,11 +108,17 @@
 #include "cos406.h"              // Objects from CiA 406, encoder
 #endif
 
+#if (COS_SDO_STAT > 0) || (COS_MGR_STAT > 0) || (COS_BUS_STAT > 0)
+#include "mc_tmr.h"              // timer tick for statistic
+#include <string.h>
+#endif
+
 /*----------------------------------------------------------------------------*\
 ** Variables of module                                                        **
 **                                                                            **
 \*----------------------------------------------------------------------------*/
 
+#if COS_INSTANCE_MAX == 1
 uint8_t        ubCosMgrNodeAddressG;      // node address
 uint8_t        ubCosMgrBaudrateG;         // baudrate (required for LSS)
 #if CP_SMALL_CODE == 0
@@ -122,22 +130,166 @@ CpPort_ts      tsCanPortG;                // CAN interface
 extern uint8_t  ubCos301ParmSaveG;        // requested save operation
 extern uint8_t  ubCos301ParmLoadG;        // requested load operation
 #endif
+#endif
 
 
 #if COS_MGR_INT == 0
 extern uint32_t         ulCpRcvBufferFlagG;
 extern uint32_t         ulCpTrmBufferFlagG;
 extern CpCanMsg_ts      atsCanMsgG[];
+
+//-------------------------------------------------------------------
+// position of the lowest bit set inside a nibble, used to jump to
+// the pending buffers in CosMgrProcessMsg()
+//
+static CPP_CONST uint8_t aubCosMgrBitPosC[16] = {
+   0, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0
+};
 #endif
 
+#if COS_INSTANCE_MAX == 1
 uint8_t  ubCosMgrStatusG;                 // status of CANopen stack
 uint16_t uwCosMgrConfigG;                 // configuration of CANopen stack
 
+static uint8_t ubCosMgrErrStateS;         // last CAN error state
+#else
+#define  ubCosMgrErrStateS    (ptsCosInstG->ubMgrErrState)
+#endif
+
+#if (COS_DICT_OBJ_1016 > 0) && (COS_NMT_HBC_MERGE > 0)
+extern uint8_t  aubCosNmtHbConsNodeG[];   // monitored node-IDs
+extern uint16_t auwCosNmtHbConsTimeG[];   // consumer heartbeat times
+
+//-------------------------------------------------------------------
+// consumer entry of a node-ID, COS_MGR_HBC_NONE if the node-ID is
+// not monitored
+//
+#define  COS_MGR_HBC_NONE     0xFF
+
+#if COS_INSTANCE_MAX == 1
+static uint8_t  aubCosMgrHbcEntryS[128];
+#else
+#define  aubCosMgrHbcEntryS   (ptsCosInstG->aubMgrHbcEntry)
+#endif
+#endif
+
+#if COS_SDO_STAT > 0
+static CosMgrSdoStat_ts tsCosMgrSdoStatS; // SDO statistic
+static uint32_t  ulCosMgrSdoTickS;        // time of last SDO request, us
+static uint8_t   ubCosMgrSdoPendS;        // SDO request not answered
+static uint8_t   ubCosMgrSdoTypeS;        // transfer type of request
+static uint8_t   ubCosMgrSdoBlkS;         // block download in progress
+#endif
+
+#if COS_MGR_STAT > 0
+static CosMgrStat_ts tsCosMgrStatS;       // main loop statistic
+#endif
+
+#if COS_BUS_STAT > 0
+//-------------------------------------------------------------------
+// counters of one message buffer of the stack, the times are
+// measured in microseconds, the jitter is limited to 16 bit
+//
+struct CosMgrBusObj_s {
+   uint32_t    ulRcvCount;
+   uint32_t    ulTrmCount;
+   uint32_t    ulTickLast;                // time of last frame
+   uint32_t    ulPeriodLast;              // last frame interval
+   uint16_t    uwJitterMax;               // largest change of interval
+};
+
+static struct CosMgrBusObj_s atsCosMgrBusObjS[COS_BUFFER_MAX];
+static uint32_t  ulCosMgrBusTickS;        // start of measuring window, us
+static uint32_t  ulCosMgrBusBitsS;        // bits in measuring window
+static uint16_t  uwCosMgrBusFramesS;      // frames in measuring window
+static uint16_t  uwCosMgrBusRateS;        // frames of last window
+static uint8_t   ubCosMgrBusLoadS;        // bus load of last window
+
+//-------------------------------------------------------------------
+// bitrate in kBit/s, the index is the CP_BAUD enumeration
+//
+static CPP_CONST uint16_t auwCosMgrBitrateC[] = {
+   10, 20, 50, 100, 125, 250, 500, 800, 1000
+};
+#endif
+
+#if COS_DICT_OBJ_1010 > 0
+#if COS_INSTANCE_MAX == 1
+static uint16_t  uwCosMgrNvmSelS;         // parameter selection
+static uint8_t   ubCosMgrNvmStepS;        // step of NVM operation
+static uint8_t   ubCosMgrNvmGroupS;       // parameter group to save
+static uint8_t   ubCosMgrNvmFailS;        // failed NVM accesses
+#else
+#define  uwCosMgrNvmSelS      (ptsCosInstG->uwMgrNvmSel)
+#define  ubCosMgrNvmStepS     (ptsCosInstG->ubMgrNvmStep)
+#define  ubCosMgrNvmGroupS    (ptsCosInstG->ubMgrNvmGroup)
+#define  ubCosMgrNvmFailS     (ptsCosInstG->ubMgrNvmFail)
+#endif
+#endif
+
+//-------------------------------------------------------------------
+// declaration of internal functions
+//
+#if COS_DICT_OBJ_1010 > 0
+static void    CosMgrNvmSaveStart(uint8_t ubGroupV);
+static void    CosMgrNvmStep(void);
+#endif
+
+#if (COS_DICT_OBJ_1016 > 0) && (COS_NMT_HBC_MERGE > 0)
+static void    CosMgrHbcHandler(CpCanMsg_ts * ptsCanMsgV);
+#endif
+
+#if COS_MGR_FIFO > 0
+static void    CosMgrProcessFifo(void);
+#endif
+
+#if COS_SDO_STAT > 0
+static void    CosMgrSdoStatRcv(uint8_t ubCommandV);
+static void    CosMgrSdoStatTrm(void);
+#endif
+
+#if (COS_SDO_STAT > 0) || (COS_MGR_STAT > 0)
+static uint8_t CosMgrTickClass(uint32_t ulTickV, uint8_t ubClassMaxV);
+#endif
+
+#if COS_BUS_STAT > 0
+static void    CosMgrBusStatFrame(CpCanMsg_ts * ptsCanMsgV,
+                                  uint8_t ubBufferIdxV, uint8_t ubTrmV);
+#endif
+
 /*----------------------------------------------------------------------------*\
 ** Definitions                                                                **
 **                                                                            **
 \*----------------------------------------------------------------------------*/
 
+//-------------------------------------------------------------------
+// steps of a save / restore operation, CosMgrNvmStep() performs
+// one step for each call of CosMgrProcess()
+//
+enum CosMgrNvmStep_e {
+   eCOS_MGR_NVM_IDLE = 0,
+   eCOS_MGR_NVM_SAVE_COM,
+   eCOS_MGR_NVM_SAVE_APP,
+   eCOS_MGR_NVM_SAVE_MAN,
+   eCOS_MGR_NVM_SELECT,
+   eCOS_MGR_NVM_CHECKSUM,
+   eCOS_MGR_NVM_DONE
+};
+
+//-------------------------------------------------------------------
+// length of the measuring window for frame rate and bus load
+//
+#define  COS_MGR_BUS_WINDOW   1000000L
+
+//-------------------------------------------------------------------
+// a message buffer which receives more than one COB-ID has no frame
+// interval, the jitter of the buffer is not measured
+//
+#if (COS_NMT_HBC_MERGE > 0) && (COS_DICT_OBJ_1016 > 0)
+#define  COS_MGR_BUS_SHARED(BUF)    ((BUF) == eCosBuf_NMT_HBC)
+#else
+#define  COS_MGR_BUS_SHARED(BUF)    (0)
+#endif
 
 
 /*----------------------------------------------------------------------------*\
@@ -145,6 +297,165 @@ uint16_t uwCosMgrConfigG;                 // configuration of CANopen stack
 **                                                                            **
 \*----------------------------------------------------------------------------*/
 
+//----------------------------------------------------------------------------//
+// CosMgrBusStatFrame()                                                       //
+// count one frame of a message buffer, called by the CAN callbacks           //
+//----------------------------------------------------------------------------//
+#if COS_BUS_STAT > 0
+static void CosMgrBusStatFrame(CpCanMsg_ts * ptsCanMsgV,
+                               uint8_t ubBufferIdxV, uint8_t ubTrmV)
+{
+   struct CosMgrBusObj_s * ptsObjT;
+   uint32_t    ulTickT;
+   uint32_t    ulBitrateT;
+   uint32_t    ulPeriodT;
+   uint32_t    ulJitterT;
+   uint8_t     ubDataBitsT;
+
+   ulTickT = McTmrHResTick();
+
+   //----------------------------------------------------------------
+   // the counters are kept for the message buffers of the stack,
+   // the frames of the application buffers are part of the bus load
+   //
+   if((ubBufferIdxV >= 1) && (ubBufferIdxV <= COS_BUFFER_MAX))
+   {
+      ptsObjT = &atsCosMgrBusObjS[ubBufferIdxV - 1];
+
+      //--------------------------------------------------------
+      // jitter of the frame interval, it is defined after the
+      // third frame of the buffer
+      //
+      ulPeriodT = ulTickT - ptsObjT->ulTickLast;
+      if( ((ptsObjT->ulRcvCount + ptsObjT->ulTrmCount) > 1) &&
+          (!COS_MGR_BUS_SHARED(ubBufferIdxV)) )
+      {
+         if(ulPeriodT > ptsObjT->ulPeriodLast)
+         {
+            ulJitterT = ulPeriodT - ptsObjT->ulPeriodLast;
+         }
+         else
+         {
+            ulJitterT = ptsObjT->ulPeriodLast - ulPeriodT;
+         }
+         if(ulJitterT > 0xFFFF) ulJitterT = 0xFFFF;
+         if(ulJitterT > ptsObjT->uwJitterMax)
+         {
+            ptsObjT->uwJitterMax = (uint16_t) ulJitterT;
+         }
+      }
+      ptsObjT->ulPeriodLast = ulPeriodT;
+      ptsObjT->ulTickLast   = ulTickT;
+
+      if(ubTrmV) ptsObjT->ulTrmCount++;
+      else       ptsObjT->ulRcvCount++;
+   }
+
+   //----------------------------------------------------------------
+   // close the measuring window, if nothing was counted during
+   // the last window the values are 0
+   //
+   if((ulTickT - ulCosMgrBusTickS) >= COS_MGR_BUS_WINDOW)
+   {
+      if((ulTickT - ulCosMgrBusTickS) < (2 * COS_MGR_BUS_WINDOW))
+      {
+         //--- bits * 100 / (kBit/s * 1000) ---------------------
+         ulBitrateT = 0;
+         if(ubCosMgrBaudrateG < sizeof(auwCosMgrBitrateC) / 2)
+         {
+            ulBitrateT = ulCosMgrBusBitsS /
+                         (auwCosMgrBitrateC[ubCosMgrBaudrateG] * 10L);
+            if(ulBitrateT > 100) ulBitrateT = 100;
+         }
+
+         uwCosMgrBusRateS  = uwCosMgrBusFramesS;
+         ubCosMgrBusLoadS  = (uint8_t) ulBitrateT;
+         ulCosMgrBusTickS += COS_MGR_BUS_WINDOW;
+      }
+      else
+      {
+         uwCosMgrBusRateS  = 0;
+         ubCosMgrBusLoadS  = 0;
+         ulCosMgrBusTickS  = ulTickT;
+      }
+      uwCosMgrBusFramesS = 0;
+      ulCosMgrBusBitsS   = 0;
+   }
+
+   //----------------------------------------------------------------
+   // length of the frame including the worst case number of
+   // stuff bits
+   //
+   ubDataBitsT = 0;
+   if(!CpMsgIsRemote(ptsCanMsgV))
+   {
+      ubDataBitsT = CpMsgGetDlc(ptsCanMsgV);
+      if(ubDataBitsT > 8) ubDataBitsT = 8;
+      ubDataBitsT = ubDataBitsT * 8;
+   }
+
+   if(CpMsgIsExtended(ptsCanMsgV))
+   {
+      ulCosMgrBusBitsS += 67 + ubDataBitsT + ((53 + ubDataBitsT) / 4);
+   }
+   else
+   {
+      ulCosMgrBusBitsS += 47 + ubDataBitsT + ((33 + ubDataBitsT) / 4);
+   }
+   uwCosMgrBusFramesS++;
+}
+#endif
+
+
+//----------------------------------------------------------------------------//
+// CosMgrBusStatistic()                                                       //
+// read bus statistic                                                         //
+//----------------------------------------------------------------------------//
+#if COS_BUS_STAT > 0
+void CosMgrBusStatistic(CosMgrBusStat_ts * ptsStatV, uint8_t ubBufferIdxV,
+                        uint8_t ubClearV)
+{
+   uint8_t  ubBufferT;
+
+   memset(ptsStatV, 0, sizeof(CosMgrBusStat_ts));
+
+   //----------------------------------------------------------------
+   // the values are changed by the CAN interrupt handler, they are
+   // read and cleared with the interrupt locked, one buffer after
+   // the other; a window without any frame has not been closed by
+   // CosMgrBusStatFrame()
+   //
+   CpCoreIntLock(&tsCanPortG);
+   if((McTmrHResTick() - ulCosMgrBusTickS) < (2 * COS_MGR_BUS_WINDOW))
+   {
+      ptsStatV->uwFrameRate = uwCosMgrBusRateS;
+      ptsStatV->ubBusLoad   = ubCosMgrBusLoadS;
+   }
+   CpCoreIntUnlock(&tsCanPortG);
+
+   for(ubBufferT = 1; ubBufferT <= COS_BUFFER_MAX; ubBufferT++)
+   {
+      if((ubBufferIdxV != 0) && (ubBufferIdxV != ubBufferT)) continue;
+
+      CpCoreIntLock(&tsCanPortG);
+      ptsStatV->ulRcvCount += atsCosMgrBusObjS[ubBufferT - 1].ulRcvCount;
+      ptsStatV->ulTrmCount += atsCosMgrBusObjS[ubBufferT - 1].ulTrmCount;
+      if(atsCosMgrBusObjS[ubBufferT - 1].uwJitterMax > ptsStatV->uwJitterMax)
+      {
+         ptsStatV->uwJitterMax = atsCosMgrBusObjS[ubBufferT - 1].uwJitterMax;
+      }
+
+      if(ubClearV)
+      {
+         memset(&atsCosMgrBusObjS[ubBufferT - 1], 0,
+                sizeof(struct CosMgrBusObj_s));
+      }
+      CpCoreIntUnlock(&tsCanPortG);
+   }
+}
+#endif
+
+
 
 //----------------------------------------------------------------------------//
 // CosMgrCanErrHandler()                                                      //
@@ -152,8 +463,6 @@ uint16_t uwCosMgrConfigG;                 // configuration of CANopen stack
 //----------------------------------------------------------------------------//
 uint8_t  CosMgrCanErrHandler(CpState_ts * ptsStateV)
 {
-   static uint8_t ubLastErrorT = CP_STATE_BUS_ACTIVE;
-
    #if COS_BUS_EMCY == 1
    uint8_t  aubEmcyAddCode[5];         // additional code for emergency message
    #endif
@@ -179,9 +488,9 @@ uint8_t  CosMgrCanErrHandler(CpState_ts * ptsStateV)
          #endif
 
          #if COS_BUS_EMCY == 1
-         if(ubLastErrorT != CP_STATE_BUS_ACTIVE)
+         if(ubCosMgrErrStateS != CP_STATE_BUS_ACTIVE)
          {
-            if(ubLastErrorT == CP_STATE_BUS_OFF)
+            if(ubCosMgrErrStateS == CP_STATE_BUS_OFF)
             {
                CosEmcySend(EMCY_ERR_CAN_BUSOFF_RECOVER, (uint8_t *) 0);
             }
@@ -189,7 +498,7 @@ uint8_t  CosMgrCanErrHandler(CpState_ts * ptsStateV)
          }
          #endif
 
-         ubLastErrorT = CP_STATE_BUS_ACTIVE;
+         ubCosMgrErrStateS = CP_STATE_BUS_ACTIVE;
          break;
 
 
@@ -208,7 +517,7 @@ uint8_t  CosMgrCanErrHandler(CpState_ts * ptsStateV)
          #endif
 
          #if COS_BUS_EMCY == 1
-         if(ubLastErrorT != CP_STATE_BUS_WARN)
+         if(ubCosMgrErrStateS != CP_STATE_BUS_WARN)
          {
             aubEmcyAddCode[0] = ptsStateV->ubCanErrState;
             aubEmcyAddCode[1] = ptsStateV->ubCanErrType;
@@ -220,7 +529,7 @@ uint8_t  CosMgrCanErrHandler(CpState_ts * ptsStateV)
          #endif
 
 
-         ubLastErrorT = CP_STATE_BUS_WARN;
+         ubCosMgrErrStateS = CP_STATE_BUS_WARN;
          break;
 
 
@@ -239,7 +548,7 @@ uint8_t  CosMgrCanErrHandler(CpState_ts * ptsStateV)
          #endif
 
          #if COS_BUS_EMCY == 1
-         if(ubLastErrorT != CP_STATE_BUS_PASSIVE)
+         if(ubCosMgrErrStateS != CP_STATE_BUS_PASSIVE)
          {
             aubEmcyAddCode[0] = ptsStateV->ubCanErrState;
             aubEmcyAddCode[1] = ptsStateV->ubCanErrType;
@@ -251,7 +560,7 @@ uint8_t  CosMgrCanErrHandler(CpState_ts * ptsStateV)
          #endif
 
 
-         ubLastErrorT = CP_STATE_BUS_PASSIVE;
+         ubCosMgrErrStateS = CP_STATE_BUS_PASSIVE;
          break;
 
       //---------------------------------------------------
@@ -262,11 +571,11 @@ uint8_t  CosMgrCanErrHandler(CpState_ts * ptsStateV)
          #if COS_LED_SUPPORT > 0
          CosLedNetworkError(eCosLedErr_BUS_OFF);
          #endif
-         if(ubLastErrorT != CP_STATE_BUS_OFF)
+         if(ubCosMgrErrStateS != CP_STATE_BUS_OFF)
          {
             CosMgrOnBusOff();
             ubCosMgrStatusG = eCOS_MGR_BUS_OFF;
-            ubLastErrorT = CP_STATE_BUS_OFF;
+            ubCosMgrErrStateS = CP_STATE_BUS_OFF;
          }
          break;
 
@@ -280,7 +589,7 @@ uint8_t  CosMgrCanErrHandler(CpState_ts * ptsStateV)
          #endif
          CosMgrOnBusOff();
          ubCosMgrStatusG = eCOS_MGR_BUS_OFF;
-         ubLastErrorT = CP_STATE_BUS_OFF;
+         ubCosMgrErrStateS = CP_STATE_BUS_OFF;
          break;
    }
 
@@ -295,8 +604,20 @@ uint8_t  CosMgrCanErrHandler(CpState_ts * ptsStateV)
 /*!
 ** \callgraph
 */
+#if COS_MGR_FIFO > 0
+static uint8_t CosMgrCanRcvService(CpCanMsg_ts * ptsCanMsgV,
+                                   uint8_t ubBufferIdxV)
+#else
 uint8_t CosMgrCanRcvHandler(CpCanMsg_ts * ptsCanMsgV, uint8_t ubBufferIdxV)
+#endif
 {
+   #if (COS_SDO_STAT > 0) && (COS_MGR_FIFO == 0)
+   uint8_t  aubSdoDataT[8];            // SDO request for the statistic
+   #endif
+
+   #if (COS_BUS_STAT > 0) && (COS_MGR_FIFO == 0)
+   CosMgrBusStatFrame(ptsCanMsgV, ubBufferIdxV, 0);
+   #endif
 
    //----------------------------------------------------------------
    // test for buffer overrun
@@ -330,6 +651,9 @@ uint8_t CosMgrCanRcvHandler(CpCanMsg_ts * ptsCanMsgV, uint8_t ubBufferIdxV)
          if( CosNmtGetNodeState() == NODE_STATE_OPERATIONAL)
          {
             CosSyncMessageHandler();
+            #if COS_PDO_SCHED > 0
+            CosPschSync();
+            #endif
          }
          break;
       #endif
@@ -340,6 +664,11 @@ uint8_t CosMgrCanRcvHandler(CpCanMsg_ts * ptsCanMsgV, uint8_t ubBufferIdxV)
       case eCosBuf_SDO_RCV:
          if( CosNmtGetNodeState() != NODE_STATE_STOPPED)
          {
+            #if (COS_SDO_STAT > 0) && (COS_MGR_FIFO == 0)
+            CpCoreBufferGetData(&tsCanPortG, eCosBuf_SDO_RCV,
+                                &aubSdoDataT[0]);
+            CosMgrSdoStatRcv(aubSdoDataT[0]);
+            #endif
             CosSdoMessageHandler();
          }
          break;
@@ -360,27 +689,32 @@ uint8_t CosMgrCanRcvHandler(CpCanMsg_ts * ptsCanMsgV, uint8_t ubBufferIdxV)
 
       //---------------------------------------------------
       // NMT heartbeat consumer messages
-      // it is limited to 4 heartbeat consumers here
+      // it is limited to 4 heartbeat consumers here, unless
+      // they share one message buffer
       //
-      #if COS_DICT_OBJ_1016 > 0
+      #if (COS_DICT_OBJ_1016 > 0) && (COS_NMT_HBC_MERGE > 0)
+      case eCosBuf_NMT_HBC:
+         CosMgrHbcHandler(ptsCanMsgV);
+         break;
+      #elif COS_DICT_OBJ_1016 > 0
       case (eCosBuf_NMT_HBC + 0):
          CosNmtHBConsHandler(0);
          break;
       #endif
 
-      #if COS_DICT_OBJ_1016 > 1
+      #if (COS_DICT_OBJ_1016 > 1) && (COS_NMT_HBC_MERGE == 0)
       case (eCosBuf_NMT_HBC + 1):
          CosNmtHBConsHandler(1);
          break;
       #endif
 
-      #if COS_DICT_OBJ_1016 > 2
+      #if (COS_DICT_OBJ_1016 > 2) && (COS_NMT_HBC_MERGE == 0)
       case (eCosBuf_NMT_HBC + 2):
          CosNmtHBConsHandler(2);
          break;
       #endif
 
-      #if COS_DICT_OBJ_1016 > 3
+      #if (COS_DICT_OBJ_1016 > 3) && (COS_NMT_HBC_MERGE == 0)
       case (eCosBuf_NMT_HBC + 3):
          CosNmtHBConsHandler(3);
          break;
@@ -506,13 +840,75 @@ uint8_t CosMgrCanRcvHandler(CpCanMsg_ts * ptsCanMsgV, uint8_t ubBufferIdxV)
 }
 
 
+//----------------------------------------------------------------------------//
+// CosMgrCanRcvHandler()                                                      //
+// put messages which are not time critical into the receive FIFO             //
+//----------------------------------------------------------------------------//
+#if COS_MGR_FIFO > 0
+uint8_t CosMgrCanRcvHandler(CpCanMsg_ts * ptsCanMsgV, uint8_t ubBufferIdxV)
+{
+   #if COS_BUS_STAT > 0
+   CosMgrBusStatFrame(ptsCanMsgV, ubBufferIdxV, 0);
+   #endif
+
+   //----------------------------------------------------------------
+   // these services are processed by CosMgrProcess(), a burst of
+   // messages does not overrun the message buffer then
+   //
+   switch(ubBufferIdxV)
+   {
+      case eCosBuf_SDO_RCV:
+         //--------------------------------------------------
+         // the response time includes the time in the FIFO
+         //
+         #if COS_SDO_STAT > 0
+         CosMgrSdoStatRcv(CpMsgGetData(ptsCanMsgV, 0));
+         #endif
+
+      #if COS_LSS_SUPPORT > 0
+      case eCosBuf_LSS_RCV:
+      #endif
+
+      #if COS_SDO_CLIENT > 0
+      case eCosBuf_SDOC_RCV:
+      #endif
+
+      #if COS_DICT_OBJ_1016 > 0
+      case (eCosBuf_NMT_HBC + 0):
+      #endif
+
+      #if (COS_DICT_OBJ_1016 > 1) && (COS_NMT_HBC_MERGE == 0)
+      case (eCosBuf_NMT_HBC + 1):
+      #endif
+
+      #if (COS_DICT_OBJ_1016 > 2) && (COS_NMT_HBC_MERGE == 0)
+      case (eCosBuf_NMT_HBC + 2):
+      #endif
+
+      #if (COS_DICT_OBJ_1016 > 3) && (COS_NMT_HBC_MERGE == 0)
+      case (eCosBuf_NMT_HBC + 3):
+      #endif
+         return(CP_CALLBACK_PUSH_FIFO);
+
+      default:
+         break;
+   }
+
+   return(CosMgrCanRcvService(ptsCanMsgV, ubBufferIdxV));
+}
+#endif
+
+
 //----------------------------------------------------------------------------//
 // CosMgrCanTransmitHandler()                                                 //
 // do transmit message handling                                               //
 //----------------------------------------------------------------------------//
-uint8_t CosMgrCanTrmHandler(CpCanMsg_ts * CPP_PARM_UNUSED(ptsCanMsgV),
+uint8_t CosMgrCanTrmHandler(CpCanMsg_ts * ptsCanMsgV,
                             uint8_t ubBufferIdxV)
 {
+   #if COS_BUS_STAT > 0
+   CosMgrBusStatFrame(ptsCanMsgV, ubBufferIdxV, 1);
+   #endif
 
    //----------------------------------------------------------------
    // set the state to eCOS_MGR_RUN after the boot-up message
@@ -567,8 +963,29 @@ uint8_t CosMgrCanTrmHandler(CpCanMsg_ts * CPP_PARM_UNUSED(ptsCanMsgV),
          #endif
          break;
 
-      default:
+      #if COS_DICT_OBJ_1014 > 1
+      case eCosBuf_EMCY:
+         CosEmcyTrmEvent();
+         break;
+      #endif
+
+      #if COS_SDO_STAT > 0
+      case eCosBuf_SDO_TRM:
+         CosMgrSdoStatTrm();
+         break;
+      #endif
 
+      default:
+         //--------------------------------------------------
+         // the next queued frame of a transmit PDO
+         //
+         #if (COS_PDO_SCHED > 0) && (COS_PDO_TRM_NUMBER > 0)
+         if( (ubBufferIdxV >= eCosBuf_PDO1_TRM) &&
+             (ubBufferIdxV <  eCosBuf_PDO1_TRM + COS_PDO_TRM_NUMBER) )
+         {
+            CosPschTrmEvent(ubBufferIdxV - eCosBuf_PDO1_TRM);
+         }
+         #endif
          break;
    }
 
@@ -577,6 +994,103 @@ uint8_t CosMgrCanTrmHandler(CpCanMsg_ts * CPP_PARM_UNUSED(ptsCanMsgV),
 }
 
 
+#if (COS_DICT_OBJ_1016 > 0) && (COS_NMT_HBC_MERGE > 0)
+//----------------------------------------------------------------------------//
+// CosMgrHbcFilter()                                                          //
+// setup the shared message buffer of the heartbeat consumers                 //
+//----------------------------------------------------------------------------//
+void CosMgrHbcFilter(void)
+{
+   CpCanMsg_ts    tsCanMsgT;     // CAN message structure
+   uint8_t        ubEntryT;
+   uint8_t        ubNodeT;
+   uint8_t        ubBitsAndT;    // bits set in all node-IDs
+   uint8_t        ubBitsOrT;     // bits set in any node-ID
+
+
+   //----------------------------------------------------------------
+   // no heartbeat is received while the lookup table is rebuilt
+   //
+   CpCoreBufferRelease(&tsCanPortG, eCosBuf_NMT_HBC);
+   for(ubNodeT = 0; ubNodeT < 128; ubNodeT++)
+   {
+      aubCosMgrHbcEntryS[ubNodeT] = COS_MGR_HBC_NONE;
+   }
+
+   //----------------------------------------------------------------
+   // collect the node-IDs of all active consumers, a node-ID
+   // is assigned to its first entry
+   //
+   ubBitsAndT = 0x7F;
+   ubBitsOrT  = 0x00;
+   for(ubEntryT = 0; ubEntryT < COS_DICT_OBJ_1016; ubEntryT++)
+   {
+      ubNodeT = aubCosNmtHbConsNodeG[ubEntryT];
+      if( (ubNodeT == 0) || (ubNodeT > 127) ||
+          (auwCosNmtHbConsTimeG[ubEntryT] == 0)  )
+      {
+         #if COS_NMT_HBC_WHEEL > 0
+         CosHbwStop(ubEntryT);
+         #endif
+         continue;
+      }
+
+      if(aubCosMgrHbcEntryS[ubNodeT] == COS_MGR_HBC_NONE)
+      {
+         aubCosMgrHbcEntryS[ubNodeT] = ubEntryT;
+      }
+      ubBitsAndT &= ubNodeT;
+      ubBitsOrT  |= ubNodeT;
+   }
+
+   //----------------------------------------------------------------
+   // no active consumer: the buffer stays released
+   //
+   if(ubBitsOrT == 0) return;
+
+   //----------------------------------------------------------------
+   // The identifier bits 10..7 must match 700h, a node-ID bit is
+   // only compared when it has the same value in all node-IDs.
+   // The bits which are set in all node-IDs form the identifier.
+   //
+   CpMsgClear(&tsCanMsgT);
+   CpMsgSetStdId(&tsCanMsgT, 0x700 | ubBitsAndT);
+   CpMsgSetDlc(&tsCanMsgT, 1);
+   CpCoreBufferInit(&tsCanPortG, &tsCanMsgT, eCosBuf_NMT_HBC, CP_BUFFER_DIR_RX);
+   CpCoreBufferAccMask(&tsCanPortG, eCosBuf_NMT_HBC,
+                       0x780 | ((~(ubBitsAndT ^ ubBitsOrT)) & 0x7F));
+}
+
+
+//----------------------------------------------------------------------------//
+// CosMgrHbcHandler()                                                         //
+// assign a heartbeat message of the shared buffer to its consumer            //
+//----------------------------------------------------------------------------//
+static void CosMgrHbcHandler(CpCanMsg_ts * ptsCanMsgV)
+{
+   uint8_t  ubEntryT;
+   uint8_t  ubNodeT;
+
+   //----------------------------------------------------------------
+   // the mask may accept node-IDs which are not monitored, these
+   // messages are dropped by the lookup table
+   //
+   ubNodeT  = (uint8_t) (CpMsgGetStdId(ptsCanMsgV) & 0x7F);
+   ubEntryT = aubCosMgrHbcEntryS[ubNodeT];
+   if(ubEntryT == COS_MGR_HBC_NONE) return;
+
+   CosNmtHBConsHandler(ubEntryT);
+
+   //----------------------------------------------------------------
+   // each heartbeat restarts the consumer time
+   //
+   #if COS_NMT_HBC_WHEEL > 0
+   CosHbwStart(ubEntryT, auwCosNmtHbConsTimeG[ubEntryT]);
+   #endif
+}
+#endif
+
+
 //----------------------------------------------------------------------------//
 // CosMgrIdCheck()                                                            //
 //                                                                            //
@@ -659,6 +1173,45 @@ uint8_t CosMgrInit(uint8_t ubCanIfV, uint16_t uwConfigV)
    // we are in initialisation mode
    //
    ubCosMgrStatusG = eCOS_MGR_INIT;
+   ubCosMgrErrStateS = CP_STATE_BUS_ACTIVE;
+
+   //----------------------------------------------------------------
+   // the statistics measure times with the high-resolution timer
+   //
+   #if (COS_SDO_STAT > 0) || (COS_MGR_STAT > 0) || (COS_BUS_STAT > 0)
+   McTmrHResInit(eTMR_HRES_TICK_1us);
+   McTmrHResStart();
+   #endif
+
+   #if COS_SDO_STAT > 0
+   memset(&tsCosMgrSdoStatS, 0, sizeof(CosMgrSdoStat_ts));
+   ubCosMgrSdoPendS = 0;
+   ubCosMgrSdoTypeS = eCOS_SDO_TYPE_EXPEDITED;
+   ubCosMgrSdoBlkS  = 0;
+   #endif
+
+   #if COS_MGR_STAT > 0
+   memset(&tsCosMgrStatS, 0, sizeof(CosMgrStat_ts));
+   #endif
+
+   #if COS_BUS_STAT > 0
+   memset(&atsCosMgrBusObjS[0], 0, sizeof(atsCosMgrBusObjS));
+   ulCosMgrBusTickS   = McTmrHResTick();
+   ulCosMgrBusBitsS   = 0;
+   uwCosMgrBusFramesS = 0;
+   uwCosMgrBusRateS   = 0;
+   ubCosMgrBusLoadS   = 0;
+   #endif
+
+   #if COS_DICT_OBJ_1010 > 0
+   ubCosMgrNvmStepS = eCOS_MGR_NVM_IDLE;
+   #endif
+
+   //----------------------------------------------------------------
+   // prepare the dictionary search, this must be done before the
+   // parameters are loaded
+   //
+   CosDictInit();
 
    //----------------------------------------------------------------
    // store configuration option
@@ -693,7 +1246,41 @@ void  CosMgrNvmOperation(void)
 {
    #if COS_DICT_OBJ_1010 > 0
    uint16_t  uwParmSelT;          // the setup for load/restore
-   uint16_t  uwNvmChecksumT;      // checksum for restore operation
+
+
+   //----------------------------------------------------------------
+   // a save / restore operation is running: perform the next step,
+   // the deferred SDO response is sent after the last step
+   //
+   if(ubCosMgrNvmStepS != eCOS_MGR_NVM_IDLE)
+   {
+      CosMgrNvmStep();
+      if(ubCosMgrNvmStepS != eCOS_MGR_NVM_DONE)
+      {
+         return;
+      }
+      ubCosMgrNvmStepS = eCOS_MGR_NVM_IDLE;
+
+      if(ubCos301ParmSaveG & 0x80)
+      {
+         if(ubCosMgrNvmFailS == 0)
+         {
+            CosSdoResponse(eCosSdo_WRITE_OK);
+         }
+         else
+         {
+            CosSdoResponse(eCosSdo_ERR_HARDWARE);
+         }
+         ubCos301ParmSaveG = 0;
+      }
+
+      if(ubCos301ParmLoadG & 0x80)
+      {
+         CosSdoResponse(eCosSdo_WRITE_OK);
+         ubCos301ParmLoadG = 0;
+      }
+      return;
+   }
 
 
    //----------------------------------------------------------------
@@ -710,20 +1297,11 @@ void  CosMgrNvmOperation(void)
       ubCos301ParmSaveG |= 0x80;
 
       //--------------------------------------------------------
-      // save parameters to EEPROM
+      // start saving parameters to EEPROM
       // only the last three bits are valid (values 0 .. 4)
-      // send deferred SDO response
       //
-      if(CosMgrParmSave(ubCos301ParmSaveG & 0x07) == eCosErr_OK)
-      {
-         CosSdoResponse(eCosSdo_WRITE_OK);
-      }
-      else
-      {
-         CosSdoResponse(eCosSdo_ERR_HARDWARE);
-      }
-
-      ubCos301ParmSaveG = 0;
+      CosMgrNvmSaveStart(ubCos301ParmSaveG & 0x07);
+      return;
    }
 
 
@@ -797,34 +1375,176 @@ void  CosMgrNvmOperation(void)
 
 
       //--------------------------------------------------------
-      // enable write operation
+      // enable write operation, the new setup and the checksum
+      // are stored by the next calls of this function
       //
       McNvmWriteEnable();
 
+      uwCosMgrNvmSelS  = uwParmSelT;
+      ubCosMgrNvmFailS = 0;
+      ubCosMgrNvmStepS = eCOS_MGR_NVM_SELECT;
+   }
+
+   #endif
+}
+
+
+//----------------------------------------------------------------------------//
+// CosMgrNvmSaveStart()                                                       //
+// prepare a save operation, the data is written by CosMgrNvmStep()           //
+//----------------------------------------------------------------------------//
+#if COS_DICT_OBJ_1010 > 0
+static void CosMgrNvmSaveStart(uint8_t ubGroupV)
+{
+   ubCosMgrNvmFailS  = 0;
+   ubCosMgrNvmGroupS = ubGroupV;
+
+   //----------------------------------------------------------------
+   // read current default setting from EEPROM
+   //
+   if(McNvmRead(eNVM_PARM_SEL_U16, &uwCosMgrNvmSelS, 2) > eNVM_ERR_OK)
+   {
+      ubCosMgrNvmFailS++;
+   }
+   if( (uwCosMgrNvmSelS & 0xFFF0) != 0x5AC0)
+   {
+      uwCosMgrNvmSelS = 0x5AC0;     // set signature
+   }
+
 
+   //----------------------------------------------------------------
+   // enable write operation
+   //
+   if(McNvmWriteEnable() > eNVM_ERR_OK)
+   {
+      ubCosMgrNvmFailS++;
+   }
+
+   ubCosMgrNvmStepS = eCOS_MGR_NVM_SAVE_COM;
+}
+
+
+//----------------------------------------------------------------------------//
+// CosMgrNvmStep()                                                            //
+// perform one step of a save / restore operation                             //
+//----------------------------------------------------------------------------//
+static void CosMgrNvmStep(void)
+{
+   uint16_t  uwNvmChecksumT;              // checksum of non-volatile memory
+   uint8_t   ubGroupT;                    // parameter group
+
+   ubGroupT = ubCosMgrNvmGroupS;
+
+   switch(ubCosMgrNvmStepS)
+   {
       //--------------------------------------------------------
-      // store new setup
+      // save setting for CiA 301
       //
-      McNvmWrite(eNVM_PARM_SEL_U16, &uwParmSelT, 2);
+      case eCOS_MGR_NVM_SAVE_COM:
+         if( (ubGroupT == eCOS_PARM_ALL) || (ubGroupT == eCOS_PARM_COM) )
+         {
+            if(Cos301_ParmSave() > 0)
+            {
+               ubCosMgrNvmFailS++;
+            }
+            uwCosMgrNvmSelS = uwCosMgrNvmSelS | 0x0001;
+         }
+         break;
 
+      //--------------------------------------------------------
+      // save setting for CiA 4xx
+      //
+      case eCOS_MGR_NVM_SAVE_APP:
+         if( (ubGroupT == eCOS_PARM_ALL) || (ubGroupT == eCOS_PARM_APP) )
+         {
+            #if COS_DS401_DI > 0
+            Cos401_DI_ParmSave();   // CiA 401, save digital input
+            #endif
+
+            #if COS_DS401_DO > 0
+            Cos401_DO_ParmSave();   // CiA 401, save digital output
+            #endif
+
+            #if COS_DS401_AI > 0
+            Cos401_AI_ParmSave();   // CiA 401, save analogue input
+            #endif
+
+            #if COS_DS401_AO > 0
+            Cos401_AO_ParmSave();   // CiA 401, save analogue output
+            #endif
+
+            #if COS_DS402 > 0
+            Cos402_ParmSave();      // CiA 402, drive
+            #endif
+
+            #if COS_DS404_AI > 0
+            Cos404_AI_ParmSave();   // CiA 404, save analogue input
+            #endif
+
+            #if COS_DS404_AO > 0
+            Cos404_AO_ParmSave();   // CiA 404, save analogue output
+            #endif
+
+            #if COS_DS404_AL > 0
+            Cos404_AL_ParmSave();   // CiA 404, save alarm functions
+            #endif
+
+            #if COS_DS406 > 0
+            Cos406_ParmSave();      // CiA 406, save paramaters
+            #endif
+
+            #if COS_DS410 > 0
+            Cos406_ParmSave();      // CiA 410, inclinometer
+            #endif
+
+            #if COS_DS437 > 0
+            Cos437_ParmSave();      // CiA 437, photovoltaic
+            #endif
+
+            uwCosMgrNvmSelS = uwCosMgrNvmSelS | 0x0002;
+         }
+         break;
 
       //--------------------------------------------------------
-      // build checksum and disable write operation
+      // save setting for manufacturer specific objects
       //
-      uwNvmChecksumT = McNvmBuildChecksum(eNVM_CHECKSUM_START,
-                                          eNVM_CHECKSUM_END);
-      McNvmWrite(eNVM_CHECKSUM_U16, &uwNvmChecksumT, 2);
-      McNvmWriteDisable();
+      case eCOS_MGR_NVM_SAVE_MAN:
+         if( (ubGroupT == eCOS_PARM_ALL) || (ubGroupT == eCOS_PARM_MAN) )
+         {
+            #if COS_DICT_MAN > 0
+            CosMob_ParmSave();
+            #endif
+            uwCosMgrNvmSelS = uwCosMgrNvmSelS | 0x0004;
+         }
+         break;
 
       //--------------------------------------------------------
-      // send deferred SDO response
+      // store new setup
       //
-      CosSdoResponse(eCosSdo_WRITE_OK);
-      ubCos301ParmLoadG = 0;
+      case eCOS_MGR_NVM_SELECT:
+         if(McNvmWrite(eNVM_PARM_SEL_U16, &uwCosMgrNvmSelS, 2) > eNVM_ERR_OK)
+         {
+            ubCosMgrNvmFailS++;
+         }
+         break;
+
+      //--------------------------------------------------------
+      // build checksum and disable write operation
+      //
+      case eCOS_MGR_NVM_CHECKSUM:
+         uwNvmChecksumT = McNvmBuildChecksum(eNVM_CHECKSUM_START,
+                                             eNVM_CHECKSUM_END);
+         McNvmWrite(eNVM_CHECKSUM_U16, &uwNvmChecksumT, 2);
+         McNvmWriteDisable();
+         break;
+
+      default:
+         return;
    }
 
-   #endif
+   ubCosMgrNvmStepS++;
 }
+#endif
 
 
 //----------------------------------------------------------------------------//
@@ -1034,128 +1754,26 @@ uint8_t CosMgrParmLoad(void)
 #if COS_DICT_OBJ_1010 > 0
 uint8_t CosMgrParmSave(uint8_t ubGroupV)
 {
-   uint16_t  uwNvmChecksumT;              // checksum of non-volatile memory
-   uint16_t  uwParmSelT;                  // the current setup
-   uint8_t   ubNvmFailT = 0;              // status of NVM operation
-
-
-   //----------------------------------------------------------------
-   // read current default setting from EEPROM
-   //
-   if(McNvmRead(eNVM_PARM_SEL_U16, &uwParmSelT, 2) > eNVM_ERR_OK)
-   {
-      ubNvmFailT++;
-   }
-   if( (uwParmSelT & 0xFFF0) != 0x5AC0)
-   {
-      uwParmSelT = 0x5AC0;    // set signature
-   }
-
-
-   //----------------------------------------------------------------
-   // enable write operation
-   //
-   if(McNvmWriteEnable() > eNVM_ERR_OK)
-   {
-      ubNvmFailT++;
-   }
-
-
-   //----------------------------------------------------------------
-   // save setting for CiA 301
-   //
-   if( (ubGroupV == eCOS_PARM_ALL) || (ubGroupV == eCOS_PARM_COM) )
-   {
-      if(Cos301_ParmSave() > 0)
-      {
-         ubNvmFailT++;
-      }
-      uwParmSelT = uwParmSelT | 0x0001;
-   }
-
-   //----------------------------------------------------------------
-   // save setting for CiA 4xx
-   //
-   if( (ubGroupV == eCOS_PARM_ALL) || (ubGroupV == eCOS_PARM_APP) )
-   {
-      #if COS_DS401_DI > 0
-      Cos401_DI_ParmSave();      // CiA 401, save digital input
-      #endif
-
-      #if COS_DS401_DO > 0
-      Cos401_DO_ParmSave();      // CiA 401, save digital output
-      #endif
-
-      #if COS_DS401_AI > 0
-      Cos401_AI_ParmSave();      // CiA 401, save analogue input
-      #endif
-
-      #if COS_DS401_AO > 0
-      Cos401_AO_ParmSave();      // CiA 401, save analogue output
-      #endif
-
-      #if COS_DS402 > 0
-      Cos402_ParmSave();         // CiA 402, drive
-      #endif
-
-      #if COS_DS404_AI > 0
-      Cos404_AI_ParmSave();      // CiA 404, save analogue input
-      #endif
-
-      #if COS_DS404_AO > 0
-      Cos404_AO_ParmSave();      // CiA 404, save analogue output
-      #endif
-
-      #if COS_DS404_AL > 0
-      Cos404_AL_ParmSave();      // CiA 404, save alarm functions
-      #endif
-
-      #if COS_DS406 > 0
-      Cos406_ParmSave();         // CiA 406, save paramaters
-      #endif
-
-      #if COS_DS410 > 0
-      Cos406_ParmSave();         // CiA 410, inclinometer
-      #endif
-
-      #if COS_DS437 > 0
-      Cos437_ParmSave();         // CiA 437, photovoltaic
-      #endif
-
-      uwParmSelT = uwParmSelT | 0x0002;
-
-   }
-
    //----------------------------------------------------------------
-   // save setting for manufacturer specific objects
+   // a save / restore operation of the SDO server is running
    //
-   if( (ubGroupV == eCOS_PARM_ALL) || (ubGroupV == eCOS_PARM_MAN) )
+   if(ubCosMgrNvmStepS != eCOS_MGR_NVM_IDLE)
    {
-      #if COS_DICT_MAN > 0
-      CosMob_ParmSave();
-      #endif
-      uwParmSelT = uwParmSelT | 0x0004;
+      return(eCosErr_PARM_SAVE);
    }
 
-
    //----------------------------------------------------------------
-   // store new setup
+   // the application waits for the result, so all steps are
+   // performed at once
    //
-   if(McNvmWrite(eNVM_PARM_SEL_U16, &uwParmSelT, 2) > eNVM_ERR_OK)
+   CosMgrNvmSaveStart(ubGroupV);
+   while(ubCosMgrNvmStepS != eCOS_MGR_NVM_DONE)
    {
-      ubNvmFailT++;
+      CosMgrNvmStep();
    }
+   ubCosMgrNvmStepS = eCOS_MGR_NVM_IDLE;
 
-
-   //----------------------------------------------------------------
-   // build checksum and disable write operation
-   //
-   uwNvmChecksumT = McNvmBuildChecksum(eNVM_CHECKSUM_START, eNVM_CHECKSUM_END);
-   McNvmWrite(eNVM_CHECKSUM_U16, &uwNvmChecksumT, 2);
-   McNvmWriteDisable();
-
-
-   return(ubNvmFailT);
+   return(ubCosMgrNvmFailS);
 }
 #endif
 
@@ -1166,6 +1784,12 @@ uint8_t CosMgrParmSave(uint8_t ubGroupV)
 //----------------------------------------------------------------------------//
 uint8_t CosMgrProcess(void)
 {
+   uint8_t  ubResultT;
+   #if COS_MGR_STAT > 0
+   uint32_t ulTickT;
+
+   ulTickT = McTmrHResTick();
+   #endif
 
    //----------------------------------------------------------------
    // process messages if no CAN interrupt handler is available
@@ -1174,6 +1798,13 @@ uint8_t CosMgrProcess(void)
    CosMgrProcessMsg();
    #endif
 
+   //----------------------------------------------------------------
+   // process messages from the receive FIFO
+   //
+   #if COS_MGR_FIFO > 0
+   CosMgrProcessFifo();
+   #endif
+
 
    //----------------------------------------------------------------
    // the operations are only performed when the node left the
@@ -1189,30 +1820,51 @@ uint8_t CosMgrProcess(void)
       //
       if(CosNmtCheckNodeReset() != NMT_RESET_OFF)
       {
-         return(eCosErr_NODE_RESET);
+         ubResultT = eCosErr_NODE_RESET;
       }
+      else
+      {
+         //------------------------------------------------
+         // perform data load / restore operations, one
+         // step per call
+         //
+         CosMgrNvmOperation();
 
-      //--------------------------------------------------------
-      // perform data load / restore operations
-      //
-      CosMgrNvmOperation();
-
-
-      return(eCosErr_OK);
+         ubResultT = eCosErr_OK;
+      }
    }
 
    //----------------------------------------------------------------
    // the node is in reset state
    //
-   if(ubCosMgrStatusG == eCOS_MGR_STOP)
+   else if(ubCosMgrStatusG == eCOS_MGR_STOP)
    {
-      return(eCosErr_NODE_RESET);
+      ubResultT = eCosErr_NODE_RESET;
    }
 
    //----------------------------------------------------------------
    // the node is not initialised
    //
-   return(eCosErr_NODE_INIT);
+   else
+   {
+      ubResultT = eCosErr_NODE_INIT;
+   }
+
+   //----------------------------------------------------------------
+   // duration of this call for the main loop statistic
+   //
+   #if COS_MGR_STAT > 0
+   ulTickT = McTmrHResTick() - ulTickT;
+
+   tsCosMgrStatS.ulCallCount++;
+   if(ulTickT > tsCosMgrStatS.ulTickMax)
+   {
+      tsCosMgrStatS.ulTickMax = ulTickT;
+   }
+   tsCosMgrStatS.aulTickClass[CosMgrTickClass(ulTickT, COS_MGR_STAT_CLASS)]++;
+   #endif
+
+   return(ubResultT);
 }
 
 
@@ -1223,66 +1875,99 @@ uint8_t CosMgrProcess(void)
 #if COS_MGR_INT == 0
 void CosMgrProcessMsg(void)
 {
-   register uint8_t     ubBufferNumT = 0;
-   register uint32_t    ulBufferMaskT = 1;
+   register uint8_t     ubBufferNumT;
+   register uint8_t     ubPendingT;
+   uint8_t              ubBitPosT;
+   uint8_t              ubByteBaseT;
+   uint32_t             ulPendingT;
+   uint32_t             ulBufferMaskT;
+   uint32_t             ulByteMaskT;
    static   CpState_ts  tsCanStateS;
 
    //----------------------------------------------------------------
-   // Run through all possible buffers and check if there is
-   // a message that need processing. We do this first for the
-   // Rx buffers and then for the Tx buffers.
+   // Take a snapshot of all buffers that need processing and
+   // jump directly to the pending ones: empty groups of 8 buffers
+   // are skipped with one test, inside a group the lowest pending
+   // buffer is found by table look-up. For every buffer the Rx
+   // flag is handled first, then the Tx flag.
    //
-   for(ubBufferNumT = 1; ubBufferNumT <= CP_BUFFER_MAX; ubBufferNumT++)
+   ulPendingT  = ulCpRcvBufferFlagG | ulCpTrmBufferFlagG;
+   ulByteMaskT = 1;
+   ubByteBaseT = 1;
+
+   while(ulPendingT != 0)
    {
+      ubPendingT = (uint8_t) ulPendingT;
 
-      //---------------------------------------------------
-      // test the Rx buffers
-      //
-      if(ulCpRcvBufferFlagG & ulBufferMaskT)
+      while(ubPendingT != 0)
       {
-         //--------------------------------------
-         // process this buffer
+         //---------------------------------------------------
+         // get the lowest pending buffer of this group
          //
-         CosMgrCanRcvHandler(&(atsCanMsgG[ubBufferNumT - 1]), ubBufferNumT);
+         if(ubPendingT & 0x0F)
+         {
+            ubBitPosT = aubCosMgrBitPosC[ubPendingT & 0x0F];
+         }
+         else
+         {
+            ubBitPosT = aubCosMgrBitPosC[ubPendingT >> 4] + 4;
+         }
+         ubPendingT   &= ubPendingT - 1;
+         ubBufferNumT  = ubByteBaseT + ubBitPosT;
+         ulBufferMaskT = ulByteMaskT << ubBitPosT;
 
 
-         //--------------------------------------
-         // clear flag for this buffer
+         //---------------------------------------------------
+         // test the Rx buffers
          //
-         ulCpRcvBufferFlagG &= ~ulBufferMaskT;
-      }
+         if(ulCpRcvBufferFlagG & ulBufferMaskT)
+         {
+            //--------------------------------------
+            // process this buffer
+            //
+            CosMgrCanRcvHandler(&(atsCanMsgG[ubBufferNumT - 1]), ubBufferNumT);
 
-      
-      //---------------------------------------------------
-      // test the Tx buffers
-      //
-      if(ulCpTrmBufferFlagG & ulBufferMaskT)
-      {
-         //--------------------------------------
-         // process this buffer
-         //
-         CosMgrCanTrmHandler(&atsCanMsgG[ubBufferNumT - 1], ubBufferNumT);
 
-         //--------------------------------------
-         // clear flag for this buffer
-         //
-         ulCpTrmBufferFlagG &= ~ulBufferMaskT;
-
-         //--------------------------------------
-         // A CAN message was sent. Check for
-         // pending transmit messages by calling
-         // CpCoreBufferSend() with buffer index
-         // 0 (invalid buffer). This is for
-         // strange CAN controllers (e.g. PIC)
-         // only.
+            //--------------------------------------
+            // clear flag for this buffer
+            //
+            ulCpRcvBufferFlagG &= ~ulBufferMaskT;
+         }
+
+
+         //---------------------------------------------------
+         // test the Tx buffers
          //
-         CpCoreBufferSend(&tsCanPortG , 0);
+         if(ulCpTrmBufferFlagG & ulBufferMaskT)
+         {
+            //--------------------------------------
+            // process this buffer
+            //
+            CosMgrCanTrmHandler(&atsCanMsgG[ubBufferNumT - 1], ubBufferNumT);
+
+            //--------------------------------------
+            // clear flag for this buffer
+            //
+            ulCpTrmBufferFlagG &= ~ulBufferMaskT;
+
+            //--------------------------------------
+            // A CAN message was sent. Check for
+            // pending transmit messages by calling
+            // CpCoreBufferSend() with buffer index
+            // 0 (invalid buffer). This is for
+            // strange CAN controllers (e.g. PIC)
+            // only.
+            //
+            CpCoreBufferSend(&tsCanPortG , 0);
+         }
       }
 
-      ulBufferMaskT = ulBufferMaskT << 1;
+      ulPendingT  = ulPendingT  >> 8;
+      ulByteMaskT = ulByteMaskT << 8;
+      ubByteBaseT = ubByteBaseT + 8;
    }
 
-   
+
    //----------------------------------------------------------------
    // process error / status information
    //
@@ -1293,6 +1978,44 @@ void CosMgrProcessMsg(void)
 #endif
 
 
+//----------------------------------------------------------------------------//
+// CosMgrProcessFifo()                                                        //
+// process messages from the receive FIFO of the CAN driver                   //
+//----------------------------------------------------------------------------//
+#if COS_MGR_FIFO > 0
+static void CosMgrProcessFifo(void)
+{
+   uint8_t              ubCountT;
+   uint32_t             ulSizeT;
+   static   CpCanMsg_ts tsCanMsgS;
+
+   //----------------------------------------------------------------
+   // Drain the FIFO in one pass. The messages are read one by one:
+   // the driver returns the data of the message read last when a
+   // service calls CpCoreBufferGetData() for this buffer. The read
+   // of the empty FIFO ends the pass and releases this copy.
+   //
+   for(ubCountT = 0; ubCountT < CP_FIFO_RCV_SIZE; ubCountT++)
+   {
+      ulSizeT = 1;
+      if(CpCoreMsgRead(&tsCanPortG, &tsCanMsgS, &ulSizeT) != CpErr_OK)
+      {
+         return;
+      }
+      CosMgrCanRcvService(&tsCanMsgS, (uint8_t) tsCanMsgS.ulMsgUser);
+   }
+
+   //----------------------------------------------------------------
+   // the FIFO has been refilled by the CAN interrupt during the pass,
+   // the remaining messages are processed by the next call: release
+   // the copy of the message read last
+   //
+   ulSizeT = 0;
+   CpCoreMsgRead(&tsCanPortG, &tsCanMsgS, &ulSizeT);
+}
+#endif
+
+
 //----------------------------------------------------------------------------//
 // CosMgrRelease()                                                            //
 // release CANopen stack                                                      //
@@ -1316,6 +2039,147 @@ uint8_t CosMgrRelease(void)
 }
 
 
+//----------------------------------------------------------------------------//
+// CosMgrSdoStatistic()                                                       //
+// read SDO statistic                                                         //
+//----------------------------------------------------------------------------//
+#if COS_SDO_STAT > 0
+void CosMgrSdoStatistic(CosMgrSdoStat_ts * ptsStatV, uint8_t ubClearV)
+{
+   //----------------------------------------------------------------
+   // the statistic is changed by the CAN interrupt handler
+   //
+   CpCoreIntLock(&tsCanPortG);
+   memcpy(ptsStatV, &tsCosMgrSdoStatS, sizeof(CosMgrSdoStat_ts));
+
+   if(ubClearV)
+   {
+      memset(&tsCosMgrSdoStatS, 0, sizeof(CosMgrSdoStat_ts));
+   }
+   CpCoreIntUnlock(&tsCanPortG);
+}
+
+
+//----------------------------------------------------------------------------//
+// CosMgrSdoStatRcv()                                                         //
+// SDO request received                                                       //
+//----------------------------------------------------------------------------//
+static void CosMgrSdoStatRcv(uint8_t ubCommandV)
+{
+   //----------------------------------------------------------------
+   // the time is taken from the last request frame, so the response
+   // time of a block download is the time after the last segment
+   //
+   tsCosMgrSdoStatS.ulRcvCount++;
+   ulCosMgrSdoTickS = McTmrHResTick();
+   ubCosMgrSdoPendS = 1;
+
+   //----------------------------------------------------------------
+   // the segments of a block download carry a sequence number
+   // instead of a command specifier: 1 = segments are received,
+   // 2 = the last segment has been received, the next request is
+   // the end of the transfer
+   //
+   if(ubCosMgrSdoBlkS > 0)
+   {
+      if(ubCommandV == 0x80)           // abort
+      {
+         ubCosMgrSdoPendS = 0;
+         ubCosMgrSdoBlkS  = 0;
+      }
+      else if(ubCosMgrSdoBlkS == 2)    // end request
+      {
+         ubCosMgrSdoBlkS  = 0;
+      }
+      else if(ubCommandV & 0x80)       // last segment
+      {
+         ubCosMgrSdoBlkS  = 2;
+      }
+      return;
+   }
+
+   //----------------------------------------------------------------
+   // transfer type from the client command specifier (bits 7..5)
+   //
+   switch(ubCommandV >> 5)
+   {
+      case 1:                          // initiate download
+         if(ubCommandV & 0x02)
+         {
+            ubCosMgrSdoTypeS = eCOS_SDO_TYPE_EXPEDITED;
+         }
+         else
+         {
+            ubCosMgrSdoTypeS = eCOS_SDO_TYPE_SEGMENTED;
+         }
+         break;
+
+      case 2:                          // initiate upload
+         ubCosMgrSdoTypeS = eCOS_SDO_TYPE_EXPEDITED;
+         break;
+
+      case 0:                          // download segment
+      case 3:                          // upload segment
+         ubCosMgrSdoTypeS = eCOS_SDO_TYPE_SEGMENTED;
+         break;
+
+      case 5:                          // block upload
+         ubCosMgrSdoTypeS = eCOS_SDO_TYPE_BLOCK;
+         break;
+
+      case 6:                          // block download
+         ubCosMgrSdoTypeS = eCOS_SDO_TYPE_BLOCK;
+         if((ubCommandV & 0x01) == 0) ubCosMgrSdoBlkS = 1;
+         break;
+
+      default:                         // abort, not answered
+         ubCosMgrSdoPendS = 0;
+         break;
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// CosMgrSdoStatTrm()                                                         //
+// SDO response transmitted                                                   //
+//----------------------------------------------------------------------------//
+static void CosMgrSdoStatTrm(void)
+{
+   struct CosMgrSdoType_s *   ptsTypeT;
+   uint32_t                   ulTickT;
+   uint8_t                    ubClassT;
+
+   tsCosMgrSdoStatS.ulTrmCount++;
+
+   //----------------------------------------------------------------
+   // further frames of a block upload are no responses
+   //
+   if(ubCosMgrSdoPendS == 0) return;
+   ubCosMgrSdoPendS = 0;
+
+   ulTickT  = McTmrHResTick() - ulCosMgrSdoTickS;
+   ubClassT = CosMgrTickClass(ulTickT, COS_SDO_STAT_CLASS);
+
+   tsCosMgrSdoStatS.ulReqCount++;
+   tsCosMgrSdoStatS.ulTickSum += ulTickT;
+   if(ulTickT > tsCosMgrSdoStatS.ulTickMax)
+   {
+      tsCosMgrSdoStatS.ulTickMax = ulTickT;
+   }
+   tsCosMgrSdoStatS.aulTickClass[ubClassT]++;
+
+   ptsTypeT = &(tsCosMgrSdoStatS.atsType[ubCosMgrSdoTypeS]);
+   ptsTypeT->ulReqCount++;
+   ptsTypeT->ulTickSum += ulTickT;
+   if(ulTickT > ptsTypeT->ulTickMax)
+   {
+      ptsTypeT->ulTickMax = ulTickT;
+   }
+   ptsTypeT->aulTickClass[ubClassT]++;
+}
+#endif
+
+
 //----------------------------------------------------------------------------//
 // CosMgrStart()                                                              //
 // start CANopen stack                                                        //
@@ -1343,6 +2207,13 @@ uint8_t CosMgrStart(uint8_t ubBaudSelV, uint8_t ubNodeIdV)
    ubCosMgrNodeAddressG = ubNodeIdV;
    ubCosMgrBaudrateG    = ubBaudSelV;
 
+   //----------------------------------------------------------------
+   // no heartbeat consumer is supervised before its first heartbeat
+   //
+   #if (COS_DICT_OBJ_1016 > 0) && (COS_NMT_HBC_WHEEL > 0)
+   CosHbwInit();
+   #endif
+
    //----------------------------------------------------------------
    // setup the parameters of the device
    //
@@ -1386,6 +2257,9 @@ uint8_t CosMgrStart(uint8_t ubBaudSelV, uint8_t ubNodeIdV)
    #if COS_PDO_SUPPORT == 1
    CosPdoInit();
    #endif
+   #if (COS_PDO_SCHED > 0) && (COS_PDO_TRM_NUMBER > 0)
+   CosPschInit();
+   #endif
 
    //-----------------------------------------------------#
    // TIME service
@@ -1445,3 +2319,40 @@ uint8_t CosMgrStart(uint8_t ubBaudSelV, uint8_t ubNodeIdV)
 
 }
 
+
+//----------------------------------------------------------------------------//
+// CosMgrStatistic()                                                          //
+// read main loop statistic                                                   //
+//----------------------------------------------------------------------------//
+#if COS_MGR_STAT > 0
+void CosMgrStatistic(CosMgrStat_ts * ptsStatV, uint8_t ubClearV)
+{
+   memcpy(ptsStatV, &tsCosMgrStatS, sizeof(CosMgrStat_ts));
+
+   if(ubClearV)
+   {
+      memset(&tsCosMgrStatS, 0, sizeof(CosMgrStat_ts));
+   }
+}
+#endif
+
+
+//----------------------------------------------------------------------------//
+// CosMgrTickClass()                                                          //
+// latency class of a time, this is the number of significant bits            //
+//----------------------------------------------------------------------------//
+#if (COS_SDO_STAT > 0) || (COS_MGR_STAT > 0)
+static uint8_t CosMgrTickClass(uint32_t ulTickV, uint8_t ubClassMaxV)
+{
+   uint8_t  ubClassT = 0;
+
+   while((ulTickV > 0) && (ubClassT < (ubClassMaxV - 1)))
+   {
+      ulTickV = ulTickV >> 1;
+      ubClassT++;
+   }
+
+   return(ubClassT);
+}
+#endif
+
@@ -83,16 +83,144 @@ enum CosMgr_e {
 #define  CO_CONF_SLAVE           0x0000
 #define  CO_CONF_MASTER          0x0001
 
+
+#if COS_SDO_STAT > 0
+//-------------------------------------------------------------------
+// number of latency classes of the SDO statistic, the times are
+// taken from the high-resolution timer with a tick of 1 us: class 0
+// counts responses within the same microsecond, class n (n > 0)
+// counts responses after 2^(n-1) .. 2^n - 1 us, the last class
+// counts all responses after 16.4 ms or more
+//
+#define  COS_SDO_STAT_CLASS      16
+
+
+/*!
+** \enum    CosMgrSdoType_e
+** \brief   Transfer types of the SDO statistic
+**
+** The type is taken from the command specifier of the request. An
+** upload is counted as expedited until the client requests the
+** first segment, so the initiate request of a segmented upload is
+** counted as expedited. A block download which is aborted by the
+** server is counted as block transfer until the client sends an
+** abort or a last segment.
+*/
+enum CosMgrSdoType_e {
+   /*!   expedited download and upload                         */
+   eCOS_SDO_TYPE_EXPEDITED = 0,
+   /*!   segmented download and upload                         */
+   eCOS_SDO_TYPE_SEGMENTED,
+   /*!   block download and upload                             */
+   eCOS_SDO_TYPE_BLOCK,
+
+   eCOS_SDO_TYPE_MAX
+};
+
+
+/*!
+** \struct  CosMgrSdoType_s
+** \brief   SDO server statistic of one transfer type
+**
+*/
+struct CosMgrSdoType_s {
+   /*!   number of requests that have been answered            */
+   uint32_t    ulReqCount;
+   /*!   sum of all response times in microseconds             */
+   uint32_t    ulTickSum;
+   /*!   longest response time in microseconds                 */
+   uint32_t    ulTickMax;
+   /*!   number of responses per latency class                 */
+   uint32_t    aulTickClass[COS_SDO_STAT_CLASS];
+};
+
+
+/*!
+** \struct  CosMgrSdoStat_s
+** \brief   SDO server statistic
+**
+*/
+struct CosMgrSdoStat_s {
+   /*!   number of received SDO request frames                 */
+   uint32_t    ulRcvCount;
+   /*!   number of transmitted SDO response frames             */
+   uint32_t    ulTrmCount;
+   /*!   number of requests that have been answered            */
+   uint32_t    ulReqCount;
+   /*!   sum of all response times in microseconds             */
+   uint32_t    ulTickSum;
+   /*!   longest response time in microseconds                 */
+   uint32_t    ulTickMax;
+   /*!   number of responses per latency class                 */
+   uint32_t    aulTickClass[COS_SDO_STAT_CLASS];
+   /*!   the same values per transfer type                     */
+   struct CosMgrSdoType_s  atsType[eCOS_SDO_TYPE_MAX];
+};
+
+typedef struct CosMgrSdoStat_s   CosMgrSdoStat_ts;
+#endif
+
+#if COS_MGR_STAT > 0
+//-------------------------------------------------------------------
+// number of latency classes of the main loop statistic, the classes
+// are built like the classes of the SDO statistic
+//
+#define  COS_MGR_STAT_CLASS      16
+
+
+/*!
+** \struct  CosMgrStat_s
+** \brief   Main loop statistic
+**
+*/
+struct CosMgrStat_s {
+   /*!   number of calls of CosMgrProcess()                    */
+   uint32_t    ulCallCount;
+   /*!   longest duration of CosMgrProcess() in microseconds   */
+   uint32_t    ulTickMax;
+   /*!   number of calls per latency class                     */
+   uint32_t    aulTickClass[COS_MGR_STAT_CLASS];
+};
+
+typedef struct CosMgrStat_s   CosMgrStat_ts;
+#endif
+
+#if COS_BUS_STAT > 0
+/*!
+** \struct  CosMgrBusStat_s
+** \brief   Bus statistic
+**
+** The counters refer to one message buffer or to all message buffers,
+** the frame rate and the bus load always refer to all buffers.
+*/
+struct CosMgrBusStat_s {
+   /*!   number of received frames                             */
+   uint32_t    ulRcvCount;
+   /*!   number of transmitted frames                          */
+   uint32_t    ulTrmCount;
+   /*!   largest change of the frame interval in microseconds  */
+   uint16_t    uwJitterMax;
+   /*!   number of frames during the last second               */
+   uint16_t    uwFrameRate;
+   /*!   estimated bus load during the last second in percent  */
+   uint8_t     ubBusLoad;
+};
+
+typedef struct CosMgrBusStat_s   CosMgrBusStat_ts;
+#endif
+
 /*----------------------------------------------------------------------------*\
 ** Variables of module for external use                                       **
 **                                                                            **
 \*----------------------------------------------------------------------------*/
+#if COS_INSTANCE_MAX == 1
 extern uint8_t       ubCosMgrNodeAddressG;
 extern uint8_t       ubCosMgrBaudrateG;
 #if CP_SMALL_CODE == 0
 extern CpPort_ts     tsCanPortG;                // CAN interface
 #endif
 extern uint16_t      uwCosMgrConfigG;
+#endif
 
 
 /*----------------------------------------------------------------------------*\
@@ -221,6 +349,35 @@ uint32_t  CosMgrGetSerialNumber(void);
 uint8_t  CosMgrIdCheck(uint32_t ulIdentifierV);
 
 
+#if (COS_DICT_OBJ_1016 > 0) && (COS_NMT_HBC_MERGE > 0)
+/*!
+** \brief   Setup the shared heartbeat consumer buffer
+**
+** This function calculates identifier and acceptance mask of the
+** message buffer eCosBuf_NMT_HBC from the node-IDs of all active
+** entries of index 1016h. The mask only compares the node-ID bits
+** which have the same value in all monitored node-IDs. Without an
+** active entry the message buffer is released.
+** <p>
+** The mask may still accept node-IDs which are not monitored. The
+** function therefore also builds a table which assigns each node-ID
+** to its consumer entry, so the receive handler finds the entry of
+** a heartbeat with one access. If a node-ID is entered twice, only
+** the first entry is served.
+** <p>
+** The parameter setup in cos301.c calls the function after all
+** entries have been set. A write access to index 1016h must call it
+** as well. The NMT module is not part of this source tree: its
+** CosNmtSetHeartbeatCons() must not initialise a message buffer of
+** its own in this configuration and must address the heartbeat
+** consumer buffers only by COS_BUF_HBC(n), which maps all entries
+** to eCosBuf_NMT_HBC. The function is only available if
+** #COS_NMT_HBC_MERGE is set.
+*/
+void CosMgrHbcFilter(void);
+#endif
+
+
 /*!
 ** \brief   Initialise the CANopen Slave
 ** \param   ubCanIfV  physical CAN interface
@@ -238,7 +395,12 @@ uint8_t CosMgrInit(uint8_t ubCanIfV, uint16_t uwConfigV);
 /*!
 ** \brief   Perform NVM access
 **
-**
+** The function is called by CosMgrProcess(). A save (index 1010h) or
+** restore (index 1011h) request of the SDO server is split into
+** steps: one call of the function saves one parameter group, stores
+** the parameter selection or builds the checksum. The deferred SDO
+** response is sent after the last step, so the main loop continues
+** to serve the CAN messages during the operation.
 */
 void CosMgrNvmOperation(void);
 
@@ -288,6 +450,9 @@ uint8_t CosMgrParmLoad(void);
 ** \li   eCOS_PARM_APP - application parameters (device profile)
 ** \li   eCOS_PARM_MAN - manufacturer specific parameters
 **
+** The function returns after all data has been stored. While a save
+** or restore operation of the SDO server is running the function
+** returns eCosErr_PARM_SAVE.
 */
 uint8_t CosMgrParmSave(uint8_t ubGroupV);
 
@@ -310,6 +475,65 @@ void CosMgrProcessMsg(void);
 void CosMgrProfileUpdate(uint16_t uwIndexV, uint8_t ubSubIndexV);
 
 
+#if COS_SDO_STAT > 0
+/*!
+** \brief   Read SDO server statistic
+** \param   ptsStatV     pointer to statistic structure
+** \param   ubClearV     clear the statistic after reading (1)
+**
+** This function copies the SDO statistic of the CANopen manager to
+** \a ptsStatV. The response time of a request is measured from the
+** reception of the request until the first response frame has been
+** transmitted, so a segmented transfer counts one request per segment.
+** Frames of a block transfer that are not answered by the server
+** are counted as received frames only, an abort request is never
+** answered. Percentiles of the response time can be taken from the
+** latency classes, in total and per transfer type (#CosMgrSdoType_e).
+** The statistic is copied and cleared with the CAN interrupt locked.
+*/
+void CosMgrSdoStatistic(CosMgrSdoStat_ts * ptsStatV, uint8_t ubClearV);
+#endif
+
+
+#if COS_MGR_STAT > 0
+/*!
+** \brief   Read main loop statistic
+** \param   ptsStatV     pointer to statistic structure
+** \param   ubClearV     clear the statistic after reading (1)
+**
+** This function copies the statistic of CosMgrProcess() to
+** \a ptsStatV. The duration of every call is measured in
+** microseconds with McTmrHResTick() and counted in a latency class,
+** so the worst case duration of a main loop iteration can be checked
+** e.g. during the steps of a parameter save operation.
+*/
+void CosMgrStatistic(CosMgrStat_ts * ptsStatV, uint8_t ubClearV);
+#endif
+
+
+#if COS_BUS_STAT > 0
+/*!
+** \brief   Read bus statistic
+** \param   ptsStatV       pointer to statistic structure
+** \param   ubBufferIdxV   message buffer, 0 = all message buffers
+** \param   ubClearV       clear the statistic after reading (1)
+**
+** This function copies the bus statistic of the message buffer
+** \a ubBufferIdxV to \a ptsStatV. Counters are kept for the message
+** buffers of the stack (1 .. #COS_BUFFER_MAX). The jitter is the
+** largest difference between two consecutive frame intervals of the
+** buffer in microseconds, it is limited to 65535. The shared buffer
+** of the heartbeat consumers (#COS_NMT_HBC_MERGE) receives the COB-IDs
+** of several nodes, its jitter is not measured. The bus load is
+** estimated from the DLC of every frame including the worst case number
+** of stuff bits. With \a ubBufferIdxV = 0 the counters are summed up and the
+** largest jitter of all buffers is returned.
+*/
+void CosMgrBusStatistic(CosMgrBusStat_ts * ptsStatV, uint8_t ubBufferIdxV,
+                        uint8_t ubClearV);
+#endif
+
+
 /*!
 ** \brief   Release the CANopen Slave protocol stack
 ** \return  Error Code
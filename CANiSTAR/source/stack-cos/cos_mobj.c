@@ -44,6 +44,10 @@
 #include "cos_nvm.h"       // include NVM memory access
 #include "cos_sdo.h"       // include SDO services
 
+#if COS_BUS_STAT > 0
+#include "cos_mgr.h"       // include bus statistic
+#endif
+
 
 
 /*----------------------------------------------------------------------------*\
@@ -53,6 +57,11 @@
 
 #define  MOB2000_SIZE   5
 
+//-------------------------------------------------------------------
+// number of entries of object 2011h
+//
+#define  MOB2011_SIZE   4
+
 //-------------------------------------------------------------------
 // these values are accessed via SDO callbacks, they are not
 // mapped in a PDO
@@ -462,3 +471,167 @@ uint8_t  CosMob_Idx2007(uint8_t ubSubIndexV, uint8_t ubReqCodeV)
    return(ubHandlerCodeT);
 
 }
+
+
+#if COS_BUS_STAT > 0
+//----------------------------------------------------------------------------//
+// CosMob_BusBuffer()                                                         //
+// read access to one value of the bus statistic of a message buffer          //
+//----------------------------------------------------------------------------//
+static uint8_t CosMob_BusBuffer( uint8_t ubSubIndexV, uint8_t ubReqCodeV,
+                                 uint16_t uwIndexV)
+{
+   CosMgrBusStat_ts  tsStatT;
+   uint32_t          ulValueT;
+   uint8_t           ubSubIdx0T = COS_BUFFER_MAX;
+
+   //----------------------------------------------------------------
+   // test the maximum sub-index
+   //
+   if(ubSubIndexV > COS_BUFFER_MAX)
+   {
+      return(eCosSdo_ERR_NO_SUB_INDEX);
+   }
+
+   if(ubReqCodeV != eSDO_READ_REQ)
+   {
+      return(eCosSdo_ERR_ACCESS_RO);
+   }
+
+   if(ubSubIndexV == 0)
+   {
+      CosSdoCopyValueToMessage(  (void *) &ubSubIdx0T, CoDT_UNSIGNED8);
+      return(eCosSdo_READ1_OK);
+   }
+
+   CosMgrBusStatistic(&tsStatT, ubSubIndexV, 0);
+   switch(uwIndexV)
+   {
+      case 0x2012:
+         ulValueT = tsStatT.ulRcvCount;
+         break;
+
+      case 0x2013:
+         ulValueT = tsStatT.ulTrmCount;
+         break;
+
+      default:
+         ulValueT = tsStatT.uwJitterMax;
+         break;
+   }
+
+   CosSdoCopyValueToMessage(  (void *) &ulValueT, CoDT_UNSIGNED32);
+   return(eCosSdo_READ4_OK);
+}
+
+
+//----------------------------------------------------------------------------//
+// CosMob_Idx2011()                                                           //
+// bus statistic of all message buffers                                       //
+//----------------------------------------------------------------------------//
+uint8_t CosMob_Idx2011(uint8_t ubSubIndexV, uint8_t ubReqCodeV)
+{
+   CosMgrBusStat_ts  tsStatT;
+   uint8_t           ubValueT;
+
+
+   //----------------------------------------------------------------
+   // test the maximum sub-index
+   //
+   if(ubSubIndexV > MOB2011_SIZE)
+   {
+      return(eCosSdo_ERR_NO_SUB_INDEX);
+   }
+
+
+   //----------------------------------------------------------------
+   // write access: only a value of 0 to sub-index 0 is allowed,
+   // it clears the statistic
+   //
+   if(ubReqCodeV != eSDO_READ_REQ)
+   {
+      if(ubSubIndexV != 0)
+      {
+         return(eCosSdo_ERR_ACCESS_RO);
+      }
+
+      if( (ubReqCodeV != eSDO_WRITE_REQ_0) &&
+          (ubReqCodeV != eSDO_WRITE_REQ_1) )
+      {
+         return(eCosSdo_ERR_DATATYPE);
+      }
+
+      CosSdoCopyMessageToValue(  (void *) &ubValueT, CoDT_UNSIGNED8);
+      if(ubValueT > 0)
+      {
+         return(eCosSdo_ERR_VALUE_HIGH);
+      }
+
+      CosMgrBusStatistic(&tsStatT, 0, 1);
+      return(eCosSdo_WRITE_OK);
+   }
+
+
+   //----------------------------------------------------------------
+   // read access
+   //
+   CosMgrBusStatistic(&tsStatT, 0, 0);
+   switch(ubSubIndexV)
+   {
+      case 1:
+         CosSdoCopyValueToMessage(  (void *) &tsStatT.uwFrameRate,
+                                    CoDT_UNSIGNED16);
+         return(eCosSdo_READ2_OK);
+
+      case 2:
+         CosSdoCopyValueToMessage(  (void *) &tsStatT.ubBusLoad,
+                                    CoDT_UNSIGNED8);
+         return(eCosSdo_READ1_OK);
+
+      case 3:
+         CosSdoCopyValueToMessage(  (void *) &tsStatT.ulRcvCount,
+                                    CoDT_UNSIGNED32);
+         return(eCosSdo_READ4_OK);
+
+      case 4:
+         CosSdoCopyValueToMessage(  (void *) &tsStatT.ulTrmCount,
+                                    CoDT_UNSIGNED32);
+         return(eCosSdo_READ4_OK);
+
+      default:
+         ubValueT = MOB2011_SIZE;
+         CosSdoCopyValueToMessage(  (void *) &ubValueT, CoDT_UNSIGNED8);
+         return(eCosSdo_READ1_OK);
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// CosMob_Idx2012()                                                           //
+// received frames per message buffer                                         //
+//----------------------------------------------------------------------------//
+uint8_t CosMob_Idx2012(uint8_t ubSubIndexV, uint8_t ubReqCodeV)
+{
+   return(CosMob_BusBuffer(ubSubIndexV, ubReqCodeV, 0x2012));
+}
+
+
+//----------------------------------------------------------------------------//
+// CosMob_Idx2013()                                                           //
+// transmitted frames per message buffer                                      //
+//----------------------------------------------------------------------------//
+uint8_t CosMob_Idx2013(uint8_t ubSubIndexV, uint8_t ubReqCodeV)
+{
+   return(CosMob_BusBuffer(ubSubIndexV, ubReqCodeV, 0x2013));
+}
+
+
+//----------------------------------------------------------------------------//
+// CosMob_Idx2014()                                                           //
+// largest frame interval jitter per message buffer                           //
+//----------------------------------------------------------------------------//
+uint8_t CosMob_Idx2014(uint8_t ubSubIndexV, uint8_t ubReqCodeV)
+{
+   return(CosMob_BusBuffer(ubSubIndexV, ubReqCodeV, 0x2014));
+}
+#endif
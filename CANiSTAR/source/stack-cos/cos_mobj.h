@@ -89,29 +89,34 @@ extern "C" {                                                         //
 
 
 //-------------------------------------------------------------------
-// the variable 'ubCosMob_Var2002G' has read/write access
+// the variable 'ubCosMob_Var2002G' has read/write access, it can
+// be mapped into a PDO
 //
 extern uint8_t    ubCosMob_Var2002G;
 
 //-------------------------------------------------------------------
-// the variable 'uwCosMob_Var2003G' has read/write access
+// the variable 'uwCosMob_Var2003G' has read/write access, it can
+// be mapped into a PDO
 //
 extern uint16_t   uwCosMob_Var2003G;
 
 //-------------------------------------------------------------------
-// the variable 'ulCosMob_Var2004G' has read/write access
+// the variable 'ulCosMob_Var2004G' has read/write access, it can
+// be mapped into a PDO
 //
 extern uint32_t   ulCosMob_Var2004G;
 
 //-------------------------------------------------------------------
-// the variable 'uqCosMob_Var2005G' has read/write access
+// the variable 'uqCosMob_Var2005G' has read/write access, it can
+// be mapped into a PDO
 //
 #if CPP_DATA_SIZE >= 64
 extern uint64_t   uqCosMob_Var2005G;
 #endif
 
 //-------------------------------------------------------------------
-// the string 'szCosMob_Str2008G' has read/write acccess
+// the string 'szCosMob_Str2008G' has read/write acccess, it can
+// be mapped into a PDO
 //
 extern char	      szCosMob_Str2008G[];
 
@@ -229,6 +234,65 @@ uint8_t  CosMob_Idx2006(uint8_t ubSubIndexV, uint8_t ubReqCodeV);
 
 uint8_t  CosMob_Idx2007(uint8_t ubSubIndexV, uint8_t ubReqCodeV);
 
+
+#if COS_BUS_STAT > 0
+/*!
+** \brief   Index 2011h - Bus statistic
+** \param   ubSubIndexV    sub-index
+** \param   ubReqCodeV     read / write access
+** \return  SDO response code
+**
+** The object has the following sub-indices:
+** \li 1: frames per second (UNSIGNED16)
+** \li 2: estimated bus load in percent (UNSIGNED8)
+** \li 3: received frames of all message buffers (UNSIGNED32)
+** \li 4: transmitted frames of all message buffers (UNSIGNED32)
+**
+** Writing the value 0 to sub-index 0 clears the counters of all
+** message buffers.
+*/
+uint8_t  CosMob_Idx2011(uint8_t ubSubIndexV, uint8_t ubReqCodeV);
+
+
+/*!
+** \brief   Index 2012h - Received frames per message buffer
+** \param   ubSubIndexV    sub-index
+** \param   ubReqCodeV     read / write access
+** \return  SDO response code
+**
+** The sub-index is the message buffer number (#CosBuf_e), only the
+** message buffers of the stack (1 .. #COS_BUFFER_MAX) have counters.
+** The values are UNSIGNED32.
+*/
+uint8_t  CosMob_Idx2012(uint8_t ubSubIndexV, uint8_t ubReqCodeV);
+
+
+/*!
+** \brief   Index 2013h - Transmitted frames per message buffer
+** \param   ubSubIndexV    sub-index
+** \param   ubReqCodeV     read / write access
+** \return  SDO response code
+**
+** The object is built like index 2012h.
+*/
+uint8_t  CosMob_Idx2013(uint8_t ubSubIndexV, uint8_t ubReqCodeV);
+
+
+/*!
+** \brief   Index 2014h - Frame interval jitter per message buffer
+** \param   ubSubIndexV    sub-index
+** \param   ubReqCodeV     read / write access
+** \return  SDO response code
+**
+** The object is built like index 2012h. The value is the largest
+** difference between two consecutive frame intervals in microseconds.
+** The shared buffer of the heartbeat consumers (#COS_NMT_HBC_MERGE)
+** receives the COB-IDs of several nodes, its value is 0.
+*/
+uint8_t  CosMob_Idx2014(uint8_t ubSubIndexV, uint8_t ubReqCodeV);
+#endif
+
+
 //-------------------------------------------------------------------//
 #ifdef __cplusplus                                                   //
 }                                                                    //
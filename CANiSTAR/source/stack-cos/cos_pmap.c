@@ -0,0 +1,384 @@
+//****************************************************************************//
+// File:          cos_pmap.c                                                  //
+// Description:   Copy plans for the variable PDO mapping                     //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include "cos_pmap.h"      // PDO copy plans
+#include "cos_dict.h"      // object dictionary
+
+
+//------------------------------------------------------------------#
+// test if the variable PDO mapping is enabled
+#if COS_PDO_MAPPING > 0
+
+
+/*----------------------------------------------------------------------------*\
+** Variables of module                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#if COS_INSTANCE_MAX == 1
+#if COS_PDO_RCV_NUMBER > 0
+static CosPmap_ts    atsCosPmapRcvS[COS_PDO_RCV_NUMBER];
+#endif
+#if COS_PDO_TRM_NUMBER > 0
+static CosPmap_ts    atsCosPmapTrmS[COS_PDO_TRM_NUMBER];
+#endif
+#else
+#define  atsCosPmapRcvS       (ptsCosInstG->atsPmapRcv)
+#define  atsCosPmapTrmS       (ptsCosInstG->atsPmapTrm)
+#endif
+
+//-------------------------------------------------------------------
+// size in bytes of the data types CoDT_BOOLEAN .. CoDT_UNSIGNED64,
+// a value of 0 is used for data types with variable length
+//
+static CPP_CONST uint8_t aubCosPmapSizeC[] = {
+   0,                      // not used
+   1, 1, 2, 4,             // BOOLEAN, INTEGER8, INTEGER16, INTEGER32
+   1, 2, 4, 4,             // UNSIGNED8, UNSIGNED16, UNSIGNED32, REAL32
+   0, 0, 0,                // VISIBLE_STRING, OCTET_STRING, UNICODE
+   6, 6, 0, 0,             // TIME_OF_DAY, TIME_DIFFERENCE, -, DOMAIN
+   3, 8, 5, 6, 7, 8,       // INTEGER24, REAL64, INTEGER40 .. 64
+   3, 0, 5, 6, 7, 8        // UNSIGNED24, -, UNSIGNED40 .. 64
+};
+
+//-------------------------------------------------------------------
+// declaration of internal functions
+//
+static CosPmap_ts * CosPmapSelect(uint8_t ubDirV, uint8_t ubPdoV);
+
+
+/*----------------------------------------------------------------------------*\
+** Functions                                                                  **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//----------------------------------------------------------------------------//
+// CosPmapBuild()                                                             //
+// translate the mapping entries of a PDO into a copy plan                    //
+//----------------------------------------------------------------------------//
+uint8_t CosPmapBuild(uint8_t ubDirV, uint8_t ubPdoV,
+                     CPP_CONST uint32_t * pulMapV, uint8_t ubCountV)
+{
+   CosPmap_ts                 tsPlanT;       // plan under construction
+   CosPmap_ts *               ptsPlanT;
+   CPP_CONST CosDicEntry_ts * ptsEntryT;
+   uint16_t                   uwIndexT;
+   uint8_t                    ubSubIndexT;
+   uint8_t                    ubSizeT;
+   uint8_t                    ubTypeSizeT;
+   uint8_t                    ubStatusT;
+   uint8_t                    ubEntryT;
+
+
+   ptsPlanT = CosPmapSelect(ubDirV, ubPdoV);
+   if(ptsPlanT == 0L) return(eCosSdo_ERR_GENERAL_PARAMETER);
+   if(ubCountV > 8)   return(eCosSdo_ERR_MAPPING_LENGTH);
+
+   tsPlanT.ubCount = ubCountV;
+   tsPlanT.ubDlc   = 0;
+
+   for(ubEntryT = 0; ubEntryT < ubCountV; ubEntryT++)
+   {
+      uwIndexT    = (uint16_t) (pulMapV[ubEntryT] >> 16);
+      ubSubIndexT = (uint8_t)  (pulMapV[ubEntryT] >>  8);
+
+      //--------------------------------------------------------
+      // the length must be a multiple of 8 bit and the PDO
+      // holds 8 bytes at most
+      //
+      if(((uint8_t) pulMapV[ubEntryT]) & 0x07) return(eCosSdo_ERR_MAPPING_OBJECT);
+      ubSizeT = ((uint8_t) pulMapV[ubEntryT]) >> 3;
+      if(ubSizeT == 0) return(eCosSdo_ERR_MAPPING_OBJECT);
+      if((tsPlanT.ubDlc + ubSizeT) > 8) return(eCosSdo_ERR_MAPPING_LENGTH);
+
+      tsPlanT.atsOp[ubEntryT].ubSize = ubSizeT;
+      tsPlanT.atsOp[ubEntryT].ubSwap = 0;
+      tsPlanT.ubDlc += ubSizeT;
+
+      //--------------------------------------------------------
+      // dummy entry: index 0001h .. 0007h is a data type, the
+      // bytes are skipped in a receive PDO
+      //
+      if((uwIndexT > 0) && (uwIndexT <= CoDT_UNSIGNED32))
+      {
+         if(ubDirV != eCosPmap_RCV) return(eCosSdo_ERR_MAPPING_OBJECT);
+         if(aubCosPmapSizeC[uwIndexT] != ubSizeT)
+         {
+            return(eCosSdo_ERR_MAPPING_OBJECT);
+         }
+         tsPlanT.atsOp[ubEntryT].pubValue = 0L;
+         continue;
+      }
+
+      //--------------------------------------------------------
+      // search the dictionary, this is the only place where
+      // the mapping needs a search
+      //
+      ptsEntryT = CosDictFindEntry(uwIndexT, ubSubIndexT, &ubStatusT);
+      if((ptsEntryT == 0L) || (ubStatusT != eCosDict_FOUND_OBJECT))
+      {
+         return(eCosSdo_ERR_NO_OBJECT);
+      }
+
+      //--------------------------------------------------------
+      // an object with SDO callback has no address to copy
+      // from or to
+      //
+      if((ptsEntryT->ubAttribute & CoATTR_PDO_MAP) == 0)
+      {
+         return(eCosSdo_ERR_MAPPING_OBJECT);
+      }
+      if(ptsEntryT->ubAttribute & CoATTR_FUNCTION)
+      {
+         return(eCosSdo_ERR_MAPPING_OBJECT);
+      }
+
+      //--------------------------------------------------------
+      // a receive PDO writes the object, a transmit PDO reads it
+      //
+      if(ubDirV == eCosPmap_RCV)
+      {
+         if((ptsEntryT->ubAttribute & CoATTR_ACC_WO) == 0)
+         {
+            return(eCosSdo_ERR_MAPPING_OBJECT);
+         }
+      }
+      else
+      {
+         if((ptsEntryT->ubAttribute & CoATTR_ACC_RO) == 0)
+         {
+            return(eCosSdo_ERR_MAPPING_OBJECT);
+         }
+      }
+
+      //--------------------------------------------------------
+      // a value must be mapped with its full size, for strings
+      // and domains the mapped length is taken
+      //
+      ubTypeSizeT = 0;
+      if(ptsEntryT->ubDataType < sizeof(aubCosPmapSizeC))
+      {
+         ubTypeSizeT = aubCosPmapSizeC[ptsEntryT->ubDataType];
+      }
+      if((ubTypeSizeT > 0) && (ubTypeSizeT != ubSizeT))
+      {
+         return(eCosSdo_ERR_MAPPING_OBJECT);
+      }
+
+      //--------------------------------------------------------
+      // only numeric values are swapped on a big endian CPU,
+      // strings, domains and the TIME types are byte streams
+      //
+      #if CPP_BIG_ENDIAN > 0
+      if((ubTypeSizeT > 1)                              &&
+         (ptsEntryT->ubDataType != CoDT_TIME_OF_DAY)    &&
+         (ptsEntryT->ubDataType != CoDT_TIME_DIFFERENCE)  )
+      {
+         tsPlanT.atsOp[ubEntryT].ubSwap = 1;
+      }
+      #endif
+
+      tsPlanT.atsOp[ubEntryT].pubValue = (uint8_t *) ptsEntryT->pvdValue;
+   }
+
+   //----------------------------------------------------------------
+   // all entries are valid, activate the new plan
+   //
+   *ptsPlanT = tsPlanT;
+
+   return(eCosSdo_WRITE_OK);
+}
+
+
+//----------------------------------------------------------------------------//
+// CosPmapClear()                                                             //
+// disable a PDO                                                              //
+//----------------------------------------------------------------------------//
+void CosPmapClear(uint8_t ubDirV, uint8_t ubPdoV)
+{
+   CosPmap_ts *   ptsPlanT;
+
+   ptsPlanT = CosPmapSelect(ubDirV, ubPdoV);
+   if(ptsPlanT == 0L) return;
+
+   ptsPlanT->ubCount = 0;
+   ptsPlanT->ubDlc   = 0;
+}
+
+
+//----------------------------------------------------------------------------//
+// CosPmapInit()                                                              //
+// disable all PDOs                                                           //
+//----------------------------------------------------------------------------//
+void CosPmapInit(void)
+{
+   uint8_t  ubPdoT;
+
+   #if COS_PDO_RCV_NUMBER > 0
+   for(ubPdoT = 0; ubPdoT < COS_PDO_RCV_NUMBER; ubPdoT++)
+   {
+      CosPmapClear(eCosPmap_RCV, ubPdoT);
+   }
+   #endif
+
+   #if COS_PDO_TRM_NUMBER > 0
+   for(ubPdoT = 0; ubPdoT < COS_PDO_TRM_NUMBER; ubPdoT++)
+   {
+      CosPmapClear(eCosPmap_TRM, ubPdoT);
+   }
+   #endif
+}
+
+
+//----------------------------------------------------------------------------//
+// CosPmapRcv()                                                               //
+// copy the data of a receive PDO to the mapped objects                       //
+//----------------------------------------------------------------------------//
+uint8_t CosPmapRcv(uint8_t ubPdoV, CPP_CONST uint8_t * pubDataV,
+                   uint8_t ubDlcV)
+{
+   #if COS_PDO_RCV_NUMBER > 0
+   CPP_CONST CosPmap_ts *     ptsPlanT;
+   CPP_CONST CosPmapOp_ts *   ptsOpT;
+   uint8_t *                  pubValueT;
+   uint8_t                    ubCountT;
+   uint8_t                    ubSizeT;
+
+
+   if(ubPdoV >= COS_PDO_RCV_NUMBER) return(1);
+
+   ptsPlanT = &atsCosPmapRcvS[ubPdoV];
+   if(ptsPlanT->ubCount == 0)     return(1);
+   if(ubDlcV < ptsPlanT->ubDlc)   return(1);
+
+   ptsOpT = &ptsPlanT->atsOp[0];
+   for(ubCountT = ptsPlanT->ubCount; ubCountT > 0; ubCountT--)
+   {
+      ubSizeT   = ptsOpT->ubSize;
+      pubValueT = ptsOpT->pubValue;
+      if(pubValueT != 0L)
+      {
+         #if CPP_BIG_ENDIAN > 0
+         if(ptsOpT->ubSwap)
+         {
+            pubValueT += ubSizeT;
+            while(ubSizeT > 0)
+            {
+               *(--pubValueT) = *pubDataV++;
+               ubSizeT--;
+            }
+         }
+         #endif
+         while(ubSizeT > 0)
+         {
+            *pubValueT++ = *pubDataV++;
+            ubSizeT--;
+         }
+      }
+      else
+      {
+         pubDataV += ubSizeT;
+      }
+      ptsOpT++;
+   }
+
+   return(0);
+
+   #else
+   return(1);
+   #endif
+}
+
+
+//----------------------------------------------------------------------------//
+// CosPmapSelect()                                                            //
+// get the plan of a PDO                                                      //
+//----------------------------------------------------------------------------//
+static CosPmap_ts * CosPmapSelect(uint8_t ubDirV, uint8_t ubPdoV)
+{
+   #if COS_PDO_RCV_NUMBER > 0
+   if((ubDirV == eCosPmap_RCV) && (ubPdoV < COS_PDO_RCV_NUMBER))
+   {
+      return(&atsCosPmapRcvS[ubPdoV]);
+   }
+   #endif
+
+   #if COS_PDO_TRM_NUMBER > 0
+   if((ubDirV == eCosPmap_TRM) && (ubPdoV < COS_PDO_TRM_NUMBER))
+   {
+      return(&atsCosPmapTrmS[ubPdoV]);
+   }
+   #endif
+
+   return(0L);
+}
+
+
+//----------------------------------------------------------------------------//
+// CosPmapTrm()                                                               //
+// copy the mapped objects to the data of a transmit PDO                      //
+//----------------------------------------------------------------------------//
+uint8_t CosPmapTrm(uint8_t ubPdoV, uint8_t * pubDataV)
+{
+   #if COS_PDO_TRM_NUMBER > 0
+   CPP_CONST CosPmap_ts *     ptsPlanT;
+   CPP_CONST CosPmapOp_ts *   ptsOpT;
+   CPP_CONST uint8_t *        pubValueT;
+   uint8_t                    ubCountT;
+   uint8_t                    ubSizeT;
+
+
+   if(ubPdoV >= COS_PDO_TRM_NUMBER) return(0);
+
+   ptsPlanT = &atsCosPmapTrmS[ubPdoV];
+   ptsOpT   = &ptsPlanT->atsOp[0];
+   for(ubCountT = ptsPlanT->ubCount; ubCountT > 0; ubCountT--)
+   {
+      ubSizeT   = ptsOpT->ubSize;
+      pubValueT = ptsOpT->pubValue;
+
+      #if CPP_BIG_ENDIAN > 0
+      if(ptsOpT->ubSwap)
+      {
+         pubValueT += ubSizeT;
+         while(ubSizeT > 0)
+         {
+            *pubDataV++ = *(--pubValueT);
+            ubSizeT--;
+         }
+      }
+      #endif
+      while(ubSizeT > 0)
+      {
+         *pubDataV++ = *pubValueT++;
+         ubSizeT--;
+      }
+      ptsOpT++;
+   }
+
+   return(ptsPlanT->ubDlc);
+
+   #else
+   return(0);
+   #endif
+}
+
+
+#endif   // COS_PDO_MAPPING > 0
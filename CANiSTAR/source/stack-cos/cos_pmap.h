@@ -0,0 +1,179 @@
+//****************************************************************************//
+// File:          cos_pmap.h                                                  //
+// Description:   Copy plans for the variable PDO mapping                     //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+#ifndef  COS_PMAP_H_
+#define  COS_PMAP_H_
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include "cos_defs.h"      // CANopen Slave definition file
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \file    cos_pmap.h
+** \brief   Copy plans for the variable PDO mapping
+**
+** With the variable PDO mapping (#COS_PDO_MAPPING == 1) the content of
+** a PDO is defined by the mapping objects 1600h .. and 1A00h .. . Each
+** mapping entry has the format <i>index (16 bit), sub-index (8 bit),
+** length in bits (8 bit)</i>.
+** <p>
+** This module translates the mapping entries of one PDO into a copy
+** plan: a flat list of (address, length) pairs. The object dictionary
+** is searched only once, when the plan is built. Receiving or sending
+** a PDO just runs through the list, which is as fast as a hand-coded
+** fixed mapping.
+** <p>
+** The PDO module (cos_pdo.c) uses the functions as follows:
+** \li CosPmapBuild() when sub-index 0 of a mapping object is written
+**     with a value greater 0, and after loading the mapping parameters
+**     from non-volatile memory
+** \li CosPmapClear() when sub-index 0 of a mapping object is set to 0
+** \li CosPmapRcv() inside CosPdoReceive()
+** \li CosPmapTrm() before a transmit PDO is sent
+** <p>
+** Only objects with a data pointer (no SDO callback) and the attribute
+** #CoATTR_PDO_MAP can be mapped. The length must be a multiple of 8
+** bits. Dummy entries (index 0001h .. 0007h) are accepted for receive
+** PDOs, the data bytes at this position are skipped.
+** <p>
+** The data inside a PDO is little endian. On a big endian CPU
+** (#CPP_BIG_ENDIAN) the byte order of numeric values is reversed
+** during the copy operation. Strings, domains and the TIME types
+** are copied byte by byte, CosPmapBuild() stores the decision per
+** copy operation.
+*/
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------
+// The plan structures CosPmap_ts and CosPmapOp_ts are defined in
+// cos_defs.h, they are part of the instance data (cos_inst.h).
+//
+
+//-------------------------------------------------------------------
+/*!
+** \enum    CosPmapDir_e
+** \brief   Direction of a PDO
+*/
+enum CosPmapDir_e {
+   /*! Receive PDO, mapping object 1600h + PDO number   */
+   eCosPmap_RCV = 0,
+
+   /*! Transmit PDO, mapping object 1A00h + PDO number  */
+   eCosPmap_TRM
+};
+
+
+/*----------------------------------------------------------------------------*\
+** Function prototypes                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------//
+// take precautions if compiled with C++ compiler                    //
+#ifdef __cplusplus                                                   //
+extern "C" {                                                         //
+#endif                                                               //
+//-------------------------------------------------------------------//
+
+
+#if COS_PDO_MAPPING > 0
+
+/*!
+** \brief   Build the copy plan of a PDO
+** \param   ubDirV         Direction, taken from #CosPmapDir_e
+** \param   ubPdoV         PDO number, starting with 0
+** \param   pulMapV        Mapping entries (sub-index 1 .. n)
+** \param   ubCountV       Number of mapping entries (sub-index 0)
+**
+** \return  eCosSdo_WRITE_OK or the SDO abort code:
+**          \li eCosSdo_ERR_NO_OBJECT - mapped object does not exist
+**          \li eCosSdo_ERR_MAPPING_OBJECT - object can not be mapped
+**          \li eCosSdo_ERR_MAPPING_LENGTH - PDO length exceeded
+**          \li eCosSdo_ERR_GENERAL_PARAMETER - wrong PDO number
+**
+** The function searches the object dictionary for every mapping entry
+** and stores the address and the size of the object. The plan of the
+** PDO is only changed if all entries are valid, i.e. on an error the
+** previous plan stays active. A value of 0 for \a ubCountV disables
+** the PDO.
+*/
+uint8_t  CosPmapBuild(uint8_t ubDirV, uint8_t ubPdoV,
+                      CPP_CONST uint32_t * pulMapV, uint8_t ubCountV);
+
+
+/*!
+** \brief   Disable the copy plan of a PDO
+** \param   ubDirV         Direction, taken from #CosPmapDir_e
+** \param   ubPdoV         PDO number, starting with 0
+*/
+void     CosPmapClear(uint8_t ubDirV, uint8_t ubPdoV);
+
+
+/*!
+** \brief   Initialise the copy plans
+**
+** All receive and transmit PDOs are disabled. The function is called
+** before the mapping parameters are loaded.
+*/
+void     CosPmapInit(void);
+
+
+/*!
+** \brief   Copy the data of a receive PDO to the mapped objects
+** \param   ubPdoV         PDO number, starting with 0
+** \param   pubDataV       Data of the received CAN message
+** \param   ubDlcV         DLC of the received CAN message
+**
+** \return  0 if the data was copied, 1 if the PDO is disabled or
+**          the DLC is too short (the caller sends EMCY 8210h)
+**
+** A PDO with more data bytes than mapped is accepted, the additional
+** bytes are ignored.
+*/
+uint8_t  CosPmapRcv(uint8_t ubPdoV, CPP_CONST uint8_t * pubDataV,
+                    uint8_t ubDlcV);
+
+
+/*!
+** \brief   Copy the mapped objects to the data of a transmit PDO
+** \param   ubPdoV         PDO number, starting with 0
+** \param   pubDataV       Data of the CAN message (8 bytes)
+**
+** \return  DLC of the transmit PDO, 0 if the PDO is disabled
+*/
+uint8_t  CosPmapTrm(uint8_t ubPdoV, uint8_t * pubDataV);
+
+#endif
+
+
+//-------------------------------------------------------------------//
+#ifdef __cplusplus                                                   //
+}                                                                    //
+#endif                                                               //
+// end of C++ compiler wrapper                                       //
+//-------------------------------------------------------------------//
+
+#endif   // COS_PMAP_H_
@@ -0,0 +1,394 @@
+//****************************************************************************//
+// File:          cos_psch.c                                                  //
+// Description:   Transmit PDO scheduler                                      //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include "cos_psch.h"      // PDO scheduler
+#include "cos_mgr.h"       // CAN interface
+#include "cos_nmt.h"       // NMT state
+#include "cos_pdo.h"       // PDO communication parameter
+
+#if COS_PDO_MAPPING > 0
+#include "cos_pmap.h"      // PDO copy plans
+#endif
+
+
+//------------------------------------------------------------------#
+// test if the PDO scheduler is enabled
+#if (COS_PDO_SCHED > 0) && (COS_PDO_TRM_NUMBER > 0)
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------
+// transmission types of index 180xh, sub-index 2
+//
+#define  PSCH_TYPE_ACYCLIC    0           // synchronous, acyclic
+#define  PSCH_TYPE_SYNC_MAX   240         // synchronous, every n-th SYNC
+#define  PSCH_TYPE_EVENT_MAN  254         // event-driven, manufacturer
+#define  PSCH_TYPE_EVENT_DEV  255         // event-driven, device profile
+
+//-------------------------------------------------------------------
+// bit 31 of the COB-ID: PDO does not exist / is not valid
+//
+#define  PSCH_COB_ID_INVALID  0x80000000
+
+//-------------------------------------------------------------------
+// timer ticks to wait for the transmit interrupt of a PDO, then the
+// next frame of this PDO is handed to the CAN controller anyway
+//
+#define  PSCH_TRM_TIMEOUT     10
+
+
+/*----------------------------------------------------------------------------*\
+** Variables of module                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#if COS_INSTANCE_MAX == 1
+static uint32_t   aulCosPschEventS[COS_PDO_TRM_NUMBER];     // event timer
+static uint16_t   auwCosPschInhibitS[COS_PDO_TRM_NUMBER];   // inhibit time
+static uint8_t    aubCosPschSyncS[COS_PDO_TRM_NUMBER];      // SYNC counter
+static uint8_t    aubCosPschPendS[COS_PDO_TRM_NUMBER];      // event pending
+static uint8_t    aubCosPschQueueS[COS_PDO_TRM_NUMBER];     // PDO is queued
+static uint8_t    aubCosPschTrmPendS[COS_PDO_TRM_NUMBER];   // not transmitted
+#if COS_PDO_MAPPING > 0
+static uint8_t    aubCosPschDataS[COS_PDO_TRM_NUMBER][8];   // sampled data
+static uint8_t    aubCosPschDlcS[COS_PDO_TRM_NUMBER];       // sampled DLC
+#endif
+#else
+#define  aulCosPschEventS     (ptsCosInstG->aulPschEvent)
+#define  auwCosPschInhibitS   (ptsCosInstG->auwPschInhibit)
+#define  aubCosPschSyncS      (ptsCosInstG->aubPschSync)
+#define  aubCosPschPendS      (ptsCosInstG->aubPschPend)
+#define  aubCosPschQueueS     (ptsCosInstG->aubPschQueue)
+#define  aubCosPschTrmPendS   (ptsCosInstG->aubPschTrmPend)
+#define  aubCosPschDataS      (ptsCosInstG->aubPschData)
+#define  aubCosPschDlcS       (ptsCosInstG->aubPschDlc)
+#endif
+
+//-------------------------------------------------------------------
+// declaration of internal functions
+//
+static uint32_t   CosPschEventTicks(uint8_t ubPdoV);
+static void       CosPschQueueSend(void);
+static void       CosPschSample(uint8_t ubPdoV);
+
+
+/*----------------------------------------------------------------------------*\
+** Functions                                                                  **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//----------------------------------------------------------------------------//
+// CosPschAppEvent()                                                          //
+// data of a transmit PDO has changed                                         //
+//----------------------------------------------------------------------------//
+void CosPschAppEvent(uint8_t ubPdoV)
+{
+   uint8_t  ubTypeT;
+
+   if(ubPdoV >= COS_PDO_TRM_NUMBER) return;
+
+   ubTypeT = atsTrmPdoComG[ubPdoV].ubTransType;
+
+   //----------------------------------------------------------------
+   // the function runs in the main loop, CosPschSync() and
+   // CosPschTrmEvent() use the same variables from the CAN interrupt
+   //
+   CpCoreIntLock(&tsCanPortG);
+
+   //----------------------------------------------------------------
+   // acyclic synchronous PDO: send after the next SYNC
+   //
+   if(ubTypeT == PSCH_TYPE_ACYCLIC)
+   {
+      aubCosPschPendS[ubPdoV] = 1;
+   }
+
+   //----------------------------------------------------------------
+   // event-driven PDO: send now or when the inhibit time has
+   // elapsed
+   //
+   else if(ubTypeT >= PSCH_TYPE_EVENT_MAN)
+   {
+      if(auwCosPschInhibitS[ubPdoV] == 0)
+      {
+         CosPschSample(ubPdoV);
+      }
+      else
+      {
+         aubCosPschPendS[ubPdoV] = 1;
+      }
+   }
+   CpCoreIntUnlock(&tsCanPortG);
+
+   CosPschQueueSend();
+}
+
+
+//----------------------------------------------------------------------------//
+// CosPschEventTicks()                                                        //
+// event timer of a PDO in timer ticks, 0 if not used                         //
+//----------------------------------------------------------------------------//
+static uint32_t CosPschEventTicks(uint8_t ubPdoV)
+{
+   uint32_t ulTicksT;
+
+   //----------------------------------------------------------------
+   // the event timer has a resolution of 1 ms, a value greater 0
+   // gives at least one tick
+   //
+   ulTicksT = atsTrmPdoComG[ubPdoV].uwEventTime;
+   ulTicksT = (ulTicksT * 1000L) / COS_TIMER_PERIOD;
+   if((ulTicksT == 0) && (atsTrmPdoComG[ubPdoV].uwEventTime > 0))
+   {
+      ulTicksT = 1;
+   }
+
+   return(ulTicksT);
+}
+
+
+//----------------------------------------------------------------------------//
+// CosPschInit()                                                              //
+// initialise the counters and the queue of all transmit PDOs                 //
+//----------------------------------------------------------------------------//
+void CosPschInit(void)
+{
+   uint8_t  ubPdoT;
+
+   CpCoreIntLock(&tsCanPortG);
+   for(ubPdoT = 0; ubPdoT < COS_PDO_TRM_NUMBER; ubPdoT++)
+   {
+      aulCosPschEventS[ubPdoT]   = CosPschEventTicks(ubPdoT);
+      auwCosPschInhibitS[ubPdoT] = 0;
+      aubCosPschSyncS[ubPdoT]    = atsTrmPdoComG[ubPdoT].ubTransType;
+      aubCosPschPendS[ubPdoT]    = 0;
+      aubCosPschQueueS[ubPdoT]   = 0;
+      aubCosPschTrmPendS[ubPdoT] = 0;
+   }
+   CpCoreIntUnlock(&tsCanPortG);
+}
+
+
+//----------------------------------------------------------------------------//
+// CosPschQueueSend()                                                         //
+// hand the queued PDOs to the CAN controller                                 //
+//----------------------------------------------------------------------------//
+static void CosPschQueueSend(void)
+{
+   uint8_t  ubPdoT;
+   #if COS_PDO_MAPPING > 0
+   uint8_t  aubDataT[8];
+   uint8_t  ubDlcT;
+   uint8_t  ubCntT;
+   #endif
+
+   for(ubPdoT = 0; ubPdoT < COS_PDO_TRM_NUMBER; ubPdoT++)
+   {
+      //--------------------------------------------------------
+      // the message buffer of a PDO holds one frame: a PDO whose
+      // last frame has not been transmitted stays in the queue
+      // until its transmit interrupt, the driver functions below
+      // lock the interrupt by themselves
+      //
+      CpCoreIntLock(&tsCanPortG);
+      if( (aubCosPschQueueS[ubPdoT] == 0) ||
+          (aubCosPschTrmPendS[ubPdoT] > 0) )
+      {
+         CpCoreIntUnlock(&tsCanPortG);
+         continue;
+      }
+
+      #if COS_PDO_MAPPING > 0
+      for(ubCntT = 0; ubCntT < 8; ubCntT++)
+      {
+         aubDataT[ubCntT] = aubCosPschDataS[ubPdoT][ubCntT];
+      }
+      ubDlcT = aubCosPschDlcS[ubPdoT];
+      #endif
+      aubCosPschQueueS[ubPdoT]   = 0;
+      aubCosPschTrmPendS[ubPdoT] = PSCH_TRM_TIMEOUT;
+      CpCoreIntUnlock(&tsCanPortG);
+
+      #if COS_PDO_MAPPING > 0
+      CpCoreBufferSetData(&tsCanPortG, eCosBuf_PDO1_TRM + ubPdoT,
+                          &aubDataT[0]);
+      CpCoreBufferSetDlc(&tsCanPortG, eCosBuf_PDO1_TRM + ubPdoT, ubDlcT);
+      #else
+      CosPdoTrmDataUpdate(ubPdoT);
+      #endif
+
+      CpCoreBufferSend(&tsCanPortG, eCosBuf_PDO1_TRM + ubPdoT);
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// CosPschSample()                                                            //
+// sample the data of a transmit PDO and put it into the queue                //
+//----------------------------------------------------------------------------//
+static void CosPschSample(uint8_t ubPdoV)
+{
+   #if COS_PDO_MAPPING > 0
+   uint8_t  ubDlcT;
+   #endif
+
+   aubCosPschPendS[ubPdoV] = 0;
+
+   if(CosNmtGetNodeState() != NODE_STATE_OPERATIONAL)           return;
+   if(atsTrmPdoComG[ubPdoV].ulIdentifier & PSCH_COB_ID_INVALID) return;
+
+   //----------------------------------------------------------------
+   // sample the data of the mapped objects, a PDO which is still
+   // queued gets the new data
+   //
+   #if COS_PDO_MAPPING > 0
+   ubDlcT = CosPmapTrm(ubPdoV, &aubCosPschDataS[ubPdoV][0]);
+   if(ubDlcT == 0) return;
+   aubCosPschDlcS[ubPdoV] = ubDlcT;
+   #endif
+   aubCosPschQueueS[ubPdoV] = 1;
+
+   //----------------------------------------------------------------
+   // restart inhibit time and event timer
+   //
+   #if COS_PDO_INHIBIT == 1
+   auwCosPschInhibitS[ubPdoV] = (uint16_t)
+         ( ( ((uint32_t) atsTrmPdoComG[ubPdoV].uwInhibitTime) * 100L +
+             (COS_TIMER_PERIOD - 1) ) / COS_TIMER_PERIOD );
+   #endif
+   aulCosPschEventS[ubPdoV] = CosPschEventTicks(ubPdoV);
+}
+
+
+//----------------------------------------------------------------------------//
+// CosPschSync()                                                              //
+// send the synchronous PDOs which are due for this SYNC                      //
+//----------------------------------------------------------------------------//
+void CosPschSync(void)
+{
+   uint8_t  ubPdoT;
+   uint8_t  ubTypeT;
+
+   //----------------------------------------------------------------
+   // all PDOs due for this SYNC are sampled first, then they are
+   // handed to the CAN controller in one pass
+   //
+   CpCoreIntLock(&tsCanPortG);
+   for(ubPdoT = 0; ubPdoT < COS_PDO_TRM_NUMBER; ubPdoT++)
+   {
+      ubTypeT = atsTrmPdoComG[ubPdoT].ubTransType;
+
+      if(ubTypeT == PSCH_TYPE_ACYCLIC)
+      {
+         if(aubCosPschPendS[ubPdoT]) CosPschSample(ubPdoT);
+         continue;
+      }
+
+      if(ubTypeT > PSCH_TYPE_SYNC_MAX) continue;
+
+      //--------------------------------------------------------
+      // the counter is reloaded with the transmission type,
+      // a changed type takes effect with the next reload
+      //
+      if(aubCosPschSyncS[ubPdoT] > 1)
+      {
+         aubCosPschSyncS[ubPdoT]--;
+         continue;
+      }
+      aubCosPschSyncS[ubPdoT] = ubTypeT;
+      CosPschSample(ubPdoT);
+   }
+   CpCoreIntUnlock(&tsCanPortG);
+
+   CosPschQueueSend();
+}
+
+
+//----------------------------------------------------------------------------//
+// CosPschTmrEvent()                                                          //
+// run inhibit time and event timer of the event-driven PDOs                  //
+//----------------------------------------------------------------------------//
+void CosPschTmrEvent(void)
+{
+   uint8_t  ubPdoT;
+
+   CpCoreIntLock(&tsCanPortG);
+   for(ubPdoT = 0; ubPdoT < COS_PDO_TRM_NUMBER; ubPdoT++)
+   {
+      //--------------------------------------------------------
+      // a lost transmit interrupt does not block the PDO
+      //
+      if(aubCosPschTrmPendS[ubPdoT] > 0)
+      {
+         aubCosPschTrmPendS[ubPdoT]--;
+      }
+
+      if(atsTrmPdoComG[ubPdoT].ubTransType < PSCH_TYPE_EVENT_MAN) continue;
+
+      if(auwCosPschInhibitS[ubPdoT] > 0)
+      {
+         auwCosPschInhibitS[ubPdoT]--;
+      }
+
+      //--------------------------------------------------------
+      // an expired event timer is handled like an application
+      // event
+      //
+      if(aulCosPschEventS[ubPdoT] > 0)
+      {
+         aulCosPschEventS[ubPdoT]--;
+         if(aulCosPschEventS[ubPdoT] == 0)
+         {
+            aubCosPschPendS[ubPdoT] = 1;
+         }
+      }
+
+      if(aubCosPschPendS[ubPdoT] && (auwCosPschInhibitS[ubPdoT] == 0))
+      {
+         CosPschSample(ubPdoT);
+      }
+   }
+   CpCoreIntUnlock(&tsCanPortG);
+
+   CosPschQueueSend();
+}
+
+
+//----------------------------------------------------------------------------//
+// CosPschTrmEvent()                                                          //
+// transmit PDO has been transmitted                                          //
+//----------------------------------------------------------------------------//
+void CosPschTrmEvent(uint8_t ubPdoV)
+{
+   if(ubPdoV >= COS_PDO_TRM_NUMBER) return;
+
+   CpCoreIntLock(&tsCanPortG);
+   aubCosPschTrmPendS[ubPdoV] = 0;
+   CpCoreIntUnlock(&tsCanPortG);
+
+   CosPschQueueSend();
+}
+
+
+#endif   // (COS_PDO_SCHED > 0) && (COS_PDO_TRM_NUMBER > 0)
@@ -0,0 +1,145 @@
+//****************************************************************************//
+// File:          cos_psch.h                                                  //
+// Description:   Transmit PDO scheduler                                      //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+#ifndef  COS_PSCH_H_
+#define  COS_PSCH_H_
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include "cos_defs.h"      // CANopen Slave definition file
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \file    cos_psch.h
+** \brief   Transmit PDO scheduler
+**
+** The scheduler sends the transmit PDOs according to their
+** communication parameters (atsTrmPdoComG[], index 1800h ..):
+** transmission type, inhibit time and event timer. It is enabled by
+** the symbol #COS_PDO_SCHED.
+** <p>
+** The scheduler has four entry points:
+** \li CosPschSync() is called by the SYNC receive handler. It samples
+**     all synchronous PDOs which are due for this SYNC and hands them
+**     to the CAN controller in one pass, i.e. within the CAN interrupt
+**     that received the SYNC. The CAN controller sends them ordered by
+**     their identifier.
+** \li CosPschTmrEvent() is called once per timer tick after
+**     CosTmrEvent(). It runs the inhibit time and the event timer of
+**     the PDOs with transmission type 254 / 255.
+** \li CosPschAppEvent() is called by the application when the data of
+**     a PDO has changed.
+** \li CosPschTrmEvent() is called by the transmit handler of CosMgr
+**     when a PDO has been transmitted.
+** <p>
+** A PDO which is due is sampled into the transmit queue, one entry per
+** PDO. The message buffer of a PDO holds one frame: an entry whose
+** previous frame is still pending waits for the transmit interrupt of
+** this frame and newer data replaces the sampled data. So a PDO leaves
+** at the latest with the end of its previous frame, it is not lost.
+** <p>
+** The data is sampled by the copy plan of the variable mapping
+** (cos_pmap.h). With the fixed mapping CosPdoTrmDataUpdate() copies
+** the data when the entry is handed to the CAN controller. A PDO is
+** only sent in the NMT state Operational and if its COB-ID is valid.
+** <p>
+** The entry points run in the main loop, in the timer tick and in the
+** CAN interrupt. They lock the CAN interrupt while they access the
+** counters and the queue.
+** <p>
+** The inhibit time (sub-index 3) and the event timer (sub-index 5) are
+** converted into timer ticks when they are loaded, the resolution is
+** #COS_TIMER_PERIOD.
+*/
+
+
+/*----------------------------------------------------------------------------*\
+** Function prototypes                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------//
+// take precautions if compiled with C++ compiler                    //
+#ifdef __cplusplus                                                   //
+extern "C" {                                                         //
+#endif                                                               //
+//-------------------------------------------------------------------//
+
+
+#if (COS_PDO_SCHED > 0) && (COS_PDO_TRM_NUMBER > 0)
+
+/*!
+** \brief   Application event for a transmit PDO
+** \param   ubPdoV         PDO number, starting with 0
+**
+** A PDO with transmission type 254 / 255 is sent at once if the
+** inhibit time has elapsed, else when it elapses. A PDO with
+** transmission type 0 is sent after the next SYNC. The event is
+** ignored for the other transmission types.
+*/
+void  CosPschAppEvent(uint8_t ubPdoV);
+
+
+/*!
+** \brief   Initialise the PDO scheduler
+**
+** The function is called after the communication parameters have
+** been loaded and after each change of a transmission type, an
+** inhibit time or an event timer. All pending events are cleared.
+*/
+void  CosPschInit(void);
+
+
+/*!
+** \brief   SYNC event
+**
+** The function is called by the SYNC receive handler.
+*/
+void  CosPschSync(void);
+
+
+/*!
+** \brief   Timer event
+**
+** The function is called once per timer tick, after CosTmrEvent().
+*/
+void  CosPschTmrEvent(void);
+
+
+/*!
+** \brief   Transmit event
+** \param   ubPdoV         PDO number, starting with 0
+**
+** The function is called by the transmit handler of CosMgr, the next
+** queued frame of the PDO is handed to the CAN controller.
+*/
+void  CosPschTrmEvent(uint8_t ubPdoV);
+
+#endif
+
+
+//-------------------------------------------------------------------//
+#ifdef __cplusplus                                                   //
+}                                                                    //
+#endif                                                               //
+// end of C++ compiler wrapper                                       //
+//-------------------------------------------------------------------//
+
+#endif   // COS_PSCH_H_
@@ -0,0 +1,259 @@
+//****************************************************************************//
+// File:          bench_dict.c                                                //
+// Description:   Benchmark of the dictionary search methods                  //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "cos_dict.h"
+#include "cos_emcy.h"
+#include "cos_mobj.h"
+#include "cos_nmt.h"
+#include "cos_pdo.h"
+#include "cos_sync.h"
+#include "cos301.h"
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \file    bench_dict.c
+** \brief   Benchmark of CosDictFindEntry()
+**
+** The program is built once for every search method of cos_dict.c:
+** linear search (#COS_DICT_SEARCH_FAST = 0), divide-and-conquer
+** (#COS_DICT_SEARCH_FAST = 1) and hash table (#COS_DICT_SEARCH_HASH
+** slots). The dictionary is the one of the test build, i.e. the
+** objects of CiA 301 and the manufacturer specific objects.
+**
+** Every index from 0000h to BENCH_INDEX_END with the sub-indices 0 to
+** BENCH_SUBIDX_END - 1 is searched once to split the keys into hits
+** and misses. Both key lists are then searched repeatedly and the
+** time per search is reported as one CSV line:
+**
+** method,slots,hits,misses,hit_ns,miss_ns,checksum
+**
+** The checksum covers the result of every search (status, index and
+** sub-index of the entry). All builds must report the same checksum,
+** the Makefile compares them against the linear search.
+**
+** bench_dict [-h] [-n rounds]
+*/
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#define  BENCH_INDEX_END      0x3000
+#define  BENCH_SUBIDX_END     16
+#define  BENCH_KEY_MAX        (BENCH_INDEX_END * BENCH_SUBIDX_END)
+
+#if COS_DICT_SEARCH_HASH > 0
+#define  BENCH_METHOD         "hash"
+#elif COS_DICT_SEARCH_FAST == 1
+#define  BENCH_METHOD         "fast"
+#else
+#define  BENCH_METHOD         "linear"
+#endif
+
+
+/*----------------------------------------------------------------------------*\
+** Variables of module                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------
+// objects of the dictionary, the benchmark reads no value
+//
+uint32_t ulIdx1000_DeviceTypeC;
+uint8_t  ubIdx1001_ErrorRegisterG;
+uint32_t ulIdx1002_StatusRegisterG;
+uint8_t  ubIdx1008_DeviceNameC[] = "bench";
+uint8_t  ubIdx1009_HwVersionC[]  = "1";
+uint8_t  ubIdx100A_SwVersionC[]  = "1";
+
+uint8_t  ubCosMob_Var2002G;
+uint16_t uwCosMob_Var2003G;
+uint32_t ulCosMob_Var2004G;
+uint64_t uqCosMob_Var2005G;
+char     szCosMob_Str2008G[] = "bench";
+
+static uint32_t   aulKeyHitS[BENCH_KEY_MAX];
+static uint32_t   aulKeyMissS[BENCH_KEY_MAX];
+static uint32_t   ulHitCountS;
+static uint32_t   ulMissCountS;
+
+
+/*----------------------------------------------------------------------------*\
+** Functions                                                                  **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//----------------------------------------------------------------------------//
+// SDO callbacks of modules which are not linked to the benchmark            //
+//----------------------------------------------------------------------------//
+uint8_t  Cos301_Idx1018(uint8_t ubSubIndexV, uint8_t ubReqCodeV)     { return(0); }
+uint8_t  CosEmcyErrorField(uint8_t ubSubIndexV, uint8_t ubReqCodeV)  { return(0); }
+uint8_t  CosEmcyIdentifier(uint8_t ubSubIndexV, uint8_t ubReqCodeV)  { return(0); }
+uint8_t  CosMob_Idx2000(uint8_t ubSubIndexV, uint8_t ubReqCodeV)     { return(0); }
+uint8_t  CosMob_Idx2001(uint8_t ubSubIndexV, uint8_t ubReqCodeV)     { return(0); }
+uint8_t  CosMob_Idx2006(uint8_t ubSubIndexV, uint8_t ubReqCodeV)     { return(0); }
+uint8_t  CosMob_Idx2007(uint8_t ubSubIndexV, uint8_t ubReqCodeV)     { return(0); }
+uint8_t  CosNmt_Idx100C(uint8_t ubSubIndexV, uint8_t ubReqCodeV)     { return(0); }
+uint8_t  CosNmt_Idx100D(uint8_t ubSubIndexV, uint8_t ubReqCodeV)     { return(0); }
+uint8_t  CosNmt_Idx1017(uint8_t ubSubIndexV, uint8_t ubReqCodeV)     { return(0); }
+uint8_t  CosNmt_Idx1029(uint8_t ubSubIndexV, uint8_t ubReqCodeV)     { return(0); }
+uint8_t  CosPdoMapParameter(uint8_t ubSubIndexV, uint8_t ubReqCodeV) { return(0); }
+uint8_t  CosPdoRcvComParam(uint8_t ubSubIndexV, uint8_t ubReqCodeV)  { return(0); }
+uint8_t  CosPdoTrmComParam(uint8_t ubSubIndexV, uint8_t ubReqCodeV)  { return(0); }
+uint8_t  CosSync_Idx1005(uint8_t ubSubIndexV, uint8_t ubReqCodeV)    { return(0); }
+uint8_t  CosSync_Idx1006(uint8_t ubSubIndexV, uint8_t ubReqCodeV)    { return(0); }
+
+
+//----------------------------------------------------------------------------//
+// BenchChecksum()                                                            //
+// FNV-1a over the result of one search                                       //
+//----------------------------------------------------------------------------//
+static uint32_t BenchChecksum(uint32_t ulSumV, uint32_t ulKeyV)
+{
+   CPP_CONST CosDicEntry_ts * ptsEntryT;
+   uint32_t                   ulValueT;
+   uint8_t                    ubStatusT;
+   uint8_t                    ubByteT;
+
+   ptsEntryT = CosDictFindEntry((uint16_t) (ulKeyV >> 8), (uint8_t) ulKeyV,
+                                &ubStatusT);
+   ulValueT  = ubStatusT;
+   if(ptsEntryT != 0L)
+   {
+      ulValueT |= ((uint32_t) ptsEntryT->uwIndex << 16) |
+                  ((uint32_t) ptsEntryT->ubSubIndex << 8);
+   }
+
+   for(ubByteT = 0; ubByteT < 4; ubByteT++)
+   {
+      ulSumV = (ulSumV ^ (ulValueT & 0xFF)) * 16777619UL;
+      ulValueT = ulValueT >> 8;
+   }
+   return(ulSumV);
+}
+
+
+//----------------------------------------------------------------------------//
+// BenchRun()                                                                 //
+// search all keys of a list, returns the time per search in ns              //
+//----------------------------------------------------------------------------//
+static double BenchRun(uint32_t * pulKeyV, uint32_t ulCountV, uint32_t ulRoundsV)
+{
+   struct timespec   tsStartT;
+   struct timespec   tsStopT;
+   volatile uint8_t  ubSinkT = 0;
+   uint8_t           ubStatusT;
+   uint32_t          ulRoundT;
+   uint32_t          ulKeyT;
+   double            dNsT;
+
+   if(ulCountV == 0) return(0.0);
+
+   clock_gettime(CLOCK_MONOTONIC, &tsStartT);
+   for(ulRoundT = 0; ulRoundT < ulRoundsV; ulRoundT++)
+   {
+      for(ulKeyT = 0; ulKeyT < ulCountV; ulKeyT++)
+      {
+         CosDictFindEntry((uint16_t) (pulKeyV[ulKeyT] >> 8),
+                          (uint8_t) pulKeyV[ulKeyT], &ubStatusT);
+         ubSinkT += ubStatusT;
+      }
+   }
+   clock_gettime(CLOCK_MONOTONIC, &tsStopT);
+
+   dNsT = (double) (tsStopT.tv_sec - tsStartT.tv_sec) * 1e9 +
+          (double) (tsStopT.tv_nsec - tsStartT.tv_nsec);
+   return(dNsT / ((double) ulCountV * (double) ulRoundsV));
+}
+
+
+//----------------------------------------------------------------------------//
+// main()                                                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+int main(int argc, char * argv[])
+{
+   uint32_t ulRoundsT = 20;
+   uint32_t ulSumT    = 2166136261UL;
+   uint32_t ulKeyT;
+   uint32_t ulIdxT;
+   uint8_t  ubStatusT;
+   int      slArgT;
+   double   dHitNsT;
+   double   dMissNsT;
+
+   for(slArgT = 1; slArgT < argc; slArgT++)
+   {
+      if(strcmp(argv[slArgT], "-h") == 0)
+      {
+         printf("method,slots,hits,misses,hit_ns,miss_ns,checksum\n");
+      }
+      else if((strcmp(argv[slArgT], "-n") == 0) && (slArgT + 1 < argc))
+      {
+         sscanf(argv[++slArgT], "%u", &ulRoundsT);
+      }
+      else
+      {
+         fprintf(stderr, "usage: bench_dict [-h] [-n rounds]\n");
+         return(2);
+      }
+   }
+
+   //----------------------------------------------------------------
+   // the hash table is built as by CosMgrInit()
+   //
+   CosDictInit();
+
+   for(ulKeyT = 0; ulKeyT < BENCH_KEY_MAX; ulKeyT++)
+   {
+      ulSumT = BenchChecksum(ulSumT, ((ulKeyT / BENCH_SUBIDX_END) << 8) |
+                                     (ulKeyT % BENCH_SUBIDX_END));
+   }
+
+   for(ulKeyT = 0; ulKeyT < BENCH_KEY_MAX; ulKeyT++)
+   {
+      ulIdxT = ((ulKeyT / BENCH_SUBIDX_END) << 8) | (ulKeyT % BENCH_SUBIDX_END);
+      CosDictFindEntry((uint16_t) (ulIdxT >> 8), (uint8_t) ulIdxT, &ubStatusT);
+      if(ubStatusT == eCosDict_FOUND_OBJECT)
+      {
+         aulKeyHitS[ulHitCountS++] = ulIdxT;
+      }
+      else
+      {
+         aulKeyMissS[ulMissCountS++] = ulIdxT;
+      }
+   }
+
+   dHitNsT  = BenchRun(aulKeyHitS,  ulHitCountS,  ulRoundsT * 100);
+   dMissNsT = BenchRun(aulKeyMissS, ulMissCountS, ulRoundsT);
+
+   printf("%s,%u,%u,%u,%.1f,%.1f,%08X\n", BENCH_METHOD,
+          (unsigned) COS_DICT_SEARCH_HASH, ulHitCountS, ulMissCountS,
+          dHitNsT, dMissNsT, ulSumT);
+
+   return(0);
+}
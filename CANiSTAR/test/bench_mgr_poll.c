@@ -0,0 +1,413 @@
+//****************************************************************************//
+// File:          bench_mgr_poll.c                                            //
+// Description:   Benchmark of the message dispatch in polling mode           //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "SI_C8051F550_Register_Enums.h"
+#include "cos_mgr.h"
+#include "cos_emcy.h"
+#include "cos_led.h"
+#include "cos301.h"
+#include "cos_stub.h"
+#include "cp_msg.h"
+#include "mc_tmr.h"
+
+#if COS_MGR_INT != 0
+#error  The benchmark requires COS_MGR_INT = 0
+#endif
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \file    bench_mgr_poll.c
+** \brief   Benchmark of CosMgrProcessMsg()
+**
+** In polling mode (#COS_MGR_INT = 0) the main loop calls
+** CosMgrProcessMsg() to serve the buffers flagged by the CAN driver in
+** ulCpRcvBufferFlagG and ulCpTrmBufferFlagG. The benchmark compares the
+** bit position dispatch of cos_mgr.c with the former loop, which
+** tested all #CP_BUFFER_MAX buffers one by one. The former loop is kept
+** here as BenchProcessLoop(), both call the handlers of cos_mgr.c.
+**
+** For every pattern of pending buffers the flags are set, the dispatch
+** is called once and its duration is read from the time stamp counter
+** of the CPU (clock_gettime() in ns on other hosts). The report holds
+** the median of all runs, the overhead of reading the counter is
+** subtracted. The numbers are host cycles: they show the relation of
+** the two variants, not the cycles of the C8051F550.
+**
+** The handlers are traced with the state of the buffer flags at every
+** call: all messages carry the overrun flag, the receive handler sends
+** an EMCY message for each of them; CpCoreBufferSend() with buffer 0
+** follows every transmitted message, it is recorded through the link
+** option --wrap. Both variants must give the same trace and clear all
+** flags, the program returns 1 otherwise.
+**
+** bench_mgr_poll [-h] [-n runs]
+*/
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#define  BENCH_RUN_MAX        100000
+
+#define  BENCH_TRACE_MAX      (2 * CP_BUFFER_MAX)
+
+#define  BENCH_BIT(BUF)       (((uint32_t) 1) << ((BUF) - 1))
+
+#if defined(__x86_64__) || defined(__i386__)
+#define  BENCH_UNIT           "cycles"
+#else
+#define  BENCH_UNIT           "ns"
+#endif
+
+typedef struct BenchPattern_s {
+   const char *   pszName;
+   uint32_t       ulRcv;
+   uint32_t       ulTrm;
+} BenchPattern_ts;
+
+//-------------------------------------------------------------------
+// flags at the call of a handler, ubTrm is 1 for a transmitted
+// message
+//
+typedef struct BenchTrace_s {
+   uint32_t       ulRcv;
+   uint32_t       ulTrm;
+   uint8_t        ubTrm;
+} BenchTrace_ts;
+
+
+/*----------------------------------------------------------------------------*\
+** Variables of module                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+uint32_t             ulCpRcvBufferFlagG;
+uint32_t             ulCpTrmBufferFlagG;
+CpCanMsg_ts          atsCanMsgG[CP_BUFFER_MAX];
+
+static const BenchPattern_ts atsPatternS[] = {
+   { "idle",      0,                          0                          },
+   { "nmt",       BENCH_BIT(eCosBuf_NMT),     0                          },
+   { "sdo",       BENCH_BIT(eCosBuf_SDO_RCV), BENCH_BIT(eCosBuf_SDO_TRM) },
+   { "emcy",      0,                          BENCH_BIT(eCosBuf_EMCY)    },
+   { "last",      BENCH_BIT(CP_BUFFER_MAX),   0                          },
+   { "sparse",    0x00010001UL,               0x80000100UL               },
+   { "burst",     0x0000FFFFUL,               0xFFFF0000UL               },
+   { "all",       0xFFFFFFFFUL,               0xFFFFFFFFUL               }
+};
+
+#define  BENCH_PATTERN_MAX    (sizeof(atsPatternS) / sizeof(atsPatternS[0]))
+
+static BenchTrace_ts aatsTraceS[2][BENCH_TRACE_MAX];
+static BenchTrace_ts * ptsTraceS;       // trace buffer, 0 if off
+static uint8_t       ubTraceCountS;
+
+static uint32_t      aulTimeS[BENCH_RUN_MAX];
+
+
+/*----------------------------------------------------------------------------*\
+** Functions                                                                  **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//----------------------------------------------------------------------------//
+// functions of modules which are not linked to the benchmark                 //
+//----------------------------------------------------------------------------//
+uint8_t  ubIdx1001_ErrorRegisterG;
+
+uint32_t McTmrTick(void)                        { return(0);                }
+void     Cos301_ParmInit(void)                  { }
+void     CosMgrOnBusOff(void)                   { }
+void     CosEmcyInit(void)                      { }
+void     CosLedInit(void)                       { }
+void     CosLedNetworkError(uint8_t ubErrorV)   { }
+void     CosLedNetworkStatus(uint8_t ubStatusV) { }
+void     CosDictInit(void)                      { }
+void     CosSdoInit(uint8_t ubNodeIdV)          { }
+void     CosSdoMessageHandler(void)             { }
+
+
+//----------------------------------------------------------------------------//
+// BenchTraceAdd()                                                            //
+// record the buffer flags at the call of a handler                           //
+//----------------------------------------------------------------------------//
+static void BenchTraceAdd(uint8_t ubTrmV)
+{
+   if((ptsTraceS != 0L) && (ubTraceCountS < BENCH_TRACE_MAX))
+   {
+      ptsTraceS[ubTraceCountS].ulRcv = ulCpRcvBufferFlagG;
+      ptsTraceS[ubTraceCountS].ulTrm = ulCpTrmBufferFlagG;
+      ptsTraceS[ubTraceCountS].ubTrm = ubTrmV;
+      ubTraceCountS++;
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// CosEmcySend()                                                              //
+// a received message with overrun flag                                       //
+//----------------------------------------------------------------------------//
+void CosEmcySend(uint16_t uwCodeV, uint8_t * pubV)
+{
+   if(uwCodeV == EMCY_ERR_CAN_OVERRUN) BenchTraceAdd(0);
+}
+
+
+//----------------------------------------------------------------------------//
+// __wrap_CpCoreBufferSend()                                                  //
+// record a transmitted message                                               //
+//----------------------------------------------------------------------------//
+CpStatus_tv __real_CpCoreBufferSend(CpPort_ts * ptsPortV, uint8_t ubBufferIdxV);
+
+CpStatus_tv __wrap_CpCoreBufferSend(CpPort_ts * ptsPortV, uint8_t ubBufferIdxV)
+{
+   BenchTraceAdd(1);
+   return(__real_CpCoreBufferSend(ptsPortV, ubBufferIdxV));
+}
+
+
+//----------------------------------------------------------------------------//
+// BenchProcessLoop()                                                         //
+// dispatch of CosMgrProcessMsg() before the bit position look-up             //
+//----------------------------------------------------------------------------//
+static void BenchProcessLoop(void)
+{
+   register uint8_t     ubBufferNumT;
+   uint32_t             ulBufferMaskT;
+   static   CpState_ts  tsCanStateS;
+
+   ulBufferMaskT = 1;
+   for(ubBufferNumT = 1; ubBufferNumT <= CP_BUFFER_MAX; ubBufferNumT++)
+   {
+      if(ulCpRcvBufferFlagG & ulBufferMaskT)
+      {
+         CosMgrCanRcvHandler(&(atsCanMsgG[ubBufferNumT - 1]), ubBufferNumT);
+         ulCpRcvBufferFlagG &= ~ulBufferMaskT;
+      }
+
+      if(ulCpTrmBufferFlagG & ulBufferMaskT)
+      {
+         CosMgrCanTrmHandler(&atsCanMsgG[ubBufferNumT - 1], ubBufferNumT);
+         ulCpTrmBufferFlagG &= ~ulBufferMaskT;
+         CpCoreBufferSend(&tsCanPortG , 0);
+      }
+
+      ulBufferMaskT <<= 1;
+   }
+
+   CpCoreCanState(&tsCanPortG, &tsCanStateS);
+   CosMgrCanErrHandler(&tsCanStateS);
+}
+
+
+//----------------------------------------------------------------------------//
+// BenchCounter()                                                             //
+// read the time stamp counter                                                //
+//----------------------------------------------------------------------------//
+static inline uint64_t BenchCounter(void)
+{
+   #if defined(__x86_64__) || defined(__i386__)
+   return(__rdtsc());
+   #else
+   struct timespec   tsNowT;
+
+   clock_gettime(CLOCK_MONOTONIC, &tsNowT);
+   return((uint64_t) tsNowT.tv_sec * 1000000000ULL + tsNowT.tv_nsec);
+   #endif
+}
+
+
+//----------------------------------------------------------------------------//
+// BenchCompare()                                                             //
+// sort function for qsort()                                                  //
+//----------------------------------------------------------------------------//
+static int BenchCompare(const void * pvAV, const void * pvBV)
+{
+   uint32_t ulAT = *((const uint32_t *) pvAV);
+   uint32_t ulBT = *((const uint32_t *) pvBV);
+
+   return((ulAT > ulBT) - (ulAT < ulBT));
+}
+
+
+//----------------------------------------------------------------------------//
+// BenchMedian()                                                              //
+// median of the measured times                                               //
+//----------------------------------------------------------------------------//
+static uint32_t BenchMedian(uint32_t ulRunsV)
+{
+   qsort(aulTimeS, ulRunsV, sizeof(aulTimeS[0]), BenchCompare);
+   return(aulTimeS[ulRunsV / 2]);
+}
+
+
+//----------------------------------------------------------------------------//
+// BenchRun()                                                                 //
+// median time of one dispatch for a pattern of pending buffers               //
+//----------------------------------------------------------------------------//
+static uint32_t BenchRun(void (* pfnDispatchV)(void),
+                         const BenchPattern_ts * ptsPatternV,
+                         uint32_t ulRunsV, uint32_t ulOverheadV)
+{
+   uint64_t ulStartT;
+   uint32_t ulRunT;
+   uint32_t ulTimeT;
+
+   for(ulRunT = 0; ulRunT < ulRunsV; ulRunT++)
+   {
+      ulCpRcvBufferFlagG = ptsPatternV->ulRcv;
+      ulCpTrmBufferFlagG = ptsPatternV->ulTrm;
+
+      ulStartT = BenchCounter();
+      pfnDispatchV();
+      aulTimeS[ulRunT] = (uint32_t) (BenchCounter() - ulStartT);
+   }
+
+   ulTimeT = BenchMedian(ulRunsV);
+   if(ulTimeT < ulOverheadV) return(0);
+   return(ulTimeT - ulOverheadV);
+}
+
+
+//----------------------------------------------------------------------------//
+// BenchTrace()                                                               //
+// dispatch a pattern once and record the served buffers                      //
+//----------------------------------------------------------------------------//
+static uint8_t BenchTrace(void (* pfnDispatchV)(void),
+                          const BenchPattern_ts * ptsPatternV,
+                          BenchTrace_ts * ptsTraceV)
+{
+   ulCpRcvBufferFlagG = ptsPatternV->ulRcv;
+   ulCpTrmBufferFlagG = ptsPatternV->ulTrm;
+
+   memset(ptsTraceV, 0, BENCH_TRACE_MAX * sizeof(BenchTrace_ts));
+   ubTraceCountS = 0;
+   ptsTraceS     = ptsTraceV;
+   pfnDispatchV();
+   ptsTraceS     = 0L;
+
+   //----------------------------------------------------------------
+   // all flags must be cleared
+   //
+   if((ulCpRcvBufferFlagG != 0) || (ulCpTrmBufferFlagG != 0))
+   {
+      return(0xFF);
+   }
+   return(ubTraceCountS);
+}
+
+
+//----------------------------------------------------------------------------//
+// main()                                                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+int main(int argc, char * argv[])
+{
+   const BenchPattern_ts * ptsPatternT;
+   uint8_t  ubCountLoopT;
+   uint8_t  ubCountBitPosT;
+   uint32_t ulRunsT = 10000;
+   uint32_t ulOverheadT;
+   uint32_t ulRunT;
+   uint32_t ulPatternT;
+   uint32_t ulErrorT = 0;
+   uint64_t ulStartT;
+   int      slArgT;
+
+   for(slArgT = 1; slArgT < argc; slArgT++)
+   {
+      if(strcmp(argv[slArgT], "-h") == 0)
+      {
+         printf("pattern,rcv,trm,buffers,unit,loop,bitpos\n");
+      }
+      else if((strcmp(argv[slArgT], "-n") == 0) && (slArgT + 1 < argc))
+      {
+         sscanf(argv[++slArgT], "%u", &ulRunsT);
+         if(ulRunsT == 0)             ulRunsT = 1;
+         if(ulRunsT > BENCH_RUN_MAX)  ulRunsT = BENCH_RUN_MAX;
+      }
+      else
+      {
+         fprintf(stderr, "usage: bench_mgr_poll [-h] [-n runs]\n");
+         return(2);
+      }
+   }
+
+   //----------------------------------------------------------------
+   // every received message is traced by the EMCY message of the
+   // overrun
+   //
+   for(ulRunT = 0; ulRunT < CP_BUFFER_MAX; ulRunT++)
+   {
+      CpMsgClear(&atsCanMsgG[ulRunT]);
+      CpMsgSetOverrun(&atsCanMsgG[ulRunT]);
+   }
+
+   //----------------------------------------------------------------
+   // time of reading the counter twice
+   //
+   for(ulRunT = 0; ulRunT < ulRunsT; ulRunT++)
+   {
+      ulStartT = BenchCounter();
+      aulTimeS[ulRunT] = (uint32_t) (BenchCounter() - ulStartT);
+   }
+   ulOverheadT = BenchMedian(ulRunsT);
+
+   for(ulPatternT = 0; ulPatternT < BENCH_PATTERN_MAX; ulPatternT++)
+   {
+      ptsPatternT = &atsPatternS[ulPatternT];
+
+      //--------------------------------------------------------
+      // both variants must serve the same buffers in the same
+      // order
+      //
+      ubCountLoopT   = BenchTrace(BenchProcessLoop, ptsPatternT,
+                                  aatsTraceS[0]);
+      ubCountBitPosT = BenchTrace(CosMgrProcessMsg, ptsPatternT,
+                                  aatsTraceS[1]);
+      if((ubCountLoopT == 0xFF) || (ubCountLoopT != ubCountBitPosT) ||
+         (memcmp(aatsTraceS[0], aatsTraceS[1], sizeof(aatsTraceS[0])) != 0))
+      {
+         fprintf(stderr, "bench_mgr_poll: %s: dispatch differs\n",
+                 ptsPatternT->pszName);
+         ulErrorT++;
+      }
+
+      printf("%s,%08X,%08X,%u,%s,%u,%u\n", ptsPatternT->pszName,
+             ptsPatternT->ulRcv, ptsPatternT->ulTrm, ubCountLoopT,
+             BENCH_UNIT,
+             BenchRun(BenchProcessLoop, ptsPatternT, ulRunsT, ulOverheadT),
+             BenchRun(CosMgrProcessMsg, ptsPatternT, ulRunsT, ulOverheadT));
+   }
+
+   return(ulErrorT > 0);
+}
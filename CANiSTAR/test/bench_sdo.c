@@ -0,0 +1,1118 @@
+//****************************************************************************//
+// File:          bench_sdo.c                                                 //
+// Description:   SDO request benchmark against the object dictionary         //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "SI_C8051F550_Register_Enums.h"
+#include "can_model.h"
+#include "cos_mgr.h"
+#include "cos_dict.h"
+#include "cos_emcy.h"
+#include "cos_led.h"
+#include "cos_mobj.h"
+#include "cos301.h"
+#include "cos_stub.h"
+#include "mc_cpu.h"
+#include "mc_tmr.h"
+
+#if COS_SDO_STAT == 0
+#error  The benchmark requires COS_SDO_STAT = 1
+#endif
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \file    bench_sdo.c
+** \brief   SDO request benchmark
+**
+** The benchmark sends SDO requests through the request path of the
+** stack: the request is received by the C8051F550 driver (register
+** model), dispatched by CosMgrCanRcvHandler(), served from the object
+** dictionary of cos_dict.c, and the response is counted by
+** CosMgrCanTrmHandler(). The objects are the real ones: the data of
+** CiA 301 and of the user file, the callbacks of cos_mobj.c and the
+** hooks CosSdoSegFinal() and CosSdoBlkUpObjectSize() of
+** cos_user_SK60-1171.c.
+**
+** cos_sdo.c is not part of this source tree. The request handler of
+** the benchmark (CosSdoMessageHandler()) decodes the command specifier
+** and does the dictionary access as the SDO server does: expedited
+** and segmented transfers, the initiate of a block upload; other
+** requests are aborted.
+**
+** The time of every request is measured with clock_gettime() from the
+** receive interrupt until the transmit interrupt of the response has
+** been handled. McTmrHResTick() of the SDO statistic runs on the same
+** clock with a tick of 1 us. The report contains per transfer type the
+** percentiles of the measured times in ns and the percentiles from the
+** latency classes of CosMgrSdoStatistic() in us. The number of requests
+** of the statistic is checked against the requests of the benchmark
+** (the statistic counts the initiate of a segmented upload as an
+** expedited request, the abort of the client is not answered),
+** the program returns 1 on a mismatch or on a transfer error.
+**
+** bench_sdo [-f json|csv] [-n runs]
+*/
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#define  BENCH_NODE_ID        0x20
+
+#define  BENCH_SAMPLE_MAX     65536
+
+//-------------------------------------------------------------------
+// abort codes of the request handler
+//
+#define  SDO_ABORT_TOGGLE     0x05030000UL
+#define  SDO_ABORT_COMMAND    0x05040001UL
+#define  SDO_ABORT_ACCESS     0x06010000UL
+#define  SDO_ABORT_WO         0x06010001UL
+#define  SDO_ABORT_RO         0x06010002UL
+#define  SDO_ABORT_NO_OBJECT  0x06020000UL
+#define  SDO_ABORT_LENGTH     0x06070010UL
+#define  SDO_ABORT_NO_SUB     0x06090011UL
+#define  SDO_ABORT_RANGE      0x06090030UL
+#define  SDO_ABORT_GENERAL    0x08000000UL
+
+//-------------------------------------------------------------------
+// state of the request handler
+//
+enum BenchSdo_e {
+   eBENCH_SDO_IDLE = 0,
+   eBENCH_SDO_SEG_DOWN,
+   eBENCH_SDO_SEG_UP
+};
+
+typedef struct BenchType_s {
+   uint32_t    ulRequests;
+   uint32_t    ulSamples;
+   uint32_t    aulTimeNs[BENCH_SAMPLE_MAX];
+   uint32_t    ulStatReq;              // expected requests of the statistic
+} BenchType_ts;
+
+
+/*----------------------------------------------------------------------------*\
+** Variables of module                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+static uint32_t      ulRunsS    = 100;
+static uint8_t       ubCsvS;
+static uint32_t      ulErrorS;
+
+static BenchType_ts  atsTypeS[eCOS_SDO_TYPE_MAX];
+static const char *  apszTypeS[eCOS_SDO_TYPE_MAX] = {
+                        "expedited", "segmented", "block" };
+
+static struct timespec  tsHResStartS;
+
+//-------------------------------------------------------------------
+// transfer of the request handler
+//
+static uint8_t                      ubSdoStateS;
+static uint8_t                      ubSdoToggleS;
+static uint16_t                     uwSdoIndexS;
+static uint8_t                      ubSdoSubIndexS;
+static CPP_CONST CosDicEntry_ts *   ptsSdoEntryS;
+static uint8_t *                    pubSdoDataS;
+static uint32_t                     ulSdoSizeS;
+static uint32_t                     ulSdoPosS;
+
+void CAN0_IRQ(void);
+
+
+/*----------------------------------------------------------------------------*\
+** Functions                                                                  **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//----------------------------------------------------------------------------//
+// functions of modules which are not linked to the benchmark                 //
+//----------------------------------------------------------------------------//
+uint8_t  ubIdx1001_ErrorRegisterG;
+uint32_t ulIdx1002_StatusRegisterG;
+
+uint32_t McTmrTick(void)                        { return(0);                }
+void     Cos301_ParmInit(void)                  { }
+void     CosEmcyInit(void)                      { }
+void     CosEmcySend(uint16_t uwCodeV, uint8_t * pubV) { }
+void     CosLedInit(void)                       { }
+void     CosLedNetworkError(uint8_t ubErrorV)   { }
+void     CosLedNetworkStatus(uint8_t ubStatusV) { }
+void     CosPdoSend(uint8_t ubPdoNumberV)       { }
+int8_t   McGetChannelId(void)                   { return(0);                }
+uint32_t McGetSerialNumber(void)                { return(0);                }
+uint8_t  Cos401_DI_Read(uint8_t ubChannelV)     { return(0);                }
+uint16_t Cos401_AI_GetAdcValue(uint8_t ubChV)   { return(0);                }
+
+CosPdoCom_ts   atsTrmPdoComG[COS_PDO_TRM_NUMBER];
+
+uint8_t  Cos301_Idx1018(uint8_t ubSubIndexV, uint8_t ubReqCodeV)     { return(0); }
+uint8_t  CosEmcyErrorField(uint8_t ubSubIndexV, uint8_t ubReqCodeV)  { return(0); }
+uint8_t  CosEmcyIdentifier(uint8_t ubSubIndexV, uint8_t ubReqCodeV)  { return(0); }
+uint8_t  CosNmt_Idx100C(uint8_t ubSubIndexV, uint8_t ubReqCodeV)     { return(0); }
+uint8_t  CosNmt_Idx100D(uint8_t ubSubIndexV, uint8_t ubReqCodeV)     { return(0); }
+uint8_t  CosNmt_Idx1017(uint8_t ubSubIndexV, uint8_t ubReqCodeV)     { return(0); }
+uint8_t  CosNmt_Idx1029(uint8_t ubSubIndexV, uint8_t ubReqCodeV)     { return(0); }
+uint8_t  CosPdoMapParameter(uint8_t ubSubIndexV, uint8_t ubReqCodeV) { return(0); }
+uint8_t  CosPdoRcvComParam(uint8_t ubSubIndexV, uint8_t ubReqCodeV)  { return(0); }
+uint8_t  CosPdoTrmComParam(uint8_t ubSubIndexV, uint8_t ubReqCodeV)  { return(0); }
+uint8_t  CosSync_Idx1005(uint8_t ubSubIndexV, uint8_t ubReqCodeV)    { return(0); }
+uint8_t  CosSync_Idx1006(uint8_t ubSubIndexV, uint8_t ubReqCodeV)    { return(0); }
+
+
+//----------------------------------------------------------------------------//
+// high-resolution timer of the SDO statistic, 1 us of the monotonic clock    //
+//----------------------------------------------------------------------------//
+Status_tv McTmrHResInit(uint8_t ubTickPeriodV)
+{
+   if(ubTickPeriodV != eTMR_HRES_TICK_1us) return(-eTMR_ERR_RES_INVALID);
+   return(eTMR_ERR_OK);
+}
+
+void McTmrHResStart(void)
+{
+   clock_gettime(CLOCK_MONOTONIC, &tsHResStartS);
+}
+
+uint32_t McTmrHResTick(void)
+{
+   struct timespec   tsNowT;
+
+   clock_gettime(CLOCK_MONOTONIC, &tsNowT);
+   return((uint32_t) ((tsNowT.tv_sec - tsHResStartS.tv_sec) * 1000000L +
+                      (tsNowT.tv_nsec - tsHResStartS.tv_nsec) / 1000L));
+}
+
+
+//----------------------------------------------------------------------------//
+// BenchSdoSend()                                                             //
+// write the response to the transmit buffer                                  //
+//----------------------------------------------------------------------------//
+static void BenchSdoSend(uint8_t * pubDataV)
+{
+   CpCoreBufferSetData(&tsCanPortG, eCosBuf_SDO_TRM, pubDataV);
+   CpCoreBufferSend(&tsCanPortG, eCosBuf_SDO_TRM);
+}
+
+
+//----------------------------------------------------------------------------//
+// BenchSdoAbort()                                                            //
+//                                                                            //
+//----------------------------------------------------------------------------//
+static void BenchSdoAbort(uint32_t ulCodeV)
+{
+   uint8_t  aubRspT[8];
+
+   aubRspT[0] = eSDO_ABORT;
+   aubRspT[1] = (uint8_t) (uwSdoIndexS);
+   aubRspT[2] = (uint8_t) (uwSdoIndexS >> 8);
+   aubRspT[3] = ubSdoSubIndexS;
+   aubRspT[4] = (uint8_t) (ulCodeV);
+   aubRspT[5] = (uint8_t) (ulCodeV >> 8);
+   aubRspT[6] = (uint8_t) (ulCodeV >> 16);
+   aubRspT[7] = (uint8_t) (ulCodeV >> 24);
+   BenchSdoSend(&aubRspT[0]);
+
+   ubSdoStateS = eBENCH_SDO_IDLE;
+}
+
+
+//----------------------------------------------------------------------------//
+// BenchSdoAbortCode()                                                        //
+// abort code of a callback result                                            //
+//----------------------------------------------------------------------------//
+static uint32_t BenchSdoAbortCode(uint8_t ubResultV)
+{
+   switch(ubResultV)
+   {
+      case eCosSdo_ERR_ACCESS_WO:      return(SDO_ABORT_WO);
+      case eCosSdo_ERR_ACCESS_RO:      return(SDO_ABORT_RO);
+      case eCosSdo_ERR_NO_OBJECT:      return(SDO_ABORT_NO_OBJECT);
+      case eCosSdo_ERR_NO_SUB_INDEX:   return(SDO_ABORT_NO_SUB);
+      case eCosSdo_ERR_DATATYPE:       return(SDO_ABORT_LENGTH);
+      case eCosSdo_ERR_VALUE_RANGE:    return(SDO_ABORT_RANGE);
+      default:                         break;
+   }
+   return(SDO_ABORT_GENERAL);
+}
+
+
+//----------------------------------------------------------------------------//
+// BenchSdoSize()                                                             //
+// size of a data entry, a string ends at the terminating 0                   //
+//----------------------------------------------------------------------------//
+static uint32_t BenchSdoSize(CPP_CONST CosDicEntry_ts * ptsEntryV)
+{
+   switch(ptsEntryV->ubDataType)
+   {
+      case CoDT_BOOLEAN:
+      case CoDT_INTEGER8:
+      case CoDT_UNSIGNED8:
+         return(1);
+
+      case CoDT_INTEGER16:
+      case CoDT_UNSIGNED16:
+         return(2);
+
+      case CoDT_INTEGER32:
+      case CoDT_UNSIGNED32:
+      case CoDT_REAL32:
+         return(4);
+
+      case CoDT_VISIBLE_STRING:
+         return(strlen((char *) ptsEntryV->pvdValue));
+
+      default:
+         break;
+   }
+   return(0);
+}
+
+
+//----------------------------------------------------------------------------//
+// BenchSdoEntry()                                                            //
+// search the object of an initiate request                                   //
+//----------------------------------------------------------------------------//
+static uint8_t BenchSdoEntry(uint8_t * pubReqV)
+{
+   uint8_t  ubStatusT;
+
+   uwSdoIndexS    = ((uint16_t) pubReqV[2] << 8) | pubReqV[1];
+   ubSdoSubIndexS = pubReqV[3];
+   ptsSdoEntryS   = CosDictFindEntry(uwSdoIndexS, ubSdoSubIndexS, &ubStatusT);
+
+   if(ubStatusT == eCosDict_FAIL_INDEX)
+   {
+      BenchSdoAbort(SDO_ABORT_NO_OBJECT);
+      return(0);
+   }
+   if(ubStatusT == eCosDict_FAIL_SUBINDEX)
+   {
+      BenchSdoAbort(SDO_ABORT_NO_SUB);
+      return(0);
+   }
+   return(1);
+}
+
+
+//----------------------------------------------------------------------------//
+// BenchSdoUpload()                                                           //
+// initiate upload                                                            //
+//----------------------------------------------------------------------------//
+static void BenchSdoUpload(uint8_t * pubRspV)
+{
+   SdoHandler_fn  pfnHandlerT;
+   uint8_t        ubResultT;
+
+   if((ptsSdoEntryS->ubAttribute & 0x0F) == CoATTR_ACC_WO)
+   {
+      BenchSdoAbort(SDO_ABORT_WO);
+      return;
+   }
+
+   //----------------------------------------------------------------
+   // a callback returns the number of bytes or sets up a segmented
+   // transfer with CosSdoSegSetup(), the value is taken from the
+   // stand-in of CosSdoCopyValueToMessage()
+   //
+   if(ptsSdoEntryS->ubAttribute & CoATTR_FUNCTION)
+   {
+      pfnHandlerT = (SdoHandler_fn) ptsSdoEntryS->pvdValue;
+      ubResultT   = (*pfnHandlerT)(ubSdoSubIndexS, eSDO_READ_REQ);
+      if((ubResultT >= eCosSdo_READ1_OK) && (ubResultT <= eCosSdo_READ4_OK))
+      {
+         pubRspV[0] = 0x43 | ((eCosSdo_READ4_OK - ubResultT) << 2);
+         memcpy(&pubRspV[4], &ulStubSdoValueG, 4);
+      }
+      else if(ubResultT == eCosSdo_READ_SEG_OK)
+      {
+         pubRspV[0] = eSDO_READ_RESP_SEG;
+         memcpy(&pubRspV[4], &ulSdoSizeS, 4);
+         ubSdoStateS  = eBENCH_SDO_SEG_UP;
+         ubSdoToggleS = 0;
+      }
+      else
+      {
+         BenchSdoAbort(BenchSdoAbortCode(ubResultT));
+         return;
+      }
+   }
+   else
+   {
+      ulSdoSizeS  = BenchSdoSize(ptsSdoEntryS);
+      pubSdoDataS = (uint8_t *) ptsSdoEntryS->pvdValue;
+      if(ulSdoSizeS <= 4)
+      {
+         pubRspV[0] = 0x43 | ((4 - ulSdoSizeS) << 2);
+         memcpy(&pubRspV[4], pubSdoDataS, ulSdoSizeS);
+      }
+      else
+      {
+         pubRspV[0] = eSDO_READ_RESP_SEG;
+         memcpy(&pubRspV[4], &ulSdoSizeS, 4);
+         ulSdoPosS    = 0;
+         ubSdoStateS  = eBENCH_SDO_SEG_UP;
+         ubSdoToggleS = 0;
+      }
+   }
+
+   BenchSdoSend(pubRspV);
+}
+
+
+//----------------------------------------------------------------------------//
+// BenchSdoDownload()                                                         //
+// initiate download                                                          //
+//----------------------------------------------------------------------------//
+static void BenchSdoDownload(uint8_t * pubReqV, uint8_t * pubRspV)
+{
+   SdoHandler_fn  pfnHandlerT;
+   uint32_t       ulSizeT;
+   uint8_t        ubResultT;
+
+   if(((ptsSdoEntryS->ubAttribute & 0x0F) == CoATTR_ACC_RO) ||
+      ((ptsSdoEntryS->ubAttribute & 0x0F) == CoATTR_ACC_CONST))
+   {
+      BenchSdoAbort(SDO_ABORT_RO);
+      return;
+   }
+
+   //----------------------------------------------------------------
+   // expedited: the command is the request code of the callback
+   //
+   if(pubReqV[0] & 0x02)
+   {
+      ulSizeT = (pubReqV[0] & 0x01) ? 4 - ((pubReqV[0] >> 2) & 0x03) : 4;
+      if(ptsSdoEntryS->ubAttribute & CoATTR_FUNCTION)
+      {
+         pfnHandlerT     = (SdoHandler_fn) ptsSdoEntryS->pvdValue;
+         ulStubSdoValueG = 0;
+         memcpy(&ulStubSdoValueG, &pubReqV[4], ulSizeT);
+         ubResultT = (*pfnHandlerT)(ubSdoSubIndexS, pubReqV[0]);
+         if(ubResultT != eCosSdo_WRITE_OK)
+         {
+            BenchSdoAbort(BenchSdoAbortCode(ubResultT));
+            return;
+         }
+      }
+      else
+      {
+         if(ulSizeT != BenchSdoSize(ptsSdoEntryS))
+         {
+            BenchSdoAbort(SDO_ABORT_LENGTH);
+            return;
+         }
+         memcpy(ptsSdoEntryS->pvdValue, &pubReqV[4], ulSizeT);
+      }
+   }
+
+   //----------------------------------------------------------------
+   // segmented: the size of a data entry is not known from the
+   // dictionary, only callbacks provide the memory with
+   // CosSdoSegSetup()
+   //
+   else
+   {
+      if((ptsSdoEntryS->ubAttribute & CoATTR_FUNCTION) == 0)
+      {
+         BenchSdoAbort(SDO_ABORT_ACCESS);
+         return;
+      }
+
+      pfnHandlerT = (SdoHandler_fn) ptsSdoEntryS->pvdValue;
+      memcpy(&ulStubSdoValueG, &pubReqV[4], 4);
+      pubSdoDataS = 0L;
+      ubResultT   = (*pfnHandlerT)(ubSdoSubIndexS, eSDO_WRITE_REQ_SEG);
+      if((ubResultT != eCosSdo_WRITE_OK) || (pubSdoDataS == 0L))
+      {
+         BenchSdoAbort(BenchSdoAbortCode(ubResultT));
+         return;
+      }
+      ubSdoStateS  = eBENCH_SDO_SEG_DOWN;
+      ubSdoToggleS = 0;
+   }
+
+   pubRspV[0] = eSDO_WRITE_RESP;
+   BenchSdoSend(pubRspV);
+}
+
+
+//----------------------------------------------------------------------------//
+// BenchSdoSegment()                                                          //
+// download or upload segment                                                 //
+//----------------------------------------------------------------------------//
+static void BenchSdoSegment(uint8_t * pubReqV, uint8_t * pubRspV)
+{
+   SdoHandler_fn  pfnHandlerT;
+   uint32_t       ulSizeT;
+   uint8_t        ubResultT;
+
+   if((pubReqV[0] & 0x10) != ubSdoToggleS)
+   {
+      BenchSdoAbort(SDO_ABORT_TOGGLE);
+      return;
+   }
+
+   //----------------------------------------------------------------
+   // upload segment
+   //
+   if(ubSdoStateS == eBENCH_SDO_SEG_UP)
+   {
+      ulSizeT = ulSdoSizeS - ulSdoPosS;
+      if(ulSizeT > 7) ulSizeT = 7;
+
+      pubRspV[0] = 0x00 | ubSdoToggleS | ((7 - ulSizeT) << 1);
+      memcpy(&pubRspV[1], pubSdoDataS + ulSdoPosS, ulSizeT);
+      ulSdoPosS = ulSdoPosS + ulSizeT;
+      if(ulSdoPosS == ulSdoSizeS)
+      {
+         pubRspV[0] |= 0x01;
+         ubSdoStateS = eBENCH_SDO_IDLE;
+      }
+      ubSdoToggleS ^= 0x10;
+      BenchSdoSend(pubRspV);
+      return;
+   }
+
+   //----------------------------------------------------------------
+   // download segment, the last one runs the hook of the user file
+   // and the final check of the callback
+   //
+   ulSizeT = 7 - ((pubReqV[0] >> 1) & 0x07);
+   if((ulSdoPosS + ulSizeT) > ulSdoSizeS)
+   {
+      BenchSdoAbort(SDO_ABORT_LENGTH);
+      return;
+   }
+   memcpy(pubSdoDataS + ulSdoPosS, &pubReqV[1], ulSizeT);
+   ulSdoPosS = ulSdoPosS + ulSizeT;
+
+   if(pubReqV[0] & 0x01)
+   {
+      ubSdoStateS = eBENCH_SDO_IDLE;
+      ubResultT   = CosSdoSegFinal(eSDO_WRITE_REQ_SEG, uwSdoIndexS,
+                                   ubSdoSubIndexS);
+      if(ubResultT == eCosSdo_WRITE_OK)
+      {
+         pfnHandlerT = (SdoHandler_fn) ptsSdoEntryS->pvdValue;
+         ubResultT   = (*pfnHandlerT)(ubSdoSubIndexS, eSDO_WRITE_RESP_SEG);
+      }
+      if(ubResultT != eCosSdo_WRITE_OK)
+      {
+         BenchSdoAbort(BenchSdoAbortCode(ubResultT));
+         return;
+      }
+   }
+
+   pubRspV[0] = 0x20 | ubSdoToggleS;
+   ubSdoToggleS ^= 0x10;
+   BenchSdoSend(pubRspV);
+}
+
+
+//----------------------------------------------------------------------------//
+// CosSdoInit()                                                               //
+// setup the message buffers of the default SDO server                        //
+//----------------------------------------------------------------------------//
+void CosSdoInit(uint8_t ubNodeIdV)
+{
+   CpCanMsg_ts    tsCanMsgT;
+
+   CpMsgClear(&tsCanMsgT);
+   CpMsgSetStdId(&tsCanMsgT, ID_BASE_SDO_RX + ubNodeIdV);
+   CpMsgSetDlc(&tsCanMsgT, 8);
+   CpCoreBufferInit(&tsCanPortG, &tsCanMsgT, eCosBuf_SDO_RCV,
+                    CP_BUFFER_DIR_RX);
+
+   CpMsgClear(&tsCanMsgT);
+   CpMsgSetStdId(&tsCanMsgT, ID_BASE_SDO_TX + ubNodeIdV);
+   CpMsgSetDlc(&tsCanMsgT, 8);
+   CpCoreBufferInit(&tsCanPortG, &tsCanMsgT, eCosBuf_SDO_TRM,
+                    CP_BUFFER_DIR_TX);
+
+   ubSdoStateS = eBENCH_SDO_IDLE;
+}
+
+
+//----------------------------------------------------------------------------//
+// CosSdoSegSetup()                                                           //
+// memory of a segmented transfer, called by the object callbacks             //
+//----------------------------------------------------------------------------//
+void CosSdoSegSetup(void * pvDataV, uint32_t ulSizeV)
+{
+   pubSdoDataS = (uint8_t *) pvDataV;
+   ulSdoSizeS  = ulSizeV;
+   ulSdoPosS   = 0;
+}
+
+
+//----------------------------------------------------------------------------//
+// CosSdoMessageHandler()                                                     //
+// request handler of the benchmark                                           //
+//----------------------------------------------------------------------------//
+void CosSdoMessageHandler(void)
+{
+   uint8_t  aubReqT[8];
+   uint8_t  aubRspT[8];
+   uint32_t ulSizeT;
+
+   CpCoreBufferGetData(&tsCanPortG, eCosBuf_SDO_RCV, &aubReqT[0]);
+   memset(&aubRspT[0], 0, 8);
+   memcpy(&aubRspT[1], &aubReqT[1], 3);
+
+   //----------------------------------------------------------------
+   // abort from the client, no response
+   //
+   if(aubReqT[0] == eSDO_ABORT)
+   {
+      ubSdoStateS = eBENCH_SDO_IDLE;
+      return;
+   }
+
+   switch(aubReqT[0] >> 5)
+   {
+      case 0:                          // download segment
+         if(ubSdoStateS != eBENCH_SDO_SEG_DOWN) break;
+         BenchSdoSegment(&aubReqT[0], &aubRspT[0]);
+         return;
+
+      case 3:                          // upload segment
+         if(ubSdoStateS != eBENCH_SDO_SEG_UP) break;
+         memset(&aubRspT[0], 0, 8);
+         BenchSdoSegment(&aubReqT[0], &aubRspT[0]);
+         return;
+
+      case 1:                          // initiate download
+         if(BenchSdoEntry(&aubReqT[0]) == 0) return;
+         BenchSdoDownload(&aubReqT[0], &aubRspT[0]);
+         return;
+
+      case 2:                          // initiate upload
+         if(BenchSdoEntry(&aubReqT[0]) == 0) return;
+         BenchSdoUpload(&aubRspT[0]);
+         return;
+
+      case 5:                          // initiate block upload
+         if((aubReqT[0] & 0x03) != 0) break;
+         if(BenchSdoEntry(&aubReqT[0]) == 0) return;
+
+         //--------------------------------------------------------
+         // the size is taken from the hook of the user file, a
+         // size of 0 is not indicated
+         //
+         ulSizeT    = CosSdoBlkUpObjectSize(uwSdoIndexS, ubSdoSubIndexS);
+         aubRspT[0] = 0xC0 | ((ulSizeT > 0) ? 0x02 : 0x00);
+         memcpy(&aubRspT[4], &ulSizeT, 4);
+         BenchSdoSend(&aubRspT[0]);
+         return;
+
+      default:
+         break;
+   }
+
+   BenchSdoAbort(SDO_ABORT_COMMAND);
+}
+
+
+//----------------------------------------------------------------------------//
+// BenchRequest()                                                             //
+// send a request and measure the time until the response is transmitted,    //
+// returns 0 if the response is missing or an abort                           //
+//----------------------------------------------------------------------------//
+static uint8_t BenchRequest(uint8_t ubTypeV, uint8_t ubStatTypeV,
+                            uint8_t * pubReqV, uint8_t * pubRspV)
+{
+   struct timespec      tsStartT;
+   struct timespec      tsStopT;
+   CanModelFrame_ts *   ptsFrameT;
+   BenchType_ts *       ptsTypeT = &atsTypeS[ubTypeV];
+
+   CanModelTrmClear();
+   CanModelReceive(ID_BASE_SDO_RX + BENCH_NODE_ID, 0, 8, pubReqV);
+
+   clock_gettime(CLOCK_MONOTONIC, &tsStartT);
+   while(CanModelIrqPending())
+   {
+      CAN0_IRQ();
+   }
+   clock_gettime(CLOCK_MONOTONIC, &tsStopT);
+
+   ptsTypeT->ulRequests++;
+   if(pubRspV == 0L) return(1);
+
+   ptsFrameT = CanModelTrmFrame(0);
+   if(ptsFrameT == 0L) return(0);
+   memcpy(pubRspV, &ptsFrameT->aubData[0], 8);
+
+   if(ptsTypeT->ulSamples < BENCH_SAMPLE_MAX)
+   {
+      ptsTypeT->aulTimeNs[ptsTypeT->ulSamples++] =
+            (uint32_t) ((tsStopT.tv_sec - tsStartT.tv_sec) * 1000000000L +
+                        (tsStopT.tv_nsec - tsStartT.tv_nsec));
+   }
+   atsTypeS[ubStatTypeV].ulStatReq++;
+
+   if(pubRspV[0] == eSDO_ABORT) return(0);
+   return(1);
+}
+
+
+//----------------------------------------------------------------------------//
+// BenchTransfer()                                                            //
+// request which must be answered without abort                               //
+//----------------------------------------------------------------------------//
+static uint8_t BenchTransfer(uint8_t ubTypeV, uint8_t ubStatTypeV,
+                             uint8_t * pubReqV, uint8_t * pubRspV)
+{
+   if(BenchRequest(ubTypeV, ubStatTypeV, pubReqV, pubRspV)) return(1);
+
+   ulErrorS++;
+   return(0);
+}
+
+
+//----------------------------------------------------------------------------//
+// BenchInitiate()                                                            //
+//                                                                            //
+//----------------------------------------------------------------------------//
+static void BenchInitiate(uint8_t * pubReqV, uint8_t ubCommandV,
+                          uint16_t uwIndexV, uint8_t ubSubIndexV)
+{
+   memset(pubReqV, 0, 8);
+   pubReqV[0] = ubCommandV;
+   pubReqV[1] = (uint8_t) (uwIndexV);
+   pubReqV[2] = (uint8_t) (uwIndexV >> 8);
+   pubReqV[3] = ubSubIndexV;
+}
+
+
+//----------------------------------------------------------------------------//
+// BenchExpedited()                                                           //
+// data of 2003h, 2004h and 1000h                                             //
+//----------------------------------------------------------------------------//
+static void BenchExpedited(uint32_t ulRunV)
+{
+   uint8_t        aubReqT[8];
+   uint8_t        aubRspT[8];
+   uint32_t       ulValueT;
+
+   ulValueT = 0x5A000000UL | ulRunV;
+   BenchInitiate(aubReqT, eSDO_WRITE_REQ_4, 0x2004, 0);
+   memcpy(&aubReqT[4], &ulValueT, 4);
+   if(BenchTransfer(eCOS_SDO_TYPE_EXPEDITED, eCOS_SDO_TYPE_EXPEDITED,
+                    aubReqT, aubRspT) == 0) return;
+
+   BenchInitiate(aubReqT, eSDO_READ_REQ, 0x2004, 0);
+   if(BenchTransfer(eCOS_SDO_TYPE_EXPEDITED, eCOS_SDO_TYPE_EXPEDITED,
+                    aubReqT, aubRspT) == 0) return;
+   if((aubRspT[0] != eSDO_READ_RESP_4) || memcmp(&aubRspT[4], &ulValueT, 4) ||
+      (ulCosMob_Var2004G != ulValueT))
+   {
+      ulErrorS++;
+   }
+
+   BenchInitiate(aubReqT, eSDO_WRITE_REQ_2, 0x2003, 0);
+   memcpy(&aubReqT[4], &ulValueT, 2);
+   if(BenchTransfer(eCOS_SDO_TYPE_EXPEDITED, eCOS_SDO_TYPE_EXPEDITED,
+                    aubReqT, aubRspT) == 0) return;
+   if(uwCosMob_Var2003G != (uint16_t) ulValueT) ulErrorS++;
+
+   BenchInitiate(aubReqT, eSDO_READ_REQ, 0x1000, 0);
+   if(BenchTransfer(eCOS_SDO_TYPE_EXPEDITED, eCOS_SDO_TYPE_EXPEDITED,
+                    aubReqT, aubRspT) == 0) return;
+   if((aubRspT[0] != eSDO_READ_RESP_4) ||
+      memcmp(&aubRspT[4], &ulIdx1000_DeviceTypeC, 4))
+   {
+      ulErrorS++;
+   }
+
+   //----------------------------------------------------------------
+   // a write to a constant is aborted by the dictionary access
+   //
+   BenchInitiate(aubReqT, eSDO_WRITE_REQ_4, 0x1000, 0);
+   aubRspT[0] = 0;
+   BenchRequest(eCOS_SDO_TYPE_EXPEDITED, eCOS_SDO_TYPE_EXPEDITED,
+                aubReqT, aubRspT);
+   if(aubRspT[0] != eSDO_ABORT) ulErrorS++;
+}
+
+
+//----------------------------------------------------------------------------//
+// BenchUpload()                                                              //
+// segmented upload, the initiate request is counted as expedited            //
+//----------------------------------------------------------------------------//
+static uint32_t BenchUpload(uint16_t uwIndexV, uint8_t * pubDataV,
+                            uint32_t ulMaxV)
+{
+   uint8_t        aubReqT[8];
+   uint8_t        aubRspT[8];
+   uint32_t       ulPosT = 0;
+   uint8_t        ubSizeT;
+   uint8_t        ubToggleT = 0;
+
+   BenchInitiate(aubReqT, eSDO_READ_REQ, uwIndexV, 0);
+   if(BenchTransfer(eCOS_SDO_TYPE_SEGMENTED, eCOS_SDO_TYPE_EXPEDITED,
+                    aubReqT, aubRspT) == 0) return(0);
+   if(aubRspT[0] != eSDO_READ_RESP_SEG)
+   {
+      ulErrorS++;
+      return(0);
+   }
+
+   do
+   {
+      memset(aubReqT, 0, 8);
+      aubReqT[0] = eSDO_READ_REQ_SEG_0 | ubToggleT;
+      if(BenchTransfer(eCOS_SDO_TYPE_SEGMENTED, eCOS_SDO_TYPE_SEGMENTED,
+                       aubReqT, aubRspT) == 0) return(0);
+      ubSizeT = 7 - ((aubRspT[0] >> 1) & 0x07);
+      if((ulPosT + ubSizeT) > ulMaxV)
+      {
+         ulErrorS++;
+         return(0);
+      }
+      memcpy(&pubDataV[ulPosT], &aubRspT[1], ubSizeT);
+      ulPosT    = ulPosT + ubSizeT;
+      ubToggleT = ubToggleT ^ 0x10;
+   } while((aubRspT[0] & 0x01) == 0);
+
+   return(ulPosT);
+}
+
+
+//----------------------------------------------------------------------------//
+// BenchSegmented()                                                           //
+// domain of the callback 2007h, device name 1008h                            //
+//----------------------------------------------------------------------------//
+static void BenchSegmented(uint32_t ulRunV)
+{
+   uint8_t        aubReqT[8];
+   uint8_t        aubRspT[8];
+   uint8_t        aubDataT[24];
+   uint8_t        aubUpT[64];
+   uint32_t       ulSizeT;
+   uint32_t       ulPosT;
+   uint8_t        ubSizeT;
+   uint8_t        ubToggleT;
+
+   //----------------------------------------------------------------
+   // download into the domain of 2007h, at most 24 bytes; the
+   // callback rejects an 'A' at the start in the final check
+   //
+   ulSizeT = sizeof(aubDataT);
+   for(ulPosT = 0; ulPosT < ulSizeT; ulPosT++)
+   {
+      aubDataT[ulPosT] = (uint8_t) ('a' + ((ulRunV + ulPosT) % 26));
+   }
+
+   BenchInitiate(aubReqT, eSDO_WRITE_REQ_SEG, 0x2007, 0);
+   memcpy(&aubReqT[4], &ulSizeT, 4);
+   if(BenchTransfer(eCOS_SDO_TYPE_SEGMENTED, eCOS_SDO_TYPE_SEGMENTED,
+                    aubReqT, aubRspT) == 0) return;
+
+   ulPosT    = 0;
+   ubToggleT = 0;
+   while(ulPosT < ulSizeT)
+   {
+      ubSizeT = ((ulSizeT - ulPosT) > 7) ? 7 : (uint8_t) (ulSizeT - ulPosT);
+      memset(aubReqT, 0, 8);
+      aubReqT[0] = ubToggleT | ((7 - ubSizeT) << 1);
+      if((ulPosT + ubSizeT) == ulSizeT) aubReqT[0] |= 0x01;
+      memcpy(&aubReqT[1], &aubDataT[ulPosT], ubSizeT);
+      if(BenchTransfer(eCOS_SDO_TYPE_SEGMENTED, eCOS_SDO_TYPE_SEGMENTED,
+                       aubReqT, aubRspT) == 0) return;
+      ulPosT    = ulPosT + ubSizeT;
+      ubToggleT = ubToggleT ^ 0x10;
+   }
+
+   //----------------------------------------------------------------
+   // upload of the domain and of the device name of the user file
+   //
+   if((BenchUpload(0x2007, aubUpT, sizeof(aubUpT)) != ulSizeT) ||
+      memcmp(aubUpT, aubDataT, ulSizeT))
+   {
+      ulErrorS++;
+   }
+
+   ulSizeT = strlen((char *) ubIdx1008_DeviceNameC);
+   if((BenchUpload(0x1008, aubUpT, sizeof(aubUpT)) != ulSizeT) ||
+      memcmp(aubUpT, ubIdx1008_DeviceNameC, ulSizeT))
+   {
+      ulErrorS++;
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// BenchBlock()                                                               //
+// initiate of a block upload, the size comes from the user file              //
+//----------------------------------------------------------------------------//
+static void BenchBlock(void)
+{
+   uint8_t        aubReqT[8];
+   uint8_t        aubRspT[8];
+   uint32_t       ulSizeT;
+
+   BenchInitiate(aubReqT, eSDO_BLK_UP_REQ_0, 0x2007, 0);
+   aubReqT[4] = 127;
+   if(BenchTransfer(eCOS_SDO_TYPE_BLOCK, eCOS_SDO_TYPE_BLOCK,
+                    aubReqT, aubRspT) == 0) return;
+
+   ulSizeT = CosSdoBlkUpObjectSize(0x2007, 0);
+   if(((aubRspT[0] & 0xE0) != 0xC0) ||
+      (((aubRspT[0] & 0x02) != 0) != (ulSizeT > 0)) ||
+      memcmp(&aubRspT[4], &ulSizeT, 4))
+   {
+      ulErrorS++;
+   }
+
+   //----------------------------------------------------------------
+   // the client ends the transfer, the abort is not answered
+   //
+   BenchInitiate(aubReqT, eSDO_ABORT, 0x2007, 0);
+   BenchRequest(eCOS_SDO_TYPE_BLOCK, eCOS_SDO_TYPE_BLOCK, aubReqT, 0L);
+}
+
+
+//----------------------------------------------------------------------------//
+// BenchCompare()                                                             //
+//                                                                            //
+//----------------------------------------------------------------------------//
+static int BenchCompare(const void * pvAV, const void * pvBV)
+{
+   uint32_t ulAT = *((const uint32_t *) pvAV);
+   uint32_t ulBT = *((const uint32_t *) pvBV);
+
+   return((ulAT > ulBT) - (ulAT < ulBT));
+}
+
+
+//----------------------------------------------------------------------------//
+// BenchPercentile()                                                          //
+// nearest rank percentile of the sorted samples                              //
+//----------------------------------------------------------------------------//
+static uint32_t BenchPercentile(BenchType_ts * ptsTypeV, uint32_t ulPercentV)
+{
+   uint32_t ulRankT;
+
+   if(ptsTypeV->ulSamples == 0) return(0);
+
+   ulRankT = (ptsTypeV->ulSamples * ulPercentV + 99) / 100;
+   if(ulRankT == 0) ulRankT = 1;
+   return(ptsTypeV->aulTimeNs[ulRankT - 1]);
+}
+
+
+//----------------------------------------------------------------------------//
+// BenchClassPercentile()                                                     //
+// upper bound of the latency class which holds the percentile, in us         //
+//----------------------------------------------------------------------------//
+static uint32_t BenchClassPercentile(struct CosMgrSdoType_s * ptsStatV,
+                                     uint32_t ulPercentV)
+{
+   uint32_t ulRankT;
+   uint32_t ulSumT = 0;
+   uint8_t  ubClassT;
+
+   if(ptsStatV->ulReqCount == 0) return(0);
+
+   ulRankT = (ptsStatV->ulReqCount * ulPercentV + 99) / 100;
+   for(ubClassT = 0; ubClassT < COS_SDO_STAT_CLASS - 1; ubClassT++)
+   {
+      ulSumT += ptsStatV->aulTickClass[ubClassT];
+      if(ulSumT >= ulRankT) break;
+   }
+
+   //----------------------------------------------------------------
+   // the last class has no upper bound, the maximum is taken
+   //
+   if(ubClassT == COS_SDO_STAT_CLASS - 1)          return(ptsStatV->ulTickMax);
+   if(((1UL << ubClassT) - 1) > ptsStatV->ulTickMax) return(ptsStatV->ulTickMax);
+   return((1UL << ubClassT) - 1);
+}
+
+
+//----------------------------------------------------------------------------//
+// BenchReport()                                                              //
+//                                                                            //
+//----------------------------------------------------------------------------//
+static void BenchReport(CosMgrSdoStat_ts * ptsStatV)
+{
+   BenchType_ts *             ptsTypeT;
+   struct CosMgrSdoType_s *   ptsStatTypeT;
+   uint8_t                    ubTypeT;
+
+   if(ubCsvS)
+   {
+      printf("type,requests,answered,time_p50_ns,time_p90_ns,time_p99_ns,"
+             "time_max_ns,stat_requests,stat_p50_us,stat_p90_us,"
+             "stat_p99_us,stat_max_us\n");
+   }
+   else
+   {
+      printf("{\n  \"config\": {\"runs\": %u},\n"
+             "  \"frames_rcv\": %u, \"frames_trm\": %u,\n  \"types\": [\n",
+             ulRunsS, ptsStatV->ulRcvCount, ptsStatV->ulTrmCount);
+   }
+
+   for(ubTypeT = 0; ubTypeT < eCOS_SDO_TYPE_MAX; ubTypeT++)
+   {
+      ptsTypeT     = &atsTypeS[ubTypeT];
+      ptsStatTypeT = &(ptsStatV->atsType[ubTypeT]);
+      qsort(ptsTypeT->aulTimeNs, ptsTypeT->ulSamples, sizeof(uint32_t),
+            BenchCompare);
+
+      if(ubCsvS)
+      {
+         printf("%s,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u\n",
+                apszTypeS[ubTypeT], ptsTypeT->ulRequests, ptsTypeT->ulSamples,
+                BenchPercentile(ptsTypeT, 50), BenchPercentile(ptsTypeT, 90),
+                BenchPercentile(ptsTypeT, 99), BenchPercentile(ptsTypeT, 100),
+                ptsStatTypeT->ulReqCount,
+                BenchClassPercentile(ptsStatTypeT, 50),
+                BenchClassPercentile(ptsStatTypeT, 90),
+                BenchClassPercentile(ptsStatTypeT, 99),
+                ptsStatTypeT->ulTickMax);
+      }
+      else
+      {
+         printf("    {\"type\": \"%s\", \"requests\": %u, \"answered\": %u,\n"
+                "     \"time_ns\": {\"p50\": %u, \"p90\": %u, \"p99\": %u, "
+                "\"max\": %u},\n"
+                "     \"stat\": {\"requests\": %u, \"p50_us\": %u, "
+                "\"p90_us\": %u, \"p99_us\": %u, \"max_us\": %u}}%s\n",
+                apszTypeS[ubTypeT], ptsTypeT->ulRequests, ptsTypeT->ulSamples,
+                BenchPercentile(ptsTypeT, 50), BenchPercentile(ptsTypeT, 90),
+                BenchPercentile(ptsTypeT, 99), BenchPercentile(ptsTypeT, 100),
+                ptsStatTypeT->ulReqCount,
+                BenchClassPercentile(ptsStatTypeT, 50),
+                BenchClassPercentile(ptsStatTypeT, 90),
+                BenchClassPercentile(ptsStatTypeT, 99),
+                ptsStatTypeT->ulTickMax,
+                (ubTypeT < eCOS_SDO_TYPE_MAX - 1) ? "," : "");
+      }
+   }
+
+   if(ubCsvS == 0)
+   {
+      printf("  ],\n  \"errors\": %u\n}\n", ulErrorS);
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// BenchUsage()                                                               //
+//                                                                            //
+//----------------------------------------------------------------------------//
+static int BenchUsage(void)
+{
+   fprintf(stderr, "usage: bench_sdo [-f json|csv] [-n runs]\n");
+   return(2);
+}
+
+
+//----------------------------------------------------------------------------//
+// main()                                                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+int main(int argc, char * argv[])
+{
+   CosMgrSdoStat_ts  tsStatT;
+   CpCanMsg_ts       tsMsgT;
+   uint32_t          ulRunT;
+   uint8_t           ubTypeT;
+   int               slArgT;
+
+   for(slArgT = 1; slArgT < argc; slArgT++)
+   {
+      if(slArgT + 1 >= argc) return(BenchUsage());
+
+      if(strcmp(argv[slArgT], "-f") == 0)
+      {
+         ubCsvS = (strcmp(argv[++slArgT], "csv") == 0);
+      }
+      else if(strcmp(argv[slArgT], "-n") == 0)
+      {
+         ulRunsS = strtoul(argv[++slArgT], 0L, 0);
+      }
+      else
+      {
+         return(BenchUsage());
+      }
+   }
+
+   //----------------------------------------------------------------
+   // the driver, the dictionary and the SDO server are set up as
+   // by CosMgrInit() and CosMgrStart()
+   //
+   CanModelReset();
+   CpCoreDriverInit(CP_CHANNEL_1, &tsCanPortG);
+   CpCoreIntFunctions(CP_CHANNEL_1, CosMgrCanRcvHandler,
+                      CosMgrCanTrmHandler, CosMgrCanErrHandler);
+   CpCoreBaudrate(&tsCanPortG, CP_BAUD_125K);
+   CpCoreCanMode(&tsCanPortG, CP_MODE_START);
+   McTmrHResInit(eTMR_HRES_TICK_1us);
+   McTmrHResStart();
+   CosDictInit();
+   CosMob_ParmInit();
+   CosSdoInit(BENCH_NODE_ID);
+
+   //----------------------------------------------------------------
+   // the boot-up message has been sent, the manager is running
+   //
+   CpMsgClear(&tsMsgT);
+   CosMgrCanTrmHandler(&tsMsgT, eCosBuf_NMT_ERR);
+   CosMgrSdoStatistic(&tsStatT, 1);
+
+   for(ulRunT = 0; ulRunT < ulRunsS; ulRunT++)
+   {
+      BenchExpedited(ulRunT);
+      BenchSegmented(ulRunT);
+      BenchBlock();
+   }
+
+   CosMgrSdoStatistic(&tsStatT, 0);
+   BenchReport(&tsStatT);
+
+   //----------------------------------------------------------------
+   // the statistic of the stack must count the same requests
+   //
+   for(ubTypeT = 0; ubTypeT < eCOS_SDO_TYPE_MAX; ubTypeT++)
+   {
+      if(tsStatT.atsType[ubTypeT].ulReqCount != atsTypeS[ubTypeT].ulStatReq)
+      {
+         fprintf(stderr, "bench_sdo: %s: statistic %u requests, "
+                 "expected %u\n", apszTypeS[ubTypeT],
+                 tsStatT.atsType[ubTypeT].ulReqCount,
+                 atsTypeS[ubTypeT].ulStatReq);
+         ulErrorS++;
+      }
+   }
+
+   return(ulErrorS ? 1 : 0);
+}
@@ -0,0 +1,471 @@
+//****************************************************************************//
+// File:          can_model.c                                                 //
+// Description:   Host model of the C8051F550 CAN0 register block (C_CAN)     //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <string.h>
+#include "can_model.h"
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------
+// bits of the registers, taken from the C_CAN user's manual and not
+// from c51f550_can.h: a wrong value in the driver header shall fail
+// the test
+//
+#define  MDL_CN_INIT          0x0001
+#define  MDL_CN_IE            0x0002
+
+#define  MDL_STAT_TXOK        0x0008
+#define  MDL_STAT_RXOK        0x0010
+
+#define  MDL_CM_WRRD          0x0080
+#define  MDL_CM_MASK          0x0040
+#define  MDL_CM_ARB           0x0020
+#define  MDL_CM_CONTROL       0x0010
+#define  MDL_CM_CLRINTPND     0x0008
+#define  MDL_CM_TXRQST        0x0004
+#define  MDL_CM_DATAA         0x0002
+#define  MDL_CM_DATAB         0x0001
+
+#define  MDL_MSK2_MXTD        0x8000
+
+#define  MDL_ARB2_MSGVAL      0x8000
+#define  MDL_ARB2_XTD         0x4000
+#define  MDL_ARB2_DIR         0x2000
+
+#define  MDL_MC_NEWDAT        0x8000
+#define  MDL_MC_MSGLST        0x4000
+#define  MDL_MC_INTPND        0x2000
+#define  MDL_MC_UMASK         0x1000
+#define  MDL_MC_TXIE          0x0800
+#define  MDL_MC_RXIE          0x0400
+#define  MDL_MC_TXRQST        0x0100
+#define  MDL_MC_DLC           0x000F
+
+//-------------------------------------------------------------------
+// offset of the IF registers inside the register file
+//
+#define  MDL_IF_CR            0
+#define  MDL_IF_CM            1
+#define  MDL_IF_M1            2
+#define  MDL_IF_M2            3
+#define  MDL_IF_A1            4
+#define  MDL_IF_A2            5
+#define  MDL_IF_MC            6
+#define  MDL_IF_DA1           7
+
+
+/*----------------------------------------------------------------------------*\
+** Variables of module                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------
+// SFRs outside of the CAN0 block which are used by the driver
+//
+volatile uint8_t  EIE2;
+volatile uint8_t  SFRPAGE;
+
+static uint16_t            auwRegS[eCAN_REG_MAX];
+static CanModelObj_ts      atsObjS[CAN_MODEL_OBJ_MAX];
+static CanModelFrame_ts    atsLogS[CAN_MODEL_LOG_MAX];
+static uint8_t             ubLogCountS;
+static uint8_t             ubTrmHoldS;        // bus is busy
+
+
+/*----------------------------------------------------------------------------*\
+** Functions                                                                  **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//----------------------------------------------------------------------------//
+// CanModelIfTransfer()                                                       //
+// transfer between one IF register set and a message object                  //
+//----------------------------------------------------------------------------//
+static void CanModelIfTransfer(uint16_t * puwIfV)
+{
+   CanModelObj_ts *  ptsObjT;
+   uint16_t          uwCmdT;
+   uint8_t           ubCntT;
+
+   if((puwIfV[MDL_IF_CR] & 0x003F) == 0) return;
+   if((puwIfV[MDL_IF_CR] & 0x003F) > CAN_MODEL_OBJ_MAX)
+   {
+      puwIfV[MDL_IF_CR] = 0;
+      return;
+   }
+
+   ptsObjT = &atsObjS[(puwIfV[MDL_IF_CR] & 0x003F) - 1];
+   uwCmdT  = puwIfV[MDL_IF_CM];
+
+   if(uwCmdT & MDL_CM_WRRD)
+   {
+      //--------------------------------------------------------
+      // IF registers -> message object
+      //
+      if(uwCmdT & MDL_CM_MASK)
+      {
+         ptsObjT->uwMsk1 = puwIfV[MDL_IF_M1];
+         ptsObjT->uwMsk2 = puwIfV[MDL_IF_M2];
+      }
+      if(uwCmdT & MDL_CM_ARB)
+      {
+         ptsObjT->uwArb1 = puwIfV[MDL_IF_A1];
+         ptsObjT->uwArb2 = puwIfV[MDL_IF_A2];
+      }
+      if(uwCmdT & MDL_CM_CONTROL)
+      {
+         ptsObjT->uwMsgCtrl = puwIfV[MDL_IF_MC];
+      }
+      if(uwCmdT & MDL_CM_TXRQST)
+      {
+         ptsObjT->uwMsgCtrl |= MDL_MC_TXRQST;
+      }
+      if(uwCmdT & MDL_CM_DATAA)
+      {
+         ptsObjT->auwData[0] = puwIfV[MDL_IF_DA1 + 0];
+         ptsObjT->auwData[1] = puwIfV[MDL_IF_DA1 + 1];
+      }
+      if(uwCmdT & MDL_CM_DATAB)
+      {
+         ptsObjT->auwData[2] = puwIfV[MDL_IF_DA1 + 2];
+         ptsObjT->auwData[3] = puwIfV[MDL_IF_DA1 + 3];
+      }
+   }
+   else
+   {
+      //--------------------------------------------------------
+      // message object -> IF registers, NewDat and IntPnd in
+      // the IF show the value before they are cleared
+      //
+      if(uwCmdT & MDL_CM_MASK)
+      {
+         puwIfV[MDL_IF_M1] = ptsObjT->uwMsk1;
+         puwIfV[MDL_IF_M2] = ptsObjT->uwMsk2;
+      }
+      if(uwCmdT & MDL_CM_ARB)
+      {
+         puwIfV[MDL_IF_A1] = ptsObjT->uwArb1;
+         puwIfV[MDL_IF_A2] = ptsObjT->uwArb2;
+      }
+      if(uwCmdT & MDL_CM_CONTROL)
+      {
+         puwIfV[MDL_IF_MC] = ptsObjT->uwMsgCtrl;
+      }
+      for(ubCntT = 0; ubCntT < 4; ubCntT++)
+      {
+         if(uwCmdT & ((ubCntT < 2) ? MDL_CM_DATAA : MDL_CM_DATAB))
+         {
+            puwIfV[MDL_IF_DA1 + ubCntT] = ptsObjT->auwData[ubCntT];
+         }
+      }
+      if(uwCmdT & MDL_CM_CLRINTPND)
+      {
+         ptsObjT->uwMsgCtrl &= ~MDL_MC_INTPND;
+      }
+      if(uwCmdT & MDL_CM_TXRQST)
+      {
+         ptsObjT->uwMsgCtrl &= ~MDL_MC_NEWDAT;
+      }
+   }
+
+   puwIfV[MDL_IF_CR] = 0;
+}
+
+
+//----------------------------------------------------------------------------//
+// CanModelTransmit()                                                         //
+// send all message objects with a transmit request                           //
+//----------------------------------------------------------------------------//
+static void CanModelTransmit(void)
+{
+   CanModelObj_ts *     ptsObjT;
+   CanModelFrame_ts *   ptsFrameT;
+   uint8_t              ubObjT;
+   uint8_t              ubCntT;
+
+   if(auwRegS[eCAN_REG_CN] & MDL_CN_INIT) return;
+   if(ubTrmHoldS)                         return;
+
+   for(ubObjT = 0; ubObjT < CAN_MODEL_OBJ_MAX; ubObjT++)
+   {
+      ptsObjT = &atsObjS[ubObjT];
+      if((ptsObjT->uwMsgCtrl & MDL_MC_TXRQST) == 0)    continue;
+      if((ptsObjT->uwArb2 & MDL_ARB2_MSGVAL) == 0)     continue;
+
+      if(ubLogCountS < CAN_MODEL_LOG_MAX)
+      {
+         ptsFrameT = &atsLogS[ubLogCountS++];
+         if(ptsObjT->uwArb2 & MDL_ARB2_XTD)
+         {
+            ptsFrameT->ulIdentifier = ((uint32_t) (ptsObjT->uwArb2 & 0x1FFF)
+                                       << 16) | ptsObjT->uwArb1;
+            ptsFrameT->ubExtended   = 1;
+         }
+         else
+         {
+            ptsFrameT->ulIdentifier = (ptsObjT->uwArb2 >> 2) & 0x07FF;
+            ptsFrameT->ubExtended   = 0;
+         }
+         ptsFrameT->ubDlc = ptsObjT->uwMsgCtrl & MDL_MC_DLC;
+         for(ubCntT = 0; ubCntT < 8; ubCntT++)
+         {
+            ptsFrameT->aubData[ubCntT] = (uint8_t) (ptsObjT->auwData[ubCntT / 2]
+                                                    >> ((ubCntT & 1) * 8));
+         }
+         ptsFrameT->ubBufferIdx = ubObjT + 1;
+      }
+
+      ptsObjT->uwMsgCtrl &= ~MDL_MC_TXRQST;
+      if(ptsObjT->uwMsgCtrl & MDL_MC_TXIE)
+      {
+         ptsObjT->uwMsgCtrl |= MDL_MC_INTPND;
+      }
+      auwRegS[eCAN_REG_STAT] |= MDL_STAT_TXOK;
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// CanModelUpdate()                                                           //
+// execute pending IF transfers and transmit requests                         //
+//----------------------------------------------------------------------------//
+static void CanModelUpdate(void)
+{
+   uint8_t  ubObjT;
+
+   CanModelIfTransfer(&auwRegS[eCAN_REG_IF1CR]);
+   CanModelIfTransfer(&auwRegS[eCAN_REG_IF2CR]);
+   CanModelTransmit();
+
+   //----------------------------------------------------------------
+   // the interrupt register shows the lowest message object with
+   // a pending interrupt
+   //
+   auwRegS[eCAN_REG_IID] = 0;
+   for(ubObjT = 0; ubObjT < CAN_MODEL_OBJ_MAX; ubObjT++)
+   {
+      if(atsObjS[ubObjT].uwMsgCtrl & MDL_MC_INTPND)
+      {
+         auwRegS[eCAN_REG_IID] = ubObjT + 1;
+         break;
+      }
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// CanModelReg16()                                                            //
+// access to a 16 bit register                                                //
+//----------------------------------------------------------------------------//
+volatile uint16_t * CanModelReg16(uint8_t ubRegV)
+{
+   CanModelUpdate();
+   return(&auwRegS[ubRegV]);
+}
+
+
+//----------------------------------------------------------------------------//
+// CanModelReg8()                                                             //
+// access to the low / high byte of a 16 bit register                         //
+//----------------------------------------------------------------------------//
+volatile uint8_t * CanModelReg8(uint8_t ubRegV, uint8_t ubHighV)
+{
+   static const uint16_t uwOrderT = 0x0100;   // byte 0 is 0 on little endian
+
+   CanModelUpdate();
+   if(*((const uint8_t *) &uwOrderT) != 0) ubHighV = !ubHighV;
+   return(((uint8_t *) &auwRegS[ubRegV]) + (ubHighV ? 1 : 0));
+}
+
+
+//----------------------------------------------------------------------------//
+// CanModelReset()                                                            //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void CanModelReset(void)
+{
+   memset(auwRegS, 0, sizeof(auwRegS));
+   memset(atsObjS, 0, sizeof(atsObjS));
+   memset(atsLogS, 0, sizeof(atsLogS));
+   ubLogCountS = 0;
+   ubTrmHoldS  = 0;
+   auwRegS[eCAN_REG_CN] = MDL_CN_INIT;
+   EIE2    = 0;
+   SFRPAGE = 0;
+}
+
+
+//----------------------------------------------------------------------------//
+// CanModelObject()                                                           //
+//                                                                            //
+//----------------------------------------------------------------------------//
+CanModelObj_ts * CanModelObject(uint8_t ubBufferIdxV)
+{
+   CanModelUpdate();
+   return(&atsObjS[ubBufferIdxV - 1]);
+}
+
+
+//----------------------------------------------------------------------------//
+// CanModelReceive()                                                          //
+// acceptance filtering of a data frame                                       //
+//----------------------------------------------------------------------------//
+uint8_t CanModelReceive(uint32_t ulIdV, uint8_t ubExtV, uint8_t ubDlcV,
+                        const uint8_t * pubDataV)
+{
+   CanModelObj_ts *  ptsObjT;
+   uint32_t          ulFrameT;      // identifier in arbitration format
+   uint32_t          ulObjIdT;
+   uint32_t          ulMaskT;
+   uint8_t           ubObjT;
+   uint8_t           ubCntT;
+
+   CanModelUpdate();
+   if(auwRegS[eCAN_REG_CN] & MDL_CN_INIT) return(0);
+
+   //----------------------------------------------------------------
+   // a standard identifier is stored in bits 28..18
+   //
+   ulFrameT = ubExtV ? (ulIdV & 0x1FFFFFFF) : ((ulIdV & 0x07FF) << 18);
+
+   for(ubObjT = 0; ubObjT < CAN_MODEL_OBJ_MAX; ubObjT++)
+   {
+      ptsObjT = &atsObjS[ubObjT];
+      if((ptsObjT->uwArb2 & MDL_ARB2_MSGVAL) == 0)  continue;
+      if(ptsObjT->uwArb2 & MDL_ARB2_DIR)            continue;
+
+      ulObjIdT = ((uint32_t) (ptsObjT->uwArb2 & 0x1FFF) << 16) |
+                 ptsObjT->uwArb1;
+      if(ptsObjT->uwMsgCtrl & MDL_MC_UMASK)
+      {
+         ulMaskT = ((uint32_t) (ptsObjT->uwMsk2 & 0x1FFF) << 16) |
+                   ptsObjT->uwMsk1;
+         if( (ptsObjT->uwMsk2 & MDL_MSK2_MXTD) &&
+             ((ptsObjT->uwArb2 & MDL_ARB2_XTD) ? 1 : 0) != (ubExtV ? 1 : 0))
+         {
+            continue;
+         }
+      }
+      else
+      {
+         ulMaskT = 0x1FFFFFFF;
+         if(((ptsObjT->uwArb2 & MDL_ARB2_XTD) ? 1 : 0) != (ubExtV ? 1 : 0))
+         {
+            continue;
+         }
+      }
+      if(((ulObjIdT ^ ulFrameT) & ulMaskT) != 0) continue;
+
+      //--------------------------------------------------------
+      // store the frame, the identifier of the frame replaces
+      // the identifier of the message object
+      //
+      ptsObjT->uwArb1 = (uint16_t) ulFrameT;
+      ptsObjT->uwArb2 = (ptsObjT->uwArb2 & (MDL_ARB2_MSGVAL | MDL_ARB2_DIR)) |
+                        (ubExtV ? MDL_ARB2_XTD : 0) |
+                        ((uint16_t) (ulFrameT >> 16) & 0x1FFF);
+      for(ubCntT = 0; ubCntT < 4; ubCntT++)
+      {
+         ptsObjT->auwData[ubCntT] = 0;
+      }
+      for(ubCntT = 0; (ubCntT < ubDlcV) && (ubCntT < 8); ubCntT++)
+      {
+         ptsObjT->auwData[ubCntT / 2] |= (uint16_t) pubDataV[ubCntT]
+                                         << ((ubCntT & 1) * 8);
+      }
+      if(ptsObjT->uwMsgCtrl & MDL_MC_NEWDAT)
+      {
+         ptsObjT->uwMsgCtrl |= MDL_MC_MSGLST;
+      }
+      ptsObjT->uwMsgCtrl = (ptsObjT->uwMsgCtrl & ~MDL_MC_DLC) |
+                           MDL_MC_NEWDAT | (ubDlcV & MDL_MC_DLC);
+      if(ptsObjT->uwMsgCtrl & MDL_MC_RXIE)
+      {
+         ptsObjT->uwMsgCtrl |= MDL_MC_INTPND;
+      }
+      auwRegS[eCAN_REG_STAT] |= MDL_STAT_RXOK;
+
+      CanModelUpdate();
+      return(ubObjT + 1);
+   }
+
+   return(0);
+}
+
+
+//----------------------------------------------------------------------------//
+// CanModelIrqPending()                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+uint8_t CanModelIrqPending(void)
+{
+   CanModelUpdate();
+   if((EIE2 & 0x02) == 0)                          return(0);
+   if((auwRegS[eCAN_REG_CN] & MDL_CN_IE) == 0)     return(0);
+   return(auwRegS[eCAN_REG_IID] != 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// CanModelTrmClear()                                                         //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void CanModelTrmClear(void)
+{
+   CanModelUpdate();
+   ubLogCountS = 0;
+}
+
+
+//----------------------------------------------------------------------------//
+// CanModelTrmCount()                                                         //
+//                                                                            //
+//----------------------------------------------------------------------------//
+uint8_t CanModelTrmCount(void)
+{
+   CanModelUpdate();
+   return(ubLogCountS);
+}
+
+
+//----------------------------------------------------------------------------//
+// CanModelTrmFrame()                                                         //
+//                                                                            //
+//----------------------------------------------------------------------------//
+CanModelFrame_ts * CanModelTrmFrame(uint8_t ubFrameV)
+{
+   CanModelUpdate();
+   if(ubFrameV >= ubLogCountS) return(0L);
+   return(&atsLogS[ubFrameV]);
+}
+
+
+//----------------------------------------------------------------------------//
+// CanModelTrmHold()                                                          //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void CanModelTrmHold(uint8_t ubHoldV)
+{
+   ubTrmHoldS = ubHoldV;
+}
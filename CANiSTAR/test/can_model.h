@@ -0,0 +1,214 @@
+//****************************************************************************//
+// File:          can_model.h                                                 //
+// Description:   Host model of the C8051F550 CAN0 register block (C_CAN)     //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+#ifndef _CAN_MODEL_H_
+#define _CAN_MODEL_H_
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \file    can_model.h
+** \brief   Register level model of the Bosch C_CAN block of the C8051F550
+**
+** The test build of c51f550_can.c includes the register header of
+** test/stub, which maps every CAN0 SFR onto this model. The model keeps
+** the 32 message objects of the message RAM and the two message interface
+** register sets IF1 / IF2.
+**
+** A write of a message number to IFx Command Request starts a transfer
+** between the IF registers and the message object. The transfer is
+** executed before the next register access, so the Busy bit is set for
+** exactly one access and CAN_WaitIF() sees the end of the transfer. The
+** transfer follows the C_CAN rules for the command mask bits WR/RD, Mask,
+** Arb, Control, ClrIntPnd, TxRqst/NewDat, Data A and Data B.
+**
+** A message object with TxRqst set is sent when the controller is not
+** in initialisation mode, it is appended to the transmit log.
+** CanModelReceive() puts a frame from the bus through the acceptance
+** filter, the lowest matching receive object wins (the same rules as
+** device/linux_can.c). There is no interrupt on the host, the test calls
+** the CAN interrupt handler when CanModelIrqPending() returns 1.
+*/
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------
+// number of message objects in the message RAM
+//
+#define  CAN_MODEL_OBJ_MAX    32
+
+//-------------------------------------------------------------------
+// size of the transmit log
+//
+#define  CAN_MODEL_LOG_MAX    64
+
+/*!
+** \enum    CAN_MODEL_REG_e
+** \brief   Registers of the model
+**
+** The byte registers of the C8051F550 (CAN0IFxCRL, CAN0IFxDA1H, ...)
+** address the low / high byte of these 16 bit registers.
+*/
+enum CAN_MODEL_REG_e {
+   eCAN_REG_CN = 0,
+   eCAN_REG_STAT,
+   eCAN_REG_ERR,
+   eCAN_REG_BT,
+   eCAN_REG_IID,
+   eCAN_REG_TST,
+
+   eCAN_REG_IF1CR,
+   eCAN_REG_IF1CM,
+   eCAN_REG_IF1M1,
+   eCAN_REG_IF1M2,
+   eCAN_REG_IF1A1,
+   eCAN_REG_IF1A2,
+   eCAN_REG_IF1MC,
+   eCAN_REG_IF1DA1,
+   eCAN_REG_IF1DA2,
+   eCAN_REG_IF1DB1,
+   eCAN_REG_IF1DB2,
+
+   eCAN_REG_IF2CR,
+   eCAN_REG_IF2CM,
+   eCAN_REG_IF2M1,
+   eCAN_REG_IF2M2,
+   eCAN_REG_IF2A1,
+   eCAN_REG_IF2A2,
+   eCAN_REG_IF2MC,
+   eCAN_REG_IF2DA1,
+   eCAN_REG_IF2DA2,
+   eCAN_REG_IF2DB1,
+   eCAN_REG_IF2DB2,
+
+   eCAN_REG_MAX
+};
+
+/*!
+** \struct  CanModelObj_s
+** \brief   Message object of the message RAM
+*/
+typedef struct CanModelObj_s {
+   uint16_t uwMsk1;
+   uint16_t uwMsk2;
+   uint16_t uwArb1;
+   uint16_t uwArb2;
+   uint16_t uwMsgCtrl;
+   uint16_t auwData[4];       // DA1, DA2, DB1, DB2
+} CanModelObj_ts;
+
+/*!
+** \struct  CanModelFrame_s
+** \brief   Frame of the transmit log
+*/
+typedef struct CanModelFrame_s {
+   uint32_t ulIdentifier;
+   uint8_t  ubExtended;
+   uint8_t  ubDlc;
+   uint8_t  aubData[8];
+   uint8_t  ubBufferIdx;      // message object which sent the frame
+} CanModelFrame_ts;
+
+
+/*----------------------------------------------------------------------------*\
+** Function prototypes                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------
+// register access, used by the register header of test/stub
+//
+volatile uint16_t *  CanModelReg16(uint8_t ubRegV);
+volatile uint8_t *   CanModelReg8(uint8_t ubRegV, uint8_t ubHighV);
+
+/*!
+** \brief   Reset the model
+**
+** All registers and message objects are cleared, the controller is in
+** initialisation mode and the transmit log is empty.
+*/
+void     CanModelReset(void);
+
+/*!
+** \brief   Message object
+** \param   ubBufferIdxV - message object number, 1 .. 32
+** \return  Pointer to the message object
+**
+** A pending IF transfer is executed first.
+*/
+CanModelObj_ts * CanModelObject(uint8_t ubBufferIdxV);
+
+/*!
+** \brief   Receive a data frame from the bus
+** \param   ulIdV - identifier
+** \param   ubExtV - 1 for an extended frame
+** \param   ubDlcV - data length code
+** \param   pubDataV - data, may be 0L for DLC = 0
+** \return  Number of the message object that took the frame, 0 if no
+**          message object accepted it
+*/
+uint8_t  CanModelReceive(uint32_t ulIdV, uint8_t ubExtV, uint8_t ubDlcV,
+                         const uint8_t * pubDataV);
+
+/*!
+** \brief   Test for a pending CAN interrupt
+** \return  1 if an interrupt request is pending and enabled (CAN0CN.IE
+**          and EIE2.ECAN0)
+*/
+uint8_t  CanModelIrqPending(void);
+
+/*!
+** \brief   Transmit log
+** \param   ubFrameV - index of the frame
+** \return  Pointer to the frame, 0L if the log has less frames
+*/
+CanModelFrame_ts * CanModelTrmFrame(uint8_t ubFrameV);
+
+/*!
+** \brief   Number of frames in the transmit log
+*/
+uint8_t  CanModelTrmCount(void);
+
+/*!
+** \brief   Clear the transmit log
+**
+** Message objects with a pending transmit request are sent first.
+*/
+void     CanModelTrmClear(void);
+
+/*!
+** \brief   Hold the transmission
+** \param   ubHoldV - 1 to hold, 0 to release
+**
+** While the transmission is held a transmit request stays pending, as
+** if the bus was busy. A test uses this to let time pass between the
+** transmit request and the transmit interrupt.
+*/
+void     CanModelTrmHold(uint8_t ubHoldV);
+
+
+#endif   // _CAN_MODEL_H_
@@ -0,0 +1,131 @@
+//****************************************************************************//
+// File:          cos_stub.c                                                  //
+// Description:   Stand-in functions for the host test build of the stack    //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include "cos_stub.h"
+
+
+/*----------------------------------------------------------------------------*\
+** Variables of module                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------
+// variables of the NMT module
+//
+uint16_t    uwCosNmtHeartTimeG;
+uint16_t    uwCosNmtGuardTimeG;
+uint8_t     ubCosNmtGuardFactorG;
+uint8_t     ubCosNmtStartupG;
+
+uint8_t     aubCosNmtHbConsNodeG[COS_STUB_HBC_MAX];
+uint16_t    auwCosNmtHbConsTimeG[COS_STUB_HBC_MAX];
+
+//-------------------------------------------------------------------
+// observation of the stand-in functions
+//
+uint8_t     ubStubNodeStateG = NODE_STATE_OPERATIONAL;
+uint16_t    auwStubHbConsCountG[COS_STUB_HBC_MAX];
+uint32_t    ulStubSdoValueG;
+
+
+/*----------------------------------------------------------------------------*\
+** Functions                                                                  **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//----------------------------------------------------------------------------//
+// NMT                                                                        //
+//----------------------------------------------------------------------------//
+uint8_t  CosNmtCheckNodeReset(void)             { return(NMT_RESET_OFF);    }
+void     CosNmtErrorSetup(uint8_t ubModeV)      { (void) ubModeV;           }
+uint8_t  CosNmtGetNodeState(void)               { return(ubStubNodeStateG); }
+void     CosNmtGuardingHandler(void)            { }
+void     CosNmtInit(void)                       { }
+void     CosNmtMessageHandler(void)             { }
+void     CosNmtSetHeartbeatProd(uint16_t uwV)   { (void) uwV;               }
+
+void CosNmtHBConsHandler(uint8_t ubEntryV)
+{
+   if(ubEntryV < COS_STUB_HBC_MAX) auwStubHbConsCountG[ubEntryV]++;
+}
+
+void CosNmtSetHeartbeatCons(uint8_t ubEntryV, uint8_t ubNodeV,
+                            uint16_t uwTimeV)
+{
+   if(ubEntryV >= COS_STUB_HBC_MAX) return;
+   aubCosNmtHbConsNodeG[ubEntryV] = ubNodeV;
+   auwCosNmtHbConsTimeG[ubEntryV] = uwTimeV;
+}
+
+
+//----------------------------------------------------------------------------//
+// PDO, SYNC, CiA 401                                                         //
+//----------------------------------------------------------------------------//
+void     CosPdoInit(void)                       { }
+void     CosSyncInit(void)                      { }
+void     CosSyncMessageHandler(void)            { }
+void     Cos401_DI_ParmInit(void)               { }
+void     Cos401_AI_ParmInit(void)               { }
+
+
+//----------------------------------------------------------------------------//
+// CosSdoCopyValueToMessage()                                                 //
+// ulStubSdoValueG takes the value of a read access                           //
+//----------------------------------------------------------------------------//
+void CosSdoCopyValueToMessage(void * pvValueV, uint8_t ubTypeV)
+{
+   switch(ubTypeV)
+   {
+      case CoDT_UNSIGNED8:
+         ulStubSdoValueG = *((uint8_t *) pvValueV);
+         break;
+
+      case CoDT_UNSIGNED16:
+         ulStubSdoValueG = *((uint16_t *) pvValueV);
+         break;
+
+      default:
+         ulStubSdoValueG = *((uint32_t *) pvValueV);
+         break;
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// CosSdoCopyMessageToValue()                                                 //
+// ulStubSdoValueG is the value of a write access                             //
+//----------------------------------------------------------------------------//
+void CosSdoCopyMessageToValue(void * pvValueV, uint8_t ubTypeV)
+{
+   switch(ubTypeV)
+   {
+      case CoDT_UNSIGNED8:
+         *((uint8_t *) pvValueV) = (uint8_t) ulStubSdoValueG;
+         break;
+
+      case CoDT_UNSIGNED16:
+         *((uint16_t *) pvValueV) = (uint16_t) ulStubSdoValueG;
+         break;
+
+      default:
+         *((uint32_t *) pvValueV) = ulStubSdoValueG;
+         break;
+   }
+}
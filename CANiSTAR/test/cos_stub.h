@@ -0,0 +1,57 @@
+//****************************************************************************//
+// File:          cos_stub.h                                                  //
+// Description:   Stand-in functions for the host test build of the stack    //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+#ifndef _COS_STUB_H_
+#define _COS_STUB_H_
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \file    cos_stub.h
+** \brief   Stand-in for the stack modules which are not in this tree
+**
+** cos_nmt.c, cos_sdo.c, cos_pdo.c, cos_sync.c and the CiA 401 modules
+** are not part of this source tree. cos_stub.c provides their functions
+** and variables as far as the tested modules use them, the headers of
+** test/stub declare them. The stand-in functions count their calls, a
+** test checks these counters. The SDO request handler of bench_sdo.c
+** serves the object dictionary, the other tests do not answer SDO
+** requests.
+*/
+
+#include "cos_dict.h"
+#include "cos_nmt.h"
+#include "cos_sdo.h"
+#include "cos_pdo.h"
+#include "cos_sync.h"
+#include "cos401di.h"
+#include "cos401ai.h"
+
+
+//-------------------------------------------------------------------
+// size of the heartbeat consumer arrays, independent of the value
+// of COS_DICT_OBJ_1016
+//
+#define  COS_STUB_HBC_MAX     127
+
+extern uint8_t    aubCosNmtHbConsNodeG[COS_STUB_HBC_MAX];
+extern uint16_t   auwCosNmtHbConsTimeG[COS_STUB_HBC_MAX];
+
+extern uint8_t    ubStubNodeStateG;             // NMT state
+extern uint16_t   auwStubHbConsCountG[COS_STUB_HBC_MAX];
+extern uint32_t   ulStubSdoValueG;              // SDO data, read and write
+
+
+#endif   // _COS_STUB_H_
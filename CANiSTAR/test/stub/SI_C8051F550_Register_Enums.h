@@ -0,0 +1,100 @@
+//****************************************************************************//
+// File:          SI_C8051F550_Register_Enums.h                               //
+// Description:   SFR declarations of the C8051F550 for the host test build   //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+#ifndef _SI_C8051F550_REGISTER_ENUMS_H_
+#define _SI_C8051F550_REGISTER_ENUMS_H_
+
+//-----------------------------------------------------------------------------
+// This header replaces the Silicon Labs header in the host test build.
+// Only the SFRs used by c51f550_can.c are declared, the CAN0 registers
+// are mapped onto the register model of can_model.c.
+//
+#include "can_model.h"
+
+
+//-------------------------------------------------------------------
+// interrupt handler: a plain function on the host
+//
+#define  INTERRUPT(name, vector)  void name(void)
+
+#define  CAN0_IRQn                16
+#define  CAN0_PAGE                0x0C
+
+extern volatile uint8_t  EIE2;
+extern volatile uint8_t  SFRPAGE;
+
+//-------------------------------------------------------------------
+// 16 bit CAN0 registers
+//
+#define  CAN0CN      (*CanModelReg16(eCAN_REG_CN))
+#define  CAN0STAT    (*CanModelReg16(eCAN_REG_STAT))
+#define  CAN0ERR     (*CanModelReg16(eCAN_REG_ERR))
+#define  CAN0BT      (*CanModelReg16(eCAN_REG_BT))
+#define  CAN0IID     (*CanModelReg16(eCAN_REG_IID))
+#define  CAN0TST     (*CanModelReg16(eCAN_REG_TST))
+#define  CAN0IF1CR   (*CanModelReg16(eCAN_REG_IF1CR))
+#define  CAN0IF1CM   (*CanModelReg16(eCAN_REG_IF1CM))
+#define  CAN0IF1M1   (*CanModelReg16(eCAN_REG_IF1M1))
+#define  CAN0IF1M2   (*CanModelReg16(eCAN_REG_IF1M2))
+#define  CAN0IF1A1   (*CanModelReg16(eCAN_REG_IF1A1))
+#define  CAN0IF1A2   (*CanModelReg16(eCAN_REG_IF1A2))
+#define  CAN0IF1MC   (*CanModelReg16(eCAN_REG_IF1MC))
+#define  CAN0IF1DA1  (*CanModelReg16(eCAN_REG_IF1DA1))
+#define  CAN0IF1DA2  (*CanModelReg16(eCAN_REG_IF1DA2))
+#define  CAN0IF1DB1  (*CanModelReg16(eCAN_REG_IF1DB1))
+#define  CAN0IF1DB2  (*CanModelReg16(eCAN_REG_IF1DB2))
+#define  CAN0IF2CR   (*CanModelReg16(eCAN_REG_IF2CR))
+#define  CAN0IF2CM   (*CanModelReg16(eCAN_REG_IF2CM))
+#define  CAN0IF2M1   (*CanModelReg16(eCAN_REG_IF2M1))
+#define  CAN0IF2M2   (*CanModelReg16(eCAN_REG_IF2M2))
+#define  CAN0IF2A1   (*CanModelReg16(eCAN_REG_IF2A1))
+#define  CAN0IF2A2   (*CanModelReg16(eCAN_REG_IF2A2))
+#define  CAN0IF2MC   (*CanModelReg16(eCAN_REG_IF2MC))
+#define  CAN0IF2DA1  (*CanModelReg16(eCAN_REG_IF2DA1))
+#define  CAN0IF2DA2  (*CanModelReg16(eCAN_REG_IF2DA2))
+#define  CAN0IF2DB1  (*CanModelReg16(eCAN_REG_IF2DB1))
+#define  CAN0IF2DB2  (*CanModelReg16(eCAN_REG_IF2DB2))
+
+//-------------------------------------------------------------------
+// byte access to the 16 bit registers
+//
+#define  CAN0IF1CRL  (*CanModelReg8(eCAN_REG_IF1CR, 0))
+#define  CAN0IF1CML  (*CanModelReg8(eCAN_REG_IF1CM, 0))
+#define  CAN0IF1DA1L (*CanModelReg8(eCAN_REG_IF1DA1, 0))
+#define  CAN0IF1DA1H (*CanModelReg8(eCAN_REG_IF1DA1, 1))
+#define  CAN0IF1DA2L (*CanModelReg8(eCAN_REG_IF1DA2, 0))
+#define  CAN0IF1DA2H (*CanModelReg8(eCAN_REG_IF1DA2, 1))
+#define  CAN0IF1DB1L (*CanModelReg8(eCAN_REG_IF1DB1, 0))
+#define  CAN0IF1DB1H (*CanModelReg8(eCAN_REG_IF1DB1, 1))
+#define  CAN0IF1DB2L (*CanModelReg8(eCAN_REG_IF1DB2, 0))
+#define  CAN0IF1DB2H (*CanModelReg8(eCAN_REG_IF1DB2, 1))
+#define  CAN0IF2CRL  (*CanModelReg8(eCAN_REG_IF2CR, 0))
+#define  CAN0IF2CML  (*CanModelReg8(eCAN_REG_IF2CM, 0))
+#define  CAN0IF2DA1L (*CanModelReg8(eCAN_REG_IF2DA1, 0))
+#define  CAN0IF2DA1H (*CanModelReg8(eCAN_REG_IF2DA1, 1))
+#define  CAN0IF2DA2L (*CanModelReg8(eCAN_REG_IF2DA2, 0))
+#define  CAN0IF2DA2H (*CanModelReg8(eCAN_REG_IF2DA2, 1))
+#define  CAN0IF2DB1L (*CanModelReg8(eCAN_REG_IF2DB1, 0))
+#define  CAN0IF2DB1H (*CanModelReg8(eCAN_REG_IF2DB1, 1))
+#define  CAN0IF2DB2L (*CanModelReg8(eCAN_REG_IF2DB2, 0))
+#define  CAN0IF2DB2H (*CanModelReg8(eCAN_REG_IF2DB2, 1))
+
+//-------------------------------------------------------------------
+// bit CCE of CAN0CN (sbit)
+//
+#define  CAN0CN_CCE  ((CAN0CN >> 6) & 0x01)
+
+
+#endif   // _SI_C8051F550_REGISTER_ENUMS_H_
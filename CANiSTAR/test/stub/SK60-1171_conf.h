@@ -0,0 +1,20 @@
+//****************************************************************************//
+// File:          SK60-1171_conf.h                                            //
+// Description:   Board configuration of the host test build                  //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+//-------------------------------------------------------------------
+// cos_conf.h includes the board configuration, the test build uses
+// the defaults of cos_conf.h. Options for a single test are passed
+// by the Makefile.
+//
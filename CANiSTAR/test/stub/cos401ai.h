@@ -0,0 +1,27 @@
+//****************************************************************************//
+// File:          cos401ai.h                                                  //
+// Description:   CiA 401 analogue input of the host test build (stand-in)    //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+#ifndef _COS401AI_H_
+#define _COS401AI_H_
+
+#include "cos_defs.h"
+
+void     Cos401_AI_ParmInit(void);
+uint8_t  Cos401_AI_ParmLoad(void);
+uint8_t  Cos401_AI_ParmSave(void);
+uint16_t Cos401_AI_GetAdcValue(uint8_t ubChannelV);
+
+
+#endif   // _COS401AI_H_
@@ -0,0 +1,27 @@
+//****************************************************************************//
+// File:          cos401di.h                                                  //
+// Description:   CiA 401 digital input of the host test build (stand-in)     //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+#ifndef _COS401DI_H_
+#define _COS401DI_H_
+
+#include "cos_defs.h"
+
+void     Cos401_DI_ParmInit(void);
+uint8_t  Cos401_DI_ParmLoad(void);
+uint8_t  Cos401_DI_ParmSave(void);
+uint8_t  Cos401_DI_Read(uint8_t ubChannelV);
+
+
+#endif   // _COS401DI_H_
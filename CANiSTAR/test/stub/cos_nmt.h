@@ -0,0 +1,54 @@
+//****************************************************************************//
+// File:          cos_nmt.h                                                   //
+// Description:   NMT service of the host test build (stand-in)               //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+#ifndef _COS_NMT_H_
+#define _COS_NMT_H_
+
+//-------------------------------------------------------------------
+// cos_nmt.c is not part of this source tree, the test build links
+// the functions of cos_stub.c
+//
+#include "cos_defs.h"
+
+#define  NODE_STATE_INIT            0
+#define  NODE_STATE_STOPPED         4
+#define  NODE_STATE_OPERATIONAL     5
+#define  NODE_STATE_PREOPERATIONAL  127
+
+#define  NMT_RESET_OFF              0
+
+extern uint16_t   uwCosNmtHeartTimeG;
+extern uint16_t   uwCosNmtGuardTimeG;
+extern uint8_t    ubCosNmtGuardFactorG;
+extern uint8_t    ubCosNmtStartupG;
+
+uint8_t  CosNmtCheckNodeReset(void);
+void     CosNmtErrorSetup(uint8_t ubModeV);
+uint8_t  CosNmtGetNodeState(void);
+void     CosNmtGuardingHandler(void);
+void     CosNmtHBConsHandler(uint8_t ubEntryV);
+void     CosNmtInit(void);
+void     CosNmtMessageHandler(void);
+void     CosNmtSetHeartbeatCons(uint8_t ubEntryV, uint8_t ubNodeV,
+                                uint16_t uwTimeV);
+void     CosNmtSetHeartbeatProd(uint16_t uwTimeV);
+
+uint8_t  CosNmt_Idx100C(uint8_t ubSubIndexV, uint8_t ubReqCodeV);
+uint8_t  CosNmt_Idx100D(uint8_t ubSubIndexV, uint8_t ubReqCodeV);
+uint8_t  CosNmt_Idx1017(uint8_t ubSubIndexV, uint8_t ubReqCodeV);
+uint8_t  CosNmt_Idx1029(uint8_t ubSubIndexV, uint8_t ubReqCodeV);
+
+
+#endif   // _COS_NMT_H_
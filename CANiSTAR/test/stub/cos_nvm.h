@@ -0,0 +1,37 @@
+//****************************************************************************//
+// File:          cos_nvm.h                                                   //
+// Description:   NVM access of the host test build (stand-in)                //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+#ifndef _COS_NVM_H_
+#define _COS_NVM_H_
+
+#include "cos_defs.h"
+#include "mc_nvm.h"
+
+
+//-------------------------------------------------------------------
+// cos_nvm.h of the application is not part of this source tree, the
+// layout holds the entries used by the tested modules
+//
+enum CosNvm_e {
+   eNVM_CHECKSUM_U16       = 0x00,
+   eNVM_CHECKSUM_START     = 0x02,
+   eNVM_305_BAUDRATE_U08   = 0x02,
+   eNVM_305_NODE_ID_U08    = 0x03,
+   eNVM_PARM_SEL_U16       = 0x04,
+   eNVM_CHECKSUM_END       = 0x06
+};
+
+
+#endif   // _COS_NVM_H_
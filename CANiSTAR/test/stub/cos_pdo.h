@@ -0,0 +1,57 @@
+//****************************************************************************//
+// File:          cos_pdo.h                                                   //
+// Description:   PDO service of the host test build (stand-in)               //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+#ifndef _COS_PDO_H_
+#define _COS_PDO_H_
+
+#include "cos_defs.h"
+
+//-------------------------------------------------------------------
+// fixed mapping entry and communication parameter of a transmit PDO,
+// as far as they are used by cos301.c, cos_psch.c and the user file
+//
+typedef struct CosPdoMap_s {
+   uint16_t    uwIndex;
+   uint8_t     ubSubIndex;
+   uint8_t     ubLength;
+} CosPdoMap_ts;
+
+typedef struct CosPdoCom_s {
+   uint32_t    ulIdentifier;
+   uint8_t     ubTransType;
+   uint8_t     ubSyncCount;
+   uint16_t    uwInhibitTime;
+   uint16_t    uwInhibitTick;
+   uint16_t    uwEventTime;
+   uint16_t    uwEventTick;
+   uint8_t     ubSyncStartValue;
+   uint8_t     ubSyncStartFlag;
+} CosPdoCom_ts;
+
+extern CosPdoCom_ts  atsTrmPdoComG[];
+
+void     CosPdoInit(void);
+void     CosPdoSend(uint8_t ubPdoNumberV);
+
+void     CosPdoComSetup(void);
+void     CosPdoRcvDataUpdate(uint8_t ubPdoNumberV);
+void     CosPdoTrmDataUpdate(uint8_t ubPdoNumberV);
+
+uint8_t  CosPdoMapParameter(uint8_t ubSubIndexV, uint8_t ubReqCodeV);
+uint8_t  CosPdoRcvComParam(uint8_t ubSubIndexV, uint8_t ubReqCodeV);
+uint8_t  CosPdoTrmComParam(uint8_t ubSubIndexV, uint8_t ubReqCodeV);
+
+
+#endif   // _COS_PDO_H_
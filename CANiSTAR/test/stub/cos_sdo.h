@@ -0,0 +1,37 @@
+//****************************************************************************//
+// File:          cos_sdo.h                                                   //
+// Description:   SDO server of the host test build (stand-in)                //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+#ifndef _COS_SDO_H_
+#define _COS_SDO_H_
+
+#include "cos_defs.h"
+
+void     CosSdoInit(uint8_t ubNodeIdV);
+void     CosSdoMessageHandler(void);
+void     CosSdoResponse(uint8_t ubResponseV);
+
+void     CosSdoCopyMessageToValue(void * pvValueV, uint8_t ubTypeV);
+void     CosSdoCopyValueToMessage(void * pvValueV, uint8_t ubTypeV);
+void     CosSdoSegSetup(void * pvDataV, uint32_t ulSizeV);
+
+//-------------------------------------------------------------------
+// hooks of the application, they are in the user file
+//
+uint32_t CosSdoBlkUpObjectSize(uint16_t uwIndexV, uint8_t ubSubIndexV);
+uint8_t  CosSdoSegFinal(uint8_t ubReqCodeV, uint16_t uwIndexV,
+                        uint8_t ubSubIndexV);
+
+
+#endif   // _COS_SDO_H_
@@ -0,0 +1,28 @@
+//****************************************************************************//
+// File:          cos_sync.h                                                  //
+// Description:   SYNC service of the host test build (stand-in)              //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+#ifndef _COS_SYNC_H_
+#define _COS_SYNC_H_
+
+#include "cos_defs.h"
+
+void     CosSyncInit(void);
+void     CosSyncMessageHandler(void);
+
+uint8_t  CosSync_Idx1005(uint8_t ubSubIndexV, uint8_t ubReqCodeV);
+uint8_t  CosSync_Idx1006(uint8_t ubSubIndexV, uint8_t ubReqCodeV);
+
+
+#endif   // _COS_SYNC_H_
@@ -0,0 +1,22 @@
+//****************************************************************************//
+// File:          cos_time.h                                                  //
+// Description:   TIME service of the host test build (stand-in)              //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+#ifndef _COS_TIME_H_
+#define _COS_TIME_H_
+
+#include "cos_defs.h"
+
+
+#endif   // _COS_TIME_H_
@@ -0,0 +1,346 @@
+//****************************************************************************//
+// File:          test_c51f550_can.c                                          //
+// Description:   Test of the C8051F550 CANpie driver on the register model   //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include "can_model.h"
+#include "cp_core.h"
+#include "cp_msg.h"
+#include "mc_tmr.h"
+#include "c51f550_can.h"
+#include "test_check.h"
+
+
+/*----------------------------------------------------------------------------*\
+** Variables of module                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+TEST_CHECK_DATA;
+
+CpPort_ts            tsCanPortG;
+static CpCanMsg_ts   tsRcvMsgS;        // copy of the last received message
+static uint8_t       ubRcvBufferS;
+static uint8_t       ubRcvCountS;
+static uint32_t      ulTickS;          // timer tick, advanced by the test
+
+//-------------------------------------------------------------------
+// interrupt handler of the driver
+//
+void CAN0_IRQ(void);
+
+
+/*----------------------------------------------------------------------------*\
+** Functions                                                                  **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//----------------------------------------------------------------------------//
+// McTmrTick()                                                                //
+// the driver uses the tick only for the automatic bitrate detection          //
+//----------------------------------------------------------------------------//
+uint32_t McTmrTick(void)
+{
+   return(ulTickS);
+}
+
+
+//----------------------------------------------------------------------------//
+// TestRcvHandler()                                                           //
+//                                                                            //
+//----------------------------------------------------------------------------//
+static uint8_t TestRcvHandler(CpCanMsg_ts * ptsCanMsgV, uint8_t ubBufferIdxV)
+{
+   tsRcvMsgS    = *ptsCanMsgV;
+   ubRcvBufferS = ubBufferIdxV;
+   ubRcvCountS++;
+   return(CP_CALLBACK_PROCESSED);
+}
+
+
+//----------------------------------------------------------------------------//
+// TestStart()                                                                //
+// initialise driver and model, start the controller                          //
+//----------------------------------------------------------------------------//
+static void TestStart(void)
+{
+   CanModelReset();
+   CpCoreDriverInit(CP_CHANNEL_1, &tsCanPortG);
+   CpCoreIntFunctions(CP_CHANNEL_1, TestRcvHandler, 0L, 0L);
+   CpCoreBaudrate(&tsCanPortG, CP_BAUD_125K);
+   CpCoreCanMode(&tsCanPortG, CP_MODE_START);
+   ubRcvCountS = 0;
+}
+
+
+//----------------------------------------------------------------------------//
+// TestIrq()                                                                  //
+// run the interrupt handler while an interrupt is pending                    //
+//----------------------------------------------------------------------------//
+static void TestIrq(void)
+{
+   while(CanModelIrqPending())
+   {
+      CAN0_IRQ();
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// TestBufferInitExtTx()                                                      //
+// transmit buffer with extended identifier                                   //
+//----------------------------------------------------------------------------//
+static void TestBufferInitExtTx(void)
+{
+   CpCanMsg_ts       tsMsgT;
+   CanModelObj_ts *  ptsObjT;
+   CanModelFrame_ts * ptsFrameT;
+
+   TestStart();
+
+   CpMsgClear(&tsMsgT);
+   CpMsgSetExtId(&tsMsgT, 0x1ABC5678);
+   CpMsgSetDlc(&tsMsgT, 2);
+   TEST_CHECK_EQ(CpCoreBufferInit(&tsCanPortG, &tsMsgT, 3, CP_BUFFER_DIR_TX),
+                 CpErr_OK);
+
+   //----------------------------------------------------------------
+   // the lower 16 bits of the identifier are in Arb1
+   //
+   ptsObjT = CanModelObject(3);
+   TEST_CHECK_EQ(ptsObjT->uwArb1, 0x5678);
+   TEST_CHECK_EQ(ptsObjT->uwArb2, 0x8000 | 0x4000 | 0x2000 | 0x1ABC);
+   TEST_CHECK_EQ(ptsObjT->uwMsgCtrl & 0x000F, 2);
+
+   //----------------------------------------------------------------
+   // the frame on the bus has the complete identifier
+   //
+   CpCoreBufferSend(&tsCanPortG, 3);
+   TEST_CHECK_EQ(CanModelTrmCount(), 1);
+   ptsFrameT = CanModelTrmFrame(0);
+   TEST_CHECK(ptsFrameT != 0L);
+   if(ptsFrameT != 0L)
+   {
+      TEST_CHECK_EQ(ptsFrameT->ulIdentifier, 0x1ABC5678);
+      TEST_CHECK_EQ(ptsFrameT->ubExtended, 1);
+      TEST_CHECK_EQ(ptsFrameT->ubBufferIdx, 3);
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// TestBufferInitStdRx()                                                      //
+// receive buffer with standard identifier after an extended one              //
+//----------------------------------------------------------------------------//
+static void TestBufferInitStdRx(void)
+{
+   CpCanMsg_ts       tsMsgT;
+   CanModelObj_ts *  ptsObjT;
+
+   TestStart();
+
+   //----------------------------------------------------------------
+   // an extended receive buffer leaves 0xFFFF in IF1 Mask 1
+   //
+   CpMsgClear(&tsMsgT);
+   CpMsgSetExtId(&tsMsgT, 0x00012345);
+   CpCoreBufferInit(&tsCanPortG, &tsMsgT, 1, CP_BUFFER_DIR_RX);
+
+   CpMsgClear(&tsMsgT);
+   CpMsgSetStdId(&tsMsgT, 0x123);
+   CpCoreBufferInit(&tsCanPortG, &tsMsgT, 2, CP_BUFFER_DIR_RX);
+
+   ptsObjT = CanModelObject(2);
+   TEST_CHECK_EQ(ptsObjT->uwMsk1, 0x0000);
+   TEST_CHECK_EQ(ptsObjT->uwMsk2, 0x07FF << 2);
+   TEST_CHECK_EQ(ptsObjT->uwArb1, 0x0000);
+   TEST_CHECK_EQ(ptsObjT->uwArb2, 0x8000 | (0x123 << 2));
+
+   //----------------------------------------------------------------
+   // only the configured identifier is received
+   //
+   TEST_CHECK_EQ(CanModelReceive(0x124, 0, 0, 0L), 0);
+   TEST_CHECK_EQ(CanModelReceive(0x123, 0, 0, 0L), 2);
+   TestIrq();
+   TEST_CHECK_EQ(ubRcvCountS, 1);
+   TEST_CHECK_EQ(ubRcvBufferS, 2);
+   TEST_CHECK_EQ(CpMsgGetStdId(&tsRcvMsgS), 0x123);
+}
+
+
+//----------------------------------------------------------------------------//
+// TestBufferSetDlc()                                                         //
+// the read-modify-write keeps the upper byte of the message control          //
+//----------------------------------------------------------------------------//
+static void TestBufferSetDlc(void)
+{
+   CpCanMsg_ts       tsMsgT;
+   CanModelObj_ts *  ptsObjT;
+   uint16_t          uwCtrlT;
+
+   TestStart();
+
+   CpMsgClear(&tsMsgT);
+   CpMsgSetStdId(&tsMsgT, 0x181);
+   CpMsgSetDlc(&tsMsgT, 8);
+   CpCoreBufferInit(&tsCanPortG, &tsMsgT, 5, CP_BUFFER_DIR_TX);
+   uwCtrlT = CanModelObject(5)->uwMsgCtrl;
+
+   TEST_CHECK_EQ(CpCoreBufferSetDlc(&tsCanPortG, 5, 3), CpErr_OK);
+   ptsObjT = CanModelObject(5);
+   TEST_CHECK_EQ(ptsObjT->uwMsgCtrl, (uwCtrlT & 0xFFF0) | 3);
+
+   //----------------------------------------------------------------
+   // UMask, TxIE and RxIE are in the upper byte
+   //
+   TEST_CHECK_EQ(ptsObjT->uwMsgCtrl & 0x1C80, 0x1C80);
+
+   CpCoreBufferSend(&tsCanPortG, 5);
+   TEST_CHECK_EQ(CanModelTrmCount(), 1);
+   TEST_CHECK_EQ(CanModelTrmFrame(0)->ubDlc, 3);
+}
+
+
+//----------------------------------------------------------------------------//
+// TestBufferReserve()                                                        //
+// no access to the data registers by pointer, the data is set by SetData     //
+//----------------------------------------------------------------------------//
+static void TestBufferReserve(void)
+{
+   CpCanMsg_ts          tsMsgT;
+   CanModelFrame_ts *   ptsFrameT;
+   uint8_t              aubDataT[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+   uint8_t *            pubDataT;
+   uint8_t              ubCntT;
+
+   TestStart();
+
+   CpMsgClear(&tsMsgT);
+   CpMsgSetStdId(&tsMsgT, 0x7E4);
+   CpMsgSetDlc(&tsMsgT, 8);
+   CpCoreBufferInit(&tsCanPortG, &tsMsgT, 6, CP_BUFFER_DIR_TX);
+
+   pubDataT = 0L;
+   TEST_CHECK_EQ(CpCoreBufferReserve(&tsCanPortG, 6, &pubDataT),
+                 CpErr_NOT_SUPPORTED);
+   TEST_CHECK(pubDataT == 0L);
+   TEST_CHECK_EQ(CpCoreBufferCommit(&tsCanPortG, 6, 1), CpErr_NOT_SUPPORTED);
+   TEST_CHECK_EQ(CanModelTrmCount(), 0);
+
+   TEST_CHECK_EQ(CpCoreBufferSetData(&tsCanPortG, 6, &aubDataT[0]), CpErr_OK);
+   CpCoreBufferSend(&tsCanPortG, 6);
+   TEST_CHECK_EQ(CanModelTrmCount(), 1);
+   ptsFrameT = CanModelTrmFrame(0);
+   TEST_CHECK(ptsFrameT != 0L);
+   if(ptsFrameT != 0L)
+   {
+      for(ubCntT = 0; ubCntT < 8; ubCntT++)
+      {
+         TEST_CHECK_EQ(ptsFrameT->aubData[ubCntT], aubDataT[ubCntT]);
+      }
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// TestAutobaud()                                                             //
+// every call of the automatic bitrate detection checks the bus once          //
+//----------------------------------------------------------------------------//
+static void TestAutobaud(void)
+{
+   uint8_t  ubBaudSelT = CP_BAUD_AUTO;
+   uint16_t uwWaitT    = 4;
+
+   CanModelReset();
+   CpCoreDriverInit(CP_CHANNEL_1, &tsCanPortG);
+
+   //----------------------------------------------------------------
+   // quiet bus: the first bitrate of the detection order is tested
+   // in silent mode until the listen time is over
+   //
+   ulTickS = 100;
+   TEST_CHECK_EQ(CpCoreAutobaud(&tsCanPortG, &ubBaudSelT, &uwWaitT),
+                 CpErr_BAUDRATE_WAIT);
+   TEST_CHECK_EQ(ubBaudSelT, CP_BAUD_125K);
+   TEST_CHECK_EQ(CAN0TST, CAN_TST_SILENT);
+   TEST_CHECK_EQ(CAN0CN & (CAN_CR_INIT | CAN_CR_TEST), CAN_CR_TEST);
+
+   ulTickS = 103;
+   TEST_CHECK_EQ(CpCoreAutobaud(&tsCanPortG, &ubBaudSelT, &uwWaitT),
+                 CpErr_BAUDRATE_WAIT);
+   ulTickS = 104;
+   TEST_CHECK_EQ(CpCoreAutobaud(&tsCanPortG, &ubBaudSelT, &uwWaitT),
+                 CpErr_BAUDRATE);
+   TEST_CHECK_EQ(ubBaudSelT, CP_BAUD_AUTO);
+   TEST_CHECK_EQ(CAN0CN, CAN_CR_INIT | CAN_CR_CCE);
+
+   //----------------------------------------------------------------
+   // the next bitrate is accepted after two frames without error
+   //
+   TEST_CHECK_EQ(CpCoreAutobaud(&tsCanPortG, &ubBaudSelT, &uwWaitT),
+                 CpErr_BAUDRATE_WAIT);
+   TEST_CHECK_EQ(ubBaudSelT, CP_BAUD_250K);
+   CAN0STAT = CAN_STAT_RXOK;
+   TEST_CHECK_EQ(CpCoreAutobaud(&tsCanPortG, &ubBaudSelT, &uwWaitT),
+                 CpErr_BAUDRATE_WAIT);
+   CAN0STAT = CAN_STAT_RXOK | CAN_STAT_LEC;
+   TEST_CHECK_EQ(CpCoreAutobaud(&tsCanPortG, &ubBaudSelT, &uwWaitT),
+                 CpErr_OK);
+   TEST_CHECK_EQ(ubBaudSelT, CP_BAUD_250K);
+   TEST_CHECK_EQ(CAN0CN, CAN_CR_INIT | CAN_CR_CCE);
+
+   //----------------------------------------------------------------
+   // a cached bitrate is tested first, a protocol error rejects it
+   //
+   ubBaudSelT = CP_BAUD_500K;
+   TEST_CHECK_EQ(CpCoreAutobaud(&tsCanPortG, &ubBaudSelT, &uwWaitT),
+                 CpErr_BAUDRATE_WAIT);
+   TEST_CHECK_EQ(ubBaudSelT, CP_BAUD_500K);
+   CAN0STAT = 0x0001;                  // LEC = stuff error
+   TEST_CHECK_EQ(CpCoreAutobaud(&tsCanPortG, &ubBaudSelT, &uwWaitT),
+                 CpErr_BAUDRATE);
+   TEST_CHECK_EQ(ubBaudSelT, CP_BAUD_AUTO);
+
+   //----------------------------------------------------------------
+   // a listen time of 0 ends the running detection
+   //
+   TEST_CHECK_EQ(CpCoreAutobaud(&tsCanPortG, &ubBaudSelT, &uwWaitT),
+                 CpErr_BAUDRATE_WAIT);
+   uwWaitT = 0;
+   TEST_CHECK_EQ(CpCoreAutobaud(&tsCanPortG, &ubBaudSelT, &uwWaitT),
+                 CpErr_BAUDRATE);
+   TEST_CHECK_EQ(ubBaudSelT, CP_BAUD_AUTO);
+   TEST_CHECK_EQ(CAN0CN, CAN_CR_INIT | CAN_CR_CCE);
+}
+
+
+//----------------------------------------------------------------------------//
+// main()                                                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+int main(void)
+{
+   TestBufferInitExtTx();
+   TestBufferInitStdRx();
+   TestBufferSetDlc();
+   TestBufferReserve();
+   TestAutobaud();
+
+   return(TEST_RESULT("test_c51f550_can"));
+}
@@ -0,0 +1,55 @@
+//****************************************************************************//
+// File:          test_check.h                                                //
+// Description:   Minimal check macros for the host tests                     //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+#ifndef _TEST_CHECK_H_
+#define _TEST_CHECK_H_
+
+#include <stdio.h>
+
+//-------------------------------------------------------------------
+// every test program defines the counter once with TEST_CHECK_DATA,
+// main() returns TEST_RESULT()
+//
+#define  TEST_CHECK_DATA      uint32_t ulTestFailG
+extern   uint32_t             ulTestFailG;
+
+#define  TEST_CHECK(COND)                                               \
+         do {                                                           \
+            if(!(COND))                                                 \
+            {                                                           \
+               printf("%s:%d: check failed: %s\n",                      \
+                      __FILE__, __LINE__, #COND);                       \
+               ulTestFailG++;                                           \
+            }                                                           \
+         } while(0)
+
+#define  TEST_CHECK_EQ(VAL, EXP)                                        \
+         do {                                                           \
+            unsigned long ulValT = (unsigned long) (VAL);               \
+            unsigned long ulExpT = (unsigned long) (EXP);               \
+            if(ulValT != ulExpT)                                        \
+            {                                                           \
+               printf("%s:%d: %s = 0x%lX, expected 0x%lX\n",            \
+                      __FILE__, __LINE__, #VAL, ulValT, ulExpT);        \
+               ulTestFailG++;                                           \
+            }                                                           \
+         } while(0)
+
+#define  TEST_RESULT(NAME)                                              \
+         (printf("%s: %s\n", (NAME), ulTestFailG ? "FAIL" : "ok"),      \
+          (ulTestFailG ? 1 : 0))
+
+
+#endif   // _TEST_CHECK_H_
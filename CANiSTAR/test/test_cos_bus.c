@@ -0,0 +1,278 @@
+//****************************************************************************//
+// File:          test_cos_bus.c                                              //
+// Description:   Test of the bus statistic of the CANopen manager            //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include "SI_C8051F550_Register_Enums.h"
+#include "can_model.h"
+#include "cos_mgr.h"
+#include "cos_emcy.h"
+#include "cos_led.h"
+#include "cos301.h"
+#include "cos_stub.h"
+#include "mc_tmr.h"
+#include "linux_tmr.h"
+#include "test_check.h"
+
+#if (COS_BUS_STAT == 0) || (COS_NMT_HBC_MERGE == 0)
+#error  The test requires COS_BUS_STAT = 1 and COS_NMT_HBC_MERGE = 1
+#endif
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \file    test_cos_bus.c
+** \brief   Bus statistic on the virtual clock
+**
+** The frames are received by CAN0_IRQ() at times set with the
+** high-resolution timer of linux_tmr.c. The test checks that the
+** jitter of a message buffer is measured in microseconds, that the
+** shared buffer of the heartbeat consumers has no jitter and that the
+** frames of an application buffer are part of the frame rate and the
+** bus load, but have no counters.
+*/
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#define  TEST_NODE_ID         0x20
+
+#define  TEST_APP_BUFFER      (COS_BUFFER_MAX + 1)
+
+#define  TEST_APP_ID          0x300
+
+
+/*----------------------------------------------------------------------------*\
+** Variables of module                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+TEST_CHECK_DATA;
+
+uint8_t              ubTimerTriggerG;
+
+extern uint8_t       ubCosMgrBaudrateG;
+
+void CAN0_IRQ(void);
+
+
+/*----------------------------------------------------------------------------*\
+** Functions                                                                  **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//----------------------------------------------------------------------------//
+// functions of modules which are not linked to this test                     //
+//----------------------------------------------------------------------------//
+uint8_t  ubIdx1001_ErrorRegisterG;
+
+void     Cos301_ParmInit(void)                  { }
+void     CosMgrOnBusOff(void)                   { }
+void     CosEmcyInit(void)                      { }
+void     CosEmcySend(uint16_t uwCodeV, uint8_t * pubV) { }
+void     CosLedInit(void)                       { }
+void     CosLedNetworkError(uint8_t ubErrorV)   { }
+void     CosLedNetworkStatus(uint8_t ubStatusV) { }
+void     CosDictInit(void)                      { }
+void     CosSdoInit(uint8_t ubNodeIdV)          { }
+void     CosSdoMessageHandler(void)             { }
+
+
+//----------------------------------------------------------------------------//
+// TestFrame()                                                                //
+// receive a frame after a delay and run the CAN interrupt handler            //
+//----------------------------------------------------------------------------//
+static uint8_t TestFrame(uint32_t ulDelayV, uint16_t uwIdV, uint8_t ubDlcV)
+{
+   uint8_t  aubDataT[8] = { 0x05, 0, 0, 0, 0, 0, 0, 0 };
+   uint8_t  ubBufferT;
+
+   McTmrHResAdvance(ulDelayV);
+
+   ubBufferT = CanModelReceive(uwIdV, 0, ubDlcV, &aubDataT[0]);
+   while(CanModelIrqPending())
+   {
+      CAN0_IRQ();
+   }
+   return(ubBufferT);
+}
+
+
+//----------------------------------------------------------------------------//
+// TestStart()                                                                //
+// driver, SDO and application buffer, consumers for node 5 and 7             //
+//----------------------------------------------------------------------------//
+static void TestStart(void)
+{
+   CosMgrBusStat_ts  tsStatT;
+   CpCanMsg_ts       tsMsgT;
+
+   CanModelReset();
+   CpCoreDriverInit(CP_CHANNEL_1, &tsCanPortG);
+   CpCoreIntFunctions(CP_CHANNEL_1, CosMgrCanRcvHandler,
+                      CosMgrCanTrmHandler, CosMgrCanErrHandler);
+   CpCoreBaudrate(&tsCanPortG, CP_BAUD_125K);
+   CpCoreCanMode(&tsCanPortG, CP_MODE_START);
+   ubCosMgrBaudrateG = CP_BAUD_125K;
+
+   CpMsgClear(&tsMsgT);
+   CpMsgSetStdId(&tsMsgT, 0x600 + TEST_NODE_ID);
+   CpMsgSetDlc(&tsMsgT, 8);
+   CpCoreBufferInit(&tsCanPortG, &tsMsgT, eCosBuf_SDO_RCV, CP_BUFFER_DIR_RX);
+
+   CpMsgSetStdId(&tsMsgT, TEST_APP_ID);
+   CpCoreBufferInit(&tsCanPortG, &tsMsgT, TEST_APP_BUFFER, CP_BUFFER_DIR_RX);
+
+   CosNmtSetHeartbeatCons(0, 5, 1000);
+   CosNmtSetHeartbeatCons(1, 7, 1000);
+   CosMgrHbcFilter();
+
+   CosMgrBusStatistic(&tsStatT, 0, 1);
+}
+
+
+//----------------------------------------------------------------------------//
+// TestBusJitter()                                                            //
+// the jitter of a buffer is measured in microseconds                         //
+//----------------------------------------------------------------------------//
+static void TestBusJitter(void)
+{
+   CosMgrBusStat_ts  tsStatT;
+
+   TestStart();
+
+   //----------------------------------------------------------------
+   // intervals of 10000, 10250, 9900 and 10000 us: the changes are
+   // 250, 350 and 100 us, they are all below one timer tick
+   //
+   TEST_CHECK_EQ(TestFrame(    0, 0x600 + TEST_NODE_ID, 8), eCosBuf_SDO_RCV);
+   TEST_CHECK_EQ(TestFrame(10000, 0x600 + TEST_NODE_ID, 8), eCosBuf_SDO_RCV);
+   TEST_CHECK_EQ(TestFrame(10250, 0x600 + TEST_NODE_ID, 8), eCosBuf_SDO_RCV);
+   TEST_CHECK_EQ(TestFrame( 9900, 0x600 + TEST_NODE_ID, 8), eCosBuf_SDO_RCV);
+   TEST_CHECK_EQ(TestFrame(10000, 0x600 + TEST_NODE_ID, 8), eCosBuf_SDO_RCV);
+
+   CosMgrBusStatistic(&tsStatT, eCosBuf_SDO_RCV, 0);
+   TEST_CHECK_EQ(tsStatT.ulRcvCount, 5);
+   TEST_CHECK_EQ(tsStatT.ulTrmCount, 0);
+   TEST_CHECK_EQ(tsStatT.uwJitterMax, 350);
+
+   //----------------------------------------------------------------
+   // a change of more than 65535 us is limited
+   //
+   TEST_CHECK_EQ(TestFrame(200000, 0x600 + TEST_NODE_ID, 8), eCosBuf_SDO_RCV);
+   CosMgrBusStatistic(&tsStatT, eCosBuf_SDO_RCV, 1);
+   TEST_CHECK_EQ(tsStatT.uwJitterMax, 0xFFFF);
+
+   CosMgrBusStatistic(&tsStatT, eCosBuf_SDO_RCV, 0);
+   TEST_CHECK_EQ(tsStatT.ulRcvCount, 0);
+   TEST_CHECK_EQ(tsStatT.uwJitterMax, 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// TestBusShared()                                                            //
+// the shared heartbeat buffer has no frame interval                          //
+//----------------------------------------------------------------------------//
+static void TestBusShared(void)
+{
+   CosMgrBusStat_ts  tsStatT;
+   uint8_t           ubCntT;
+
+   TestStart();
+
+   //----------------------------------------------------------------
+   // node 5 and node 7 send every second with an offset of 100 ms,
+   // the intervals of the buffer change between 100 and 900 ms
+   //
+   for(ubCntT = 0; ubCntT < 4; ubCntT++)
+   {
+      TEST_CHECK_EQ(TestFrame(900000, 0x705, 1), eCosBuf_NMT_HBC);
+      TEST_CHECK_EQ(TestFrame(100000, 0x707, 1), eCosBuf_NMT_HBC);
+   }
+
+   CosMgrBusStatistic(&tsStatT, eCosBuf_NMT_HBC, 0);
+   TEST_CHECK_EQ(tsStatT.ulRcvCount, 8);
+   TEST_CHECK_EQ(tsStatT.uwJitterMax, 0);
+
+   CosMgrBusStatistic(&tsStatT, 0, 0);
+   TEST_CHECK_EQ(tsStatT.ulRcvCount, 8);
+   TEST_CHECK_EQ(tsStatT.uwJitterMax, 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// TestBusLoad()                                                              //
+// frame rate and bus load include the application buffers                    //
+//----------------------------------------------------------------------------//
+static void TestBusLoad(void)
+{
+   CosMgrBusStat_ts  tsStatT;
+   uint16_t          uwCntT;
+
+   TestStart();
+
+   //----------------------------------------------------------------
+   // one SDO request and one application frame every 10 ms for
+   // 3 seconds, a frame with 8 data bytes has up to 135 bits:
+   // 200 frames per second are 27000 bit/s, i.e. 21 % of 125 kBit/s
+   //
+   for(uwCntT = 0; uwCntT < 300; uwCntT++)
+   {
+      TEST_CHECK_EQ(TestFrame(5000, 0x600 + TEST_NODE_ID, 8),
+                    eCosBuf_SDO_RCV);
+      TEST_CHECK_EQ(TestFrame(5000, TEST_APP_ID, 8), TEST_APP_BUFFER);
+   }
+
+   CosMgrBusStatistic(&tsStatT, 0, 0);
+   TEST_CHECK_EQ(tsStatT.uwFrameRate, 200);
+   TEST_CHECK_EQ(tsStatT.ubBusLoad, 21);
+   TEST_CHECK_EQ(tsStatT.ulRcvCount, 300);
+   TEST_CHECK_EQ(tsStatT.uwJitterMax, 0);
+
+   CosMgrBusStatistic(&tsStatT, TEST_APP_BUFFER, 0);
+   TEST_CHECK_EQ(tsStatT.ulRcvCount, 0);
+
+   //----------------------------------------------------------------
+   // no frame for more than two windows: the values are 0
+   //
+   McTmrHResAdvance(2000000);
+   CosMgrBusStatistic(&tsStatT, 0, 0);
+   TEST_CHECK_EQ(tsStatT.uwFrameRate, 0);
+   TEST_CHECK_EQ(tsStatT.ubBusLoad, 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// main()                                                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+int main(void)
+{
+   McTmrInit();
+   TEST_CHECK_EQ(McTmrHResInit(eTMR_HRES_TICK_1us), eTMR_ERR_OK);
+   McTmrHResStart();
+
+   TestBusJitter();
+   TestBusShared();
+   TestBusLoad();
+
+   return(TEST_RESULT("test_cos_bus"));
+}
@@ -0,0 +1,176 @@
+//****************************************************************************//
+// File:          test_cos_emcy.c                                             //
+// Description:   Test of the EMCY transmit queue                             //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include "SI_C8051F550_Register_Enums.h"
+#include "can_model.h"
+#include "cos_mgr.h"
+#include "cos_emcy.h"
+#include "cos301.h"
+#include "cos_stub.h"
+#include "mc_tmr.h"
+#include "test_check.h"
+
+#if (COS_DICT_OBJ_1014 < 4) || (COS_EMCY_STAT == 0)
+#error  The test requires COS_DICT_OBJ_1014 >= 4 and COS_EMCY_STAT = 1
+#endif
+
+
+/*----------------------------------------------------------------------------*\
+** Variables of module                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+TEST_CHECK_DATA;
+
+CpPort_ts            tsCanPortG;
+
+
+/*----------------------------------------------------------------------------*\
+** Functions                                                                  **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//----------------------------------------------------------------------------//
+// functions of modules which are not linked to this test                     //
+//----------------------------------------------------------------------------//
+uint8_t  ubIdx1001_ErrorRegisterG;
+
+uint32_t McTmrTick(void)                        { return(0);                }
+uint8_t  CosMgrIdCheck(uint32_t ulIdV)          { return(1);                }
+void     Cos301_ClearVerifyConfiguration(void)  { }
+
+
+//----------------------------------------------------------------------------//
+// TestInit()                                                                 //
+// start the controller and the EMCY service of node 1                        //
+//----------------------------------------------------------------------------//
+static void TestInit(void)
+{
+   CanModelReset();
+   CpCoreDriverInit(CP_CHANNEL_1, &tsCanPortG);
+   CpCoreBaudrate(&tsCanPortG, CP_BAUD_125K);
+   CpCoreCanMode(&tsCanPortG, CP_MODE_START);
+
+   ulCosEmcyIdentifierG = 0x81;
+   CosEmcyInit();
+}
+
+
+//----------------------------------------------------------------------------//
+// TestSend()                                                                 //
+// queue an EMCY message, the CAN interrupt must be unlocked afterwards       //
+//----------------------------------------------------------------------------//
+static void TestSend(uint16_t uwCodeV)
+{
+   CosEmcySend(uwCodeV, 0L);
+   TEST_CHECK(EIE2 & 0x02);
+}
+
+
+//----------------------------------------------------------------------------//
+// TestTransmit()                                                             //
+// run the EMCY timer once and confirm the transmission                       //
+//----------------------------------------------------------------------------//
+static uint16_t TestTransmit(void)
+{
+   CanModelFrame_ts *   ptsFrameT;
+   uint8_t              ubCountT;
+
+   ubCountT = CanModelTrmCount();
+   CosEmcyTmrEvent();
+   TEST_CHECK(EIE2 & 0x02);
+   if(CanModelTrmCount() == ubCountT) return(0xFFFF);
+
+   CosEmcyTrmEvent();
+   ptsFrameT = CanModelTrmFrame(ubCountT);
+   TEST_CHECK_EQ(ptsFrameT->ulIdentifier, 0x81);
+   return((uint16_t) (ptsFrameT->aubData[1] << 8) | ptsFrameT->aubData[0]);
+}
+
+
+//----------------------------------------------------------------------------//
+// TestEmcyOrder()                                                            //
+// the queue sends by priority, no error passes an error reset               //
+//----------------------------------------------------------------------------//
+static void TestEmcyOrder(void)
+{
+   TestInit();
+
+   TestSend(EMCY_ERR_CAN_OVERRUN);
+   TestSend(0x9000);
+   TestSend(0x1000);
+   TestSend(EMCY_ERR_NONE);
+
+   TEST_CHECK_EQ(TestTransmit(), 0x1000);
+   TEST_CHECK_EQ(TestTransmit(), 0x9000);
+   TEST_CHECK_EQ(TestTransmit(), EMCY_ERR_CAN_OVERRUN);
+
+   TestSend(0x1000);
+   TEST_CHECK_EQ(TestTransmit(), EMCY_ERR_NONE);
+   TEST_CHECK_EQ(TestTransmit(), 0x1000);
+   TEST_CHECK_EQ(TestTransmit(), 0xFFFF);
+}
+
+
+//----------------------------------------------------------------------------//
+// TestEmcyStatistic()                                                        //
+// a full queue drops the new message with the lowest priority                //
+//----------------------------------------------------------------------------//
+static void TestEmcyStatistic(void)
+{
+   uint8_t  ubCntT;
+
+   TestInit();
+
+   for(ubCntT = 0; ubCntT <= COS_DICT_OBJ_1014; ubCntT++)
+   {
+      TestSend(EMCY_ERR_CAN_OVERRUN);
+   }
+
+   TEST_CHECK_EQ(CosEmcyStatistic(1, eSDO_READ_REQ), eCosSdo_READ4_OK);
+   TEST_CHECK_EQ(ulStubSdoValueG, 1);
+   TEST_CHECK_EQ(CosEmcyStatistic(3, eSDO_READ_REQ), eCosSdo_READ1_OK);
+   TEST_CHECK_EQ(ulStubSdoValueG, COS_DICT_OBJ_1014);
+
+   //----------------------------------------------------------------
+   // a reset keeps the current queue level
+   //
+   TEST_CHECK_EQ(TestTransmit(), EMCY_ERR_CAN_OVERRUN);
+   ulStubSdoValueG = 0;
+   TEST_CHECK_EQ(CosEmcyStatistic(0, eSDO_WRITE_REQ_1), eCosSdo_WRITE_OK);
+   TEST_CHECK(EIE2 & 0x02);
+   TEST_CHECK_EQ(CosEmcyStatistic(1, eSDO_READ_REQ), eCosSdo_READ4_OK);
+   TEST_CHECK_EQ(ulStubSdoValueG, 0);
+   TEST_CHECK_EQ(CosEmcyStatistic(3, eSDO_READ_REQ), eCosSdo_READ1_OK);
+   TEST_CHECK_EQ(ulStubSdoValueG, COS_DICT_OBJ_1014 - 1);
+}
+
+
+//----------------------------------------------------------------------------//
+// main()                                                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+int main(void)
+{
+   TestEmcyOrder();
+   TestEmcyStatistic();
+
+   return(TEST_RESULT("test_cos_emcy"));
+}
@@ -0,0 +1,321 @@
+//****************************************************************************//
+// File:          test_cos_fifo.c                                             //
+// Description:   Test of the receive FIFO between CAN0_IRQ and CosMgr        //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include "SI_C8051F550_Register_Enums.h"
+#include "can_model.h"
+#include "cos_mgr.h"
+#include "cos_emcy.h"
+#include "cos_led.h"
+#include "cos301.h"
+#include "cos_stub.h"
+#include "mc_tmr.h"
+#include "test_check.h"
+
+#if (COS_MGR_FIFO == 0) || (CP_FIFO_RCV_SIZE != 8)
+#error  The test requires COS_MGR_FIFO = 1 and CP_FIFO_RCV_SIZE = 8
+#endif
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \file    test_cos_fifo.c
+** \brief   SDO requests through the receive FIFO
+**
+** The SDO requests are put into the receive FIFO of the C8051F550
+** driver by CAN0_IRQ() and processed by CosMgrProcess(). The SDO
+** request handler of the test reads the request with
+** CpCoreBufferGetData(), as the SDO server does. The test checks that
+** one call of CosMgrProcess() drains the FIFO in the order of
+** reception, that CpCoreBufferGetData() returns the message object
+** after the pass and that a lost message is reported.
+*/
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#define  TEST_NODE_ID         0x20
+
+#define  TEST_REQUEST_MAX     32
+
+
+/*----------------------------------------------------------------------------*\
+** Variables of module                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+TEST_CHECK_DATA;
+
+void CAN0_IRQ(void);
+
+static uint8_t       aubRequestS[TEST_REQUEST_MAX];   // first data byte
+static uint8_t       ubRequestCountS;                 // handled requests
+static uint8_t       ubDlcErrorS;                     // DLC not read
+static uint8_t       ubInjectS;                       // request to inject
+static uint8_t       ubEmcyOverrunS;                  // EMCY for overrun
+
+
+/*----------------------------------------------------------------------------*\
+** Functions                                                                  **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+static void TestRequest(uint8_t ubValueV);
+
+//----------------------------------------------------------------------------//
+// functions of modules which are not linked to this test                     //
+//----------------------------------------------------------------------------//
+uint8_t  ubIdx1001_ErrorRegisterG;
+
+uint32_t McTmrTick(void)                        { return(0);                }
+void     Cos301_ParmInit(void)                  { }
+void     CosMgrOnBusOff(void)                   { }
+void     CosEmcyInit(void)                      { }
+void     CosLedInit(void)                       { }
+void     CosLedNetworkError(uint8_t ubErrorV)   { }
+void     CosLedNetworkStatus(uint8_t ubStatusV) { }
+void     CosDictInit(void)                      { }
+void     CosSdoInit(uint8_t ubNodeIdV)          { }
+
+
+//----------------------------------------------------------------------------//
+// CosEmcySend()                                                              //
+// count the messages lost in the FIFO                                        //
+//----------------------------------------------------------------------------//
+void CosEmcySend(uint16_t uwCodeV, uint8_t * pubV)
+{
+   if(uwCodeV == EMCY_ERR_CAN_OVERRUN) ubEmcyOverrunS++;
+}
+
+
+//----------------------------------------------------------------------------//
+// CosSdoMessageHandler()                                                     //
+// read the request as the SDO server does                                    //
+//----------------------------------------------------------------------------//
+void CosSdoMessageHandler(void)
+{
+   uint8_t  aubDataT[8];
+   uint8_t  ubDlcT = 0;
+
+   CpCoreBufferGetData(&tsCanPortG, eCosBuf_SDO_RCV, &aubDataT[0]);
+   CpCoreBufferGetDlc(&tsCanPortG, eCosBuf_SDO_RCV, &ubDlcT);
+   if(ubDlcT != 8) ubDlcErrorS++;
+
+   if(ubRequestCountS < TEST_REQUEST_MAX)
+   {
+      aubRequestS[ubRequestCountS] = aubDataT[0];
+   }
+   ubRequestCountS++;
+
+   //----------------------------------------------------------------
+   // a request received by the CAN interrupt during the pass
+   //
+   if(ubInjectS > 0)
+   {
+      TestRequest(ubInjectS);
+      ubInjectS = 0;
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// TestRequest()                                                              //
+// receive an SDO request and run the CAN interrupt handler                   //
+//----------------------------------------------------------------------------//
+static void TestRequest(uint8_t ubValueV)
+{
+   uint8_t  aubDataT[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+
+   aubDataT[0] = ubValueV;
+   TEST_CHECK_EQ(CanModelReceive(0x600 + TEST_NODE_ID, 0, 8, &aubDataT[0]),
+                 eCosBuf_SDO_RCV);
+   while(CanModelIrqPending())
+   {
+      CAN0_IRQ();
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// TestStart()                                                                //
+// initialise driver and model, SDO receive buffer                            //
+//----------------------------------------------------------------------------//
+static void TestStart(void)
+{
+   CpCanMsg_ts    tsMsgT;
+
+   CanModelReset();
+   CpCoreDriverInit(CP_CHANNEL_1, &tsCanPortG);
+   CpCoreIntFunctions(CP_CHANNEL_1, CosMgrCanRcvHandler,
+                      CosMgrCanTrmHandler, CosMgrCanErrHandler);
+   CpCoreBaudrate(&tsCanPortG, CP_BAUD_125K);
+   CpCoreCanMode(&tsCanPortG, CP_MODE_START);
+
+   CpMsgClear(&tsMsgT);
+   CpMsgSetStdId(&tsMsgT, 0x600 + TEST_NODE_ID);
+   CpMsgSetDlc(&tsMsgT, 8);
+   CpCoreBufferInit(&tsCanPortG, &tsMsgT, eCosBuf_SDO_RCV, CP_BUFFER_DIR_RX);
+
+   ubRequestCountS = 0;
+   ubDlcErrorS     = 0;
+   ubInjectS       = 0;
+   ubEmcyOverrunS  = 0;
+}
+
+
+//----------------------------------------------------------------------------//
+// TestFifoDrain()                                                            //
+// one call of CosMgrProcess() processes all requests in order                //
+//----------------------------------------------------------------------------//
+static void TestFifoDrain(void)
+{
+   uint8_t  aubDataT[8];
+   uint8_t  ubCntT;
+
+   TestStart();
+
+   for(ubCntT = 1; ubCntT <= 6; ubCntT++)
+   {
+      TestRequest(ubCntT);
+   }
+
+   //----------------------------------------------------------------
+   // nothing is processed by the CAN interrupt
+   //
+   TEST_CHECK_EQ(ubRequestCountS, 0);
+
+   CosMgrProcess();
+   TEST_CHECK_EQ(ubRequestCountS, 6);
+   TEST_CHECK_EQ(ubDlcErrorS, 0);
+   for(ubCntT = 0; ubCntT < 6; ubCntT++)
+   {
+      TEST_CHECK_EQ(aubRequestS[ubCntT], ubCntT + 1);
+   }
+
+   //----------------------------------------------------------------
+   // after the pass the data is read from the message object and
+   // not from the copy of the last request
+   //
+   aubDataT[0] = 0x77;
+   CanModelReceive(0x600 + TEST_NODE_ID, 0, 8, &aubDataT[0]);
+   aubDataT[0] = 0;
+   TEST_CHECK_EQ(CpCoreBufferGetData(&tsCanPortG, eCosBuf_SDO_RCV,
+                                     &aubDataT[0]), CpErr_OK);
+   TEST_CHECK_EQ(aubDataT[0], 0x77);
+
+   //----------------------------------------------------------------
+   // the request is processed by the next call
+   //
+   while(CanModelIrqPending())
+   {
+      CAN0_IRQ();
+   }
+   CosMgrProcess();
+   TEST_CHECK_EQ(ubRequestCountS, 7);
+   TEST_CHECK_EQ(aubRequestS[6], 0x77);
+}
+
+
+//----------------------------------------------------------------------------//
+// TestFifoRefill()                                                           //
+// a request received during the pass waits for the next call                 //
+//----------------------------------------------------------------------------//
+static void TestFifoRefill(void)
+{
+   uint8_t  aubDataT[8];
+   uint8_t  ubCntT;
+
+   TestStart();
+
+   for(ubCntT = 1; ubCntT <= CP_FIFO_RCV_SIZE; ubCntT++)
+   {
+      TestRequest(ubCntT);
+   }
+
+   //----------------------------------------------------------------
+   // the first request of the pass frees a slot, the CAN interrupt
+   // puts request 9 into it
+   //
+   ubInjectS = CP_FIFO_RCV_SIZE + 1;
+   CosMgrProcess();
+   TEST_CHECK_EQ(ubRequestCountS, CP_FIFO_RCV_SIZE);
+   TEST_CHECK_EQ(aubRequestS[CP_FIFO_RCV_SIZE - 1], CP_FIFO_RCV_SIZE);
+
+   //----------------------------------------------------------------
+   // the copy of request 8 has been released, the message object
+   // holds request 9
+   //
+   aubDataT[0] = 0;
+   CpCoreBufferGetData(&tsCanPortG, eCosBuf_SDO_RCV, &aubDataT[0]);
+   TEST_CHECK_EQ(aubDataT[0], CP_FIFO_RCV_SIZE + 1);
+
+   CosMgrProcess();
+   TEST_CHECK_EQ(ubRequestCountS, CP_FIFO_RCV_SIZE + 1);
+   TEST_CHECK_EQ(aubRequestS[CP_FIFO_RCV_SIZE], CP_FIFO_RCV_SIZE + 1);
+   TEST_CHECK_EQ(ubDlcErrorS, 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// TestFifoOverrun()                                                          //
+// a full FIFO drops requests, the next request reports the overrun           //
+//----------------------------------------------------------------------------//
+static void TestFifoOverrun(void)
+{
+   CpStatistic_ts tsStatT;
+   uint8_t        ubCntT;
+
+   TestStart();
+
+   for(ubCntT = 1; ubCntT <= CP_FIFO_RCV_SIZE + 2; ubCntT++)
+   {
+      TestRequest(ubCntT);
+   }
+
+   CpCoreStatistic(&tsCanPortG, &tsStatT);
+   TEST_CHECK_EQ(tsStatT.ulFifoOverrunCount, 2);
+   TEST_CHECK_EQ(tsStatT.ulFifoLevelMax, CP_FIFO_RCV_SIZE);
+
+   CosMgrProcess();
+   TEST_CHECK_EQ(ubRequestCountS, CP_FIFO_RCV_SIZE);
+   TEST_CHECK_EQ(ubEmcyOverrunS, 0);
+
+   TestRequest(0x55);
+   CosMgrProcess();
+   TEST_CHECK_EQ(ubRequestCountS, CP_FIFO_RCV_SIZE + 1);
+   TEST_CHECK_EQ(aubRequestS[CP_FIFO_RCV_SIZE], 0x55);
+   TEST_CHECK_EQ(ubEmcyOverrunS, 1);
+}
+
+
+//----------------------------------------------------------------------------//
+// main()                                                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+int main(void)
+{
+   TestFifoDrain();
+   TestFifoRefill();
+   TestFifoOverrun();
+
+   return(TEST_RESULT("test_cos_fifo"));
+}
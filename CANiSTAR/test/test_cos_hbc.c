@@ -0,0 +1,181 @@
+//****************************************************************************//
+// File:          test_cos_hbc.c                                              //
+// Description:   Test of the shared heartbeat consumer buffer                //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include "can_model.h"
+#include "cos_mgr.h"
+#include "cos_emcy.h"
+#include "cos_led.h"
+#include "cos301.h"
+#include "cos_stub.h"
+#include "mc_tmr.h"
+#include "test_check.h"
+
+#if (COS_DICT_OBJ_1016 < 3) || (COS_NMT_HBC_MERGE == 0)
+#error  The test requires COS_DICT_OBJ_1016 >= 3 and COS_NMT_HBC_MERGE = 1
+#endif
+
+
+/*----------------------------------------------------------------------------*\
+** Variables of module                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+TEST_CHECK_DATA;
+
+void CAN0_IRQ(void);
+
+
+/*----------------------------------------------------------------------------*\
+** Functions                                                                  **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//----------------------------------------------------------------------------//
+// functions of modules which are not linked to this test                     //
+//----------------------------------------------------------------------------//
+uint8_t  ubIdx1001_ErrorRegisterG;
+
+uint32_t McTmrTick(void)                        { return(0);                }
+void     Cos301_ParmInit(void)                  { }
+void     CosMgrOnBusOff(void)                   { }
+void     CosEmcyInit(void)                      { }
+void     CosEmcySend(uint16_t uwCodeV, uint8_t * pubV) { }
+void     CosLedInit(void)                       { }
+void     CosLedNetworkError(uint8_t ubErrorV)   { }
+void     CosLedNetworkStatus(uint8_t ubStatusV) { }
+void     CosDictInit(void)                      { }
+void     CosSdoInit(uint8_t ubNodeIdV)          { }
+void     CosSdoMessageHandler(void)             { }
+
+
+//----------------------------------------------------------------------------//
+// TestHeartbeat()                                                            //
+// send a heartbeat message and run the CAN interrupt handler                 //
+//----------------------------------------------------------------------------//
+static uint8_t TestHeartbeat(uint8_t ubNodeV)
+{
+   uint8_t  ubStateT = 0x05;
+   uint8_t  ubBufferT;
+
+   ubBufferT = CanModelReceive(0x700 + ubNodeV, 0, 1, &ubStateT);
+   while(CanModelIrqPending())
+   {
+      CAN0_IRQ();
+   }
+   return(ubBufferT);
+}
+
+
+//----------------------------------------------------------------------------//
+// TestHbcNode()                                                              //
+// the node-ID of the received message selects the consumer entry             //
+//----------------------------------------------------------------------------//
+static void TestHbcNode(void)
+{
+   CanModelReset();
+   CpCoreDriverInit(CP_CHANNEL_1, &tsCanPortG);
+   CpCoreIntFunctions(CP_CHANNEL_1, CosMgrCanRcvHandler,
+                      CosMgrCanTrmHandler, CosMgrCanErrHandler);
+   CpCoreBaudrate(&tsCanPortG, CP_BAUD_125K);
+   CpCoreCanMode(&tsCanPortG, CP_MODE_START);
+
+   //----------------------------------------------------------------
+   // consumers for node 5, 7 and 13: the acceptance mask ignores
+   // the bits 1 and 3 of the node-ID
+   //
+   CosNmtSetHeartbeatCons(0,  5, 1000);
+   CosNmtSetHeartbeatCons(1,  7, 1000);
+   CosNmtSetHeartbeatCons(2, 13, 1000);
+   CosMgrHbcFilter();
+
+   TEST_CHECK_EQ(TestHeartbeat(7), eCosBuf_NMT_HBC);
+   TEST_CHECK_EQ(auwStubHbConsCountG[0], 0);
+   TEST_CHECK_EQ(auwStubHbConsCountG[1], 1);
+   TEST_CHECK_EQ(auwStubHbConsCountG[2], 0);
+
+   TEST_CHECK_EQ(TestHeartbeat(13), eCosBuf_NMT_HBC);
+   TEST_CHECK_EQ(TestHeartbeat(5), eCosBuf_NMT_HBC);
+   TEST_CHECK_EQ(TestHeartbeat(5), eCosBuf_NMT_HBC);
+   TEST_CHECK_EQ(auwStubHbConsCountG[0], 2);
+   TEST_CHECK_EQ(auwStubHbConsCountG[1], 1);
+   TEST_CHECK_EQ(auwStubHbConsCountG[2], 1);
+
+   //----------------------------------------------------------------
+   // node 15 passes the mask but is not monitored, node 6 is
+   // rejected by the hardware
+   //
+   TEST_CHECK_EQ(TestHeartbeat(15), eCosBuf_NMT_HBC);
+   TEST_CHECK_EQ(TestHeartbeat(6), 0);
+   TEST_CHECK_EQ(auwStubHbConsCountG[0], 2);
+   TEST_CHECK_EQ(auwStubHbConsCountG[1], 1);
+   TEST_CHECK_EQ(auwStubHbConsCountG[2], 1);
+}
+
+
+//----------------------------------------------------------------------------//
+// TestHbcChange()                                                            //
+// a new setup of index 1016h rebuilds the assignment of the node-IDs         //
+//----------------------------------------------------------------------------//
+static void TestHbcChange(void)
+{
+   uint8_t  ubEntryT;
+
+   for(ubEntryT = 0; ubEntryT < 3; ubEntryT++)
+   {
+      auwStubHbConsCountG[ubEntryT] = 0;
+   }
+
+   //----------------------------------------------------------------
+   // entry 1 is switched off, node 7 moves to entry 2, node 13
+   // is not monitored any more and rejected by the new mask
+   //
+   CosNmtSetHeartbeatCons(1,  7,    0);
+   CosNmtSetHeartbeatCons(2,  7, 1000);
+   CosMgrHbcFilter();
+
+   TEST_CHECK_EQ(TestHeartbeat(7), eCosBuf_NMT_HBC);
+   TEST_CHECK_EQ(TestHeartbeat(13), 0);
+   TEST_CHECK_EQ(TestHeartbeat(5), eCosBuf_NMT_HBC);
+   TEST_CHECK_EQ(auwStubHbConsCountG[0], 1);
+   TEST_CHECK_EQ(auwStubHbConsCountG[1], 0);
+   TEST_CHECK_EQ(auwStubHbConsCountG[2], 1);
+
+   //----------------------------------------------------------------
+   // a node-ID entered twice is served by the first entry
+   //
+   CosNmtSetHeartbeatCons(1,  5, 1000);
+   CosMgrHbcFilter();
+   TEST_CHECK_EQ(TestHeartbeat(5), eCosBuf_NMT_HBC);
+   TEST_CHECK_EQ(auwStubHbConsCountG[0], 2);
+   TEST_CHECK_EQ(auwStubHbConsCountG[1], 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// main()                                                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+int main(void)
+{
+   TestHbcNode();
+   TestHbcChange();
+
+   return(TEST_RESULT("test_cos_hbc"));
+}
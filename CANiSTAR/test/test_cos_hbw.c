@@ -0,0 +1,218 @@
+//****************************************************************************//
+// File:          test_cos_hbw.c                                              //
+// Description:   Test of the heartbeat consumer timing wheel                 //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <stdlib.h>
+
+#include "SI_C8051F550_Register_Enums.h"
+#include "can_model.h"
+#include "cos_hbw.h"
+#include "cos_mgr.h"
+#include "mc_tmr.h"
+#include "test_check.h"
+
+#if (COS_DICT_OBJ_1016 < 16) || (COS_NMT_HBC_WHEEL == 0)
+#error  The test requires COS_DICT_OBJ_1016 >= 16 and COS_NMT_HBC_WHEEL > 0
+#endif
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#define  TEST_ENTRY_MAX       16
+
+#define  TEST_TICK_MAX        200000L
+
+
+/*----------------------------------------------------------------------------*\
+** Variables of module                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+TEST_CHECK_DATA;
+
+CpPort_ts            tsCanPortG;
+
+static int32_t       slTickS;                         // current tick
+static int32_t       aslExpiryS[TEST_ENTRY_MAX];      // -1: stopped
+static uint32_t      ulTimeoutCountS;
+
+//-------------------------------------------------------------------
+// entry which is restarted by a heartbeat while CosNmtHBConsTimeout()
+// runs, -1 for none
+//
+static int8_t        sbRestartS = -1;
+
+
+/*----------------------------------------------------------------------------*\
+** Functions                                                                  **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+uint32_t McTmrTick(void)                        { return(0);                }
+
+
+//----------------------------------------------------------------------------//
+// CosNmtHBConsTimeout()                                                      //
+// the consumer time must expire exactly at the expected tick                 //
+//----------------------------------------------------------------------------//
+void CosNmtHBConsTimeout(uint8_t ubEntryV)
+{
+   TEST_CHECK(EIE2 & 0x02);
+   TEST_CHECK_EQ(slTickS, aslExpiryS[ubEntryV]);
+   aslExpiryS[ubEntryV] = -1;
+   ulTimeoutCountS++;
+
+   //----------------------------------------------------------------
+   // a heartbeat of another expired consumer arrives
+   //
+   if(sbRestartS >= 0)
+   {
+      CosHbwStart((uint8_t) sbRestartS, 10);
+      aslExpiryS[sbRestartS] = slTickS + 10;
+      sbRestartS = -1;
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// TestInit()                                                                 //
+//                                                                            //
+//----------------------------------------------------------------------------//
+static void TestInit(void)
+{
+   uint8_t  ubEntryT;
+
+   CanModelReset();
+   CpCoreDriverInit(CP_CHANNEL_1, &tsCanPortG);
+   CpCoreCanMode(&tsCanPortG, CP_MODE_START);
+
+   CosHbwInit();
+   for(ubEntryT = 0; ubEntryT < TEST_ENTRY_MAX; ubEntryT++)
+   {
+      aslExpiryS[ubEntryT] = -1;
+   }
+   slTickS = 0;
+   ulTimeoutCountS = 0;
+}
+
+
+//----------------------------------------------------------------------------//
+// TestTick()                                                                 //
+// move the wheel, no consumer time may be overdue afterwards                 //
+//----------------------------------------------------------------------------//
+static void TestTick(void)
+{
+   uint8_t  ubEntryT;
+
+   slTickS++;
+   CosHbwTmrEvent();
+   TEST_CHECK(EIE2 & 0x02);
+
+   for(ubEntryT = 0; ubEntryT < TEST_ENTRY_MAX; ubEntryT++)
+   {
+      if( (aslExpiryS[ubEntryT] >= 0) && (aslExpiryS[ubEntryT] <= slTickS) )
+      {
+         TEST_CHECK_EQ(aslExpiryS[ubEntryT], -1);
+         aslExpiryS[ubEntryT] = -1;
+      }
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// TestHbwRandom()                                                            //
+// random starts, restarts and stops, also beyond one turn of the wheel       //
+//----------------------------------------------------------------------------//
+static void TestHbwRandom(void)
+{
+   uint8_t  ubEntryT;
+   uint16_t uwTicksT;
+
+   TestInit();
+   srand(1);
+
+   while(slTickS < TEST_TICK_MAX)
+   {
+      for(ubEntryT = 0; ubEntryT < TEST_ENTRY_MAX; ubEntryT++)
+      {
+         if((rand() % 50) == 0)
+         {
+            uwTicksT = (uint16_t) (rand() % 300);
+            CosHbwStart(ubEntryT, uwTicksT);
+            aslExpiryS[ubEntryT] = uwTicksT ? slTickS + uwTicksT : -1;
+         }
+      }
+
+      if((rand() % 97) == 0)
+      {
+         ubEntryT = (uint8_t) (rand() % TEST_ENTRY_MAX);
+         CosHbwStop(ubEntryT);
+         aslExpiryS[ubEntryT] = -1;
+      }
+
+      TestTick();
+   }
+
+   TEST_CHECK(ulTimeoutCountS > 1000);
+}
+
+
+//----------------------------------------------------------------------------//
+// TestHbwRestart()                                                           //
+// a heartbeat during the timeout report removes an expired consumer          //
+//----------------------------------------------------------------------------//
+static void TestHbwRestart(void)
+{
+   TestInit();
+
+   //----------------------------------------------------------------
+   // entry 3 and 4 expire in the same tick, entry 3 is reported
+   // first and entry 4 receives a heartbeat in the meantime
+   //
+   CosHbwStart(3, 5);
+   CosHbwStart(4, 5);
+   aslExpiryS[3] = 5;
+   aslExpiryS[4] = 5;
+   sbRestartS = 4;
+
+   while(slTickS < 5) TestTick();
+   TEST_CHECK_EQ(ulTimeoutCountS, 1);
+   TEST_CHECK_EQ(aslExpiryS[3], -1);
+   TEST_CHECK_EQ(aslExpiryS[4], 15);
+
+   while(slTickS < 15) TestTick();
+   TEST_CHECK_EQ(ulTimeoutCountS, 2);
+   TEST_CHECK_EQ(aslExpiryS[4], -1);
+}
+
+
+//----------------------------------------------------------------------------//
+// main()                                                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+int main(void)
+{
+   TestHbwRandom();
+   TestHbwRestart();
+
+   return(TEST_RESULT("test_cos_hbw"));
+}
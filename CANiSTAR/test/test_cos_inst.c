@@ -0,0 +1,316 @@
+//****************************************************************************//
+// File:          test_cos_inst.c                                             //
+// Description:   Two instances of CosMgr on the virtual CAN bus              //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include "cos_inst.h"
+#include "cos_mgr.h"
+#include "cos_emcy.h"
+#include "cos_led.h"
+#include "cos301.h"
+#include "cos_stub.h"
+#include "linux_can.h"
+#include "test_check.h"
+
+#if COS_INSTANCE_MAX != 2
+#error  The test requires COS_INSTANCE_MAX = 2
+#endif
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \file    test_cos_inst.c
+** \brief   Two CANopen slaves in one program
+**
+** Both instances of the stack are started by CosMgrInit() and
+** CosMgrStart() with their own node-ID and their own CAN port on the
+** virtual bus of linux_can.c. The test checks that CosInstSelect()
+** points to the data set of the instance and copies nothing: an address
+** taken from a global variable of the stack stays valid for its
+** instance after the selection of the other one.
+** <p>
+** The test plays the SDO client: the SDO server of the test answers
+** with the node-ID and the error register of the selected instance, the
+** request to a node-ID must be answered by its instance only.
+*/
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#define  SIM_BUS              8           // physical interface of the bus
+
+#define  SIM_NODE_ID          0x21        // node-ID of instance 0
+
+#define  SIM_BUF_TRM          CP_BUFFER_1
+#define  SIM_BUF_RCV          CP_BUFFER_2
+
+
+/*----------------------------------------------------------------------------*\
+** Variables of module                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+TEST_CHECK_DATA;
+
+static CpPort_ts     tsMasterS;
+
+static uint8_t       aubRspDataS[8];
+static uint8_t       ubRspCountS;
+static uint8_t       aubSdoCountS[COS_INSTANCE_MAX];
+
+
+/*----------------------------------------------------------------------------*\
+** Functions                                                                  **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//----------------------------------------------------------------------------//
+// functions of modules which are not linked to this test                     //
+//----------------------------------------------------------------------------//
+void     Cos301_ParmInit(void)                  { }
+void     CosMgrOnBusOff(void)                   { }
+void     CosEmcyInit(void)                      { }
+void     CosEmcySend(uint16_t uwCodeV, uint8_t * pubV) { }
+void     CosLedInit(void)                       { }
+void     CosLedNetworkError(uint8_t ubErrorV)   { }
+void     CosLedNetworkStatus(uint8_t ubStatusV) { }
+void     CosDictInit(void)                      { }
+
+
+//----------------------------------------------------------------------------//
+// CosSdoInit()                                                               //
+// SDO buffers on the CAN port of the selected instance                       //
+//----------------------------------------------------------------------------//
+void CosSdoInit(uint8_t ubNodeIdV)
+{
+   CpCanMsg_ts    tsMsgT;
+
+   CpMsgClear(&tsMsgT);
+   CpMsgSetDlc(&tsMsgT, 8);
+   CpMsgSetStdId(&tsMsgT, 0x600 + ubNodeIdV);
+   CpCoreBufferInit(&tsCanPortG, &tsMsgT, eCosBuf_SDO_RCV, CP_BUFFER_DIR_RX);
+   CpMsgSetStdId(&tsMsgT, 0x580 + ubNodeIdV);
+   CpCoreBufferInit(&tsCanPortG, &tsMsgT, eCosBuf_SDO_TRM, CP_BUFFER_DIR_TX);
+}
+
+
+//----------------------------------------------------------------------------//
+// CosSdoMessageHandler()                                                     //
+// answer with the data of the selected instance                              //
+//----------------------------------------------------------------------------//
+void CosSdoMessageHandler(void)
+{
+   uint8_t  aubDataT[8];
+
+   CpCoreBufferGetData(&tsCanPortG, eCosBuf_SDO_RCV, &aubDataT[0]);
+   aubDataT[1] = CosInstSelected();
+   aubDataT[2] = ubCosMgrNodeAddressG;
+   aubDataT[3] = ubIdx1001_ErrorRegisterG;
+   aubSdoCountS[CosInstSelected()]++;
+
+   CpCoreBufferSetData(&tsCanPortG, eCosBuf_SDO_TRM, &aubDataT[0]);
+   CpCoreBufferSend(&tsCanPortG, eCosBuf_SDO_TRM);
+}
+
+
+//----------------------------------------------------------------------------//
+// SimMasterRcv()                                                             //
+// receive callback of the SDO client                                         //
+//----------------------------------------------------------------------------//
+static uint8_t SimMasterRcv(CpCanMsg_ts * ptsCanMsgV, uint8_t ubBufferIdxV)
+{
+   uint8_t  ubCntT;
+
+   if(ubBufferIdxV == SIM_BUF_RCV)
+   {
+      for(ubCntT = 0; ubCntT < 8; ubCntT++)
+      {
+         aubRspDataS[ubCntT] = CpMsgGetData(ptsCanMsgV, ubCntT);
+      }
+      ubRspCountS++;
+   }
+   return(CP_CALLBACK_PROCESSED);
+}
+
+
+//----------------------------------------------------------------------------//
+// SimInit()                                                                  //
+// attach the SDO client and both instances to the bus                        //
+//----------------------------------------------------------------------------//
+static void SimInit(void)
+{
+   CpCanMsg_ts tsMsgT;
+   uint8_t     ubInstT;
+
+   CpVBusUnlink(SIM_BUS);
+
+   CpCoreDriverInit(SIM_BUS, &tsMasterS);
+   CpCoreIntFunctions(&tsMasterS, SimMasterRcv, 0L, 0L);
+   CpCoreBaudrate(&tsMasterS, CP_BAUD_125K);
+   CpCoreCanMode(&tsMasterS, CP_MODE_START);
+
+   for(ubInstT = 0; ubInstT < COS_INSTANCE_MAX; ubInstT++)
+   {
+      TEST_CHECK_EQ(CosInstSelect(ubInstT), eCosErr_OK);
+      CosMgrInit(SIM_BUS, 0);
+      CosMgrStart(CP_BAUD_125K, SIM_NODE_ID + ubInstT);
+      TEST_CHECK_EQ(ubCosMgrStatusG, eCOS_MGR_INIT);
+
+      //--------------------------------------------------------
+      // boot-up message, as CosNmtInit() sends it, the transmit
+      // handler switches the instance to eCOS_MGR_RUN
+      //
+      CpMsgClear(&tsMsgT);
+      CpMsgSetStdId(&tsMsgT, 0x700 + ubCosMgrNodeAddressG);
+      CpMsgSetDlc(&tsMsgT, 1);
+      CpMsgSetData(&tsMsgT, 0, 0);
+      CpCoreBufferInit(&tsCanPortG, &tsMsgT, eCosBuf_NMT_ERR,
+                       CP_BUFFER_DIR_TX);
+      CpCoreBufferSend(&tsCanPortG, eCosBuf_NMT_ERR);
+      CpVBusProcess(&tsCanPortG);
+   }
+   TEST_CHECK_EQ(CosInstSelect(COS_INSTANCE_MAX), eCosErr_VALUE_NODE_ID);
+}
+
+
+//----------------------------------------------------------------------------//
+// SimRequest()                                                               //
+// SDO request to a node, returns the number of responses                     //
+//----------------------------------------------------------------------------//
+static uint8_t SimRequest(uint8_t ubNodeIdV)
+{
+   CpCanMsg_ts tsMsgT;
+   uint8_t     aubDataT[8] = { 0x40, 0x01, 0x10, 0x00, 0, 0, 0, 0 };
+   uint8_t     ubInstT;
+
+   CpMsgClear(&tsMsgT);
+   CpMsgSetDlc(&tsMsgT, 8);
+   CpMsgSetStdId(&tsMsgT, 0x600 + ubNodeIdV);
+   CpCoreBufferInit(&tsMasterS, &tsMsgT, SIM_BUF_TRM, CP_BUFFER_DIR_TX);
+   CpMsgSetStdId(&tsMsgT, 0x580 + ubNodeIdV);
+   CpCoreBufferInit(&tsMasterS, &tsMsgT, SIM_BUF_RCV, CP_BUFFER_DIR_RX);
+
+   ubRspCountS = 0;
+   CpCoreBufferSetData(&tsMasterS, SIM_BUF_TRM, &aubDataT[0]);
+   CpCoreBufferSend(&tsMasterS, SIM_BUF_TRM);
+   CpVBusProcess(&tsMasterS);
+
+   for(ubInstT = 0; ubInstT < COS_INSTANCE_MAX; ubInstT++)
+   {
+      CosInstSelect(ubInstT);
+      CpVBusProcess(&tsCanPortG);
+   }
+   CpVBusProcess(&tsMasterS);
+
+   return(ubRspCountS);
+}
+
+
+//----------------------------------------------------------------------------//
+// TestInstSelect()                                                           //
+// the selection points to the data set, nothing is copied                    //
+//----------------------------------------------------------------------------//
+static void TestInstSelect(void)
+{
+   uint8_t *   pubStatusT;
+   uint8_t *   pubErrRegT;
+
+   SimInit();
+
+   CosInstSelect(0);
+   TEST_CHECK_EQ(CosInstSelected(), 0);
+   TEST_CHECK_EQ(ubCosMgrNodeAddressG, SIM_NODE_ID);
+   TEST_CHECK_EQ(ubCosMgrStatusG, eCOS_MGR_RUN);
+   pubStatusT = &ubCosMgrStatusG;
+   pubErrRegT = &ubIdx1001_ErrorRegisterG;
+   ubIdx1001_ErrorRegisterG = 0x11;
+
+   CosInstSelect(1);
+   TEST_CHECK_EQ(CosInstSelected(), 1);
+   TEST_CHECK_EQ(ubCosMgrNodeAddressG, SIM_NODE_ID + 1);
+   TEST_CHECK(pubStatusT != &ubCosMgrStatusG);
+   ubIdx1001_ErrorRegisterG = 0x81;
+   ubCosMgrStatusG = eCOS_MGR_INIT;
+
+   //----------------------------------------------------------------
+   // the addresses of instance 0 still hold its data
+   //
+   TEST_CHECK_EQ(*pubStatusT, eCOS_MGR_RUN);
+   TEST_CHECK_EQ(*pubErrRegT, 0x11);
+
+   CosInstSelect(0);
+   TEST_CHECK(pubStatusT == &ubCosMgrStatusG);
+   TEST_CHECK_EQ(ubIdx1001_ErrorRegisterG, 0x11);
+
+   CosInstSelect(1);
+   TEST_CHECK_EQ(ubCosMgrStatusG, eCOS_MGR_INIT);
+   TEST_CHECK_EQ(ubIdx1001_ErrorRegisterG, 0x81);
+   ubCosMgrStatusG = eCOS_MGR_RUN;
+}
+
+
+//----------------------------------------------------------------------------//
+// TestInstSdo()                                                              //
+// a request is served by the instance with the node-ID of the request        //
+//----------------------------------------------------------------------------//
+static void TestInstSdo(void)
+{
+   TEST_CHECK_EQ(SimRequest(SIM_NODE_ID + 1), 1);
+   TEST_CHECK_EQ(aubRspDataS[1], 1);
+   TEST_CHECK_EQ(aubRspDataS[2], SIM_NODE_ID + 1);
+   TEST_CHECK_EQ(aubRspDataS[3], 0x81);
+   TEST_CHECK_EQ(aubSdoCountS[0], 0);
+   TEST_CHECK_EQ(aubSdoCountS[1], 1);
+
+   TEST_CHECK_EQ(SimRequest(SIM_NODE_ID), 1);
+   TEST_CHECK_EQ(aubRspDataS[1], 0);
+   TEST_CHECK_EQ(aubRspDataS[2], SIM_NODE_ID);
+   TEST_CHECK_EQ(aubRspDataS[3], 0x11);
+   TEST_CHECK_EQ(aubSdoCountS[0], 1);
+   TEST_CHECK_EQ(aubSdoCountS[1], 1);
+
+   //----------------------------------------------------------------
+   // no instance has this node-ID
+   //
+   TEST_CHECK_EQ(SimRequest(SIM_NODE_ID + 2), 0);
+   TEST_CHECK_EQ(aubSdoCountS[0], 1);
+   TEST_CHECK_EQ(aubSdoCountS[1], 1);
+
+   CosInstSelect(0);
+   CosMgrRelease();
+   CosInstSelect(1);
+   CosMgrRelease();
+   CpCoreDriverRelease(&tsMasterS);
+   CpVBusUnlink(SIM_BUS);
+}
+
+
+//----------------------------------------------------------------------------//
+// main()                                                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+int main(void)
+{
+   TestInstSelect();
+   TestInstSdo();
+
+   return(TEST_RESULT("test_cos_inst"));
+}
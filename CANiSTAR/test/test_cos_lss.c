@@ -0,0 +1,387 @@
+//****************************************************************************//
+// File:          test_cos_lss.c                                              //
+// Description:   LSS Fastscan of 127 slaves on the virtual CAN bus           //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include "cos_inst.h"
+#include "cos_lss.h"
+#include "cos_mgr.h"
+#include "cos_nvm.h"
+#include "cos301.h"
+#include "linux_can.h"
+#include "test_check.h"
+
+#if (COS_LSS_FASTSCAN == 0) || (COS_INSTANCE_MAX < 2)
+#error  The test requires COS_LSS_FASTSCAN = 1 and COS_INSTANCE_MAX > 1
+#endif
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \file    test_cos_lss.c
+** \brief   LSS Fastscan simulator
+**
+** Every instance of the stack (#COS_INSTANCE_MAX) is an unconfigured
+** LSS slave with its own CAN port on the virtual bus of linux_can.c.
+** The slaves differ in the serial number only. The test plays the LSS
+** master: it identifies one slave after the other with Fastscan,
+** assigns the node-ID 1, 2, .. and switches back to waiting state,
+** until no slave answers the reset request any more.
+**
+** The receive callback of a slave passes the LSS request to
+** CosLssMessageHandler(), as CosMgrCanRcvHandler() does for a node
+** in a state other than Operational.
+**
+** Identical answers of several slaves form one frame on a real bus,
+** the scan time is therefore estimated from the number of requests:
+** a request with answer takes two frames, a request without answer
+** one frame plus the response timeout of the master.
+*/
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#define  SIM_BUS              7           // physical interface of the bus
+
+#define  SIM_ID_LSS_MASTER    0x07E5      // request of the LSS master
+#define  SIM_ID_LSS_SLAVE     0x07E4      // response of an LSS slave
+
+#define  SIM_BUF_TRM          CP_BUFFER_1
+#define  SIM_BUF_RCV          CP_BUFFER_2
+
+//-------------------------------------------------------------------
+// time of one frame (111 bit with stuffing) at 125 kbit/s and the
+// response timeout of the master, in microseconds
+//
+#define  SIM_FRAME_US         888
+#define  SIM_TIMEOUT_US       5000
+
+
+/*----------------------------------------------------------------------------*\
+** Variables of module                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+TEST_CHECK_DATA;
+
+uint32_t             ulIdx1018_VendorIdC     = 0x0000029C;
+uint32_t             ulIdx1018_ProductCodeC  = 0x00601171;
+uint32_t             ulIdx1018_RevisionNumC  = 0x00010002;
+
+static CpPort_ts     tsMasterS;
+static uint32_t      aulSerialS[COS_INSTANCE_MAX];
+static uint32_t      ulSeedS = 7;
+
+static uint8_t       aubRspDataS[8];
+static uint16_t      uwRspCountS;
+static uint32_t      ulRequestS;
+static uint32_t      ulTimeoutS;
+
+
+/*----------------------------------------------------------------------------*\
+** Functions                                                                  **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//----------------------------------------------------------------------------//
+// functions of modules which are not linked to this test                     //
+//----------------------------------------------------------------------------//
+Status_tv McNvmRead(NvmAddr_tv tvAddressV, void * pvdDataV, NvmSize_tv tvSizeV)
+{
+   *((uint8_t *) pvdDataV) = 0;
+   return(eNVM_ERR_OK);
+}
+
+Status_tv McNvmWrite(NvmAddr_tv tvAddressV, void * pvdDataV, NvmSize_tv tvSizeV)
+{
+   return(eNVM_ERR_OK);
+}
+
+Status_tv McNvmWriteEnable(void)                { return(eNVM_ERR_OK);      }
+Status_tv McNvmWriteDisable(void)               { return(eNVM_ERR_OK);      }
+uint16_t  McNvmBuildChecksum(NvmAddr_tv tvStartAddressV,
+                             NvmSize_tv tvDataCountV) { return(0);          }
+
+
+//----------------------------------------------------------------------------//
+// CosMgrGetSerialNumber()                                                    //
+// serial number of the selected slave                                        //
+//----------------------------------------------------------------------------//
+uint32_t CosMgrGetSerialNumber(void)
+{
+   return(aulSerialS[CosInstSelected()]);
+}
+
+
+//----------------------------------------------------------------------------//
+// SimRandom()                                                                //
+// seeded random sequence, independent of the C library                       //
+//----------------------------------------------------------------------------//
+static uint32_t SimRandom(void)
+{
+   ulSeedS = ulSeedS * 1103515245UL + 12345UL;
+   return((ulSeedS >> 16) & 0x7FFF);
+}
+
+
+//----------------------------------------------------------------------------//
+// SimSlaveRcv()                                                              //
+// receive callback of a slave                                                //
+//----------------------------------------------------------------------------//
+static uint8_t SimSlaveRcv(CpCanMsg_ts * ptsCanMsgV, uint8_t ubBufferIdxV)
+{
+   if(ubBufferIdxV == eCosBuf_LSS_RCV)
+   {
+      CosLssMessageHandler();
+   }
+   return(CP_CALLBACK_PROCESSED);
+}
+
+
+//----------------------------------------------------------------------------//
+// SimMasterRcv()                                                             //
+// receive callback of the master, counts the responses                       //
+//----------------------------------------------------------------------------//
+static uint8_t SimMasterRcv(CpCanMsg_ts * ptsCanMsgV, uint8_t ubBufferIdxV)
+{
+   uint8_t  ubCntT;
+
+   if(ubBufferIdxV == SIM_BUF_RCV)
+   {
+      for(ubCntT = 0; ubCntT < 8; ubCntT++)
+      {
+         aubRspDataS[ubCntT] = CpMsgGetData(ptsCanMsgV, ubCntT);
+      }
+      uwRspCountS++;
+   }
+   return(CP_CALLBACK_PROCESSED);
+}
+
+
+//----------------------------------------------------------------------------//
+// SimInit()                                                                  //
+// attach the master and all slaves to the bus                                //
+//----------------------------------------------------------------------------//
+static void SimInit(void)
+{
+   CpCanMsg_ts tsCanMsgT;
+   uint8_t     ubNodeT;
+   uint8_t     ubCmpT;
+
+   CpVBusUnlink(SIM_BUS);
+
+   CpCoreDriverInit(SIM_BUS, &tsMasterS);
+   CpCoreIntFunctions(&tsMasterS, SimMasterRcv, 0L, 0L);
+   CpCoreBaudrate(&tsMasterS, CP_BAUD_125K);
+   CpMsgClear(&tsCanMsgT);
+   CpMsgSetStdId(&tsCanMsgT, SIM_ID_LSS_MASTER);
+   CpMsgSetDlc(&tsCanMsgT, 8);
+   CpCoreBufferInit(&tsMasterS, &tsCanMsgT, SIM_BUF_TRM, CP_BUFFER_DIR_TX);
+   CpMsgSetStdId(&tsCanMsgT, SIM_ID_LSS_SLAVE);
+   CpCoreBufferInit(&tsMasterS, &tsCanMsgT, SIM_BUF_RCV, CP_BUFFER_DIR_RX);
+   CpCoreCanMode(&tsMasterS, CP_MODE_START);
+
+   for(ubNodeT = 0; ubNodeT < COS_INSTANCE_MAX; ubNodeT++)
+   {
+      //--------------------------------------------------------
+      // the serial numbers must differ
+      //
+      do
+      {
+         aulSerialS[ubNodeT] = (SimRandom() << 17) ^ (SimRandom() << 2) ^
+                               SimRandom();
+         for(ubCmpT = 0; ubCmpT < ubNodeT; ubCmpT++)
+         {
+            if(aulSerialS[ubCmpT] == aulSerialS[ubNodeT]) break;
+         }
+      } while(ubCmpT < ubNodeT);
+
+      CosInstSelect(ubNodeT);
+      ubCosMgrNodeAddressG = 0xFF;
+      CpCoreDriverInit(SIM_BUS, &tsCanPortG);
+      CpCoreIntFunctions(&tsCanPortG, SimSlaveRcv, 0L, 0L);
+      CpCoreBaudrate(&tsCanPortG, CP_BAUD_125K);
+      CpCoreCanMode(&tsCanPortG, CP_MODE_START);
+      CosLssInit();
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// SimRequest()                                                               //
+// send a request of the master, returns the number of responses              //
+//----------------------------------------------------------------------------//
+static uint16_t SimRequest(uint8_t ubCommandV, uint32_t ulDataV,
+                           uint8_t ubByte5V, uint8_t ubByte6V,
+                           uint8_t ubByte7V)
+{
+   uint8_t  aubDataT[8];
+   uint8_t  ubNodeT;
+
+   aubDataT[0] = ubCommandV;
+   aubDataT[1] = (uint8_t) (ulDataV);
+   aubDataT[2] = (uint8_t) (ulDataV >>  8);
+   aubDataT[3] = (uint8_t) (ulDataV >> 16);
+   aubDataT[4] = (uint8_t) (ulDataV >> 24);
+   aubDataT[5] = ubByte5V;
+   aubDataT[6] = ubByte6V;
+   aubDataT[7] = ubByte7V;
+
+   uwRspCountS = 0;
+   CpCoreBufferSetData(&tsMasterS, SIM_BUF_TRM, &aubDataT[0]);
+   CpCoreBufferSend(&tsMasterS, SIM_BUF_TRM);
+   CpVBusProcess(&tsMasterS);
+
+   for(ubNodeT = 0; ubNodeT < COS_INSTANCE_MAX; ubNodeT++)
+   {
+      CosInstSelect(ubNodeT);
+      CpVBusProcess(&tsCanPortG);
+   }
+   CpVBusProcess(&tsMasterS);
+
+   ulRequestS++;
+   if(uwRspCountS == 0) ulTimeoutS++;
+   return(uwRspCountS);
+}
+
+
+//----------------------------------------------------------------------------//
+// SimFastscan()                                                              //
+// identify one slave, returns 0 if no slave is left                          //
+//----------------------------------------------------------------------------//
+static uint8_t SimFastscan(uint32_t * pulSerialV)
+{
+   uint32_t aulIdT[4];
+   uint8_t  ubSubT;
+   int8_t   sbBitT;
+
+   if(SimRequest(eLSS_CMD_FASTSCAN, 0, 0x80, 0, 0) == 0) return(0);
+
+   for(ubSubT = 0; ubSubT < 4; ubSubT++)
+   {
+      //--------------------------------------------------------
+      // a bit is 0 when a slave answers, else it is 1
+      //
+      aulIdT[ubSubT] = 0;
+      for(sbBitT = 31; sbBitT >= 0; sbBitT--)
+      {
+         if(SimRequest(eLSS_CMD_FASTSCAN, aulIdT[ubSubT], (uint8_t) sbBitT,
+                       ubSubT, ubSubT) == 0)
+         {
+            aulIdT[ubSubT] |= (1UL << sbBitT);
+         }
+      }
+
+      //--------------------------------------------------------
+      // confirm the complete part, the next part is scanned then
+      //
+      TEST_CHECK(SimRequest(eLSS_CMD_FASTSCAN, aulIdT[ubSubT], 0,
+                            ubSubT, (ubSubT + 1) & 3) > 0);
+   }
+
+   TEST_CHECK_EQ(aulIdT[0], ulIdx1018_VendorIdC);
+   TEST_CHECK_EQ(aulIdT[1], ulIdx1018_ProductCodeC);
+   TEST_CHECK_EQ(aulIdT[2], ulIdx1018_RevisionNumC);
+   *pulSerialV = aulIdT[3];
+   return(1);
+}
+
+
+//----------------------------------------------------------------------------//
+// TestFastscan()                                                             //
+// identify all slaves and assign the node-IDs                                //
+//----------------------------------------------------------------------------//
+static void TestFastscan(void)
+{
+   CosInst_ts  tsInstT;
+   uint32_t    ulSerialT;
+   uint32_t    ulTimeUsT;
+   uint8_t     ubFoundT = 0;
+   uint8_t     ubNodeT;
+   uint8_t     ubConfigT;
+   uint8_t     ubSlaveT;
+
+   SimInit();
+
+   while(SimFastscan(&ulSerialT))
+   {
+      //--------------------------------------------------------
+      // exactly the slave with this serial number is in
+      // configuration state
+      //
+      ubConfigT = 0;
+      ubSlaveT  = 0;
+      for(ubNodeT = 0; ubNodeT < COS_INSTANCE_MAX; ubNodeT++)
+      {
+         CosInstSelect(ubNodeT);
+         if(ptsCosInstG->ubLssMode == eLSS_MODE_CONFIG)
+         {
+            ubConfigT++;
+            ubSlaveT = ubNodeT;
+         }
+      }
+      TEST_CHECK_EQ(ubConfigT, 1);
+      TEST_CHECK_EQ(ulSerialT, aulSerialS[ubSlaveT]);
+
+      ubFoundT++;
+      TEST_CHECK_EQ(SimRequest(eLSS_CMD_CONFIG_NODE_ID, ubFoundT, 0, 0, 0), 1);
+      TEST_CHECK_EQ(aubRspDataS[1], 0);
+      SimRequest(eLSS_CMD_MODE_GLOBAL, 0, 0, 0, 0);
+
+      if(ubFoundT > COS_INSTANCE_MAX) break;
+   }
+
+   //----------------------------------------------------------------
+   // every slave has got its own node-ID
+   //
+   TEST_CHECK_EQ(ubFoundT, COS_INSTANCE_MAX);
+   for(ubNodeT = 0; ubNodeT < COS_INSTANCE_MAX; ubNodeT++)
+   {
+      CosInstSelect(ubNodeT);
+      tsInstT = *ptsCosInstG;
+      TEST_CHECK(tsInstT.ubLssNodeId >= 1);
+      TEST_CHECK(tsInstT.ubLssNodeId <= COS_INSTANCE_MAX);
+      TEST_CHECK_EQ(tsInstT.ubLssMode, eLSS_MODE_WAIT);
+   }
+
+   ulTimeUsT = (ulRequestS * SIM_FRAME_US) +
+               ((ulRequestS - ulTimeoutS) * SIM_FRAME_US) +
+               (ulTimeoutS * SIM_TIMEOUT_US);
+   printf("identified %u slaves, %u requests, %u timeouts, "
+          "scan time %u.%02u s at 125 kbit/s / %u ms timeout\n",
+          ubFoundT, ulRequestS, ulTimeoutS, ulTimeUsT / 1000000,
+          (ulTimeUsT / 10000) % 100, SIM_TIMEOUT_US / 1000);
+
+   CpCoreDriverRelease(&tsMasterS);
+   CpVBusUnlink(SIM_BUS);
+}
+
+
+//----------------------------------------------------------------------------//
+// main()                                                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+int main(void)
+{
+   TestFastscan();
+
+   return(TEST_RESULT("test_cos_lss"));
+}
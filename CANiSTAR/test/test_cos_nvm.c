@@ -0,0 +1,391 @@
+//****************************************************************************//
+// File:          test_cos_nvm.c                                              //
+// Description:   Test of the stepped parameter save of the CANopen manager   //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include "SI_C8051F550_Register_Enums.h"
+#include "can_model.h"
+#include "cos_mgr.h"
+#include "cos_emcy.h"
+#include "cos_led.h"
+#include "cos_mobj.h"
+#include "cos_nvm.h"
+#include "cos_sdo.h"
+#include "cos301.h"
+#include "cos401ai.h"
+#include "cos401di.h"
+#include "cos_stub.h"
+#include "mc_tmr.h"
+#include "linux_tmr.h"
+#include "test_check.h"
+
+#if (COS_DICT_OBJ_1010 == 0) || (COS_MGR_STAT == 0) || (COS_DICT_MAN == 0)
+#error  The test requires COS_DICT_OBJ_1010, COS_MGR_STAT and COS_DICT_MAN
+#endif
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \file    test_cos_nvm.c
+** \brief   Parameter save in steps of CosMgrProcess()
+**
+** A write on index 1010h is simulated by setting ubCos301ParmSaveG.
+** The save functions and the NVM access of the test move the virtual
+** clock of linux_tmr.c by a known number of microseconds. The test
+** calls CosMgrProcess() until the deferred SDO response is sent and
+** checks that every call performs one step in the right order, that
+** the selection and the checksum are written and that the main loop
+** statistic holds the duration of the longest step in microseconds.
+*/
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------
+// duration of the save functions and the NVM access in microseconds
+//
+#define  TEST_NVM_READ_US     150
+#define  TEST_NVM_ENABLE_US   50
+#define  TEST_NVM_BYTE_US     250
+#define  TEST_NVM_SUM_US      300
+#define  TEST_NVM_DISABLE_US  50
+#define  TEST_SAVE_301_US     4000
+#define  TEST_SAVE_DI_US      1200
+#define  TEST_SAVE_AI_US      1800
+#define  TEST_SAVE_MAN_US     700
+
+#define  TEST_STEP_MAX        16
+
+#define  TEST_NO_RESPONSE     0xFF
+
+//-------------------------------------------------------------------
+// trace of the calls
+//
+enum TestStep_e {
+   eTEST_NVM_READ = 1,
+   eTEST_NVM_ENABLE,
+   eTEST_SAVE_301,
+   eTEST_SAVE_DI,
+   eTEST_SAVE_AI,
+   eTEST_SAVE_MAN,
+   eTEST_NVM_SELECT,
+   eTEST_NVM_SUM,
+   eTEST_NVM_CHECKSUM,
+   eTEST_NVM_DISABLE
+};
+
+
+/*----------------------------------------------------------------------------*\
+** Variables of module                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+TEST_CHECK_DATA;
+
+uint8_t              ubTimerTriggerG;
+
+extern uint8_t       ubCosMgrStatusG;
+
+static uint8_t       aubStepS[TEST_STEP_MAX];   // trace of the calls
+static uint8_t       aubStepCallS[TEST_STEP_MAX];  // call of CosMgrProcess()
+static uint8_t       ubStepCountS;
+static uint8_t       ubCallS;                   // current call
+static uint16_t      uwParmSelS;                // eNVM_PARM_SEL_U16
+static uint16_t      uwChecksumS;               // eNVM_CHECKSUM_U16
+static uint8_t       ubWriteEnableS;
+static uint8_t       ubWriteFailS;              // McNvmWrite() fails
+static uint8_t       ubResponseS;               // deferred SDO response
+static uint8_t       ubResponseCallS;
+
+
+/*----------------------------------------------------------------------------*\
+** Functions                                                                  **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//----------------------------------------------------------------------------//
+// functions of modules which are not linked to this test                     //
+//----------------------------------------------------------------------------//
+uint8_t  ubIdx1001_ErrorRegisterG;
+uint8_t  ubCos301ParmSaveG;
+uint8_t  ubCos301ParmLoadG;
+
+void     Cos301_ParmInit(void)                  { }
+void     CosMgrOnBusOff(void)                   { }
+void     CosEmcyInit(void)                      { }
+void     CosEmcySend(uint16_t uwCodeV, uint8_t * pubV) { }
+void     CosLedInit(void)                       { }
+void     CosLedNetworkError(uint8_t ubErrorV)   { }
+void     CosLedNetworkStatus(uint8_t ubStatusV) { }
+void     CosDictInit(void)                      { }
+void     CosSdoInit(uint8_t ubNodeIdV)          { }
+void     CosSdoMessageHandler(void)             { }
+uint8_t  Cos301_ParmLoad(void)                  { return(0);                }
+uint8_t  Cos401_DI_ParmLoad(void)               { return(0);                }
+uint8_t  Cos401_AI_ParmLoad(void)               { return(0);                }
+uint8_t  CosMob_ParmLoad(void)                  { return(0);                }
+void     CosMob_ParmInit(void)                  { }
+
+
+//----------------------------------------------------------------------------//
+// TestStep()                                                                 //
+// record a call and move the virtual clock                                   //
+//----------------------------------------------------------------------------//
+static void TestStep(uint8_t ubStepV, uint32_t ulTimeV)
+{
+   if(ubStepCountS < TEST_STEP_MAX)
+   {
+      aubStepS[ubStepCountS]     = ubStepV;
+      aubStepCallS[ubStepCountS] = ubCallS;
+   }
+   ubStepCountS++;
+
+   McTmrHResAdvance(ulTimeV);
+}
+
+
+//----------------------------------------------------------------------------//
+// save functions of the profiles                                             //
+//----------------------------------------------------------------------------//
+uint8_t Cos301_ParmSave(void)
+{
+   TestStep(eTEST_SAVE_301, TEST_SAVE_301_US);
+   return(0);
+}
+
+uint8_t Cos401_DI_ParmSave(void)
+{
+   TestStep(eTEST_SAVE_DI, TEST_SAVE_DI_US);
+   return(0);
+}
+
+uint8_t Cos401_AI_ParmSave(void)
+{
+   TestStep(eTEST_SAVE_AI, TEST_SAVE_AI_US);
+   return(0);
+}
+
+uint8_t CosMob_ParmSave(void)
+{
+   TestStep(eTEST_SAVE_MAN, TEST_SAVE_MAN_US);
+   return(0);
+}
+
+
+//----------------------------------------------------------------------------//
+// access to the non-volatile memory                                          //
+//----------------------------------------------------------------------------//
+Status_tv McNvmRead(NvmAddr_tv tvAddressV, void * pvdDataV, NvmSize_tv tvSizeV)
+{
+   TestStep(eTEST_NVM_READ, TEST_NVM_READ_US);
+   if(tvAddressV == eNVM_PARM_SEL_U16)
+   {
+      *((uint16_t *) pvdDataV) = uwParmSelS;
+   }
+   return(eNVM_ERR_OK);
+}
+
+Status_tv McNvmWrite(NvmAddr_tv tvAddressV, void * pvdDataV, NvmSize_tv tvSizeV)
+{
+   if(tvAddressV == eNVM_PARM_SEL_U16)
+   {
+      TestStep(eTEST_NVM_SELECT, TEST_NVM_BYTE_US * tvSizeV);
+      if(ubWriteFailS) return(eNVM_ERR_WRITE);
+      uwParmSelS = *((uint16_t *) pvdDataV);
+   }
+   if(tvAddressV == eNVM_CHECKSUM_U16)
+   {
+      TestStep(eTEST_NVM_CHECKSUM, TEST_NVM_BYTE_US * tvSizeV);
+      uwChecksumS = *((uint16_t *) pvdDataV);
+   }
+   if(ubWriteEnableS == 0) return(eNVM_ERR_WRITE);
+   return(eNVM_ERR_OK);
+}
+
+Status_tv McNvmWriteEnable(void)
+{
+   TestStep(eTEST_NVM_ENABLE, TEST_NVM_ENABLE_US);
+   ubWriteEnableS = 1;
+   return(eNVM_ERR_OK);
+}
+
+Status_tv McNvmWriteDisable(void)
+{
+   TestStep(eTEST_NVM_DISABLE, TEST_NVM_DISABLE_US);
+   ubWriteEnableS = 0;
+   return(eNVM_ERR_OK);
+}
+
+uint16_t McNvmBuildChecksum(NvmAddr_tv tvStartAddressV,
+                            NvmSize_tv tvDataCountV)
+{
+   TestStep(eTEST_NVM_SUM, TEST_NVM_SUM_US);
+   return(0x1234);
+}
+
+
+//----------------------------------------------------------------------------//
+// CosSdoResponse()                                                           //
+// deferred response of the write on index 1010h                              //
+//----------------------------------------------------------------------------//
+void CosSdoResponse(uint8_t ubResponseV)
+{
+   ubResponseS     = ubResponseV;
+   ubResponseCallS = ubCallS;
+}
+
+
+//----------------------------------------------------------------------------//
+// TestStart()                                                                //
+// clock, statistic and trace, request to save all parameters                 //
+//----------------------------------------------------------------------------//
+static void TestStart(void)
+{
+   CosMgrStat_ts  tsStatT;
+
+   McTmrInit();
+   TEST_CHECK_EQ(McTmrHResInit(eTMR_HRES_TICK_1us), eTMR_ERR_OK);
+   McTmrHResStart();
+
+   CosMgrStatistic(&tsStatT, 1);
+   ubCosMgrStatusG   = eCOS_MGR_RUN;
+
+   ubStepCountS      = 0;
+   ubCallS           = 0;
+   uwParmSelS        = 0xFFFF;
+   uwChecksumS       = 0;
+   ubWriteEnableS    = 0;
+   ubWriteFailS      = 0;
+   ubResponseS       = TEST_NO_RESPONSE;
+   ubResponseCallS   = 0;
+
+   ubCos301ParmSaveG = eCOS_PARM_ALL;
+}
+
+
+//----------------------------------------------------------------------------//
+// TestRun()                                                                  //
+// call CosMgrProcess() until the SDO response is sent                        //
+//----------------------------------------------------------------------------//
+static void TestRun(void)
+{
+   while((ubResponseS == TEST_NO_RESPONSE) && (ubCallS < 20))
+   {
+      ubCallS++;
+      TEST_CHECK_EQ(CosMgrProcess(), eCosErr_OK);
+      if(ubResponseS == TEST_NO_RESPONSE)
+      {
+         TEST_CHECK(ubCos301ParmSaveG & 0x80);
+      }
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// TestNvmSave()                                                              //
+// one step per call, longest step in the main loop statistic                 //
+//----------------------------------------------------------------------------//
+static void TestNvmSave(void)
+{
+   static const uint8_t aubStepC[] = {
+      eTEST_NVM_READ,   eTEST_NVM_ENABLE,   eTEST_SAVE_301,
+      eTEST_SAVE_DI,    eTEST_SAVE_AI,      eTEST_SAVE_MAN,
+      eTEST_NVM_SELECT, eTEST_NVM_SUM,      eTEST_NVM_CHECKSUM,
+      eTEST_NVM_DISABLE };
+   static const uint8_t aubStepCallC[] = {
+      1, 1, 2, 3, 3, 4, 5, 6, 6, 6 };
+
+   CosMgrStat_ts  tsStatT;
+   uint8_t        ubCntT;
+
+   TestStart();
+   TestRun();
+
+   //----------------------------------------------------------------
+   // start, three save steps, selection and checksum: the response
+   // is sent by the 6th call
+   //
+   TEST_CHECK_EQ(ubResponseS, eCosSdo_WRITE_OK);
+   TEST_CHECK_EQ(ubResponseCallS, 6);
+   TEST_CHECK_EQ(ubCos301ParmSaveG, 0);
+
+   TEST_CHECK_EQ(ubStepCountS, sizeof(aubStepC));
+   for(ubCntT = 0; ubCntT < sizeof(aubStepC); ubCntT++)
+   {
+      TEST_CHECK_EQ(aubStepS[ubCntT], aubStepC[ubCntT]);
+      TEST_CHECK_EQ(aubStepCallS[ubCntT], aubStepCallC[ubCntT]);
+   }
+
+   TEST_CHECK_EQ(uwParmSelS, 0x5AC7);
+   TEST_CHECK_EQ(uwChecksumS, 0x1234);
+   TEST_CHECK_EQ(ubWriteEnableS, 0);
+
+   //----------------------------------------------------------------
+   // the longest call is the save of CiA 301, the classes hold the
+   // number of significant bits of the durations:
+   // 200 us (8), 4000 us (12), 3000 us (12), 700 us (10),
+   // 500 us (9), 850 us (10)
+   //
+   ubCallS++;
+   CosMgrProcess();
+
+   CosMgrStatistic(&tsStatT, 0);
+   TEST_CHECK_EQ(tsStatT.ulCallCount, 7);
+   TEST_CHECK_EQ(tsStatT.ulTickMax, TEST_SAVE_301_US);
+   TEST_CHECK_EQ(tsStatT.aulTickClass[0],  1);
+   TEST_CHECK_EQ(tsStatT.aulTickClass[8],  1);
+   TEST_CHECK_EQ(tsStatT.aulTickClass[9],  1);
+   TEST_CHECK_EQ(tsStatT.aulTickClass[10], 2);
+   TEST_CHECK_EQ(tsStatT.aulTickClass[12], 2);
+   TEST_CHECK_EQ(ubStepCountS, sizeof(aubStepC));
+}
+
+
+//----------------------------------------------------------------------------//
+// TestNvmSaveFail()                                                          //
+// a failed write of the selection is reported by the SDO response            //
+//----------------------------------------------------------------------------//
+static void TestNvmSaveFail(void)
+{
+   TestStart();
+   uwParmSelS   = 0x5AC1;
+   ubWriteFailS = 1;
+   TestRun();
+
+   TEST_CHECK_EQ(ubResponseS, eCosSdo_ERR_HARDWARE);
+   TEST_CHECK_EQ(ubResponseCallS, 6);
+   TEST_CHECK_EQ(ubCos301ParmSaveG, 0);
+   TEST_CHECK_EQ(uwParmSelS, 0x5AC1);
+   TEST_CHECK_EQ(ubWriteEnableS, 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// main()                                                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+int main(void)
+{
+   TestNvmSave();
+   TestNvmSaveFail();
+
+   return(TEST_RESULT("test_cos_nvm"));
+}
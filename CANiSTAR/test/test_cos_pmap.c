@@ -0,0 +1,341 @@
+//****************************************************************************//
+// File:          test_cos_pmap.c                                             //
+// Description:   Test of the PDO copy plans on the object dictionary         //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <string.h>
+
+#include "cos_dict.h"
+#include "cos_emcy.h"
+#include "cos_mobj.h"
+#include "cos_nmt.h"
+#include "cos_pdo.h"
+#include "cos_pmap.h"
+#include "cos_sync.h"
+#include "cos301.h"
+#include "test_check.h"
+
+#if (COS_PDO_MAPPING == 0) || (COS_DICT_MAN == 0) || (CPP_DATA_SIZE < 64)
+#error  The test requires COS_PDO_MAPPING = 1, COS_DICT_MAN = 1 and \
+        64 bit data
+#endif
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \file    test_cos_pmap.c
+** \brief   Copy plans of cos_pmap.c on the dictionary of cos_dict.c
+**
+** The mapping entries point to the manufacturer specific objects 2002h
+** .. 2008h of the dictionary. The test checks the packed bytes of a
+** transmit PDO, the values written by a receive PDO with a dummy entry
+** and the rejected mappings.
+** <p>
+** The test is built twice: for the host and with CPP_BIG_ENDIAN = 1,
+** as the Keil C51 build for the C8051F550. The values are stored in
+** the byte order of the build, so the second build has the memory
+** layout of the target and runs the byte swap of cos_pmap.c. In both
+** builds the PDO must carry the numeric values little endian and the
+** string in its order.
+*/
+
+
+/*----------------------------------------------------------------------------*\
+** Variables of module                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+TEST_CHECK_DATA;
+
+//-------------------------------------------------------------------
+// objects of the dictionary
+//
+uint32_t ulIdx1000_DeviceTypeC;
+uint8_t  ubIdx1001_ErrorRegisterG;
+uint32_t ulIdx1002_StatusRegisterG;
+uint8_t  ubIdx1008_DeviceNameC[] = "test";
+uint8_t  ubIdx1009_HwVersionC[]  = "1";
+uint8_t  ubIdx100A_SwVersionC[]  = "1";
+
+uint8_t  ubCosMob_Var2002G;
+uint16_t uwCosMob_Var2003G;
+uint32_t ulCosMob_Var2004G;
+uint64_t uqCosMob_Var2005G;
+char     szCosMob_Str2008G[] = "CANopen";
+
+
+/*----------------------------------------------------------------------------*\
+** Functions                                                                  **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//----------------------------------------------------------------------------//
+// SDO callbacks of modules which are not linked to this test                 //
+//----------------------------------------------------------------------------//
+uint8_t  Cos301_Idx1018(uint8_t ubSubIndexV, uint8_t ubReqCodeV)     { return(0); }
+uint8_t  CosEmcyErrorField(uint8_t ubSubIndexV, uint8_t ubReqCodeV)  { return(0); }
+uint8_t  CosEmcyIdentifier(uint8_t ubSubIndexV, uint8_t ubReqCodeV)  { return(0); }
+uint8_t  CosMob_Idx2000(uint8_t ubSubIndexV, uint8_t ubReqCodeV)     { return(0); }
+uint8_t  CosMob_Idx2001(uint8_t ubSubIndexV, uint8_t ubReqCodeV)     { return(0); }
+uint8_t  CosMob_Idx2006(uint8_t ubSubIndexV, uint8_t ubReqCodeV)     { return(0); }
+uint8_t  CosMob_Idx2007(uint8_t ubSubIndexV, uint8_t ubReqCodeV)     { return(0); }
+uint8_t  CosNmt_Idx100C(uint8_t ubSubIndexV, uint8_t ubReqCodeV)     { return(0); }
+uint8_t  CosNmt_Idx100D(uint8_t ubSubIndexV, uint8_t ubReqCodeV)     { return(0); }
+uint8_t  CosNmt_Idx1017(uint8_t ubSubIndexV, uint8_t ubReqCodeV)     { return(0); }
+uint8_t  CosNmt_Idx1029(uint8_t ubSubIndexV, uint8_t ubReqCodeV)     { return(0); }
+uint8_t  CosPdoMapParameter(uint8_t ubSubIndexV, uint8_t ubReqCodeV) { return(0); }
+uint8_t  CosPdoRcvComParam(uint8_t ubSubIndexV, uint8_t ubReqCodeV)  { return(0); }
+uint8_t  CosPdoTrmComParam(uint8_t ubSubIndexV, uint8_t ubReqCodeV)  { return(0); }
+uint8_t  CosSync_Idx1005(uint8_t ubSubIndexV, uint8_t ubReqCodeV)    { return(0); }
+uint8_t  CosSync_Idx1006(uint8_t ubSubIndexV, uint8_t ubReqCodeV)    { return(0); }
+
+
+//----------------------------------------------------------------------------//
+// TestStore()                                                                //
+// store a value in the byte order of the build                               //
+//----------------------------------------------------------------------------//
+static void TestStore(void * pvdValueV, uint8_t ubSizeV, uint64_t uqValueV)
+{
+   uint8_t *   pubValueT = (uint8_t *) pvdValueV;
+   uint8_t     ubCntT;
+
+   for(ubCntT = 0; ubCntT < ubSizeV; ubCntT++)
+   {
+      #if CPP_BIG_ENDIAN > 0
+      pubValueT[ubSizeV - 1 - ubCntT] = (uint8_t) (uqValueV >> (8 * ubCntT));
+      #else
+      pubValueT[ubCntT] = (uint8_t) (uqValueV >> (8 * ubCntT));
+      #endif
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// TestLoad()                                                                 //
+// read a value in the byte order of the build                                //
+//----------------------------------------------------------------------------//
+static uint64_t TestLoad(void * pvdValueV, uint8_t ubSizeV)
+{
+   uint8_t *   pubValueT = (uint8_t *) pvdValueV;
+   uint64_t    uqValueT  = 0;
+   uint8_t     ubCntT;
+
+   for(ubCntT = 0; ubCntT < ubSizeV; ubCntT++)
+   {
+      #if CPP_BIG_ENDIAN > 0
+      uqValueT |= ((uint64_t) pubValueT[ubSizeV - 1 - ubCntT]) << (8 * ubCntT);
+      #else
+      uqValueT |= ((uint64_t) pubValueT[ubCntT]) << (8 * ubCntT);
+      #endif
+   }
+
+   return(uqValueT);
+}
+
+
+//----------------------------------------------------------------------------//
+// TestPmapTrm()                                                              //
+// packed bytes of transmit PDOs                                              //
+//----------------------------------------------------------------------------//
+static void TestPmapTrm(void)
+{
+   static CPP_CONST uint32_t aulMap1C[] = { 0x20030010, 0x20040020,
+                                            0x20020008 };
+   static CPP_CONST uint32_t aulMap2C[] = { 0x20050040 };
+   static CPP_CONST uint8_t  aubPdo1C[] = { 0x34, 0x12, 0xEF, 0xCD,
+                                            0xAB, 0x89, 0x5A };
+   static CPP_CONST uint8_t  aubPdo2C[] = { 0x08, 0x07, 0x06, 0x05,
+                                            0x04, 0x03, 0x02, 0x01 };
+   uint8_t  aubDataT[8];
+   uint8_t  ubCntT;
+
+   TestStore(&uwCosMob_Var2003G, 2, 0x1234);
+   TestStore(&ulCosMob_Var2004G, 4, 0x89ABCDEF);
+   TestStore(&ubCosMob_Var2002G, 1, 0x5A);
+   TestStore(&uqCosMob_Var2005G, 8, 0x0102030405060708ULL);
+
+   //----------------------------------------------------------------
+   // 16 + 32 + 8 bit
+   //
+   TEST_CHECK_EQ(CosPmapBuild(eCosPmap_TRM, 0, &aulMap1C[0], 3),
+                 eCosSdo_WRITE_OK);
+   memset(&aubDataT[0], 0xEE, 8);
+   TEST_CHECK_EQ(CosPmapTrm(0, &aubDataT[0]), 7);
+   for(ubCntT = 0; ubCntT < 7; ubCntT++)
+   {
+      TEST_CHECK_EQ(aubDataT[ubCntT], aubPdo1C[ubCntT]);
+   }
+   TEST_CHECK_EQ(aubDataT[7], 0xEE);
+
+   //----------------------------------------------------------------
+   // the plan holds the address, a new value is sampled by the
+   // next copy
+   //
+   TestStore(&uwCosMob_Var2003G, 2, 0xBEEF);
+   CosPmapTrm(0, &aubDataT[0]);
+   TEST_CHECK_EQ(aubDataT[0], 0xEF);
+   TEST_CHECK_EQ(aubDataT[1], 0xBE);
+
+   //----------------------------------------------------------------
+   // 64 bit
+   //
+   TEST_CHECK_EQ(CosPmapBuild(eCosPmap_TRM, 1, &aulMap2C[0], 1),
+                 eCosSdo_WRITE_OK);
+   TEST_CHECK_EQ(CosPmapTrm(1, &aubDataT[0]), 8);
+   for(ubCntT = 0; ubCntT < 8; ubCntT++)
+   {
+      TEST_CHECK_EQ(aubDataT[ubCntT], aubPdo2C[ubCntT]);
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// TestPmapString()                                                           //
+// a string is copied in its order, also on a big endian CPU                  //
+//----------------------------------------------------------------------------//
+static void TestPmapString(void)
+{
+   static CPP_CONST uint32_t aulMapC[] = { 0x20080038, 0x20020008 };
+   uint8_t  aubDataT[8];
+   uint8_t  ubCntT;
+
+   TestStore(&ubCosMob_Var2002G, 1, 0x21);
+
+   TEST_CHECK_EQ(CosPmapBuild(eCosPmap_TRM, 1, &aulMapC[0], 2),
+                 eCosSdo_WRITE_OK);
+   TEST_CHECK_EQ(CosPmapTrm(1, &aubDataT[0]), 8);
+   for(ubCntT = 0; ubCntT < 7; ubCntT++)
+   {
+      TEST_CHECK_EQ(aubDataT[ubCntT], (uint8_t) szCosMob_Str2008G[ubCntT]);
+   }
+   TEST_CHECK_EQ(aubDataT[7], 0x21);
+}
+
+
+//----------------------------------------------------------------------------//
+// TestPmapRcv()                                                              //
+// values written by a receive PDO with a dummy entry                         //
+//----------------------------------------------------------------------------//
+static void TestPmapRcv(void)
+{
+   static CPP_CONST uint32_t aulMapC[] = { 0x20040020, 0x00060010,
+                                           0x20030010 };
+   static CPP_CONST uint8_t  aubPdoC[] = { 0x78, 0x56, 0x34, 0x12,
+                                           0xFF, 0xFF, 0xCD, 0xAB };
+
+   TestStore(&ulCosMob_Var2004G, 4, 0);
+   TestStore(&uwCosMob_Var2003G, 2, 0);
+
+   TEST_CHECK_EQ(CosPmapBuild(eCosPmap_RCV, 0, &aulMapC[0], 3),
+                 eCosSdo_WRITE_OK);
+
+   //----------------------------------------------------------------
+   // a short PDO is not copied
+   //
+   TEST_CHECK_EQ(CosPmapRcv(0, &aubPdoC[0], 7), 1);
+   TEST_CHECK_EQ(TestLoad(&ulCosMob_Var2004G, 4), 0);
+
+   TEST_CHECK_EQ(CosPmapRcv(0, &aubPdoC[0], 8), 0);
+   TEST_CHECK_EQ(TestLoad(&ulCosMob_Var2004G, 4), 0x12345678);
+   TEST_CHECK_EQ(TestLoad(&uwCosMob_Var2003G, 2), 0xABCD);
+
+   //----------------------------------------------------------------
+   // a disabled PDO is not copied
+   //
+   CosPmapClear(eCosPmap_RCV, 0);
+   TestStore(&uwCosMob_Var2003G, 2, 0);
+   TEST_CHECK_EQ(CosPmapRcv(0, &aubPdoC[0], 8), 1);
+   TEST_CHECK_EQ(TestLoad(&uwCosMob_Var2003G, 2), 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// TestPmapError()                                                            //
+// invalid mappings keep the previous plan                                    //
+//----------------------------------------------------------------------------//
+static void TestPmapError(void)
+{
+   static CPP_CONST uint32_t aulMapC[] = { 0x20030010 };
+   static CPP_CONST uint32_t aulLongC[] = { 0x20050040, 0x20020008 };
+   uint32_t ulMapT;
+   uint8_t  aubDataT[8];
+
+   TEST_CHECK_EQ(CosPmapBuild(eCosPmap_TRM, 0, &aulMapC[0], 1),
+                 eCosSdo_WRITE_OK);
+
+   //--- object with SDO callback -----------------------------------
+   ulMapT = 0x20000010;
+   TEST_CHECK_EQ(CosPmapBuild(eCosPmap_TRM, 0, &ulMapT, 1),
+                 eCosSdo_ERR_MAPPING_OBJECT);
+
+   //--- object without attribute CoATTR_PDO_MAP --------------------
+   ulMapT = 0x10000020;
+   TEST_CHECK_EQ(CosPmapBuild(eCosPmap_TRM, 0, &ulMapT, 1),
+                 eCosSdo_ERR_MAPPING_OBJECT);
+
+   //--- length does not match the data type ------------------------
+   ulMapT = 0x20030008;
+   TEST_CHECK_EQ(CosPmapBuild(eCosPmap_TRM, 0, &ulMapT, 1),
+                 eCosSdo_ERR_MAPPING_OBJECT);
+
+   //--- object does not exist --------------------------------------
+   ulMapT = 0x30000008;
+   TEST_CHECK_EQ(CosPmapBuild(eCosPmap_TRM, 0, &ulMapT, 1),
+                 eCosSdo_ERR_NO_OBJECT);
+
+   //--- dummy entry in a transmit PDO ------------------------------
+   ulMapT = 0x00050008;
+   TEST_CHECK_EQ(CosPmapBuild(eCosPmap_TRM, 0, &ulMapT, 1),
+                 eCosSdo_ERR_MAPPING_OBJECT);
+
+   //--- more than 64 bit -------------------------------------------
+   TEST_CHECK_EQ(CosPmapBuild(eCosPmap_TRM, 0, &aulLongC[0], 2),
+                 eCosSdo_ERR_MAPPING_LENGTH);
+
+   //--- PDO number -------------------------------------------------
+   TEST_CHECK_EQ(CosPmapBuild(eCosPmap_TRM, COS_PDO_TRM_NUMBER,
+                              &aulMapC[0], 1),
+                 eCosSdo_ERR_GENERAL_PARAMETER);
+
+   TestStore(&uwCosMob_Var2003G, 2, 0x0102);
+   TEST_CHECK_EQ(CosPmapTrm(0, &aubDataT[0]), 2);
+   TEST_CHECK_EQ(aubDataT[0], 0x02);
+   TEST_CHECK_EQ(aubDataT[1], 0x01);
+}
+
+
+//----------------------------------------------------------------------------//
+// main()                                                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+int main(void)
+{
+   CosDictInit();
+   CosPmapInit();
+
+   TestPmapTrm();
+   TestPmapString();
+   TestPmapRcv();
+   TestPmapError();
+
+   #if CPP_BIG_ENDIAN > 0
+   return(TEST_RESULT("test_cos_pmap (big endian)"));
+   #else
+   return(TEST_RESULT("test_cos_pmap"));
+   #endif
+}
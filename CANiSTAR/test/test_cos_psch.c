@@ -0,0 +1,403 @@
+//****************************************************************************//
+// File:          test_cos_psch.c                                             //
+// Description:   Test of the transmit PDO scheduler with CosMgr              //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include "SI_C8051F550_Register_Enums.h"
+#include "can_model.h"
+#include "cos_mgr.h"
+#include "cos_emcy.h"
+#include "cos_led.h"
+#include "cos_psch.h"
+#include "cos301.h"
+#include "cos_stub.h"
+#include "mc_tmr.h"
+#include "test_check.h"
+
+#if (COS_PDO_SCHED == 0) || (COS_PDO_INHIBIT == 0) || \
+    (COS_PDO_MAPPING > 0) || (COS_PDO_TRM_NUMBER < 2)
+#error  The test requires COS_PDO_SCHED = 1, COS_PDO_INHIBIT = 1, \
+        the fixed mapping and two transmit PDOs
+#endif
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \file    test_cos_psch.c
+** \brief   Transmit PDOs of the scheduler through CAN0_IRQ and CosMgr
+**
+** The SYNC message is received by CAN0_IRQ() and passed by CosMgr to
+** CosPschSync(), the transmit interrupt of a PDO is passed by the
+** transmit handler of CosMgr to CosPschTrmEvent(). The test checks that
+** the PDOs due for a SYNC are handed to the CAN controller within the
+** interrupt of the SYNC, that a PDO whose previous frame is pending
+** waits in the queue for the transmit interrupt and that the inhibit
+** time and the event timer of an event-driven PDO are kept. After each
+** entry point of the scheduler the CAN interrupt must be enabled.
+*/
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#define  TEST_NODE_ID         0x20
+
+#define  TEST_SYNC_ID         0x080
+#define  TEST_PDO1_ID         (0x180 + TEST_NODE_ID)
+#define  TEST_PDO2_ID         (0x280 + TEST_NODE_ID)
+
+//-------------------------------------------------------------------
+// PSCH_TRM_TIMEOUT of cos_psch.c
+//
+#define  TEST_TRM_TIMEOUT     10
+
+
+/*----------------------------------------------------------------------------*\
+** Variables of module                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+TEST_CHECK_DATA;
+
+void CAN0_IRQ(void);
+
+extern uint8_t       ubCosMgrStatusG;
+
+CosPdoCom_ts         atsTrmPdoComG[COS_PDO_TRM_NUMBER];
+
+static uint8_t       aubSampleS[COS_PDO_TRM_NUMBER];  // data updates
+static uint8_t       aubFrameS[COS_PDO_TRM_NUMBER];   // frames on the bus
+static uint8_t       aubLastS[COS_PDO_TRM_NUMBER];    // data of last frame
+
+
+/*----------------------------------------------------------------------------*\
+** Functions                                                                  **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//----------------------------------------------------------------------------//
+// functions of modules which are not linked to this test                     //
+//----------------------------------------------------------------------------//
+uint8_t  ubIdx1001_ErrorRegisterG;
+
+uint32_t McTmrTick(void)                        { return(0);                }
+void     Cos301_ParmInit(void)                  { }
+void     CosMgrOnBusOff(void)                   { }
+void     CosEmcyInit(void)                      { }
+void     CosEmcySend(uint16_t uwCodeV, uint8_t * pubV) { }
+void     CosEmcyTrmEvent(void)                  { }
+void     CosLedInit(void)                       { }
+void     CosLedNetworkError(uint8_t ubErrorV)   { }
+void     CosLedNetworkStatus(uint8_t ubStatusV) { }
+void     CosDictInit(void)                      { }
+void     CosSdoInit(uint8_t ubNodeIdV)          { }
+void     CosSdoMessageHandler(void)             { }
+
+
+//----------------------------------------------------------------------------//
+// CosPdoTrmDataUpdate()                                                      //
+// fixed mapping: byte 0 counts the updates of the PDO data                   //
+//----------------------------------------------------------------------------//
+void CosPdoTrmDataUpdate(uint8_t ubPdoNumberV)
+{
+   uint8_t  aubDataT[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+
+   aubSampleS[ubPdoNumberV]++;
+   aubDataT[0] = aubSampleS[ubPdoNumberV];
+   CpCoreBufferSetData(&tsCanPortG, eCosBuf_PDO1_TRM + ubPdoNumberV,
+                       &aubDataT[0]);
+}
+
+
+//----------------------------------------------------------------------------//
+// TestBus()                                                                  //
+// run the CAN interrupt, count the PDOs in the transmit log                  //
+//----------------------------------------------------------------------------//
+static void TestBus(void)
+{
+   CanModelFrame_ts *   ptsFrameT;
+   uint8_t              ubFrameT;
+   uint8_t              ubPdoT;
+
+   while(CanModelIrqPending())
+   {
+      CAN0_IRQ();
+   }
+
+   for(ubFrameT = 0; ubFrameT < CanModelTrmCount(); ubFrameT++)
+   {
+      ptsFrameT = CanModelTrmFrame(ubFrameT);
+      ubPdoT = ptsFrameT->ubBufferIdx - eCosBuf_PDO1_TRM;
+      TEST_CHECK(ubPdoT < COS_PDO_TRM_NUMBER);
+      if(ubPdoT < COS_PDO_TRM_NUMBER)
+      {
+         aubFrameS[ubPdoT]++;
+         aubLastS[ubPdoT] = ptsFrameT->aubData[0];
+      }
+   }
+   CanModelTrmClear();
+   TEST_CHECK(EIE2 & 0x02);
+}
+
+
+//----------------------------------------------------------------------------//
+// TestSync()                                                                 //
+// receive a SYNC message                                                     //
+//----------------------------------------------------------------------------//
+static void TestSync(void)
+{
+   TEST_CHECK_EQ(CanModelReceive(TEST_SYNC_ID, 0, 0, 0L), eCosBuf_SYNC);
+   TestBus();
+}
+
+
+//----------------------------------------------------------------------------//
+// TestStart()                                                                //
+// initialise driver and model, SYNC and PDO buffers, the scheduler           //
+//----------------------------------------------------------------------------//
+static void TestStart(uint8_t ubType1V, uint8_t ubType2V)
+{
+   CpCanMsg_ts    tsMsgT;
+   uint8_t        ubPdoT;
+
+   CanModelReset();
+   CpCoreDriverInit(CP_CHANNEL_1, &tsCanPortG);
+   CpCoreIntFunctions(CP_CHANNEL_1, CosMgrCanRcvHandler,
+                      CosMgrCanTrmHandler, CosMgrCanErrHandler);
+   CpCoreBaudrate(&tsCanPortG, CP_BAUD_125K);
+   CpCoreCanMode(&tsCanPortG, CP_MODE_START);
+
+   CpMsgClear(&tsMsgT);
+   CpMsgSetStdId(&tsMsgT, TEST_SYNC_ID);
+   CpCoreBufferInit(&tsCanPortG, &tsMsgT, eCosBuf_SYNC, CP_BUFFER_DIR_RX);
+
+   CpMsgSetDlc(&tsMsgT, 8);
+   CpMsgSetStdId(&tsMsgT, TEST_PDO1_ID);
+   CpCoreBufferInit(&tsCanPortG, &tsMsgT, eCosBuf_PDO1_TRM, CP_BUFFER_DIR_TX);
+   CpMsgSetStdId(&tsMsgT, TEST_PDO2_ID);
+   CpCoreBufferInit(&tsCanPortG, &tsMsgT, eCosBuf_PDO1_TRM + 1,
+                    CP_BUFFER_DIR_TX);
+
+   for(ubPdoT = 0; ubPdoT < COS_PDO_TRM_NUMBER; ubPdoT++)
+   {
+      atsTrmPdoComG[ubPdoT].ulIdentifier  = TEST_PDO1_ID + 0x100 * ubPdoT;
+      atsTrmPdoComG[ubPdoT].ubTransType   = (ubPdoT == 0) ? ubType1V : ubType2V;
+      atsTrmPdoComG[ubPdoT].uwInhibitTime = 0;
+      atsTrmPdoComG[ubPdoT].uwEventTime   = 0;
+      aubSampleS[ubPdoT] = 0;
+      aubFrameS[ubPdoT]  = 0;
+      aubLastS[ubPdoT]   = 0;
+   }
+
+   ubCosMgrStatusG  = eCOS_MGR_RUN;
+   ubStubNodeStateG = NODE_STATE_OPERATIONAL;
+   CosPschInit();
+   TEST_CHECK(EIE2 & 0x02);
+}
+
+
+//----------------------------------------------------------------------------//
+// TestPschSync()                                                             //
+// PDOs of type 1 and 3 leave within the interrupt of the SYNC                //
+//----------------------------------------------------------------------------//
+static void TestPschSync(void)
+{
+   uint8_t  ubSyncT;
+
+   TestStart(1, 3);
+
+   for(ubSyncT = 1; ubSyncT <= 6; ubSyncT++)
+   {
+      TestSync();
+      TEST_CHECK_EQ(aubFrameS[0], ubSyncT);
+      TEST_CHECK_EQ(aubFrameS[1], ubSyncT / 3);
+   }
+   TEST_CHECK_EQ(aubLastS[0], 6);
+   TEST_CHECK_EQ(aubLastS[1], 2);
+
+   //----------------------------------------------------------------
+   // no SYNC is served in the state Pre-operational
+   //
+   ubStubNodeStateG = NODE_STATE_PREOPERATIONAL;
+   TestSync();
+   TestSync();
+   TestSync();
+   TEST_CHECK_EQ(aubFrameS[0], 6);
+   TEST_CHECK_EQ(aubFrameS[1], 2);
+}
+
+
+//----------------------------------------------------------------------------//
+// TestPschQueue()                                                            //
+// a PDO with a pending frame waits for the transmit interrupt                //
+//----------------------------------------------------------------------------//
+static void TestPschQueue(void)
+{
+   uint8_t  ubTickT;
+
+   TestStart(1, 1);
+
+   //----------------------------------------------------------------
+   // the bus is busy, the frames of the first SYNC stay pending in
+   // the CAN controller, the second SYNC queues both PDOs
+   //
+   CanModelTrmHold(1);
+   TestSync();
+   TestSync();
+   TEST_CHECK_EQ(aubFrameS[0], 0);
+   TEST_CHECK_EQ(aubSampleS[0], 1);
+   TEST_CHECK_EQ(aubSampleS[1], 1);
+
+   //----------------------------------------------------------------
+   // the transmit interrupt of each frame hands the queued PDO to
+   // the CAN controller, nothing is lost
+   //
+   CanModelTrmHold(0);
+   TestBus();
+   TestBus();
+   TEST_CHECK_EQ(aubFrameS[0], 2);
+   TEST_CHECK_EQ(aubFrameS[1], 2);
+   TEST_CHECK_EQ(aubLastS[0], 2);
+   TEST_CHECK_EQ(aubLastS[1], 2);
+
+   //----------------------------------------------------------------
+   // a lost transmit interrupt blocks the PDO for the timeout only
+   //
+   CanModelTrmHold(1);
+   TestSync();
+   CanModelObject(eCosBuf_PDO1_TRM)->uwMsgCtrl &= ~0x0800;   // TxIE
+   CanModelObject(eCosBuf_PDO1_TRM + 1)->uwMsgCtrl &= ~0x0800;
+   CanModelTrmHold(0);
+   TestBus();
+   TEST_CHECK_EQ(aubFrameS[0], 3);
+
+   TestSync();
+   TEST_CHECK_EQ(aubFrameS[0], 3);
+   for(ubTickT = 1; ubTickT < TEST_TRM_TIMEOUT; ubTickT++)
+   {
+      CosPschTmrEvent();
+      TestBus();
+   }
+   TEST_CHECK_EQ(aubFrameS[0], 3);
+   CosPschTmrEvent();
+   TestBus();
+   TEST_CHECK_EQ(aubFrameS[0], 4);
+   TEST_CHECK_EQ(aubFrameS[1], 4);
+   TEST_CHECK_EQ(aubLastS[0], 4);
+}
+
+
+//----------------------------------------------------------------------------//
+// TestPschEvent()                                                            //
+// event-driven PDO with inhibit time and event timer                         //
+//----------------------------------------------------------------------------//
+static void TestPschEvent(void)
+{
+   uint8_t  ubTickT;
+
+   TestStart(255, 254);
+
+   //----------------------------------------------------------------
+   // inhibit time 10 ms = 2 ticks, event timer 20 ms = 4 ticks,
+   // the second PDO is not valid
+   //
+   atsTrmPdoComG[0].uwInhibitTime = 100;
+   atsTrmPdoComG[0].uwEventTime   = 20;
+   atsTrmPdoComG[1].ulIdentifier |= 0x80000000;
+   CosPschInit();
+
+   CosPschAppEvent(0);
+   CosPschAppEvent(1);
+   TestBus();
+   TEST_CHECK_EQ(aubFrameS[0], 1);
+
+   CosPschAppEvent(0);
+   TestBus();
+   TEST_CHECK_EQ(aubFrameS[0], 1);
+   CosPschTmrEvent();
+   TestBus();
+   TEST_CHECK_EQ(aubFrameS[0], 1);
+   CosPschTmrEvent();
+   TestBus();
+   TEST_CHECK_EQ(aubFrameS[0], 2);
+
+   //----------------------------------------------------------------
+   // without application event the event timer sends the PDO
+   //
+   for(ubTickT = 1; ubTickT < 4; ubTickT++)
+   {
+      CosPschTmrEvent();
+      TestBus();
+   }
+   TEST_CHECK_EQ(aubFrameS[0], 2);
+   CosPschTmrEvent();
+   TestBus();
+   TEST_CHECK_EQ(aubFrameS[0], 3);
+   TEST_CHECK_EQ(aubLastS[0], 3);
+
+   TestSync();
+   TEST_CHECK_EQ(aubFrameS[0], 3);
+   TEST_CHECK_EQ(aubFrameS[1], 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// TestPschAcyclic()                                                          //
+// type 0 is sent after the SYNC following the application event             //
+//----------------------------------------------------------------------------//
+static void TestPschAcyclic(void)
+{
+   TestStart(0, 255);
+
+   CosPschAppEvent(0);
+   TestBus();
+   TEST_CHECK_EQ(aubFrameS[0], 0);
+   TestSync();
+   TEST_CHECK_EQ(aubFrameS[0], 1);
+   TestSync();
+   TEST_CHECK_EQ(aubFrameS[0], 1);
+
+   //----------------------------------------------------------------
+   // no PDO is sent outside of the state Operational
+   //
+   ubStubNodeStateG = NODE_STATE_PREOPERATIONAL;
+   CosPschAppEvent(1);
+   TestBus();
+   TEST_CHECK_EQ(aubFrameS[1], 0);
+   ubStubNodeStateG = NODE_STATE_OPERATIONAL;
+   CosPschAppEvent(1);
+   TestBus();
+   TEST_CHECK_EQ(aubFrameS[1], 1);
+}
+
+
+//----------------------------------------------------------------------------//
+// main()                                                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+int main(void)
+{
+   TestPschSync();
+   TestPschQueue();
+   TestPschEvent();
+   TestPschAcyclic();
+
+   return(TEST_RESULT("test_cos_psch"));
+}
@@ -0,0 +1,235 @@
+//****************************************************************************//
+// File:          test_cos_tmr.c                                              //
+// Description:   Long-run test of the stack timer on the virtual clock       //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include "SI_C8051F550_Register_Enums.h"
+#include "can_model.h"
+#include "cos_mgr.h"
+#include "cos_emcy.h"
+#include "cos_led.h"
+#include "cos301.h"
+#include "cos_stub.h"
+#include "mc_tmr.h"
+#include "linux_tmr.h"
+#include "test_check.h"
+
+#if COS_DICT_OBJ_1014 < 2
+#error  The test requires COS_DICT_OBJ_1014 >= 2
+#endif
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \file    test_cos_tmr.c
+** \brief   Stack timer over hours of virtual time
+**
+** The timer events of the EMCY and the LED module run from a function
+** timer of linux_tmr.c with a period of one tick, as CosTmrEvent() does
+** on the target. The test moves the virtual clock by 4 hours, half of
+** it by timer ticks and half of it by odd steps of the high-resolution
+** timer. It checks that no time is lost or gained: the tick counter,
+** the high-resolution tick and the number of timer events match the
+** time moved. An EMCY message sent every second must be transmitted
+** within the same tick, the network LED must step every 50 ms.
+*/
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#define  TEST_TICK_US         ((uint32_t) COS_TIMER_PERIOD)
+
+#define  TEST_HOUR_TICKS      (3600UL * 1000000UL / TEST_TICK_US)
+
+//-------------------------------------------------------------------
+// the second half of the time is moved in steps of this number of
+// microseconds, it is no multiple of the timer tick
+//
+#define  TEST_HRES_STEP_US    1234UL
+
+#define  TEST_EMCY_TICKS      (1000000UL / TEST_TICK_US)
+
+
+/*----------------------------------------------------------------------------*\
+** Variables of module                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+TEST_CHECK_DATA;
+
+CpPort_ts            tsCanPortG;
+uint8_t              ubTimerTriggerG;
+
+static uint32_t      ulEventCountS;       // calls of the stack timer event
+static uint32_t      ulEmcySendS;         // EMCY messages sent
+static uint32_t      ulEmcyTrmS;          // EMCY messages transmitted
+static uint32_t      ulEmcyLateS;         // EMCY not transmitted in the tick
+static uint32_t      ulLedStepS;          // steps of the network LED
+
+
+/*----------------------------------------------------------------------------*\
+** Functions                                                                  **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//----------------------------------------------------------------------------//
+// functions of modules which are not linked to this test                     //
+//----------------------------------------------------------------------------//
+uint8_t  ubIdx1001_ErrorRegisterG;
+
+uint8_t  CosMgrIdCheck(uint32_t ulIdV)          { return(1);                }
+void     Cos301_ClearVerifyConfiguration(void)  { }
+void     CosLedNetRed(bool_t btSwitchOnV)       { }
+
+
+//----------------------------------------------------------------------------//
+// CosLedNetGreen()                                                           //
+// in operational state the green LED is switched on by every step            //
+//----------------------------------------------------------------------------//
+void CosLedNetGreen(bool_t btSwitchOnV)
+{
+   if(btSwitchOnV) ulLedStepS++;
+}
+
+
+//----------------------------------------------------------------------------//
+// TestTmrEvent()                                                             //
+// timer events of the stack, confirms the transmission of the EMCY message   //
+//----------------------------------------------------------------------------//
+static void TestTmrEvent(void)
+{
+   ulEventCountS++;
+
+   CosEmcyTmrEvent();
+   if(CanModelTrmCount() > 0)
+   {
+      ulEmcyTrmS++;
+      CanModelTrmClear();
+      CosEmcyTrmEvent();
+   }
+   if(ulEmcyTrmS != ulEmcySendS) ulEmcyLateS++;
+
+   CosLedTmrEvent();
+}
+
+
+//----------------------------------------------------------------------------//
+// TestEmcySend()                                                             //
+// one EMCY message per second                                                //
+//----------------------------------------------------------------------------//
+static void TestEmcySend(void)
+{
+   ulEmcySendS++;
+   CosEmcySend(0x1000, 0L);
+}
+
+
+//----------------------------------------------------------------------------//
+// TestTimerLongRun()                                                         //
+//                                                                            //
+//----------------------------------------------------------------------------//
+static void TestTimerLongRun(void)
+{
+   uint32_t ulTicksT;
+   uint32_t ulHResT;
+   uint32_t ulStepT;
+   uint32_t ulStepsT;
+
+   CanModelReset();
+   CpCoreDriverInit(CP_CHANNEL_1, &tsCanPortG);
+   CpCoreBaudrate(&tsCanPortG, CP_BAUD_125K);
+   CpCoreCanMode(&tsCanPortG, CP_MODE_START);
+
+   ulCosEmcyIdentifierG = 0x81;
+   CosEmcyInit();
+   CosLedInit();
+   CosLedNetworkStatus(eCosLedNet_OPERATIONAL);
+
+   //----------------------------------------------------------------
+   // the EMCY message is sent before the stack timer runs in the
+   // same tick
+   //
+   McTmrInit();
+   TEST_CHECK(McTmrFunctionInit(TestEmcySend, TEST_EMCY_TICKS,
+                                eTMR_CTRL_START) > 0);
+   TEST_CHECK(McTmrFunctionInit(TestTmrEvent, 1, eTMR_CTRL_START) > 0);
+   TEST_CHECK_EQ(McTmrHResInit(eTMR_HRES_TICK_1us), eTMR_ERR_OK);
+   McTmrHResStart();
+
+   //----------------------------------------------------------------
+   // 2 hours by timer ticks, in chunks of an odd number of ticks
+   //
+   ulTicksT = 0;
+   while(ulTicksT < 2 * TEST_HOUR_TICKS)
+   {
+      ulStepT = 2 * TEST_HOUR_TICKS - ulTicksT;
+      if(ulStepT > 997) ulStepT = 997;
+      ulTicksT += McTmrAdvance(ulStepT);
+   }
+   TEST_CHECK_EQ(ulTicksT, 2 * TEST_HOUR_TICKS);
+   TEST_CHECK_EQ(McTmrTick(), 2 * TEST_HOUR_TICKS);
+   TEST_CHECK_EQ(McTmrHResTick(),
+                 (uint32_t) ((uint64_t) 2 * TEST_HOUR_TICKS * TEST_TICK_US));
+
+   //----------------------------------------------------------------
+   // 2 hours by high-resolution steps, the time between two ticks
+   // must be carried over from step to step
+   //
+   ulStepsT = (2 * 3600UL * 1000000UL) / TEST_HRES_STEP_US;
+   for(ulStepT = 0; ulStepT < ulStepsT; ulStepT++)
+   {
+      ulTicksT += McTmrHResAdvance(TEST_HRES_STEP_US);
+   }
+
+   //----------------------------------------------------------------
+   // no drift: ticks and microseconds are exact after 4 hours, the
+   // microseconds wrap around at 32 bit
+   //
+   ulHResT = (uint32_t) ((uint64_t) 2 * TEST_HOUR_TICKS * TEST_TICK_US +
+                         (uint64_t) ulStepsT * TEST_HRES_STEP_US);
+   TEST_CHECK_EQ(ulTicksT, 2 * TEST_HOUR_TICKS +
+                 (uint32_t) (((uint64_t) ulStepsT * TEST_HRES_STEP_US) /
+                             TEST_TICK_US));
+   TEST_CHECK_EQ(McTmrTick(), ulTicksT);
+   TEST_CHECK_EQ(McTmrHResTick(), ulHResT);
+
+   //----------------------------------------------------------------
+   // one stack timer event per tick, one EMCY per second, all EMCY
+   // messages transmitted in their tick, one LED step per 50 ms
+   //
+   TEST_CHECK_EQ(ulEventCountS, ulTicksT);
+   TEST_CHECK_EQ(ulEmcySendS, ulTicksT / TEST_EMCY_TICKS);
+   TEST_CHECK_EQ(ulEmcyTrmS, ulEmcySendS);
+   TEST_CHECK_EQ(ulEmcyLateS, 0);
+   TEST_CHECK_EQ(ulLedStepS, ulTicksT / (COS_LED_PERIOD / COS_TIMER_PERIOD));
+}
+
+
+//----------------------------------------------------------------------------//
+// main()                                                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+int main(void)
+{
+   TestTimerLongRun();
+
+   return(TEST_RESULT("test_cos_tmr"));
+}
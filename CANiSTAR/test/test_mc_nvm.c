@@ -0,0 +1,341 @@
+//****************************************************************************//
+// File:          test_mc_nvm.c                                               //
+// Description:   Power-fail and endurance test of the NVM flash journal      //
+// Author:        Matthias Siegenthaler                                       //
+// e-mail:        matthias@sigitronic.com                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+//                                                                            //
+// Date        History                                                        //
+// ----------  -------------------------------------------------------------- //
+// 17.10.2026  Initial version                                                //
+//                                                                            //
+//****************************************************************************//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <string.h>
+
+#include "mc_nvm.h"
+#include "linux_flash.h"
+#include "test_check.h"
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \file    test_mc_nvm.c
+** \brief   Flash journal of mc_nvm.c on the flash simulation
+**
+** The journal runs on the flash simulation of linux_flash.c. The
+** endurance test performs 200000 random writes of up to 16 bytes
+** while the supply is cut after a random number of flash operations.
+** After every cut the driver is restarted with McNvmInit(): a write
+** which returned an error must not have changed the memory, since the
+** commit byte of a record and the magic byte of a page are written
+** last. A clean restart must return the data of all successful
+** writes. At the end no write may have tried to set a bit
+** and the erase cycles must be spread over all pages.
+** <p>
+** Further tests check that a restart does not force a new page and
+** the one-time import of the data written by the former driver.
+*/
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------
+// these values must match mc_nvm.c
+//
+#define  TEST_NVM_SIZE        0xFF
+#define  TEST_NVM_BASE        0x7400
+#define  TEST_NVM_PAGES       4
+#define  TEST_NVM_REC_MAX     16
+
+#define  TEST_WRITES          200000UL
+
+//-------------------------------------------------------------------
+// the supply is cut after 0 .. TEST_CUT_OPS - 1 flash operations,
+// this is a cut every 100 writes in average
+//
+#define  TEST_CUT_OPS         4000UL
+
+//-------------------------------------------------------------------
+// a clean restart every TEST_RESTART writes
+//
+#define  TEST_RESTART         997UL
+
+
+/*----------------------------------------------------------------------------*\
+** Variables of module                                                        **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+TEST_CHECK_DATA;
+
+static uint32_t      ulRandomS = 0x12345678;
+
+
+/*----------------------------------------------------------------------------*\
+** Functions                                                                  **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//----------------------------------------------------------------------------//
+// TestRandom()                                                               //
+// xorshift generator, the test is repeatable                                 //
+//----------------------------------------------------------------------------//
+static uint32_t TestRandom(uint32_t ulRangeV)
+{
+   ulRandomS ^= ulRandomS << 13;
+   ulRandomS ^= ulRandomS >> 17;
+   ulRandomS ^= ulRandomS << 5;
+
+   return(ulRandomS % ulRangeV);
+}
+
+
+//----------------------------------------------------------------------------//
+// TestEraseCount()                                                           //
+// erase cycles of all pages of the journal                                   //
+//----------------------------------------------------------------------------//
+static uint32_t TestEraseCount(void)
+{
+   uint32_t ulCountT = 0;
+   uint8_t  ubPageT;
+
+   for(ubPageT = 0; ubPageT < TEST_NVM_PAGES; ubPageT++)
+   {
+      ulCountT += FlashSimEraseCount(TEST_NVM_BASE + ubPageT * FLASH_PAGESIZE);
+   }
+   return(ulCountT);
+}
+
+
+//----------------------------------------------------------------------------//
+// TestRestart()                                                              //
+// restart the driver and read the complete memory                            //
+//----------------------------------------------------------------------------//
+static void TestRestart(uint8_t * pubDataV)
+{
+   TEST_CHECK_EQ(McNvmInit(), eNVM_ERR_OK);
+   TEST_CHECK_EQ(McNvmRead(0, pubDataV, TEST_NVM_SIZE), eNVM_ERR_OK);
+}
+
+
+//----------------------------------------------------------------------------//
+// TestNvmRestart()                                                           //
+// a restart does not start a new page                                        //
+//----------------------------------------------------------------------------//
+static void TestNvmRestart(void)
+{
+   uint8_t  aubDataT[TEST_NVM_SIZE];
+   uint8_t  ubValueT;
+
+   FlashSimInit();
+   TestRestart(&aubDataT[0]);
+   TEST_CHECK_EQ(aubDataT[0x20], 0xFF);
+
+   ubValueT = 0x11;
+   TEST_CHECK_EQ(McNvmWrite(0x20, &ubValueT, 1), eNVM_ERR_OK);
+   TEST_CHECK_EQ(TestEraseCount(), 1);
+
+   //----------------------------------------------------------------
+   // the log continues behind the last record
+   //
+   TestRestart(&aubDataT[0]);
+   TEST_CHECK_EQ(aubDataT[0x20], 0x11);
+
+   ubValueT = 0x22;
+   TEST_CHECK_EQ(McNvmWrite(0x21, &ubValueT, 1), eNVM_ERR_OK);
+   TEST_CHECK_EQ(TestEraseCount(), 1);
+
+   TestRestart(&aubDataT[0]);
+   TEST_CHECK_EQ(aubDataT[0x20], 0x11);
+   TEST_CHECK_EQ(aubDataT[0x21], 0x22);
+   TEST_CHECK_EQ(FlashSimWriteErrors(), 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// TestNvmImport()                                                            //
+// the data of the former driver is imported once                             //
+//----------------------------------------------------------------------------//
+static void TestNvmImport(void)
+{
+   uint8_t  aubDataT[TEST_NVM_SIZE];
+   uint16_t uwAddrT;
+   uint8_t  ubValueT;
+
+   //----------------------------------------------------------------
+   // the former driver wrote the memory to the flash at address 0
+   //
+   FlashSimInit();
+   for(uwAddrT = 0; uwAddrT < TEST_NVM_SIZE; uwAddrT++)
+   {
+      FLASH_ByteWrite(uwAddrT, (uint8_t) (uwAddrT ^ 0x5A));
+   }
+
+   //----------------------------------------------------------------
+   // the import is cut by a power fail, it is repeated with the
+   // next start
+   //
+   FlashSimPowerFail(100);
+   McNvmInit();
+   FlashSimPowerOn();
+   TEST_CHECK_EQ(TestEraseCount(), 1);
+
+   TestRestart(&aubDataT[0]);
+   TEST_CHECK_EQ(TestEraseCount(), 2);
+   for(uwAddrT = 0; uwAddrT < TEST_NVM_SIZE; uwAddrT++)
+   {
+      TEST_CHECK_EQ(aubDataT[uwAddrT], (uint8_t) (uwAddrT ^ 0x5A));
+   }
+
+   //----------------------------------------------------------------
+   // the journal replaces the old data
+   //
+   ubValueT = 0x77;
+   TEST_CHECK_EQ(McNvmWrite(0x10, &ubValueT, 1), eNVM_ERR_OK);
+   TestRestart(&aubDataT[0]);
+   TEST_CHECK_EQ(aubDataT[0x10], 0x77);
+   TEST_CHECK_EQ(aubDataT[0x11], 0x11 ^ 0x5A);
+   TEST_CHECK_EQ(TestEraseCount(), 2);
+
+   //----------------------------------------------------------------
+   // an erased memory is not imported again
+   //
+   TEST_CHECK_EQ(McNvmEraseDevice(), eNVM_ERR_OK);
+   TestRestart(&aubDataT[0]);
+   for(uwAddrT = 0; uwAddrT < TEST_NVM_SIZE; uwAddrT++)
+   {
+      TEST_CHECK_EQ(aubDataT[uwAddrT], 0xFF);
+   }
+   TEST_CHECK_EQ(FLASH_ByteRead(0x10), 0x10 ^ 0x5A);
+   TEST_CHECK_EQ(FlashSimWriteErrors(), 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// TestNvmPowerFail()                                                         //
+// random writes with random power fails                                      //
+//----------------------------------------------------------------------------//
+static void TestNvmPowerFail(void)
+{
+   uint8_t  aubModelT[TEST_NVM_SIZE];     // data of the last write
+   uint8_t  aubDataT[TEST_NVM_SIZE];      // data after restart
+   uint8_t  aubWriteT[TEST_NVM_REC_MAX];
+   uint32_t ulWriteT;
+   uint32_t ulCutT     = 0;               // writes cut by a power fail
+   uint32_t ulChangedT = 0;               // cut write changed the memory
+   uint32_t ulLostT    = 0;               // data lost after restart
+   uint32_t ulEraseMinT;
+   uint32_t ulEraseMaxT;
+   uint32_t ulEraseT;
+   uint16_t uwAddrT;
+   uint8_t  ubSizeT;
+   uint8_t  ubCntT;
+   uint8_t  ubPageT;
+
+   FlashSimInit();
+   TestRestart(&aubModelT[0]);
+   FlashSimPowerFail(TestRandom(TEST_CUT_OPS));
+
+   for(ulWriteT = 0; ulWriteT < TEST_WRITES; ulWriteT++)
+   {
+      //--------------------------------------------------------
+      // 1 .. 16 bytes, some of them keep their value
+      //
+      ubSizeT = TestRandom(TEST_NVM_REC_MAX) + 1;
+      uwAddrT = TestRandom(TEST_NVM_SIZE - ubSizeT + 1);
+      for(ubCntT = 0; ubCntT < ubSizeT; ubCntT++)
+      {
+         if(TestRandom(4) == 0)
+         {
+            aubWriteT[ubCntT] = aubModelT[uwAddrT + ubCntT];
+         }
+         else
+         {
+            aubWriteT[ubCntT] = TestRandom(256);
+         }
+      }
+      if(McNvmWrite(uwAddrT, aubWriteT, ubSizeT) == eNVM_ERR_OK)
+      {
+         memcpy(&aubModelT[uwAddrT], aubWriteT, ubSizeT);
+      }
+      else
+      {
+         //------------------------------------------------
+         // the supply has been cut during this write, the
+         // memory holds the data in front of the write
+         //
+         ulCutT++;
+         FlashSimPowerOn();
+         TestRestart(&aubDataT[0]);
+         if(memcmp(aubDataT, aubModelT, sizeof(aubDataT)) != 0)
+         {
+            memcpy(aubModelT, aubDataT, sizeof(aubModelT));
+            ulChangedT++;
+         }
+         FlashSimPowerFail(TestRandom(TEST_CUT_OPS));
+      }
+
+      //--------------------------------------------------------
+      // restart without power fail
+      //
+      if((ulWriteT % TEST_RESTART) == 0)
+      {
+         TestRestart(&aubDataT[0]);
+         if(memcmp(aubDataT, aubModelT, sizeof(aubDataT)) != 0)
+         {
+            memcpy(aubModelT, aubDataT, sizeof(aubModelT));
+            ulLostT++;
+         }
+      }
+   }
+
+   FlashSimPowerOn();
+   TestRestart(&aubDataT[0]);
+   TEST_CHECK(memcmp(aubDataT, aubModelT, sizeof(aubDataT)) == 0);
+
+   TEST_CHECK_EQ(ulChangedT, 0);
+   TEST_CHECK_EQ(ulLostT, 0);
+   TEST_CHECK(ulCutT > TEST_WRITES / 200);
+   TEST_CHECK_EQ(FlashSimWriteErrors(), 0);
+
+   //----------------------------------------------------------------
+   // wear levelling: all pages are erased about equally often, a
+   // cut compaction erases the same page again
+   //
+   ulEraseMinT = 0xFFFFFFFF;
+   ulEraseMaxT = 0;
+   for(ubPageT = 0; ubPageT < TEST_NVM_PAGES; ubPageT++)
+   {
+      ulEraseT = FlashSimEraseCount(TEST_NVM_BASE + ubPageT * FLASH_PAGESIZE);
+      if(ulEraseT < ulEraseMinT) ulEraseMinT = ulEraseT;
+      if(ulEraseT > ulEraseMaxT) ulEraseMaxT = ulEraseT;
+   }
+   TEST_CHECK(ulEraseMinT > 0);
+   TEST_CHECK(ulEraseMaxT - ulEraseMinT <= ulCutT + 1);
+   TEST_CHECK(TestEraseCount() < TEST_WRITES / 4);
+}
+
+
+//----------------------------------------------------------------------------//
+// main()                                                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+int main(void)
+{
+   TestNvmRestart();
+   TestNvmImport();
+   TestNvmPowerFail();
+
+   return(TEST_RESULT("test_mc_nvm"));
+}
@@ -40,6 +40,10 @@
 //#define NO_WATCHDOG      // comment out to not use watchdog function
 
 #define FAST_SINGLE_CH	// Only one I2C channel supported, but this one multiple times faster
+#ifdef IO_LINK			// Timer 2 and SYSCLK_HZ are only set up for this board
+#define I2C_TIMED		// I2C bit timing by Timer 2 instead of counting loops (DelayTime4I2C)
+#define I2C_QUEUE		// I2cSubmit() runs transactions in the Timer 2 interrupt (needs I2C_TIMED)
+#endif
 
 #ifndef NDEBUG
 #define TESTWARE      // comment out for final FIRMWARE
@@ -237,6 +241,15 @@ SI_SBIT(PB_IN, SFR_P2, 1);
 #define DelayTime4SPI	(1)
 #define DelayIteration4I2C	(10)
 #ifdef IO_LINK
+#define SYSCLK_HZ		(48000000L) // HFOSC1, divided by 1 (InitDevice_IOLINK.c)
+#endif
+#ifdef I2C_TIMED
+#ifndef SYSCLK_HZ
+#error "I2C_TIMED needs the SYSCLK_HZ of the board"
+#endif
+#define I2C_PHASE_RELOAD(ns)	((uint16_t)(0x10000L - (((SYSCLK_HZ / 1000L) * (ns) + 999999L) / 1000000L))) // Timer 2 on SYSCLK, rounded up
+#endif
+#ifdef IO_LINK
 #define RESET_DELAY_3ms (850) //(1000 = 3,54ms)
 #else
 #define RESET_DELAY_3ms (500)
@@ -35,9 +35,16 @@
 
 #define I2C_BUFFERSIZE	(16)
 
-extern uint8_t I2C_State;
-extern uint8_t DataToWrite[I2C_BUFFERSIZE];
-extern uint8_t DataToRead[I2C_BUFFERSIZE];
+#define I2C_CHANNELS	(4)
+
+#define I2C_PROFILE_STANDARD	(0) // 100 kHz, shortest phase by fSCL  = 5.0us (two phases per clock, tLOW = 4.7us)
+#define I2C_PROFILE_FAST		(1) // 400 kHz, shortest phase by tLOW  = 1.3us
+#define I2C_PROFILES			(2) // no fast-plus: a phase of 0.5us is 24 SYSCLK cycles, less than the code between two edges
+
+#define I2C_PHASE_NS_STANDARD	(5000)
+#define I2C_PHASE_NS_FAST		(1300)
+
+extern volatile uint8_t xdata I2C_State;
 
 
 //-----------------------------------------------------------------------------
@@ -45,5 +52,8 @@ extern uint8_t DataToRead[I2C_BUFFERSIZE];
 //-----------------------------------------------------------------------------
 uint8_t AccessI2C(uint8_t Channel, uint8_t Address, uint16_t LengthWrite, uint8_t *DataToWrite, uint16_t LengthReadOrWrite, uint8_t *DataToReadOrWrite, uint8_t MultipleStartMode);
 void I2cForceBits(uint8_t Channel, bool BitValue, uint8_t BitCount);
+void I2cTimerInit(void);  // Timer 2 for the bit timing, all channels start with I2C_PROFILE_STANDARD
+void I2cSetProfile(uint8_t Channel, uint8_t Profile); // Profile must suit the slowest device on the channel
+uint16_t I2cGetPhaseReload(uint8_t Channel);
 
 #endif /* I2CDISPATCHER_H_ */
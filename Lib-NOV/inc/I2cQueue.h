@@ -0,0 +1,56 @@
+/*
+ * I2cQueue.h
+ *
+ *  Created on: 17.10.2026
+ *********************************************
+ *    (c)2016-2026 SIGITRONIC SOFTWARE       *
+ *                                           *
+ *      Author: Matthias Siegenthaler        *
+ *                                           *
+ *        matthias@sigitronic.com            *
+ *********************************************
+ */
+
+#ifndef I2CQUEUE_H_
+#define I2CQUEUE_H_
+
+#include "si_toolchain.h"
+#include "I2cDispatcher.h"
+
+#define I2C_QUEUE_SIZE		(8)    // Number of transactions waiting besides the running one
+#define I2C_JOB_PENDING		(0x01) // State of a submitted transaction until it is done (then I2C_PRESENT or I2C_ABSENT)
+
+// A transaction is owned by the caller and must stay untouched until State left I2C_JOB_PENDING.
+// The parameters have the same meaning as the ones of AccessI2C().
+// Done is called from the Timer 2 interrupt when the transaction is finished (may be 0). With Keil the
+// callbacks have to be assigned to the interrupt in the OVERLAY directive, e.g. OVERLAY(I2cQueueIsr ! MyDone).
+// Chain is started right after this transaction, ahead of the queue. If a transaction fails, the rest of its
+// chain is not executed but finished with I2C_ABSENT.
+//
+// Scope: the queue frees the main loop from the waiting of AccessI2C(), not from the bit-banging. Every
+// phase of a bit is one Timer 2 interrupt (about 27 per byte), so it only pays off for short transactions.
+// It is used for the LRA write (VibraLibJob); the sensor reads stay on the blocking AccessI2C(), which waits
+// in I2cLoadProfile() until the queue is empty.
+typedef struct I2cJob I2cJob_t;
+struct I2cJob
+{
+	uint8_t Channel;
+	uint8_t Address;
+	uint16_t LengthWrite;
+	uint8_t *DataToWriteOnly;
+	uint16_t LengthReadOrWrite;
+	uint8_t *DataToReadOrWrite;
+	uint8_t MultipleStartMode;
+	volatile uint8_t State;
+	void (*Done)(I2cJob_t *Job);
+	I2cJob_t *Chain;
+};
+
+
+//-----------------------------------------------------------------------------
+// Exported Function Prototypes
+//-----------------------------------------------------------------------------
+bool I2cSubmit(I2cJob_t *Job);	// false if the queue is full, not to be called from an interrupt
+bool I2cQueueBusy(void);
+
+#endif /* I2CQUEUE_H_ */
@@ -41,6 +41,25 @@ typedef struct {
 	uint8_t retry;
 } MLX90395_BaseStruct;
 
+#define METER_RING_SIZE	(8) // Samples of a MLX90395_RingStruct, power of 2
+
+typedef struct {
+	uint16_t Frame; // Measurement number since StartMeterStream(), the time base is the burst period of the sensor
+	int16_t xAxis;
+	int16_t yAxis;
+	int16_t zAxis;
+	int16_t Temp;
+} MLX90395_SampleStruct;
+
+typedef struct {
+	MLX90395_SampleStruct Sample[METER_RING_SIZE];
+	uint8_t Head;   // Next sample to write
+	uint8_t Count;  // Samples not yet fetched, the oldest one is overwritten when full
+	uint16_t Frame;
+	uint8_t Lost;   // Measurements missed by the polling since StartMeterStream() (saturates), gaps of 8 are not seen
+	uint8_t Running;
+} MLX90395_RingStruct;
+
 #define	BASE_ADDR_A0Lo_A1Lo	(0x18)
 #define	BASE_ADDR_A0Hi_A1Lo	(0x1A)
 #define	BASE_ADDR_A0Lo_A1Hi	(0x1C)
@@ -206,6 +225,9 @@ uint8_t InitMeterI2C(MLX90395_BaseStruct *MeterData);
 uint8_t GetMeterOnceI2C(MLX90395_BaseStruct *MeterData);
 uint8_t SetOperationMeter(MLX90395_BaseStruct *MeterData);
 uint8_t CheckForMeterI2C(MLX90395_BaseStruct *MeterData);
+uint8_t StartMeterStream(MLX90395_BaseStruct *MeterData, MLX90395_RingStruct *Ring);
+uint8_t StreamMeterI2C(MLX90395_BaseStruct *MeterData, MLX90395_RingStruct *Ring);
+bool GetMeterSample(MLX90395_RingStruct *Ring, MLX90395_SampleStruct *Sample);
 
 bool IsMeterReset(uint8_t state);
 bool IsMeterBurstMode(uint8_t state);
@@ -13,11 +13,11 @@
 
 #include "I2cDispatcher.h"
 #include "HalDef.h"
+#ifdef I2C_QUEUE
+#include "I2cQueue.h"
+#endif
 
 volatile uint8_t xdata I2C_State = 0xf0;
-volatile uint8_t DataToWrite[I2C_BUFFERSIZE];
-volatile uint8_t DataToRead[I2C_BUFFERSIZE];
-
 
 //-----------------------------------------------------------------------------
 // I2C-Bus related little helpers
@@ -26,6 +26,76 @@ volatile uint8_t DataToRead[I2C_BUFFERSIZE];
 
 //-----------------------------------------------------------------------------
 
+#ifdef I2C_TIMED
+//-----------------------------------------------------------------------------
+// Bit timing by Timer 2: one phase of a bit (SCL low, SCL high, setup/hold of
+// start and stop) lasts at least the longest minimum time of the profile.
+// Every I2cDelay() restarts the timer, so the code between two delays only
+// stretches a phase but never shortens it.
+//-----------------------------------------------------------------------------
+static const uint16_t code I2cPhaseReload[I2C_PROFILES] = {
+		I2C_PHASE_RELOAD(I2C_PHASE_NS_STANDARD),
+		I2C_PHASE_RELOAD(I2C_PHASE_NS_FAST) };
+
+static uint8_t xdata I2cProfile[I2C_CHANNELS];
+
+//-----------------------------------------------------------------------------
+void I2cTimerInit(void)
+{
+	uint8_t SFRPAGE_save = SFRPAGE;
+	uint8_t Channel;
+
+	SFRPAGE = 0x00;
+	TMR2CN0 = 0;	// 16 bit auto reload, stopped
+	CKCON0 |= CKCON0_T2ML__SYSCLK | CKCON0_T2MH__SYSCLK;
+	TMR2RL = I2cPhaseReload[I2C_PROFILE_STANDARD];
+	SFRPAGE = SFRPAGE_save;
+	for (Channel = 0; Channel < I2C_CHANNELS; Channel++)
+		I2cProfile[Channel] = I2C_PROFILE_STANDARD;
+}
+
+//-----------------------------------------------------------------------------
+void I2cSetProfile(uint8_t Channel, uint8_t Profile)
+{
+	if ((Channel < I2C_CHANNELS) && (Profile < I2C_PROFILES))
+		I2cProfile[Channel] = Profile;
+}
+
+//-----------------------------------------------------------------------------
+uint16_t I2cGetPhaseReload(uint8_t Channel)
+{
+	return (I2cPhaseReload[(Channel < I2C_CHANNELS) ? I2cProfile[Channel] : I2C_PROFILE_STANDARD]);
+}
+
+//-----------------------------------------------------------------------------
+static void I2cLoadProfile(uint8_t Profile)
+{
+	uint8_t SFRPAGE_save = SFRPAGE;
+
+#ifdef I2C_QUEUE
+	while (I2cQueueBusy());	// Timer 2 and the bus belong to the queue until it is empty
+#endif
+	SFRPAGE = 0x00;
+	TMR2RL = I2cPhaseReload[Profile];
+	SFRPAGE = SFRPAGE_save;
+}
+
+//-----------------------------------------------------------------------------
+void I2cDelay(void)
+{
+	uint8_t SFRPAGE_save = SFRPAGE;
+
+	SFRPAGE = 0x00;
+	TMR2CN0_TR2 = 0;
+	TMR2 = TMR2RL;
+	TMR2CN0_TF2H = 0;
+	TMR2CN0_TR2 = 1;
+	while (!TMR2CN0_TF2H);
+	SFRPAGE = SFRPAGE_save;
+}
+#else
+#define I2cLoadProfile(Profile)
+
 //-----------------------------------------------------------------------------
 void I2cDelay(void)
 {
@@ -33,6 +103,7 @@ void I2cDelay(void)
 	for (x = 0; x < DelayTime4I2C; x)
 		x++;
 }
+#endif // I2C_TIMED
 
 #ifndef FAST_SINGLE_CH
 
@@ -164,6 +235,7 @@ uint8_t I2C_SDA_Get(uint8_t Channel)
 //-----------------------------------------------------------------------------
 void I2cForceBits(uint8_t Channel, bool BitValue, uint8_t BitCount)
 {
+	I2cLoadProfile(I2cProfile[Channel]);
 	I2cDelay();				//Start
 	I2C_SCL_Set(Channel);
 	I2cDelay();
@@ -286,10 +358,11 @@ void I2cWrite(uint8_t Channel, uint8_t Data)   // W-Phase
 			; // clock stretching
 		I2cDelay();
 		I2C_SCL_Clr(Channel);
-		I2cDelay();
 		i >>= 1;
+		if (!i)
+			I2C_SDA_Set(Channel); // release SDA for the acknowledge a phase before SCL rises
+		I2cDelay();
 	} while (i);
-	I2C_SDA_Set(Channel);
 }
 
 //-----------------------------------------------------------------------------
@@ -321,6 +394,7 @@ uint8_t AccessI2C(uint8_t Channel, uint8_t Address, uint16_t LengthWrite, uint8_
 	uint16_t Offset;
 
 	//Pos.u16 = Position;
+	I2cLoadProfile(I2cProfile[Channel]);
 	I2cStart(Channel);
 	I2cWrite(Channel, ((MultipleStartMode == I2C_MODE_NOREPEAT_START) && LengthReadOrWrite)? Address | READ_FLAG : Address); // Address to Write
 
@@ -423,7 +497,7 @@ void I2cForceBits(uint8_t Channel, bool BitValue, uint8_t BitCount)
 {
 	if (Channel) return; // Only Channel0 supported in this fast version
 
-
+	I2cLoadProfile(I2cProfile[0]);
 
 	I2cDelay();				//Start
 	I2C_SCL_Ch0 = 1;
@@ -547,10 +621,11 @@ void I2cWrite(uint8_t Data)   // W-Phase
 			; // clock stretching
 		I2cDelay();
 		I2C_SCL_Ch0 = 0;
-		I2cDelay();
 		i >>= 1;
+		if (!i)
+			I2C_SDA_Ch0 = 1; // release SDA for the acknowledge a phase before SCL rises
+		I2cDelay();
 	} while (i);
-	I2C_SDA_Ch0 = 1;
 }
 
 //-----------------------------------------------------------------------------
@@ -583,6 +658,7 @@ uint8_t AccessI2C(uint8_t Channel, uint8_t Address, uint16_t LengthWrite, uint8_
 
 	if (Channel) // Only Channel0 supported in this fast version
 		return (I2C_ABSENT);
+	I2cLoadProfile(I2cProfile[0]);
 	I2cStart();
 	I2cWrite(((MultipleStartMode == I2C_MODE_NOREPEAT_START) && LengthReadOrWrite)? Address | READ_FLAG : Address); // Address to Write
 
@@ -0,0 +1,417 @@
+/*
+ * I2cQueue.c
+ *
+ *  Created on: 17.10.2026
+ *********************************************
+ *    (c)2016-2026 SIGITRONIC SOFTWARE       *
+ *                                           *
+ *      Author: Matthias Siegenthaler        *
+ *                                           *
+ *        matthias@sigitronic.com            *
+ *********************************************
+ */
+
+#include "I2cQueue.h"
+#include "HalDef.h"
+
+#ifdef I2C_QUEUE
+#ifndef I2C_TIMED
+#error "I2C_QUEUE needs the Timer 2 bit timing of I2C_TIMED"
+#endif
+
+//-----------------------------------------------------------------------------
+// The Timer 2 interrupt executes one phase of the bit sequence of AccessI2C()
+// per tick. The timer is restarted after the lines have been changed, so a
+// late interrupt stretches a phase but never shortens the next one.
+//
+// The lines are still bit-banged, so the queue costs one interrupt per phase,
+// about 27 per byte (test/TestI2cQueue.cpp). The ticks are one phase apart:
+// 240 SYSCLK cycles with I2C_PROFILE_STANDARD and 63 with I2C_PROFILE_FAST.
+// The main loop only gets what the interrupt leaves of a tick, so the queue
+// is used for the short LRA write of VibraLibJob only. The sensor reads are
+// longer and stay on the blocking AccessI2C().
+//-----------------------------------------------------------------------------
+#ifdef FAST_SINGLE_CH
+#define Q_SCL_SET()		I2C_SCL_Ch0 = 1
+#define Q_SCL_CLR()		I2C_SCL_Ch0 = 0
+#define Q_SDA_SET()		I2C_SDA_Ch0 = 1
+#define Q_SDA_CLR()		I2C_SDA_Ch0 = 0
+#define Q_SCL_GET()		(I2C_SCL_Ch0)
+#define Q_SDA_GET()		(I2C_SDA_Ch0)
+#define Q_CHANNELS		(1)
+#else
+#define Q_SCL_SET()		if (I2cQChannel) I2C_SCL_Ch1 = 1; else I2C_SCL_Ch0 = 1
+#define Q_SCL_CLR()		if (I2cQChannel) I2C_SCL_Ch1 = 0; else I2C_SCL_Ch0 = 0
+#define Q_SDA_SET()		if (I2cQChannel) I2C_SDA_Ch1 = 1; else I2C_SDA_Ch0 = 1
+#define Q_SDA_CLR()		if (I2cQChannel) I2C_SDA_Ch1 = 0; else I2C_SDA_Ch0 = 0
+#define Q_SCL_GET()		((I2cQChannel) ? I2C_SCL_Ch1 : I2C_SCL_Ch0)
+#define Q_SDA_GET()		((I2cQChannel) ? I2C_SDA_Ch1 : I2C_SDA_Ch0)
+#define Q_CHANNELS		(2)
+#endif
+
+#define Q_PHASE_START		(0) // S- and SR-Phase
+#define Q_PHASE_WRITE		(1) // W-Phase
+#define Q_PHASE_GET_ACK		(2) // A-Phase from slave
+#define Q_PHASE_READ		(3) // R-Phase
+#define Q_PHASE_SEND_ACK	(4) // A-Phase to slave
+#define Q_PHASE_STOP		(5) // P-Phase
+
+#define Q_SECTION_ADDRESS	(0)
+#define Q_SECTION_WRITE		(1)
+#define Q_SECTION_WRITE2	(2)
+#define Q_SECTION_ADDRESS_RD (3)
+#define Q_SECTION_READ		(4)
+
+static I2cJob_t * xdata I2cQRing[I2C_QUEUE_SIZE];
+static volatile uint8_t I2cQHead;
+static volatile uint8_t I2cQCount;
+
+static volatile uint8_t I2cQActive;	// a transaction is running
+static I2cJob_t *I2cQJob;
+static uint8_t I2cQChannel;
+static uint8_t I2cQPhase;
+static uint8_t I2cQStep;
+static uint8_t I2cQSection;
+static uint16_t I2cQOffset;
+static uint8_t I2cQMask;
+static uint8_t I2cQByte;
+static uint8_t I2cQResult;
+
+//-----------------------------------------------------------------------------
+bool I2cQueueBusy(void)
+{
+	return (I2cQActive || I2cQCount);
+}
+
+//-----------------------------------------------------------------------------
+bool I2cSubmit(I2cJob_t *Job)
+{
+	I2cJob_t *Link;
+	bool ET2_SAVE;
+	uint8_t SFRPAGE_save;
+
+	if (I2cQCount >= I2C_QUEUE_SIZE)
+		return (false);
+
+	for (Link = Job; Link; Link = Link->Chain)
+		Link->State = I2C_JOB_PENDING;
+
+	ET2_SAVE = IE_ET2;
+	IE_ET2 = 0;
+	I2cQRing[(I2cQHead + I2cQCount) % I2C_QUEUE_SIZE] = Job;
+	I2cQCount++;
+	if (!I2cQActive)	// idle: the interrupt picks up the transaction right away
+	{
+		SFRPAGE_save = SFRPAGE;
+		SFRPAGE = 0x00;
+		TMR2CN0_TR2 = 1;
+		TMR2CN0_TF2H = 1;
+		SFRPAGE = SFRPAGE_save;
+		ET2_SAVE = 1;
+	}
+	IE_ET2 = ET2_SAVE;
+	return (true);
+}
+
+//-----------------------------------------------------------------------------
+static void I2cQBegin(I2cJob_t *Job)
+{
+	I2cQJob = Job;
+	I2cQActive = 1;
+	I2cQChannel = Job->Channel;
+	I2cQSection = Q_SECTION_ADDRESS;
+	I2cQByte = ((Job->MultipleStartMode == I2C_MODE_NOREPEAT_START) && Job->LengthReadOrWrite)? Job->Address | READ_FLAG : Job->Address;
+	I2cQPhase = Q_PHASE_START;
+	I2cQStep = 0;
+	TMR2RL = I2cGetPhaseReload(I2cQChannel);
+	if (I2cQChannel >= Q_CHANNELS)
+	{
+		I2cQResult = I2C_ABSENT;
+		I2cQPhase = Q_PHASE_STOP;
+		I2cQStep = 3;	// no bus activity
+	}
+}
+
+//-----------------------------------------------------------------------------
+static void I2cQFinish(void)
+{
+	I2cJob_t *Job = I2cQJob;
+	I2cJob_t *Next = Job->Chain;
+
+	Job->State = I2cQResult;
+	if (Job->Done)
+		Job->Done(Job);
+
+	if (I2cQResult != I2C_PRESENT)
+	{
+		while (Next)	// the chain depends on this transaction
+		{
+			Next->State = I2C_ABSENT;
+			if (Next->Done)
+				Next->Done(Next);
+			Next = Next->Chain;
+		}
+	}
+
+	if (Next)
+	{
+		I2cQBegin(Next);
+	}
+	else if (I2cQCount)
+	{
+		I2cQBegin(I2cQRing[I2cQHead]);
+		I2cQHead = (I2cQHead + 1) % I2C_QUEUE_SIZE;
+		I2cQCount--;
+	}
+	else
+	{
+		I2cQActive = 0;
+	}
+}
+
+//-----------------------------------------------------------------------------
+static void I2cQNextByte(void)   // after an acknowledged byte
+{
+	I2cJob_t *Job = I2cQJob;
+
+	switch (I2cQSection)
+	{
+	case Q_SECTION_ADDRESS:
+		I2cQSection = Q_SECTION_WRITE;
+		I2cQOffset = 0;
+		break;
+	case Q_SECTION_ADDRESS_RD:
+		I2cQSection = Q_SECTION_READ;
+		I2cQOffset = 0;
+		I2cQPhase = Q_PHASE_READ;
+		I2cQStep = 0;
+		I2cQMask = 0x80;
+		I2cQByte = 0;
+		return;
+	default:
+		I2cQOffset++;
+		break;
+	}
+
+	if ((I2cQSection == Q_SECTION_WRITE) && (I2cQOffset >= Job->LengthWrite))
+	{
+		I2cQSection = Q_SECTION_WRITE2;
+		I2cQOffset = 0;
+		if (Job->LengthReadOrWrite && (Job->MultipleStartMode != I2C_MODE_WRITE_ALL_SECTIONS))
+		{
+			if (Job->MultipleStartMode == I2C_MODE_MULTIPLE_START)
+			{
+				I2cQSection = Q_SECTION_ADDRESS_RD;
+				I2cQByte = Job->Address | READ_FLAG;
+				I2cQPhase = Q_PHASE_START;   // SR-Phase
+				I2cQStep = 0;
+			}
+			else
+			{
+				I2cQSection = Q_SECTION_READ;
+				I2cQPhase = Q_PHASE_READ;
+				I2cQStep = 0;
+				I2cQMask = 0x80;
+				I2cQByte = 0;
+			}
+			return;
+		}
+	}
+
+	if ((I2cQSection == Q_SECTION_WRITE2) && (I2cQOffset >= Job->LengthReadOrWrite))
+	{
+		I2cQResult = I2C_PRESENT;
+		I2cQPhase = Q_PHASE_STOP;
+		I2cQStep = 0;
+		return;
+	}
+
+	I2cQByte = (I2cQSection == Q_SECTION_WRITE) ? *(Job->DataToWriteOnly + I2cQOffset) : *(Job->DataToReadOrWrite + I2cQOffset);
+	I2cQPhase = Q_PHASE_WRITE;
+	I2cQStep = 0;
+	I2cQMask = 0x80;
+}
+
+//-----------------------------------------------------------------------------
+static void I2cQTick(void)
+{
+	switch (I2cQPhase)
+	{
+	case Q_PHASE_START:
+		switch (I2cQStep++)
+		{
+		case 0:
+			Q_SCL_SET();
+			break;
+		case 1:
+			if (!Q_SCL_GET()) { I2cQStep--; break; } // clock stretching
+			Q_SDA_SET();
+			break;
+		case 2:
+			Q_SDA_CLR();
+			break;
+		default:
+			Q_SCL_CLR();
+			I2cQPhase = Q_PHASE_WRITE;
+			I2cQStep = 0;
+			I2cQMask = 0x80;
+			break;
+		}
+		break;
+
+	case Q_PHASE_WRITE:
+		switch (I2cQStep++)
+		{
+		case 0:
+			if (I2cQByte & I2cQMask) { Q_SDA_SET(); } else { Q_SDA_CLR(); }
+			break;
+		case 1:
+			Q_SCL_SET();
+			break;
+		default:
+			if (!Q_SCL_GET()) { I2cQStep--; break; } // clock stretching
+			Q_SCL_CLR();
+			I2cQStep = 0;
+			I2cQMask >>= 1;
+			if (!I2cQMask)
+				I2cQPhase = Q_PHASE_GET_ACK;
+			break;
+		}
+		break;
+
+	case Q_PHASE_GET_ACK:
+		switch (I2cQStep++)
+		{
+		case 0:
+			Q_SDA_SET();
+			break;
+		case 1:
+			Q_SCL_SET();
+			break;
+		default:
+			if (!Q_SCL_GET()) { I2cQStep--; break; } // clock stretching
+			if (Q_SDA_GET() == 0)
+			{
+				Q_SCL_CLR();
+				I2cQNextByte();
+			}
+			else
+			{
+				Q_SCL_CLR();
+				I2cQResult = I2C_ABSENT;
+				I2cQPhase = Q_PHASE_STOP;
+				I2cQStep = 0;
+			}
+			break;
+		}
+		break;
+
+	case Q_PHASE_READ:	// SDA is released, by the GET_ACK or SEND_ACK phase before
+		switch (I2cQStep++)
+		{
+		case 0:
+			Q_SCL_SET();
+			break;
+		default:
+			if (!Q_SCL_GET()) { I2cQStep--; break; } // clock stretching
+			if (Q_SDA_GET())
+				I2cQByte |= I2cQMask;
+			Q_SCL_CLR();
+			I2cQStep = 0;
+			I2cQMask >>= 1;
+			if (!I2cQMask)
+			{
+				*(I2cQJob->DataToReadOrWrite + I2cQOffset) = I2cQByte;
+				I2cQPhase = Q_PHASE_SEND_ACK;
+			}
+			break;
+		}
+		break;
+
+	case Q_PHASE_SEND_ACK:
+		switch (I2cQStep++)
+		{
+		case 0:
+			if (I2cQOffset + 1 == I2cQJob->LengthReadOrWrite) { Q_SDA_SET(); } else { Q_SDA_CLR(); }
+			break;
+		case 1:
+			Q_SCL_SET();
+			break;
+		default:
+			if (!Q_SCL_GET()) { I2cQStep--; break; } // clock stretching
+			Q_SCL_CLR();
+			I2cQStep = 0;
+			I2cQOffset++;
+			if (I2cQOffset < I2cQJob->LengthReadOrWrite)
+			{
+				Q_SDA_SET();	// a phase before SCL rises for the next bit of the slave
+				I2cQPhase = Q_PHASE_READ;
+				I2cQMask = 0x80;
+				I2cQByte = 0;
+			}
+			else
+			{
+				I2cQResult = I2C_PRESENT;
+				I2cQPhase = Q_PHASE_STOP;
+			}
+			break;
+		}
+		break;
+
+	default: // Q_PHASE_STOP
+		switch (I2cQStep++)
+		{
+		case 0:
+			Q_SDA_CLR();
+			break;
+		case 1:
+			Q_SCL_SET();
+			break;
+		case 2:
+			if (!Q_SCL_GET()) { I2cQStep--; break; } // clock stretching
+			Q_SDA_SET();
+			break;
+		default:
+			I2cQFinish();	// bus free time has elapsed
+			break;
+		}
+		break;
+	}
+}
+
+//-----------------------------------------------------------------------------
+SI_INTERRUPT (I2cQueueIsr, TIMER2_IRQn)
+{
+	uint8_t SFRPAGE_save = SFRPAGE;
+
+	SFRPAGE = 0x00;
+	TMR2CN0_TF2H = 0;
+
+	if (!I2cQActive)
+	{
+		if (I2cQCount)
+		{
+			I2cQBegin(I2cQRing[I2cQHead]);
+			I2cQHead = (I2cQHead + 1) % I2C_QUEUE_SIZE;
+			I2cQCount--;
+		}
+	}
+	else
+	{
+		I2cQTick();
+	}
+
+	TMR2CN0_TR2 = 0;
+	if (!I2cQActive)	// queue empty: Timer 2 returns to I2cDelay()
+	{
+		IE_ET2 = 0;
+	}
+	else
+	{
+		TMR2 = TMR2RL;
+		TMR2CN0_TR2 = 1;
+	}
+	SFRPAGE = SFRPAGE_save;
+}
+
+#endif // I2C_QUEUE
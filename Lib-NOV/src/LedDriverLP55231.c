@@ -15,82 +15,104 @@
 #include "HalDef.h"
 #include <string.h>
 
+// Simple Singleton approach like LedGetAdc(): one LP55231 per program context
+#define LED_PWM_RESYNC	(32)	// Calls of LedSetSegmentRGB() between two read backs of the PWM registers
+
+static uint8_t xdata LedWrite[10];
+static uint8_t xdata LedPwm[9];	// PWM D1..D9 as last read from or written to the chip
+static bool LedPwmValid = false;
+static uint8_t LedPwmAge = 0;
+
 uint8_t LedSetSegmentRGB(uint8_t Channel, uint8_t BaseAddress, uint8_t LedRed, uint8_t LedGreen, uint8_t LedBlue, uint8_t Segment){
 
 	uint8_t State = I2C_PRESENT;
 
-	DataToWrite[0] = IllumD1_PWM;	   // First of Led PWM Registers
-	State = (AccessI2C(Channel, BaseAddress, 1, &DataToWrite, 9, &DataToRead, I2C_MODE_MULTIPLE_START)) ? I2C_ABSENT : State;
+	if (++LedPwmAge >= LED_PWM_RESYNC) // a chip reset by a supply dip or EMI is not seen otherwise
+		LedPwmValid = false;
+	if (!LedPwmValid) // the chip is read back now and then, in between the shadow copy is merged
+	{
+		LedPwmAge = 0;
+		LedWrite[0] = IllumD1_PWM;	   // First of Led PWM Registers
+		State = (AccessI2C(Channel, BaseAddress, 1, &LedWrite, 9, &LedPwm, I2C_MODE_MULTIPLE_START)) ? I2C_ABSENT : State;
+		LedPwmValid = !State;
+	}
 	if (!State)
 	{
+		LedWrite[0] = IllumD1_PWM;	   // First of Led PWM Registers
 		if (Segment < 8)
-			memset(&DataToWrite[1], 0, 9);
+			memset(&LedWrite[1], 0, 9);
 		else
-			memcpy(&DataToWrite[1], &DataToRead, 9);
+			memcpy(&LedWrite[1], &LedPwm, 9);
 		switch (Segment)
 		{
 			case 4:
 			case 12:
-				DataToWrite[1] =  LedGreen; // PWM D1 green
-				DataToWrite[2] =  LedBlue; // PWM D2 blue
-				DataToWrite[7] =  LedRed; // PWM D7 Red
+				LedWrite[1] =  LedGreen; // PWM D1 green
+				LedWrite[2] =  LedBlue; // PWM D2 blue
+				LedWrite[7] =  LedRed; // PWM D7 Red
 
 				break;
 			case 2:
 			case 10:
-				DataToWrite[3] =  LedGreen; // PWM D3 green
-				DataToWrite[4] =  LedBlue; // PWM D4 blue
-				DataToWrite[8] =  LedRed; // PWM D8 Red
+				LedWrite[3] =  LedGreen; // PWM D3 green
+				LedWrite[4] =  LedBlue; // PWM D4 blue
+				LedWrite[8] =  LedRed; // PWM D8 Red
 				break;
 			case 6:
 			case 14:
-				DataToWrite[1] =  LedGreen; // PWM D1 green
-				DataToWrite[2] =  LedBlue; // PWM D2 blue
-				DataToWrite[3] =  LedGreen; // PWM D3 green
-				DataToWrite[4] =  LedBlue; // PWM D4 blue
-				DataToWrite[7] =  LedRed; // PWM D7 Red
-				DataToWrite[8] =  LedRed; // PWM D8 Red
+				LedWrite[1] =  LedGreen; // PWM D1 green
+				LedWrite[2] =  LedBlue; // PWM D2 blue
+				LedWrite[3] =  LedGreen; // PWM D3 green
+				LedWrite[4] =  LedBlue; // PWM D4 blue
+				LedWrite[7] =  LedRed; // PWM D7 Red
+				LedWrite[8] =  LedRed; // PWM D8 Red
 				break;
 			case 1:
 			case 9:
-				DataToWrite[5] =  LedGreen; // PWM D5 green
-				DataToWrite[6] =  LedBlue; // PWM D6 blue
-				DataToWrite[9] =  LedRed; // PWM D9 Red
+				LedWrite[5] =  LedGreen; // PWM D5 green
+				LedWrite[6] =  LedBlue; // PWM D6 blue
+				LedWrite[9] =  LedRed; // PWM D9 Red
 				break;
 			case 5:
 			case 13:
-				DataToWrite[1] =  LedGreen; // PWM D1 green
-				DataToWrite[2] =  LedBlue; // PWM D2 blue
-				DataToWrite[5] =  LedGreen; // PWM D5 green
-				DataToWrite[6] =  LedBlue; // PWM D6 blue
-				DataToWrite[7] =  LedRed; // PWM D7 Red
-				DataToWrite[9] =  LedRed; // PWM D9 Red
+				LedWrite[1] =  LedGreen; // PWM D1 green
+				LedWrite[2] =  LedBlue; // PWM D2 blue
+				LedWrite[5] =  LedGreen; // PWM D5 green
+				LedWrite[6] =  LedBlue; // PWM D6 blue
+				LedWrite[7] =  LedRed; // PWM D7 Red
+				LedWrite[9] =  LedRed; // PWM D9 Red
 				break;
 			case 3:
 			case 11:
-				DataToWrite[3] =  LedGreen; // PWM D3 green
-				DataToWrite[4] =  LedBlue; // PWM D4 blue
-				DataToWrite[5] =  LedGreen; // PWM D5 green
-				DataToWrite[6] =  LedBlue; // PWM D6 blue
-				DataToWrite[8] =  LedRed; // PWM D8 Red
-				DataToWrite[9] =  LedRed; // PWM D9 Red
+				LedWrite[3] =  LedGreen; // PWM D3 green
+				LedWrite[4] =  LedBlue; // PWM D4 blue
+				LedWrite[5] =  LedGreen; // PWM D5 green
+				LedWrite[6] =  LedBlue; // PWM D6 blue
+				LedWrite[8] =  LedRed; // PWM D8 Red
+				LedWrite[9] =  LedRed; // PWM D9 Red
 				break;
 			case 8:
 				break;
 			default:
-				DataToWrite[1] =  LedGreen; // PWM D1 green
-				DataToWrite[2] =  LedBlue; // PWM D2 blue
-				DataToWrite[3] =  LedGreen; // PWM D3 green
-				DataToWrite[4] =  LedBlue; // PWM D4 blue
-				DataToWrite[5] =  LedGreen; // PWM D5 green
-				DataToWrite[6] =  LedBlue; // PWM D6 blue
-				DataToWrite[7] =  LedRed; // PWM D7 Red
-				DataToWrite[8] =  LedRed; // PWM D8 Red
-				DataToWrite[9] =  LedRed; // PWM D9 Red
+				LedWrite[1] =  LedGreen; // PWM D1 green
+				LedWrite[2] =  LedBlue; // PWM D2 blue
+				LedWrite[3] =  LedGreen; // PWM D3 green
+				LedWrite[4] =  LedBlue; // PWM D4 blue
+				LedWrite[5] =  LedGreen; // PWM D5 green
+				LedWrite[6] =  LedBlue; // PWM D6 blue
+				LedWrite[7] =  LedRed; // PWM D7 Red
+				LedWrite[8] =  LedRed; // PWM D8 Red
+				LedWrite[9] =  LedRed; // PWM D9 Red
 				break;
 		}
-		if(memcmp(&DataToWrite[1], &DataToRead, 9))
-			State = (AccessI2C(Channel, BaseAddress, 10, &DataToWrite, 0, &DataToRead, I2C_MODE_MULTIPLE_START)) ? I2C_ABSENT : State;
+		if(memcmp(&LedWrite[1], &LedPwm, 9))
+		{
+			State = (AccessI2C(Channel, BaseAddress, 10, &LedWrite, 0, 0, I2C_MODE_MULTIPLE_START)) ? I2C_ABSENT : State;
+			if (!State)
+				memcpy(&LedPwm, &LedWrite[1], 9);
+			else
+				LedPwmValid = false;
+		}
 	}
 	return (State);
 }
@@ -101,9 +123,10 @@ uint8_t LedInitSetMaxCurrent(uint8_t Channel, uint8_t BaseAddress, uint8_t LedRe
 	const uint8_t code EnableSettings[2] = {IllumENABLE_ENGINE_CNTRL1, 0x40}; // Chip Enable
 	const uint8_t code MiscSettings[2] = {IllumMISC, 0x59}; // MISC Register Internal Oscillator On
 	uint8_t State = I2C_PRESENT;
-	State = (AccessI2C(Channel, BaseAddress, sizeof(ResetSettings), &ResetSettings, 0, &DataToRead, I2C_MODE_MULTIPLE_START)) ? I2C_ABSENT : State;
-	State = (AccessI2C(Channel, BaseAddress, sizeof(EnableSettings), &EnableSettings, 0, &DataToRead, I2C_MODE_MULTIPLE_START)) ? I2C_ABSENT : State;
-	State = (AccessI2C(Channel, BaseAddress, sizeof(MiscSettings), &MiscSettings, 0, &DataToRead, I2C_MODE_MULTIPLE_START)) ? I2C_ABSENT : State;
+	LedPwmValid = false; // the reset clears the PWM registers
+	State = (AccessI2C(Channel, BaseAddress, sizeof(ResetSettings), &ResetSettings, 0, 0, I2C_MODE_MULTIPLE_START)) ? I2C_ABSENT : State;
+	State = (AccessI2C(Channel, BaseAddress, sizeof(EnableSettings), &EnableSettings, 0, 0, I2C_MODE_MULTIPLE_START)) ? I2C_ABSENT : State;
+	State = (AccessI2C(Channel, BaseAddress, sizeof(MiscSettings), &MiscSettings, 0, 0, I2C_MODE_MULTIPLE_START)) ? I2C_ABSENT : State;
 	State = (LedSetMaxCurrent(Channel, BaseAddress, LedRed789, LedGreen135, LedBlue246)) ?  I2C_ABSENT : State;
 	return State;
 }
@@ -112,34 +135,34 @@ uint8_t LedInitSetMaxCurrent(uint8_t Channel, uint8_t BaseAddress, uint8_t LedRe
 uint8_t LedSetMaxCurrent(uint8_t Channel, uint8_t BaseAddress, uint8_t LedRed789, uint8_t LedGreen135, uint8_t LedBlue246)
 {
 	uint8_t State = I2C_PRESENT;
-	DataToWrite[0] = IllumD1_CURRENT_CONTROL;	   // First of Led PWM Registers
-	DataToWrite[1] = LedGreen135;
-	DataToWrite[2] = LedBlue246;
-	DataToWrite[3] = LedGreen135;
-	DataToWrite[4] = LedBlue246;
-	DataToWrite[5] = LedGreen135;
-	DataToWrite[6] = LedBlue246;
-	DataToWrite[7] = LedRed789;
-	DataToWrite[8] = LedRed789;
-	DataToWrite[9] = LedRed789;
-	State = (AccessI2C(Channel, BaseAddress, 10, &DataToWrite, 0, &DataToRead, I2C_MODE_MULTIPLE_START)) ? I2C_ABSENT : State;
+	LedWrite[0] = IllumD1_CURRENT_CONTROL;	   // First of Led PWM Registers
+	LedWrite[1] = LedGreen135;
+	LedWrite[2] = LedBlue246;
+	LedWrite[3] = LedGreen135;
+	LedWrite[4] = LedBlue246;
+	LedWrite[5] = LedGreen135;
+	LedWrite[6] = LedBlue246;
+	LedWrite[7] = LedRed789;
+	LedWrite[8] = LedRed789;
+	LedWrite[9] = LedRed789;
+	State = (AccessI2C(Channel, BaseAddress, 10, &LedWrite, 0, 0, I2C_MODE_MULTIPLE_START)) ? I2C_ABSENT : State;
 	return State;
 }
 
 uint8_t LedSetModeLogTC(uint8_t Channel, uint8_t BaseAddress, uint8_t LedRed789, uint8_t LedGreen135, uint8_t LedBlue246)
 {
 	uint8_t State = I2C_PRESENT;
-	DataToWrite[0] = IllumD1_CONTROL;	   // First of Led PWM Registers
-	DataToWrite[1] = LedGreen135;
-	DataToWrite[2] = LedBlue246;
-	DataToWrite[3] = LedGreen135;
-	DataToWrite[4] = LedBlue246;
-	DataToWrite[5] = LedGreen135;
-	DataToWrite[6] = LedBlue246;
-	DataToWrite[7] = LedRed789;
-	DataToWrite[8] = LedRed789;
-	DataToWrite[9] = LedRed789;
-	State = (AccessI2C(Channel, BaseAddress, 10, &DataToWrite, 0, &DataToRead, I2C_MODE_MULTIPLE_START)) ? I2C_ABSENT : State;
+	LedWrite[0] = IllumD1_CONTROL;	   // First of Led PWM Registers
+	LedWrite[1] = LedGreen135;
+	LedWrite[2] = LedBlue246;
+	LedWrite[3] = LedGreen135;
+	LedWrite[4] = LedBlue246;
+	LedWrite[5] = LedGreen135;
+	LedWrite[6] = LedBlue246;
+	LedWrite[7] = LedRed789;
+	LedWrite[8] = LedRed789;
+	LedWrite[9] = LedRed789;
+	State = (AccessI2C(Channel, BaseAddress, 10, &LedWrite, 0, 0, I2C_MODE_MULTIPLE_START)) ? I2C_ABSENT : State;
 	return (State);
 }
 
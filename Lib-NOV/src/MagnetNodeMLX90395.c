@@ -15,6 +15,9 @@
 #include "I2cDispatcher.h"
 #include "HalDef.h"
 
+static uint8_t xdata MeterWrite[3];
+static uint8_t xdata MeterRead[12];
+
 /* Initializing the master */
 
 volatile struct NotchPos xdata Positions[24];
@@ -137,12 +140,12 @@ uint8_t GetMeterOnceI2C(MLX90395_BaseStruct *MeterData) {
 #if TOGGLE_CBUS_METER == 1
 	static bool togglePin = 0;
 #endif
-	DataToWrite[0] = MeterData->ReadMode; // command to Write
-	I2C_State =  AccessI2C(MeterData->BusChannel,MeterData->BusAddress, 1, DataToWrite, 12, DataToRead, I2C_MODE_MULTIPLE_START);
+	MeterWrite[0] = MeterData->ReadMode; // command to Write
+	I2C_State =  AccessI2C(MeterData->BusChannel,MeterData->BusAddress, 1, MeterWrite, 12, MeterRead, I2C_MODE_MULTIPLE_START);
 	if (I2C_State == I2C_PRESENT)
 	{
-		MeterData->State = DataToRead[0];
-		MeterData->Crc = DataToRead[1];
+		MeterData->State = MeterRead[0];
+		MeterData->Crc = MeterRead[1];
 
 
 		if (MeterData->State & STATE_SEC_OVF)
@@ -175,33 +178,33 @@ uint8_t GetMeterOnceI2C(MLX90395_BaseStruct *MeterData) {
 			}
 			for (index = 2; index < 12; index++)
 			{
-				crc = CRCTable[crc ^ DataToRead[index]];
+				crc = CRCTable[crc ^ MeterRead[index]];
 			}
 			if (crc == MeterData->Crc) // if CRC is verified to be good
 			{	// actualize data only when verified to be vaild
-				MeterData->xAxis.RawValue.u8[0] = DataToRead[2];
-				MeterData->xAxis.RawValue.u8[1] = DataToRead[3];
+				MeterData->xAxis.RawValue.u8[0] = MeterRead[2];
+				MeterData->xAxis.RawValue.u8[1] = MeterRead[3];
 
 				if (MeterData->xAxis.SwapSign)
 				{
 					MeterData->xAxis.RawValue.s16 = (MeterData->xAxis.RawValue.s16 == -32768)? 32767 : -MeterData->xAxis.RawValue.s16;
 				}
-				MeterData->yAxis.RawValue.u8[0] = DataToRead[4];
-				MeterData->yAxis.RawValue.u8[1] = DataToRead[5];
+				MeterData->yAxis.RawValue.u8[0] = MeterRead[4];
+				MeterData->yAxis.RawValue.u8[1] = MeterRead[5];
 				if (MeterData-> yAxis.SwapSign)
 				{
 					MeterData->yAxis.RawValue.s16 = (MeterData->yAxis.RawValue.s16 == -32768)? 32767 : -MeterData->yAxis.RawValue.s16;
 				}
-				MeterData->zAxis.RawValue.u8[0] = DataToRead[6];
-				MeterData->zAxis.RawValue.u8[1] = DataToRead[7];
+				MeterData->zAxis.RawValue.u8[0] = MeterRead[6];
+				MeterData->zAxis.RawValue.u8[1] = MeterRead[7];
 				if (MeterData->zAxis.SwapSign)
 				{
 					MeterData->zAxis.RawValue.s16 = (MeterData->zAxis.RawValue.s16 == -32768)? 32767 : -MeterData->zAxis.RawValue.s16;
 				}
-				MeterData->Temp.RawValue.u8[0] = DataToRead[8];
-				MeterData->Temp.RawValue.u8[1] = DataToRead[9];
-				MeterData->Voltage.u8[0] = DataToRead[10];
-				MeterData->Voltage.u8[1] = DataToRead[11];
+				MeterData->Temp.RawValue.u8[0] = MeterRead[8];
+				MeterData->Temp.RawValue.u8[1] = MeterRead[9];
+				MeterData->Voltage.u8[0] = MeterRead[10];
+				MeterData->Voltage.u8[1] = MeterRead[11];
 #if TOGGLE_CBUS_METER == 1
 				TOGGLE_PIN = togglePin;
 		    	togglePin = !togglePin;
@@ -222,22 +225,133 @@ uint8_t GetMeterOnceI2C(MLX90395_BaseStruct *MeterData) {
 
 uint8_t SetOperationMeter(MLX90395_BaseStruct *MeterData)
 {
-	DataToWrite[0] = REGISTER_80; 	// Register
-	DataToWrite[1] = MeterData->OperationMode; 	 	// Command: Operation mode
+	MeterWrite[0] = REGISTER_80; 	// Register
+	MeterWrite[1] = MeterData->OperationMode; 	 	// Command: Operation mode
 
-	if (!AccessI2C(MeterData->BusChannel, MeterData->BusAddress, 2, DataToWrite, 1, DataToRead, I2C_MODE_MULTIPLE_START))
+	if (!AccessI2C(MeterData->BusChannel, MeterData->BusAddress, 2, MeterWrite, 1, MeterRead, I2C_MODE_MULTIPLE_START))
 	{
-		MeterData->State = DataToRead[0];
+		MeterData->State = MeterRead[0];
 		return MeterData->State & (STATE_SEC_OVF + STATE_CE_DED);
 	}
 	return I2C_ABSENT;
 }
 
+// The measurement after an interruption of unknown length gets a new frame number at least
+static void BreakMeterStream(MLX90395_RingStruct *Ring)
+{
+	if (Ring->Running)
+	{
+		Ring->Running = false;
+		Ring->Frame++;
+	}
+}
+
+// OperationMode of MeterData has to be a burst command (METER_SB_XY or METER_SB_ZXYT)
+uint8_t StartMeterStream(MLX90395_BaseStruct *MeterData, MLX90395_RingStruct *Ring)
+{
+	Ring->Head = 0;
+	Ring->Count = 0;
+	Ring->Frame = 0;
+	Ring->Lost = 0;
+	Ring->Running = false;
+	if (MeterData->State & STATE_BURST) // already converting since InitMeterI2C() or GetMagnetometer()
+	{
+		return I2C_PRESENT;
+	}
+	return SetOperationMeter(MeterData);
+}
+
+// To be polled faster than the burst period. The sensor keeps converting, every call costs only the read of
+// status and data registers. A sample is added when the measurement counter of the status byte has moved.
+// The counter has 3 bits: a poll period of 8 burst periods or more is not noticed (the new measurement looks
+// like the old one and is skipped, Lost misses 8), so the caller has to keep the period below that.
+// A sensor not answering MAX_ATTEMPTS times is reinitialised like by GetMagnetometer().
+uint8_t StreamMeterI2C(MLX90395_BaseStruct *MeterData, MLX90395_RingStruct *Ring)
+{
+	MLX90395_SampleStruct *Sample;
+	uint8_t LastFrameCounter = MeterData->LastFrameCounter;
+	uint8_t Frames;
+	uint8_t ErrorCode;
+
+	ErrorCode = GetMeterOnceI2C(MeterData);
+	if (I2C_State != I2C_PRESENT)
+	{
+		if (MeterData->retry >= MAX_ATTEMPTS)
+		{
+			BreakMeterStream(Ring);
+			if (!InitMeterI2C(MeterData))
+			{
+				MeterData->retry = 0;
+			}
+		}
+		else
+		{
+			MeterData->retry++;
+		}
+		return ErrorCode;
+	}
+	if (!(MeterData->State & STATE_BURST)) // the sensor has left the burst mode (e.g. after a reset)
+	{
+		BreakMeterStream(Ring);
+		SetOperationMeter(MeterData);
+		return ErrorCode | METER_RESET_ERROR;
+	}
+	if (ErrorCode & METER_MEAS_COUNTER_ERROR) // no new measurement yet
+	{
+		return METER_NO_ERROR;
+	}
+	if (ErrorCode & ~METER_NOT_READY_ERROR)
+	{
+		if (ErrorCode & METER_CRC_ERROR)
+		{
+			MeterData->LastFrameCounter = LastFrameCounter; // count the measurement as lost with the next one
+		}
+		return ErrorCode;
+	}
+
+	Frames = ((MeterData->LastFrameCounter - LastFrameCounter) >> 4) & 0x07;
+	if (Ring->Running)
+	{
+		Ring->Frame += Frames;
+		if (Frames > 1)
+		{
+			Ring->Lost = (Ring->Lost > 0xFF - (Frames - 1)) ? 0xFF : Ring->Lost + Frames - 1;
+		}
+	}
+	Ring->Running = true;
+	MeterData->retry = 0;
+
+	Sample = &Ring->Sample[Ring->Head];
+	Sample->Frame = Ring->Frame;
+	Sample->xAxis = MeterData->xAxis.RawValue.s16;
+	Sample->yAxis = MeterData->yAxis.RawValue.s16;
+	Sample->zAxis = MeterData->zAxis.RawValue.s16;
+	Sample->Temp = MeterData->Temp.RawValue.s16;
+	Ring->Head = (Ring->Head + 1) & (METER_RING_SIZE - 1);
+	if (Ring->Count < METER_RING_SIZE)
+	{
+		Ring->Count++;
+	}
+	return METER_NO_ERROR;
+}
+
+// Fetches the oldest sample, false if the ring is empty
+bool GetMeterSample(MLX90395_RingStruct *Ring, MLX90395_SampleStruct *Sample)
+{
+	if (!Ring->Count)
+	{
+		return false;
+	}
+	*Sample = Ring->Sample[(Ring->Head - Ring->Count) & (METER_RING_SIZE - 1)];
+	Ring->Count--;
+	return true;
+}
+
 uint8_t CheckForMeterI2C(MLX90395_BaseStruct *MeterData)
 {
-	DataToWrite[0] = REGISTER_80; 	// Register
-	DataToWrite[1] = METER_EX; 	 	// Command: Exit
-	return AccessI2C(MeterData->BusChannel, MeterData->BusAddress, 2, DataToWrite, 1, DataToRead, I2C_MODE_MULTIPLE_START);
+	MeterWrite[0] = REGISTER_80; 	// Register
+	MeterWrite[1] = METER_EX; 	 	// Command: Exit
+	return AccessI2C(MeterData->BusChannel, MeterData->BusAddress, 2, MeterWrite, 1, MeterRead, I2C_MODE_MULTIPLE_START);
 }
 
 uint8_t InitMeterI2C(MLX90395_BaseStruct *MeterData) {
@@ -245,60 +359,60 @@ uint8_t InitMeterI2C(MLX90395_BaseStruct *MeterData) {
 	uint8_t ErrorState = I2C_PRESENT;
 
 	MeterData->retry++;
-	DataToWrite[0] = REGISTER_80; 	// Register
-	DataToWrite[1] = METER_EX; 	 	// Command: Exit
-	ErrorState = (AccessI2C(MeterData->BusChannel, MeterData->BusAddress, 2, DataToWrite, 1, DataToRead, I2C_MODE_MULTIPLE_START))? I2C_ABSENT : ErrorState;
+	MeterWrite[0] = REGISTER_80; 	// Register
+	MeterWrite[1] = METER_EX; 	 	// Command: Exit
+	ErrorState = (AccessI2C(MeterData->BusChannel, MeterData->BusAddress, 2, MeterWrite, 1, MeterRead, I2C_MODE_MULTIPLE_START))? I2C_ABSENT : ErrorState;
 	LoopDelay3ms(); // Delay for Melexis to accomplish Power-up Reset
 
-	DataToWrite[1] = METER_RT; 	 	// Command: Reset
-	ErrorState = (AccessI2C(MeterData->BusChannel, MeterData->BusAddress, 2, DataToWrite, 1, DataToRead, I2C_MODE_MULTIPLE_START))? I2C_ABSENT : ErrorState;
+	MeterWrite[1] = METER_RT; 	 	// Command: Reset
+	ErrorState = (AccessI2C(MeterData->BusChannel, MeterData->BusAddress, 2, MeterWrite, 1, MeterRead, I2C_MODE_MULTIPLE_START))? I2C_ABSENT : ErrorState;
 	LoopDelay3ms(); // Delay for Melexis to accomplish Power-up Reset
 
-	DataToWrite[0] = UID_ADDR_26h_I2C; //METER_RR
-	ErrorState = (AccessI2C(MeterData->BusChannel, MeterData->BusAddress, 1, DataToWrite, 6, DataToRead, I2C_MODE_MULTIPLE_START))? I2C_ABSENT : ErrorState;
-	MeterData->ID1.u8[0] = DataToRead[0];
-	MeterData->ID1.u8[1] = DataToRead[1];
-	MeterData->ID2.u8[0] = DataToRead[2];
-	MeterData->ID2.u8[1] = DataToRead[3];
-	MeterData->ID3.u8[0] = DataToRead[4];
-	MeterData->ID3.u8[1] = DataToRead[5];
-
-	DataToWrite[0] = CALIB_ADDR_00h_I2C; //METER_RR
-	ErrorState = (AccessI2C(MeterData->BusChannel, MeterData->BusAddress, 1, DataToWrite, 2, DataToRead, I2C_MODE_MULTIPLE_START))? I2C_ABSENT : ErrorState;
+	MeterWrite[0] = UID_ADDR_26h_I2C; //METER_RR
+	ErrorState = (AccessI2C(MeterData->BusChannel, MeterData->BusAddress, 1, MeterWrite, 6, MeterRead, I2C_MODE_MULTIPLE_START))? I2C_ABSENT : ErrorState;
+	MeterData->ID1.u8[0] = MeterRead[0];
+	MeterData->ID1.u8[1] = MeterRead[1];
+	MeterData->ID2.u8[0] = MeterRead[2];
+	MeterData->ID2.u8[1] = MeterRead[3];
+	MeterData->ID3.u8[0] = MeterRead[4];
+	MeterData->ID3.u8[1] = MeterRead[5];
+
+	MeterWrite[0] = CALIB_ADDR_00h_I2C; //METER_RR
+	ErrorState = (AccessI2C(MeterData->BusChannel, MeterData->BusAddress, 1, MeterWrite, 2, MeterRead, I2C_MODE_MULTIPLE_START))? I2C_ABSENT : ErrorState;
 	//D_Value.u16 = 0x005C; // The Default for this configuration Register0
-	D_Value.u8[0] = DataToRead[0];
-	D_Value.u8[1] = DataToRead[1];
+	D_Value.u8[0] = MeterRead[0];
+	D_Value.u8[1] = MeterRead[1];
 	D_Value.u16 &= ~MASK_GAIN;
 	D_Value.u16 |= (MASK_GAIN & (((uint16_t) MeterData->Gain) << 4));
-	DataToWrite[1] = D_Value.u8[0];
-	DataToWrite[2] = D_Value.u8[1];
-	ErrorState = (AccessI2C(MeterData->BusChannel, MeterData->BusAddress, 3, DataToWrite, 1, DataToRead, I2C_MODE_MULTIPLE_START))? I2C_ABSENT : ErrorState;//METER_WR
+	MeterWrite[1] = D_Value.u8[0];
+	MeterWrite[2] = D_Value.u8[1];
+	ErrorState = (AccessI2C(MeterData->BusChannel, MeterData->BusAddress, 3, MeterWrite, 1, MeterRead, I2C_MODE_MULTIPLE_START))? I2C_ABSENT : ErrorState;//METER_WR
 
-	DataToWrite[0] = CALIB_ADDR_01h_I2C; //METER_RR
-	ErrorState = (AccessI2C(MeterData->BusChannel, MeterData->BusAddress, 1, DataToWrite, 2, DataToRead, I2C_MODE_MULTIPLE_START))? I2C_ABSENT : ErrorState;
+	MeterWrite[0] = CALIB_ADDR_01h_I2C; //METER_RR
+	ErrorState = (AccessI2C(MeterData->BusChannel, MeterData->BusAddress, 1, MeterWrite, 2, MeterRead, I2C_MODE_MULTIPLE_START))? I2C_ABSENT : ErrorState;
 	//D_Value.u16 = 0xE400; // The Default for this configuration Register1 (I2C-Mode Only!)
-	D_Value.u8[0] = DataToRead[0];
-	D_Value.u8[1] = DataToRead[1];
+	D_Value.u8[0] = MeterRead[0];
+	D_Value.u8[1] = MeterRead[1];
 	D_Value.u16 &= ~MASK_TCMP_EN;
 	D_Value.u16 |= (MASK_TCMP_EN & (((uint16_t) MeterData->AutoTempCompensation) << 10));
-	DataToWrite[1] = D_Value.u8[0];
-	DataToWrite[2] = D_Value.u8[1];
-	ErrorState = (AccessI2C(MeterData->BusChannel, MeterData->BusAddress, 3, DataToWrite, 1, DataToRead, I2C_MODE_MULTIPLE_START))? I2C_ABSENT : ErrorState;
+	MeterWrite[1] = D_Value.u8[0];
+	MeterWrite[2] = D_Value.u8[1];
+	ErrorState = (AccessI2C(MeterData->BusChannel, MeterData->BusAddress, 3, MeterWrite, 1, MeterRead, I2C_MODE_MULTIPLE_START))? I2C_ABSENT : ErrorState;
 
-	DataToWrite[0] = CALIB_ADDR_02h_I2C; //METER_RR
-	ErrorState = (AccessI2C(MeterData->BusChannel, MeterData->BusAddress, 1, DataToWrite, 2, DataToRead, I2C_MODE_MULTIPLE_START))? I2C_ABSENT : ErrorState;
+	MeterWrite[0] = CALIB_ADDR_02h_I2C; //METER_RR
+	ErrorState = (AccessI2C(MeterData->BusChannel, MeterData->BusAddress, 1, MeterWrite, 2, MeterRead, I2C_MODE_MULTIPLE_START))? I2C_ABSENT : ErrorState;
     //D_Value.u16 = 0x03DA; // The Default for this configuration Register2
-	D_Value.u8[0] = DataToRead[0];
-	D_Value.u8[1] = DataToRead[1];
+	D_Value.u8[0] = MeterRead[0];
+	D_Value.u8[1] = MeterRead[1];
 	D_Value.u16 &= ~MASK_RES;
 	D_Value.u16 |= (MASK_RES & (((uint16_t) MeterData->Resolution) << 5));
 	D_Value.u16 &= ~MASK_FILTER;
 	D_Value.u16 |= (MASK_FILTER & (((uint16_t) MeterData->Filter) << 2));
 	D_Value.u16 &= ~MASK_OSR;
 	D_Value.u16 |= (MASK_OSR & (((uint16_t) MeterData->OSR) << 0));
-	DataToWrite[1] = D_Value.u8[0];
-	DataToWrite[2] = D_Value.u8[1];
-	ErrorState = (AccessI2C(MeterData->BusChannel, MeterData->BusAddress, 3, DataToWrite, 1, DataToRead, I2C_MODE_MULTIPLE_START))? I2C_ABSENT : ErrorState;//METER_WR
+	MeterWrite[1] = D_Value.u8[0];
+	MeterWrite[2] = D_Value.u8[1];
+	ErrorState = (AccessI2C(MeterData->BusChannel, MeterData->BusAddress, 3, MeterWrite, 1, MeterRead, I2C_MODE_MULTIPLE_START))? I2C_ABSENT : ErrorState;//METER_WR
 	ErrorState = (SetOperationMeter(MeterData))? I2C_ABSENT : ErrorState;
 	return ErrorState;
 }
@@ -44,8 +44,10 @@
 #include "Cordic.h"
 #include "PersistSettings.h"
 #include "I2cDispatcher.h"
+#include "I2cQueue.h"
 #include "IoLinkPhy.h"
 #include "Filter.h"
+#include "SwitchManager.h"
 
 /****************************************************************************
  **
@@ -153,6 +155,7 @@ static adcBaseStruct  AdcData1;
 static adcBaseStruct  AdcData2;
 static MLX90395_BaseStruct  TestMeterXY;
 static MLX90395_BaseStruct  TestMeterZ;
+static MLX90395_RingStruct  MeterXYRing; // new measurements of the burst of TestMeterXY for the trend
 
 static TLE493D_BaseStruct TestSensorXY;
 static TLE493D_BaseStruct TestSensorZ;
@@ -241,6 +244,12 @@ uint8_t FrontButton1State = PB_ABSENT;
 uint8_t FrontButton2State = PB_ABSENT;
 uint8_t LastVibra = 0;
 uint8_t LastLib = 0;
+static uint8_t xdata VibraLibCmd[2];
+static uint8_t xdata VibraPattern[8]; // waveform sequencer, the unused slots stay 0
+#ifdef I2C_QUEUE
+static void VibraLibDone(I2cJob_t *Job);
+static I2cJob_t xdata VibraLibJob = {I2C_Channel_Satellite, BASE_ADDR_VIBRA, 2, VibraLibCmd, 0, 0, I2C_MODE_MULTIPLE_START, I2C_PRESENT, VibraLibDone, 0};
+#endif
 SI_UU16_t Converter16;
 uint16_t AngleMin = INT_MAX;
 uint16_t AngleMid = INT_MAX;
@@ -308,6 +317,8 @@ int8_t  TempTop2 = 0;
 int8_t  TempBase1 = 0;
 int8_t  TempBase2 = 0;
 int8_t  LRA_State = 0;
+uint8_t MeterTrend = 0;
+uint8_t MeterLost = 0;
 
 /* definition of used system commands */
 PM_SYSTEMCOMMAND_DECLARE() = {
@@ -434,6 +445,8 @@ const TVariable code VariableCollection[] = {
 	{80,   PM_UINT8        (PM_RO, STATIC(&TempBase1))},
 	{81,   PM_UINT8        (PM_RO, STATIC(&TempBase2))},
 	{82,   PM_UINT8        (PM_RO, STATIC(&LRA_State))},
+	{83,   PM_UINT8        (PM_RO, STATIC(&MeterTrend))},
+	{84,   PM_UINT8        (PM_RO, STATIC(&MeterLost))},
 	{90, {sizeof(V_InfoList), 0x00, {(void*)V_InfoList}},},
 
 	/* data storage and block parameters */
@@ -600,10 +613,20 @@ void AL_NewOutputInd(TBoolean PDValid)
 			{
 				if (LastLib != EABufferOut[3] & (SEGMENT_LED_SECTOR_1 | SEGMENT_LED_SECTOR_2 | SEGMENT_LED_SECTOR_3))
 				{
+#ifdef I2C_QUEUE
+					if (VibraLibJob.State != I2C_JOB_PENDING) // otherwise try again with the next process data
+					{
+						VibraLibCmd[0] = VibraREG03;
+						VibraLibCmd[1] = EABufferOut[3] & 0x07; // Select the LRA-Library
+						if (I2cSubmit(&VibraLibJob))
+							LastLib = VibraLibCmd[1];
+					}
+#else
 					LastLib = EABufferOut[3] & 0x07;
-			  		DataToWrite[0] = VibraREG03;
-			        DataToWrite[1] = LastLib; // Select the LRA-Library
-			        VibraError = AccessI2C(I2C_Channel_Satellite, BASE_ADDR_VIBRA, 2, DataToWrite, 0, DataToRead, I2C_MODE_MULTIPLE_START);
+			  		VibraLibCmd[0] = VibraREG03;
+			        VibraLibCmd[1] = LastLib; // Select the LRA-Library
+			        VibraError = AccessI2C(I2C_Channel_Satellite, BASE_ADDR_VIBRA, 2, VibraLibCmd, 0, 0, I2C_MODE_MULTIPLE_START);
+#endif
 				}
 			}
 			else
@@ -650,6 +673,13 @@ void AL_NewOutputInd(TBoolean PDValid)
 	}
 }
 
+#ifdef I2C_QUEUE
+static void VibraLibDone(I2cJob_t *Job) // Timer 2 interrupt
+{
+	VibraError = (Job->State != I2C_PRESENT);
+}
+#endif
+
 void ByteToStr(uint8_t Value, uint8_t *HiNibbleChar, uint8_t *LoNibbleChar)
 {
 	uint8_t Nibble;
@@ -1038,6 +1068,9 @@ int main(void) {
 	uint8_t Smooth;
 	uint8_t DeflectionVector1;
 	uint8_t DeflectionVector2;
+	MLX90395_SampleStruct MeterXYSample;
+	CalibAxisStruct TrendX;
+	CalibAxisStruct TrendY;
 	bool MagnetSensorRegular = false;
 	bool MagnetSensorGoofy = false;
 	bool MagnetMeterRegular = false;
@@ -1123,6 +1156,11 @@ int main(void) {
 
 	// Call hardware initialization routine
 	enter_DefaultMode_from_RESET();
+#ifdef I2C_TIMED
+	I2cTimerInit();
+	I2cSetProfile(I2C_Channel_Base, I2C_PROFILE_FAST);      // all devices are specified for 400 kHz
+	I2cSetProfile(I2C_Channel_Satellite, I2C_PROFILE_FAST);
+#endif
 	VCC_M = 1; // Activate Power for Base Magnetsensor
 
 	ResetHallSensors(I2C_Channel_Satellite);
@@ -1750,9 +1788,8 @@ int main(void) {
 
 				if (FrontButtonState == PB_NEW_EVENT)
 				{
-					DataToRead[0] = (ButtonFront1) ? 13 : 11;
-					DataToRead[1] = 0x00;
-					VibraError = LraVibraSetPattern(I2C_Channel_Satellite, BASE_ADDR_VIBRA, DataToRead);
+					VibraPattern[0] = (ButtonFront1) ? 13 : 11;
+					VibraError = LraVibraSetPattern(I2C_Channel_Satellite, BASE_ADDR_VIBRA, VibraPattern);
 				}
 
 
@@ -1818,11 +1855,17 @@ int main(void) {
     AdcMidRight = (AdcMaxRight>>1) + (AdcMinRight>>1);
    	AdcMidLeft = (AdcMaxLeft>>1) + (AdcMinLeft>>1);
 
+	if (!LinkTestOnly)
+	{
+		StartMeterStream(&TestMeterXY, &MeterXYRing); // the sensor stays in burst mode, the loop only collects
+	}
+
 	while (1)
 	{
 		if (!LinkTestOnly)
 		{
-			MeterXYError = GetMagnetometer(&TestMeterXY);
+			// One cycle of this loop has to stay below 8 burst periods of TestMeterXY, longer gaps are not seen by StreamMeterI2C()
+			MeterXYError = StreamMeterI2C(&TestMeterXY, &MeterXYRing);
 			SensorXYError = GetMagnetSensor(&TestSensorXY);
 		}
 
@@ -1982,6 +2025,18 @@ int main(void) {
 		AdjustAxisCenterbalancedClamped(&TestMeterXY.xAxis, LIMIT_POS, LIMIT_NEG); // Allow only values in range that can be mirrored without overflow!
 	    AdjustAxisCenterbalancedClamped(&TestMeterXY.yAxis, LIMIT_POS, LIMIT_NEG); // Allow only values in range that can be mirrored without overflow!
 	    CompensateGeometry(&TestMeterXY.xAxis, &TestMeterXY.yAxis, STRETCH, LIMIT_POS, LIMIT_NEG);
+	    while (GetMeterSample(&MeterXYRing, &MeterXYSample)) // the trend gets each new measurement once, a poll without one repeats nothing
+	    {
+	    	TrendX = TestMeterXY.xAxis;
+	    	TrendY = TestMeterXY.yAxis;
+	    	TrendX.RawValue.s16 = MeterXYSample.xAxis;
+	    	TrendY.RawValue.s16 = MeterXYSample.yAxis;
+	    	AdjustAxisCenterbalancedClamped(&TrendX, LIMIT_POS, LIMIT_NEG);
+	    	AdjustAxisCenterbalancedClamped(&TrendY, LIMIT_POS, LIMIT_NEG);
+	    	CompensateGeometry(&TrendX, &TrendY, STRETCH, LIMIT_POS, LIMIT_NEG);
+	    	MeterTrend = combineAxisToTrend(&TrendX, &TrendY);
+	    }
+	    MeterLost = MeterXYRing.Lost;
 	    if (TestMode)
 	    {
 	    	SensorXYError = true;
@@ -0,0 +1,458 @@
+/*
+ * I2cModel.cpp
+ *
+ *  Created on: 17.10.2026
+ *********************************************
+ *    (c)2016-2026 SIGITRONIC SOFTWARE       *
+ *                                           *
+ *      Author: Matthias Siegenthaler        *
+ *                                           *
+ *        matthias@sigitronic.com            *
+ *********************************************
+ */
+
+#include <stdio.h>
+#include "HalDef.h"
+#include "I2cModel.h"
+
+#define LINE_NONE	(0)
+#define LINE_SDA	(1)
+#define LINE_SCL	(2)
+
+#define PARAM_LOW		(0)
+#define PARAM_HIGH		(1)
+#define PARAM_SU_STA	(2)
+#define PARAM_HD_STA	(3)
+#define PARAM_SU_STO	(4)
+#define PARAM_BUF		(5)
+#define PARAM_SU_DAT	(6)
+#define PARAM_PERIOD	(7)
+#define PARAMS			(8)
+
+#define SLAVE_IDLE		(0) // not addressed, waits for a start
+#define SLAVE_ADDRESS	(1) // receives the address byte
+#define SLAVE_WRITE		(2) // receives a data byte
+#define SLAVE_READ		(3) // sends a data byte
+#define SLAVE_ACK_OUT	(4) // acknowledges a received byte
+#define SLAVE_ACK_IN	(5) // waits for the acknowledge of the master
+
+#define VIOLATIONS_SHOWN	(10)
+
+const I2cModelTiming_t I2cModelStandard = { "standard",  4700, 4000, 4700, 4000, 4000, 4700, 250, 10000 };
+const I2cModelTiming_t I2cModelFast     = { "fast",      1300,  600,  600,  600,  600, 1300, 100,  2500 };
+
+static const char *ParamName[PARAMS] = { "tLOW", "tHIGH", "tSU;STA", "tHD;STA", "tSU;STO", "tBUF", "tSU;DAT", "1/fSCL" };
+
+volatile uint8_t SFRPAGE;
+volatile uint8_t CKCON0;
+volatile uint8_t TMR2CN0;
+volatile uint8_t TMR2CN0_TR2;
+volatile uint16_t TMR2;
+volatile uint16_t TMR2RL;
+volatile uint8_t IE_EA;
+volatile uint8_t IE_ET2;
+I2cModelFlag TMR2CN0_TF2H;
+
+static uint64_t Now;			// SYSCLK cycles
+static const I2cModelTiming_t *Spec;
+static uint32_t SpecNs[PARAMS];
+static uint64_t MinCycles[PARAMS];
+static uint32_t Violations;
+static uint32_t Starts;
+static uint32_t Stops;
+
+static uint8_t LatchSda = 1;	// master side of the open drain lines
+static uint8_t LatchScl = 1;
+static uint8_t Sda = 1;			// level of the bus
+static uint8_t Scl = 1;
+
+static bool Busy;				// between start and stop
+static bool PeriodValid;		// a rising edge of SCL since the last start
+static bool StartInHigh;		// start condition in the current SCL high phase
+static uint64_t TimeSclRise;
+static uint64_t TimeSclFall;
+static uint64_t TimeSda;		// last change of SDA while SCL is low
+static uint64_t TimeStart;
+static uint64_t TimeStop;
+
+static uint8_t SlaveState;
+static uint8_t SlaveNext;
+static uint8_t SlavePull;		// slave holds SDA low
+static uint8_t SlaveBits;
+static uint8_t SlaveShift;
+static uint8_t SlaveNack;
+static bool SlaveFirst;			// next written byte is the register pointer
+static uint8_t SlavePtr;
+static uint8_t SlaveMem[I2C_MODEL_SLAVE_SIZE];
+
+//-----------------------------------------------------------------------------
+static uint32_t CyclesToNs(uint64_t Cycles)
+{
+	return ((uint32_t)((Cycles * 1000000000ULL) / SYSCLK_HZ));
+}
+
+//-----------------------------------------------------------------------------
+static void Measure(uint8_t Param, uint64_t Cycles)
+{
+	if (Cycles < MinCycles[Param])
+		MinCycles[Param] = Cycles;
+
+	if (Cycles * 1000000000ULL < (uint64_t) SpecNs[Param] * SYSCLK_HZ)
+	{
+		if (Violations < VIOLATIONS_SHOWN)
+			printf("I2cModel %s: %s %u ns < %u ns at %u ns\n", Spec->Name, ParamName[Param],
+					CyclesToNs(Cycles), SpecNs[Param], CyclesToNs(Now));
+		Violations++;
+	}
+}
+
+//-----------------------------------------------------------------------------
+static void SlaveDriveBit(void)
+{
+	SlavePull = (SlaveMem[SlavePtr % I2C_MODEL_SLAVE_SIZE] & (0x80 >> SlaveBits)) ? 0 : 1;
+	SlaveBits++;
+}
+
+//-----------------------------------------------------------------------------
+static void SlaveClockRise(void)
+{
+	if ((SlaveState == SLAVE_ADDRESS) || (SlaveState == SLAVE_WRITE))
+	{
+		SlaveShift = (SlaveShift << 1) | Sda;
+		SlaveBits++;
+	}
+	else if (SlaveState == SLAVE_ACK_IN)
+	{
+		SlaveNack = Sda;
+	}
+}
+
+//-----------------------------------------------------------------------------
+static void SlaveClockFall(void)
+{
+	switch (SlaveState)
+	{
+	case SLAVE_ADDRESS:
+	case SLAVE_WRITE:
+		if (SlaveBits < 8)
+			break;
+		SlaveBits = 0;
+		if (SlaveState == SLAVE_ADDRESS)
+		{
+			if ((SlaveShift & 0xFE) != I2C_MODEL_SLAVE_ADDR)
+			{
+				SlaveState = SLAVE_IDLE;
+				break;
+			}
+			SlaveNext = (SlaveShift & 0x01) ? SLAVE_READ : SLAVE_WRITE;
+			SlaveFirst = true;
+		}
+		else if (SlaveFirst)
+		{
+			SlavePtr = SlaveShift;
+			SlaveFirst = false;
+		}
+		else
+		{
+			SlaveMem[SlavePtr++ % I2C_MODEL_SLAVE_SIZE] = SlaveShift;
+		}
+		SlavePull = 1;
+		SlaveState = SLAVE_ACK_OUT;
+		break;
+
+	case SLAVE_ACK_OUT:
+		SlavePull = 0;
+		SlaveState = SlaveNext;
+		if (SlaveState == SLAVE_READ)
+			SlaveDriveBit();
+		break;
+
+	case SLAVE_READ:
+		if (SlaveBits < 8)
+		{
+			SlaveDriveBit();
+			break;
+		}
+		SlavePull = 0;
+		SlavePtr++;
+		SlaveState = SLAVE_ACK_IN;
+		break;
+
+	case SLAVE_ACK_IN:
+		if (SlaveNack)
+		{
+			SlaveState = SLAVE_IDLE;
+			break;
+		}
+		SlaveBits = 0;
+		SlaveState = SLAVE_READ;
+		SlaveDriveBit();
+		break;
+	}
+}
+
+//-----------------------------------------------------------------------------
+static void DataEdge(void)
+{
+	if (!Scl)
+	{
+		TimeSda = Now;
+		return;
+	}
+
+	if (!Sda)	// start condition
+	{
+		if (Busy)
+			Measure(PARAM_SU_STA, Now - TimeSclRise);
+		else
+			Measure(PARAM_BUF, Now - TimeStop);
+		Busy = true;
+		PeriodValid = false;
+		StartInHigh = true;
+		TimeStart = Now;
+		Starts++;
+		SlaveState = SLAVE_ADDRESS;
+		SlaveBits = 0;
+		SlaveShift = 0;
+		SlavePull = 0;
+	}
+	else		// stop condition
+	{
+		Measure(PARAM_SU_STO, Now - TimeSclRise);
+		Busy = false;
+		TimeStop = Now;
+		Stops++;
+		SlaveState = SLAVE_IDLE;
+		SlavePull = 0;
+	}
+}
+
+//-----------------------------------------------------------------------------
+static void ClockEdge(void)
+{
+	if (Scl)
+	{
+		if (Busy)
+		{
+			Measure(PARAM_LOW, Now - TimeSclFall);
+			if (TimeSda >= TimeSclFall)
+				Measure(PARAM_SU_DAT, Now - TimeSda);
+			if (PeriodValid)
+				Measure(PARAM_PERIOD, Now - TimeSclRise);
+			PeriodValid = true;
+		}
+		TimeSclRise = Now;
+		SlaveClockRise();
+	}
+	else
+	{
+		if (StartInHigh)
+			Measure(PARAM_HD_STA, Now - TimeStart);
+		else if (Busy)
+			Measure(PARAM_HIGH, Now - TimeSclRise);
+		StartInHigh = false;
+		TimeSclFall = Now;
+		SlaveClockFall();
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Brings the bus to the levels of the latches and the slave, the clock edge
+// first: the slave answers a falling edge of SCL at the same time.
+//-----------------------------------------------------------------------------
+static void Update(void)
+{
+	uint8_t Level;
+
+	if (LatchScl != Scl)
+	{
+		Scl = LatchScl;
+		ClockEdge();
+	}
+	Level = LatchSda && !SlavePull;
+	if (Level != Sda)
+	{
+		Sda = Level;
+		DataEdge();
+	}
+}
+
+//-----------------------------------------------------------------------------
+I2cModelPin::I2cModelPin(uint8_t Port, uint8_t Bit)
+{
+	Line = LINE_NONE;
+	Latch = 1;
+	if ((Port == SFR_P0) && (Bit == 6))
+		Line = LINE_SDA;
+	if ((Port == SFR_P0) && (Bit == 7))
+		Line = LINE_SCL;
+}
+
+//-----------------------------------------------------------------------------
+I2cModelPin &I2cModelPin::operator=(int Value)
+{
+	switch (Line)
+	{
+	case LINE_SDA:
+		LatchSda = Value ? 1 : 0;
+		Update();
+		break;
+	case LINE_SCL:
+		LatchScl = Value ? 1 : 0;
+		Update();
+		break;
+	default:
+		Latch = Value ? 1 : 0;
+		break;
+	}
+	return (*this);
+}
+
+//-----------------------------------------------------------------------------
+I2cModelPin::operator uint8_t() const
+{
+	switch (Line)
+	{
+	case LINE_SDA:
+		return (Sda);
+	case LINE_SCL:
+		return (Scl);
+	default:
+		return (Latch);
+	}
+}
+
+//-----------------------------------------------------------------------------
+I2cModelFlag &I2cModelFlag::operator=(int Value)
+{
+	Raw = Value ? 1 : 0;
+	return (*this);
+}
+
+//-----------------------------------------------------------------------------
+I2cModelFlag::operator uint8_t()
+{
+	if (!Raw)
+	{
+		if (!TMR2CN0_TR2)
+		{
+			printf("I2cModel: Timer 2 polled while stopped\n");
+			Violations++;
+		}
+		else
+		{
+			Now += 0x10000UL - TMR2;
+			TMR2 = TMR2RL;
+		}
+		Raw = 1;
+	}
+	return (Raw);
+}
+
+//-----------------------------------------------------------------------------
+void I2cModelReset(const I2cModelTiming_t *Timing)
+{
+	uint8_t Param;
+
+	Spec = Timing;
+	SpecNs[PARAM_LOW] = Timing->Low;
+	SpecNs[PARAM_HIGH] = Timing->High;
+	SpecNs[PARAM_SU_STA] = Timing->SuSta;
+	SpecNs[PARAM_HD_STA] = Timing->HdSta;
+	SpecNs[PARAM_SU_STO] = Timing->SuSto;
+	SpecNs[PARAM_BUF] = Timing->Buf;
+	SpecNs[PARAM_SU_DAT] = Timing->SuDat;
+	SpecNs[PARAM_PERIOD] = Timing->Period;
+	for (Param = 0; Param < PARAMS; Param++)
+		MinCycles[Param] = UINT64_MAX;
+
+	Now = 0;
+	Violations = 0;
+	Starts = 0;
+	Stops = 0;
+	LatchSda = 1;
+	LatchScl = 1;
+	Sda = 1;
+	Scl = 1;
+	Busy = false;
+	PeriodValid = false;
+	StartInHigh = false;
+	TimeSclRise = 0;
+	TimeSclFall = 0;
+	TimeSda = 0;
+	TimeStart = 0;
+	TimeStop = 0;
+	SlaveState = SLAVE_IDLE;
+	SlavePull = 0;
+}
+
+//-----------------------------------------------------------------------------
+uint32_t I2cModelViolations(void)
+{
+	return (Violations);
+}
+
+//-----------------------------------------------------------------------------
+void I2cModelReport(void)
+{
+	uint8_t Param;
+
+	printf("%-9s", Spec->Name);
+	for (Param = 0; Param < PARAMS; Param++)
+	{
+		if (MinCycles[Param] == UINT64_MAX)
+			printf("  %s -", ParamName[Param]);
+		else
+			printf("  %s %u/%u", ParamName[Param], CyclesToNs(MinCycles[Param]), SpecNs[Param]);
+	}
+	printf("  ns (shortest/minimum)\n");
+}
+
+//-----------------------------------------------------------------------------
+uint64_t I2cModelTime(void)
+{
+	return (Now);
+}
+
+//-----------------------------------------------------------------------------
+uint32_t I2cModelStarts(void)
+{
+	return (Starts);
+}
+
+//-----------------------------------------------------------------------------
+uint32_t I2cModelStops(void)
+{
+	return (Stops);
+}
+
+//-----------------------------------------------------------------------------
+uint8_t *I2cModelSlaveMem(void)
+{
+	return (SlaveMem);
+}
+
+//-----------------------------------------------------------------------------
+uint32_t I2cModelRunIsr(void (*Isr)(void))
+{
+	uint32_t Count = 0;
+
+	while (IE_ET2)
+	{
+		if (!TMR2CN0_TF2H.Raw)
+		{
+			if (!TMR2CN0_TR2)
+			{
+				printf("I2cModel: Timer 2 interrupt enabled while stopped\n");
+				Violations++;
+				break;
+			}
+			Now += 0x10000UL - TMR2;
+			TMR2 = TMR2RL;
+			TMR2CN0_TF2H.Raw = 1;
+		}
+		Isr();
+		Count++;
+	}
+	return (Count);
+}
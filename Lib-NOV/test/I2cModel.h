@@ -0,0 +1,105 @@
+/*
+ * I2cModel.h
+ *
+ *  Created on: 17.10.2026
+ *********************************************
+ *    (c)2016-2026 SIGITRONIC SOFTWARE       *
+ *                                           *
+ *      Author: Matthias Siegenthaler        *
+ *                                           *
+ *        matthias@sigitronic.com            *
+ *********************************************
+ */
+
+// Timing model of the bit-banged I2C bus for the host tests.
+//
+// The firmware sources are compiled as C++ against this model: the sbits
+// I2C_SDA_Ch0/I2C_SCL_Ch0 (P0.6/P0.7) are objects which report every write,
+// Timer 2 counts SYSCLK cycles. Time only passes while Timer 2 runs, i.e. in
+// I2cDelay() or between two ticks of the I2C queue. The time the code needs
+// between two delays is zero in the model, so every measured interval is a
+// lower bound of the one on the target.
+//
+// The Timer 2 interrupt of the I2C queue is called by I2cModelRunIsr() at
+// every overflow of the timer, the main loop does not run in between.
+//
+// Every edge on the bus is checked against the minimum times of the I2C
+// specification (I2cModelSetSpec). A slave with a register pointer answers
+// on I2C_MODEL_SLAVE_ADDR: the first byte written sets the pointer, further
+// bytes are stored, read bytes come from the pointer, which increments.
+
+#ifndef I2CMODEL_H_
+#define I2CMODEL_H_
+
+#include <stdint.h>
+
+#define I2C_MODEL_SLAVE_ADDR	(0x20)  // write address, the read address is 0x21
+#define I2C_MODEL_SLAVE_SIZE	(16)    // registers of the slave
+
+// Minimum times in ns, 0 for a time which is not checked
+typedef struct
+{
+	const char *Name;
+	uint32_t Low;	// tLOW
+	uint32_t High;	// tHIGH
+	uint32_t SuSta;	// tSU;STA, repeated start
+	uint32_t HdSta;	// tHD;STA
+	uint32_t SuSto;	// tSU;STO
+	uint32_t Buf;	// tBUF, stop to start
+	uint32_t SuDat;	// tSU;DAT
+	uint32_t Period;// 1 / fSCL, rising to rising edge of SCL
+} I2cModelTiming_t;
+
+extern const I2cModelTiming_t I2cModelStandard;
+extern const I2cModelTiming_t I2cModelFast;
+
+//-----------------------------------------------------------------------------
+// Pin of a port. P0.6 and P0.7 are SDA and SCL of the bus (open drain),
+// reading them returns the level of the bus. Other pins are plain latches.
+//-----------------------------------------------------------------------------
+class I2cModelPin
+{
+public:
+	I2cModelPin(uint8_t Port, uint8_t Bit);
+	I2cModelPin &operator=(int Value);
+	operator uint8_t() const;
+private:
+	uint8_t Line;
+	uint8_t Latch;
+};
+
+//-----------------------------------------------------------------------------
+// Overflow flag of Timer 2. Polling the flag while the timer runs lets the
+// model time pass up to the overflow.
+//-----------------------------------------------------------------------------
+class I2cModelFlag
+{
+public:
+	I2cModelFlag &operator=(int Value);
+	operator uint8_t();
+	uint8_t Raw;
+};
+
+extern volatile uint8_t SFRPAGE;
+extern volatile uint8_t CKCON0;
+extern volatile uint8_t TMR2CN0;
+extern volatile uint8_t TMR2CN0_TR2;
+extern volatile uint16_t TMR2;
+extern volatile uint16_t TMR2RL;
+extern volatile uint8_t IE_EA;
+extern volatile uint8_t IE_ET2;
+extern I2cModelFlag TMR2CN0_TF2H;
+
+//-----------------------------------------------------------------------------
+// Exported Function Prototypes
+//-----------------------------------------------------------------------------
+void I2cModelReset(const I2cModelTiming_t *Spec); // bus idle, time 0, measurement cleared
+uint32_t I2cModelViolations(void);      // edges which broke a minimum time since the reset
+void I2cModelReport(void);              // shortest measured times against the specification
+uint64_t I2cModelTime(void);            // SYSCLK cycles since the reset
+uint32_t I2cModelStarts(void);          // start conditions incl. repeated starts
+uint32_t I2cModelStops(void);
+uint8_t *I2cModelSlaveMem(void);        // I2C_MODEL_SLAVE_SIZE registers
+uint32_t I2cModelRunIsr(void (*Isr)(void)); // Timer 2 interrupts until IE_ET2 is cleared, returns their number
+
+#endif /* I2CMODEL_H_ */
@@ -0,0 +1,48 @@
+/*
+ * TestCheck.h
+ *
+ *  Created on: 17.10.2026
+ *********************************************
+ *    (c)2016-2026 SIGITRONIC SOFTWARE       *
+ *                                           *
+ *      Author: Matthias Siegenthaler        *
+ *                                           *
+ *        matthias@sigitronic.com            *
+ *********************************************
+ */
+
+// Minimal check macros for the host tests. Every test program defines the
+// counter once with TEST_CHECK_DATA, main() returns TEST_RESULT().
+
+#ifndef TESTCHECK_H_
+#define TESTCHECK_H_
+
+#include <stdio.h>
+
+#define TEST_CHECK_DATA		uint32_t TestFail
+extern uint32_t TestFail;
+
+#define TEST_CHECK(Cond) \
+	do { \
+		if (!(Cond)) \
+		{ \
+			printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #Cond); \
+			TestFail++; \
+		} \
+	} while (0)
+
+#define TEST_CHECK_EQ(Val, Exp) \
+	do { \
+		unsigned long ValT = (unsigned long)(Val); \
+		unsigned long ExpT = (unsigned long)(Exp); \
+		if (ValT != ExpT) \
+		{ \
+			printf("%s:%d: %s = 0x%lX, expected 0x%lX\n", __FILE__, __LINE__, #Val, ValT, ExpT); \
+			TestFail++; \
+		} \
+	} while (0)
+
+#define TEST_RESULT(Name) \
+	(printf("%s: %s\n", (Name), TestFail ? "FAIL" : "ok"), (TestFail ? 1 : 0))
+
+#endif /* TESTCHECK_H_ */
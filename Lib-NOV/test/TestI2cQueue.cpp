@@ -0,0 +1,168 @@
+/*
+ * TestI2cQueue.cpp
+ *
+ *  Created on: 17.10.2026
+ *********************************************
+ *    (c)2016-2026 SIGITRONIC SOFTWARE       *
+ *                                           *
+ *      Author: Matthias Siegenthaler        *
+ *                                           *
+ *        matthias@sigitronic.com            *
+ *********************************************
+ */
+
+// Transactions of the I2C queue against the slave of the bus model: chains,
+// a NACKed address which aborts its chain, all transfer modes, the queue
+// limit and the waveforms of the interrupt ticks in every profile.
+//
+// The test also measures the load of the queue: one Timer 2 interrupt per
+// phase of a bit, so the main loop only runs in the time between two ticks
+// which the interrupt itself does not need.
+
+#include "HalDef.h"
+#include "I2cDispatcher.h"
+#include "I2cQueue.h"
+#include "I2cModel.h"
+#include "TestCheck.h"
+
+#ifndef I2C_QUEUE
+#error "The test needs the I2C queue of the IO_LINK board (I2C_QUEUE)"
+#endif
+
+#define TEST_BYTES	(19) // bytes on the bus of the transactions of TestProfile(), addresses included
+
+TEST_CHECK_DATA;
+
+void I2cQueueIsr(void);
+
+static uint8_t DoneOrder[8];
+static uint8_t DoneCount;
+
+//-----------------------------------------------------------------------------
+static void Done(I2cJob_t *Job)
+{
+	if (DoneCount < sizeof(DoneOrder))
+		DoneOrder[DoneCount] = Job->Address;
+	DoneCount++;
+}
+
+//-----------------------------------------------------------------------------
+static void TestProfile(uint8_t Profile, const I2cModelTiming_t *Spec)
+{
+	uint8_t *Mem = I2cModelSlaveMem();
+	uint8_t Write[3] = { 2, 0x55, 0x66 };
+	uint8_t Pointer[1] = { 2 };
+	uint8_t Pointer8[1] = { 8 };
+	uint8_t Second[2] = { 0x11, 0x22 };
+	uint8_t Read[4] = { 0 };
+	uint8_t Read2[2] = { 0 };
+	uint8_t Absent[2] = { 0 };
+	I2cJob_t JobWrite  = { I2C_Channel_Base, I2C_MODEL_SLAVE_ADDR, 3, Write, 0, 0, I2C_MODE_MULTIPLE_START, 0, Done, 0 };
+	I2cJob_t JobRead   = { I2C_Channel_Base, I2C_MODEL_SLAVE_ADDR, 1, Pointer, 4, Read, I2C_MODE_MULTIPLE_START, 0, Done, 0 };
+	I2cJob_t JobAbsent = { I2C_Channel_Base, 0x30, 1, Pointer, 2, Absent, I2C_MODE_MULTIPLE_START, 0, Done, 0 };
+	I2cJob_t JobChained= { I2C_Channel_Base, I2C_MODEL_SLAVE_ADDR, 1, Pointer, 0, 0, I2C_MODE_MULTIPLE_START, 0, Done, 0 };
+	I2cJob_t JobSecond = { I2C_Channel_Base, I2C_MODEL_SLAVE_ADDR, 1, Pointer8, 2, Second, I2C_MODE_WRITE_ALL_SECTIONS, 0, Done, 0 };
+	I2cJob_t JobNoRep  = { I2C_Channel_Base, I2C_MODEL_SLAVE_ADDR, 0, 0, 2, Read2, I2C_MODE_NOREPEAT_START, 0, Done, 0 };
+	uint32_t Interrupts;
+	uint32_t Interval;
+	uint64_t Cycles;
+	uint8_t i;
+
+	for (i = 0; i < I2C_MODEL_SLAVE_SIZE; i++)
+		Mem[i] = 0xA0 + i;
+	JobWrite.Chain = &JobRead;
+	JobAbsent.Chain = &JobChained;
+	DoneCount = 0;
+
+	I2cModelReset(Spec);
+	I2cTimerInit();
+	I2cSetProfile(I2C_Channel_Base, Profile);
+
+	TEST_CHECK(I2cSubmit(&JobWrite));
+	TEST_CHECK(I2cSubmit(&JobAbsent));
+	TEST_CHECK(I2cSubmit(&JobSecond));
+	TEST_CHECK(I2cSubmit(&JobNoRep));
+	TEST_CHECK_EQ(JobRead.State, I2C_JOB_PENDING);
+	TEST_CHECK(I2cQueueBusy());
+
+	Interrupts = I2cModelRunIsr(I2cQueueIsr);
+	Cycles = I2cModelTime();
+
+	TEST_CHECK(!I2cQueueBusy());
+	TEST_CHECK_EQ(JobWrite.State, I2C_PRESENT);
+	TEST_CHECK_EQ(JobRead.State, I2C_PRESENT);
+	TEST_CHECK_EQ(JobAbsent.State, I2C_ABSENT);
+	TEST_CHECK_EQ(JobChained.State, I2C_ABSENT);
+	TEST_CHECK_EQ(JobSecond.State, I2C_PRESENT);
+	TEST_CHECK_EQ(JobNoRep.State, I2C_PRESENT);
+
+	TEST_CHECK_EQ(Mem[2], 0x55);
+	TEST_CHECK_EQ(Mem[3], 0x66);
+	TEST_CHECK_EQ(Read[0], 0x55);
+	TEST_CHECK_EQ(Read[1], 0x66);
+	TEST_CHECK_EQ(Read[2], 0xA4);
+	TEST_CHECK_EQ(Read[3], 0xA5);
+	TEST_CHECK_EQ(Mem[8], 0x11);
+	TEST_CHECK_EQ(Mem[9], 0x22);
+	TEST_CHECK_EQ(Read2[0], 0xAA);
+	TEST_CHECK_EQ(Read2[1], 0xAB);
+
+	// the chain of the NACKed address is finished without bus activity
+	TEST_CHECK_EQ(DoneCount, 6);
+	TEST_CHECK_EQ(DoneOrder[2], 0x30);
+	TEST_CHECK_EQ(DoneOrder[3], I2C_MODEL_SLAVE_ADDR);
+	TEST_CHECK_EQ(I2cModelStarts(), 6);
+	TEST_CHECK_EQ(I2cModelStops(), 5);
+	TEST_CHECK_EQ(I2C_SDA_Ch0, 1);
+	TEST_CHECK_EQ(I2C_SCL_Ch0, 1);
+	TEST_CHECK_EQ(IE_ET2, 0);
+	TEST_CHECK_EQ(I2cModelViolations(), 0);
+
+	// the blocking transfers may use the bus again
+	TEST_CHECK_EQ(AccessI2C(I2C_Channel_Base, I2C_MODEL_SLAVE_ADDR, 1, Pointer, 2, Read, I2C_MODE_MULTIPLE_START), I2C_PRESENT);
+	TEST_CHECK_EQ(Read[0], 0x55);
+	TEST_CHECK_EQ(I2cModelViolations(), 0);
+
+	I2cModelReport();
+	Interval = 0x10000UL - I2cGetPhaseReload(I2C_Channel_Base);
+	printf("%-9s  %u interrupts for %u bytes in %u us, %u.%u per byte, one every %u SYSCLK cycles\n",
+			Spec->Name, Interrupts, TEST_BYTES, (uint32_t)(Cycles * 1000000ULL / SYSCLK_HZ),
+			Interrupts / TEST_BYTES, (Interrupts * 10 / TEST_BYTES) % 10, Interval);
+}
+
+//-----------------------------------------------------------------------------
+static void TestQueueFull(void)
+{
+	uint8_t Data[1] = { 0 };
+	I2cJob_t Job[I2C_QUEUE_SIZE + 1];
+	uint8_t i;
+
+	I2cModelReset(&I2cModelFast);
+	I2cTimerInit();
+	for (i = 0; i <= I2C_QUEUE_SIZE; i++)
+	{
+		I2cJob_t Init = { I2C_Channel_Base, I2C_MODEL_SLAVE_ADDR, 1, Data, 0, 0, I2C_MODE_MULTIPLE_START, 0, 0, 0 };
+		Job[i] = Init;
+	}
+
+	// nothing runs before the first interrupt, so one job more than the queue holds is rejected
+	for (i = 0; i < I2C_QUEUE_SIZE; i++)
+		TEST_CHECK(I2cSubmit(&Job[i]));
+	TEST_CHECK(!I2cSubmit(&Job[I2C_QUEUE_SIZE]));
+
+	I2cModelRunIsr(I2cQueueIsr);
+	for (i = 0; i < I2C_QUEUE_SIZE; i++)
+		TEST_CHECK_EQ(Job[i].State, I2C_PRESENT);
+	TEST_CHECK_EQ(I2cModelStarts(), I2C_QUEUE_SIZE);
+	TEST_CHECK_EQ(I2cModelViolations(), 0);
+}
+
+//-----------------------------------------------------------------------------
+int main(void)
+{
+	TestProfile(I2C_PROFILE_STANDARD, &I2cModelStandard);
+	TestProfile(I2C_PROFILE_FAST, &I2cModelFast);
+	TestQueueFull();
+
+	return (TEST_RESULT("TestI2cQueue"));
+}
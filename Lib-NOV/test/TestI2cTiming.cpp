@@ -0,0 +1,89 @@
+/*
+ * TestI2cTiming.cpp
+ *
+ *  Created on: 17.10.2026
+ *********************************************
+ *    (c)2016-2026 SIGITRONIC SOFTWARE       *
+ *                                           *
+ *      Author: Matthias Siegenthaler        *
+ *                                           *
+ *        matthias@sigitronic.com            *
+ *********************************************
+ */
+
+// Waveforms of the blocking AccessI2C() and I2cForceBits() with the Timer 2
+// bit timing (I2C_TIMED) in every profile, checked edge by edge by the bus
+// model against the minimum times of the I2C specification.
+
+#include "HalDef.h"
+#include "I2cDispatcher.h"
+#include "I2cModel.h"
+#include "TestCheck.h"
+
+#ifndef I2C_TIMED
+#error "The test needs the Timer 2 bit timing of the IO_LINK board (I2C_TIMED)"
+#endif
+
+TEST_CHECK_DATA;
+
+//-----------------------------------------------------------------------------
+static void TestProfile(uint8_t Profile, const I2cModelTiming_t *Spec)
+{
+	uint8_t *Mem = I2cModelSlaveMem();
+	uint8_t Write[3] = { 2, 0x55, 0x66 };
+	uint8_t Pointer[1] = { 2 };
+	uint8_t Pointer8[1] = { 8 };
+	uint8_t Second[2] = { 0x11, 0x22 };
+	uint8_t Read[4] = { 0 };
+	uint8_t i;
+
+	for (i = 0; i < I2C_MODEL_SLAVE_SIZE; i++)
+		Mem[i] = 0xA0 + i;
+
+	I2cModelReset(Spec);
+	I2cTimerInit();
+	I2cSetProfile(I2C_Channel_Base, Profile);
+
+	// register write
+	TEST_CHECK_EQ(AccessI2C(I2C_Channel_Base, I2C_MODEL_SLAVE_ADDR, 3, Write, 0, 0, I2C_MODE_MULTIPLE_START), I2C_PRESENT);
+	TEST_CHECK_EQ(Mem[2], 0x55);
+	TEST_CHECK_EQ(Mem[3], 0x66);
+
+	// register read with repeated start
+	TEST_CHECK_EQ(AccessI2C(I2C_Channel_Base, I2C_MODEL_SLAVE_ADDR, 1, Pointer, 4, Read, I2C_MODE_MULTIPLE_START), I2C_PRESENT);
+	TEST_CHECK_EQ(Read[0], 0x55);
+	TEST_CHECK_EQ(Read[1], 0x66);
+	TEST_CHECK_EQ(Read[2], 0xA4);
+	TEST_CHECK_EQ(Read[3], 0xA5);
+
+	// two write sections
+	TEST_CHECK_EQ(AccessI2C(I2C_Channel_Base, I2C_MODEL_SLAVE_ADDR, 1, Pointer8, 2, Second, I2C_MODE_WRITE_ALL_SECTIONS), I2C_PRESENT);
+	TEST_CHECK_EQ(Mem[8], 0x11);
+	TEST_CHECK_EQ(Mem[9], 0x22);
+
+	// read from the current pointer without repeated start
+	TEST_CHECK_EQ(AccessI2C(I2C_Channel_Base, I2C_MODEL_SLAVE_ADDR, 0, 0, 2, Read, I2C_MODE_NOREPEAT_START), I2C_PRESENT);
+	TEST_CHECK_EQ(Read[0], 0xAA);
+	TEST_CHECK_EQ(Read[1], 0xAB);
+
+	// no slave on the address
+	TEST_CHECK_EQ(AccessI2C(I2C_Channel_Base, 0x30, 1, Pointer, 2, Read, I2C_MODE_MULTIPLE_START), I2C_ABSENT);
+
+	// bus recovery
+	I2cForceBits(I2C_Channel_Base, 1, 9);
+
+	TEST_CHECK_EQ(I2cModelStarts(), 7);
+	TEST_CHECK_EQ(I2cModelStops(), 6);
+	TEST_CHECK_EQ(I2cGetPhaseReload(I2C_Channel_Base), TMR2RL);
+	TEST_CHECK_EQ(I2cModelViolations(), 0);
+	I2cModelReport();
+}
+
+//-----------------------------------------------------------------------------
+int main(void)
+{
+	TestProfile(I2C_PROFILE_STANDARD, &I2cModelStandard);
+	TestProfile(I2C_PROFILE_FAST, &I2cModelFast);
+
+	return (TEST_RESULT("TestI2cTiming"));
+}
@@ -0,0 +1,33 @@
+/*
+ * SI_EFM8UB3_Register_Enums.h
+ *
+ *  Created on: 17.10.2026
+ *********************************************
+ *    (c)2016-2026 SIGITRONIC SOFTWARE       *
+ *                                           *
+ *      Author: Matthias Siegenthaler        *
+ *                                           *
+ *        matthias@sigitronic.com            *
+ *********************************************
+ */
+
+// Host replacement of the EFM8UB3 register header for the tests: only the
+// registers used by the I2C bit timing and the I2C queue, backed by the
+// bus model of I2cModel.cpp.
+
+#ifndef SI_EFM8UB3_REGISTER_ENUMS_H
+#define SI_EFM8UB3_REGISTER_ENUMS_H
+
+#include "I2cModel.h"
+
+#define SFR_P0		0x80
+#define SFR_P1		0x90
+#define SFR_P2		0xA0
+#define SFR_P3		0xB0
+
+#define CKCON0_T2ML__SYSCLK		0x10
+#define CKCON0_T2MH__SYSCLK		0x20
+
+#define TIMER2_IRQn		5
+
+#endif /* SI_EFM8UB3_REGISTER_ENUMS_H */
@@ -0,0 +1,46 @@
+/*
+ * si_toolchain.h
+ *
+ *  Created on: 17.10.2026
+ *********************************************
+ *    (c)2016-2026 SIGITRONIC SOFTWARE       *
+ *                                           *
+ *      Author: Matthias Siegenthaler        *
+ *                                           *
+ *        matthias@sigitronic.com            *
+ *********************************************
+ */
+
+// Host replacement of the Keil C51 toolchain header for the tests.
+// The memory types vanish, the SFRs and sbits are the ones of the
+// I2C bus model (I2cModel.h, included by SI_EFM8UB3_Register_Enums.h).
+
+#ifndef __SI_TOOLCHAIN_H__
+#define __SI_TOOLCHAIN_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define code
+#define data
+#define idata
+#define xdata
+#define pdata
+#define bdata
+#define reentrant
+#define bit		bool
+
+#define SI_SEG_GENERIC
+#define SI_SEG_DATA
+#define SI_SEG_IDATA
+#define SI_SEG_XDATA
+#define SI_SEG_PDATA
+#define SI_SEG_BDATA
+#define SI_SEG_CODE
+
+#define SI_BIT(name)							bool name
+#define SI_SBIT(name, address, bitnum)			static I2cModelPin name(address, bitnum)
+#define SI_INTERRUPT(name, vector)				void name(void)
+#define SI_INTERRUPT_PROTO(name, vector)		void name(void)
+
+#endif /* __SI_TOOLCHAIN_H__ */